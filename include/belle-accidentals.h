@@ -117,9 +117,9 @@ Array<Vector> PlacementForAccidentalStack(
       Affine::Translate(Vector(0.f, VerticalPosition)));
 
     //Calculate the hulls.
-    List<Vector> AccumulatingHull = Box::SegmentedHull(
+    Sequence<Vector> AccumulatingHull = Box::SegmentedHull(
       AccumulatingBounds, Box::LeftSide);
-    List<Vector> AccidentalHull = Box::SegmentedHull(
+    Sequence<Vector> AccidentalHull = Box::SegmentedHull(
       AccidentalBounds, Box::RightSide);
 
     //Calculate the placement offset.
@@ -49,19 +49,21 @@ namespace BELLE_NAMESPACE
       mica::Concept BarlineType = Token->Get(mica::Value);
 
       //Get the staff height.
-      number StaffHeight = IslandNode->Label.GetState(
-        "PartState", "Staff", "Lines").AsNumber() - 1.0f;
+      number StaffHeight = IslandNode->Label.GetState(StateKey::PartState(),
+        StateKey::Staff(), StateKey::Lines()).AsNumber() - 1.0f;
 
       //Determine whether or not this barline connects to the previous staff.
       number AmountToExtend = 0.f;
-      if(IslandNode->Label.GetState(
-        "InstantState", "BarlineConnectsToPreviousStaff") &&
-        IslandNode->Label.GetState("InstantState",
-          "InteriorDistanceToPreviousStaff").AsNumber() > 0.f)
+      if(IslandNode->Label.GetState(StateKey::InstantState(),
+        StateKey::BarlineConnectsToPreviousStaff()) &&
+        IslandNode->Label.GetState(StateKey::InstantState(),
+          StateKey::InteriorDistanceToPreviousStaff()).AsNumber() > 0.f)
       {
         //Determine how far to extend the barline to the previous staff.
-        AmountToExtend = Max(IslandNode->Label.GetState("InstantState",
-          "InteriorDistanceToPreviousStaff").AsNumber(), number(2.f));
+        AmountToExtend = Max(IslandNode->Label.GetState(
+          StateKey::InstantState(),
+          StateKey::InteriorDistanceToPreviousStaff()).AsNumber(),
+          number(2.f));
       }
 
       const number BarlineThickness = HouseStyle::GetValue(IslandNode,
@@ -71,7 +73,7 @@ namespace BELLE_NAMESPACE
 
       if(BarlineType == mica::StandardBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         Shapes::AddLine(*p, Vector(0.f, StaffHeight / 2.f + AmountToExtend),
@@ -80,7 +82,7 @@ namespace BELLE_NAMESPACE
       }
       else if(BarlineType == mica::DashedBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         Shapes::AddDashedLine(*p,
@@ -91,7 +93,7 @@ namespace BELLE_NAMESPACE
       }
       else if(BarlineType == mica::DottedBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         Shapes::AddDashedLine(*p,
@@ -102,7 +104,7 @@ namespace BELLE_NAMESPACE
       }
       else if(BarlineType == mica::ThickBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         Shapes::AddLine(*p, Vector(0.f, StaffHeight / 2.f + AmountToExtend),
@@ -111,7 +113,7 @@ namespace BELLE_NAMESPACE
       }
       else if(BarlineType == mica::TickBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         Shapes::AddLine(*p, Vector(0.f, StaffHeight * 5.f / 8.f),
@@ -120,7 +122,7 @@ namespace BELLE_NAMESPACE
       }
       else if(BarlineType == mica::ShortBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         Shapes::AddLine(*p, Vector(0.f, StaffHeight / 4.f),
@@ -129,7 +131,7 @@ namespace BELLE_NAMESPACE
       }
       else if(BarlineType == mica::ThinDoubleBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         Shapes::AddLine(*p, Vector(0.3f, StaffHeight / 2.f + AmountToExtend),
@@ -141,7 +143,7 @@ namespace BELLE_NAMESPACE
       }
       else if(BarlineType == mica::FinalBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         number z = -0.67f - ThickBarlineThickness / 2.f +
@@ -156,7 +158,7 @@ namespace BELLE_NAMESPACE
       }
       else if(BarlineType == mica::BeginRepeatBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         number z = 0.67f + ThickBarlineThickness / 2.f;
@@ -172,7 +174,7 @@ namespace BELLE_NAMESPACE
       }
       else if(BarlineType == mica::ThickThinBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         number z = 0.67f + ThickBarlineThickness / 2.f;
@@ -186,7 +188,7 @@ namespace BELLE_NAMESPACE
       }
       else if(BarlineType == mica::ThickDoubleBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         number z = 0.97f + ThickBarlineThickness / 2.f;
@@ -200,7 +202,7 @@ namespace BELLE_NAMESPACE
       }
       else if(BarlineType == mica::EndRepeatBarline)
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         number z = -0.67f - ThickBarlineThickness / 2.f +
@@ -217,7 +219,7 @@ namespace BELLE_NAMESPACE
       }
       else //For as of yet unsupported features
       {
-        Pointer<Path> p = new Path;
+        Pointer<Path> p = Pointer<Path>::Make();
         IslandStamp->Add()->p = p;
         IslandStamp->z()->Context = Token;
         Shapes::AddLine(*p, Vector(0.f, StaffHeight / 2.f + AmountToExtend),
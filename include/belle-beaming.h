@@ -574,7 +574,8 @@ namespace BELLE_NAMESPACE
 
     static Value& StemState(Music::ConstNode Island, Music::ConstNode Chord)
     {
-      return Island->Label.SetState("PartState", "Chord")[Chord]["Stem"];
+      return Island->Label.SetState(StateKey::PartState(),
+        StateKey::Chord())[Chord][StateKey::Stem()];
     }
 
     static Vector StemEndPoint(const Value& Stem)
@@ -659,9 +660,9 @@ namespace BELLE_NAMESPACE
 
       //Calculate the slant.
       number StartX = IslandsInBeam.a()->Label.GetState(
-        "IslandState", "TypesetX");
+        StateKey::IslandState(), StateKey::TypesetX());
       number EndX = IslandsInBeam.z()->Label.GetState(
-        "IslandState", "TypesetX");
+        StateKey::IslandState(), StateKey::TypesetX());
 
       if(not Limits<number>::Bounded(StartX) or
          not Limits<number>::Bounded(EndX))
@@ -703,8 +704,8 @@ namespace BELLE_NAMESPACE
         {
           CollisionPoints.Add() =
             Vector(+IslandsInBeam[i]->Label.GetState(
-            "IslandState", "TypesetX"), 0) + StemEndPoint(
-            StemState(IslandsInBeam[i], ChordsInBeam[i]));
+            StateKey::IslandState(), StateKey::TypesetX()), 0) +
+            StemEndPoint(StemState(IslandsInBeam[i], ChordsInBeam[i]));
         }
         for(count i = 0; i < IslandsNotInBeam.n(); i++)
         {
@@ -712,7 +713,7 @@ namespace BELLE_NAMESPACE
           Pointer<Stamp> s = Island->Label.Stamp().Object();
           Box r = s->Bounds();
           Vector Delta = Vector(+Island->Label.GetState(
-            "IslandState", "TypesetX"), 0);
+            StateKey::IslandState(), StateKey::TypesetX()), 0);
           if(StemUp)
             CollisionPoints.Add() = r.TopLeft() + Delta + CollisionDisplace,
             CollisionPoints.Add() = r.TopRight() + Delta + CollisionDisplace;
@@ -774,7 +775,8 @@ namespace BELLE_NAMESPACE
         Line Slant(Start, End);
         Value& Stem = StemState(IslandsInBeam[i], ChordsInBeam[i]);
         Vector CurrentEndPoint = Vector(+IslandsInBeam[i]->Label.GetState(
-          "IslandState", "TypesetX"), 0) + StemEndPoint(Stem);
+          StateKey::IslandState(), StateKey::TypesetX()), 0) +
+          StemEndPoint(Stem);
         number y = 0.f;
         Slant.VerticalIntersection(y, CurrentEndPoint.x);
         if(StemUp)
@@ -803,7 +805,7 @@ namespace BELLE_NAMESPACE
         BeamGroup.Stems[i - 1].UnitsNextStemDistance =
           XPositions[i] - XPositions[i - 1];
 
-      Pointer<Path> p = new Path;
+      Pointer<Path> p = Pointer<Path>::Make();
       Pointer<Stamp> IslandToDrawTo = IslandsInBeam.a()->Label.Stamp().Object();
       BeamGroup.Paint(p);
 
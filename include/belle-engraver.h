@@ -44,6 +44,7 @@
 //. . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . //
 
 #include "belle-music.h" //complex container
+#include "belle-frozen-music.h" //complex container
 
 //. . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . //
 
@@ -36,44 +36,44 @@ Functions for performing score autocorrection.
 */
 void AutocorrectAddToReport(Value& Report, String Tag, String Description,
   Value OtherData);
-void AutocorrectAddFinalBarline(List<Pointer<Music> >& Systems,
+void AutocorrectAddFinalBarline(Sequence<Pointer<Music> >& Systems,
   Value& Report);
-void AutocorrectAddMissingBeginBarlines(List<Pointer<Music> >& Systems,
+void AutocorrectAddMissingBeginBarlines(Sequence<Pointer<Music> >& Systems,
   Value& Report);
-void AutocorrectAddMissingBraces(List<Pointer<Music> >& Systems,
+void AutocorrectAddMissingBraces(Sequence<Pointer<Music> >& Systems,
   Value& Report);
-void AutocorrectAddMissingEndBarlines(List<Pointer<Music> >& Systems,
+void AutocorrectAddMissingEndBarlines(Sequence<Pointer<Music> >& Systems,
   Value& Report);
 mica::Concept AutocorrectGetMostLikelyWrittenKeySignature(
-  List<Pointer<Music> >& Systems);
+  Sequence<Pointer<Music> >& Systems);
 String AutocorrectGetMostLikelyWrittenTimeSignature(
-  List<Pointer<Music> >& Systems);
-void AutocorrectRejectInconsistentPartSystems(List<Pointer<Music> >& Systems,
+  Sequence<Pointer<Music> >& Systems);
+void AutocorrectRejectInconsistentPartSystems(
+  Sequence<Pointer<Music> >& Systems, Value& Report);
+void AutocorrectRejectPartlessSystems(Sequence<Pointer<Music> >& Systems,
   Value& Report);
-void AutocorrectRejectPartlessSystems(List<Pointer<Music> >& Systems,
-  Value& Report);
-void AutocorrectRemoveAllOfTokenType(List<Pointer<Music> >& Systems,
+void AutocorrectRemoveAllOfTokenType(Sequence<Pointer<Music> >& Systems,
   mica::Concept TokenType);
-void AutocorrectRemoveEmptyIslands(List<Pointer<Music> >& Systems,
+void AutocorrectRemoveEmptyIslands(Sequence<Pointer<Music> >& Systems,
   Value& Report);
-void AutocorrectRemoveRestNonSequiturs(List<Pointer<Music> >& Systems,
+void AutocorrectRemoveRestNonSequiturs(Sequence<Pointer<Music> >& Systems,
   Value& Report);
-void AutocorrectRemoveWholeNoteNonSequiturs(List<Pointer<Music> >& Systems,
+void AutocorrectRemoveWholeNoteNonSequiturs(Sequence<Pointer<Music> >& Systems,
   Value& Report);
-void AutocorrectRestoreStaffPositions(List<Pointer<Music> >& Systems);
-void AutocorrectRewriteHeaders(List<Pointer<Music> >& Systems,
+void AutocorrectRestoreStaffPositions(Sequence<Pointer<Music> >& Systems);
+void AutocorrectRewriteHeaders(Sequence<Pointer<Music> >& Systems,
   Value& Report, String TimeSigRaw, mica::Concept KeySig, bool RebeamToTimeSig);
-void AutocorrectRewriteHeaders(List<Pointer<Music> >& Systems,
+void AutocorrectRewriteHeaders(Sequence<Pointer<Music> >& Systems,
   Value& Report, String TimeSigRaw, mica::Concept KeySig, bool RebeamToTimeSig,
   bool OmitTimeSig);
-void AutocorrectSaveStaffPositions(List<Pointer<Music> >& Systems);
-void AutocorrectScore(List<Pointer<Music> >& Systems);
-void AutocorrectScore(List<Pointer<Music> >& Systems,
+void AutocorrectSaveStaffPositions(Sequence<Pointer<Music> >& Systems);
+void AutocorrectScore(Sequence<Pointer<Music> >& Systems);
+void AutocorrectScore(Sequence<Pointer<Music> >& Systems,
   bool SystemAutocorrectionOnly);
 bool IsPopularTimeSignature(String t);
 void RemoveIslandAndRestitch(Pointer<Music> MusicSystem, Music::Node Island);
 Pointer<const Geometry> ReparseGeometry(Pointer<const Music> MusicSystem);
-bool SystemsAreBraced(List<Pointer<Music> >& Systems);
+bool SystemsAreBraced(Sequence<Pointer<Music> >& Systems);
 count ValidPartsInGeometry(Pointer<const Music> MusicSystem);
 
 #ifdef BELLE_IMPLEMENTATION
@@ -89,7 +89,7 @@ void AutocorrectAddToReport(Value& Report, String Tag, String Description,
   Report.Add() = Entry;
 }
 
-void AutocorrectAddFinalBarline(List<Pointer<Music> >& Systems,
+void AutocorrectAddFinalBarline(Sequence<Pointer<Music> >& Systems,
   Value& Report)
 {
   for(count i = Systems.n() - 1; i < Systems.n(); i++)
@@ -109,7 +109,7 @@ void AutocorrectAddFinalBarline(List<Pointer<Music> >& Systems,
   }
 }
 
-void AutocorrectAddMissingBeginBarlines(List<Pointer<Music> >& Systems,
+void AutocorrectAddMissingBeginBarlines(Sequence<Pointer<Music> >& Systems,
   Value& Report)
 {
   for(count i = 0; i < Systems.n(); i++)
@@ -159,7 +159,7 @@ void AutocorrectAddMissingBeginBarlines(List<Pointer<Music> >& Systems,
   }
 }
 
-void AutocorrectAddMissingBraces(List<Pointer<Music> >& Systems,
+void AutocorrectAddMissingBraces(Sequence<Pointer<Music> >& Systems,
   Value& Report)
 {
   if(SystemsAreBraced(Systems))
@@ -185,7 +185,7 @@ void AutocorrectAddMissingBraces(List<Pointer<Music> >& Systems,
   }
 }
 
-void AutocorrectAddMissingEndBarlines(List<Pointer<Music> >& Systems,
+void AutocorrectAddMissingEndBarlines(Sequence<Pointer<Music> >& Systems,
   Value& Report)
 {
   for(count i = 0; i < Systems.n(); i++)
@@ -232,7 +232,7 @@ void AutocorrectAddMissingEndBarlines(List<Pointer<Music> >& Systems,
 }
 
 mica::Concept AutocorrectGetMostLikelyWrittenKeySignature(
-  List<Pointer<Music> >& Systems)
+  Sequence<Pointer<Music> >& Systems)
 {
   Histogram Hist;
   for(count i = 0; i < Systems.n(); i++)
@@ -257,7 +257,7 @@ mica::Concept AutocorrectGetMostLikelyWrittenKeySignature(
 }
 
 String AutocorrectGetMostLikelyWrittenTimeSignature(
-  List<Pointer<Music> >& Systems)
+  Sequence<Pointer<Music> >& Systems)
 {
   Histogram Hist;
   for(count i = 0; i < Systems.n(); i++)
@@ -289,8 +289,8 @@ String AutocorrectGetMostLikelyWrittenTimeSignature(
   return MaxBin;
 }
 
-void AutocorrectRejectInconsistentPartSystems(List<Pointer<Music> >& Systems,
-  Value& Report)
+void AutocorrectRejectInconsistentPartSystems(
+  Sequence<Pointer<Music> >& Systems, Value& Report)
 {
   Value v;
   v[0] = 0;
@@ -324,7 +324,7 @@ void AutocorrectRejectInconsistentPartSystems(List<Pointer<Music> >& Systems,
     }
 }
 
-void AutocorrectRejectPartlessSystems(List<Pointer<Music> >& Systems,
+void AutocorrectRejectPartlessSystems(Sequence<Pointer<Music> >& Systems,
   Value& Report)
 {
   count i = Systems.n();
@@ -339,7 +339,7 @@ void AutocorrectRejectPartlessSystems(List<Pointer<Music> >& Systems,
     }
 }
 
-void AutocorrectRemoveAllOfTokenType(List<Pointer<Music> >& Systems,
+void AutocorrectRemoveAllOfTokenType(Sequence<Pointer<Music> >& Systems,
   mica::Concept TokenType)
 {
   bool Modified = false;
@@ -363,7 +363,7 @@ void AutocorrectRemoveAllOfTokenType(List<Pointer<Music> >& Systems,
   }
 }
 
-void AutocorrectRemoveEmptyIslands(List<Pointer<Music> >& Systems,
+void AutocorrectRemoveEmptyIslands(Sequence<Pointer<Music> >& Systems,
   Value& Report)
 {
   for(count i = 0; i < Systems.n(); i++)
@@ -390,7 +390,7 @@ void AutocorrectRemoveEmptyIslands(List<Pointer<Music> >& Systems,
   }
 }
 
-void AutocorrectRemoveRestNonSequiturs(List<Pointer<Music> >& Systems,
+void AutocorrectRemoveRestNonSequiturs(Sequence<Pointer<Music> >& Systems,
   Value& Report)
 {
   bool Modified = false;
@@ -430,7 +430,7 @@ void AutocorrectRemoveRestNonSequiturs(List<Pointer<Music> >& Systems,
   }
 }
 
-void AutocorrectRemoveWholeNoteNonSequiturs(List<Pointer<Music> >& Systems,
+void AutocorrectRemoveWholeNoteNonSequiturs(Sequence<Pointer<Music> >& Systems,
   Value& Report)
 {
   bool Modified = false;
@@ -476,7 +476,7 @@ void AutocorrectRemoveWholeNoteNonSequiturs(List<Pointer<Music> >& Systems,
   }
 }
 
-void AutocorrectRestoreStaffPositions(List<Pointer<Music> >& Systems)
+void AutocorrectRestoreStaffPositions(Sequence<Pointer<Music> >& Systems)
 {
   for(count i = 0; i < Systems.n(); i++)
   {
@@ -513,14 +513,14 @@ void AutocorrectRestoreStaffPositions(List<Pointer<Music> >& Systems)
   }
 }
 
-void AutocorrectRewriteHeaders(List<Pointer<Music> >& Systems,
+void AutocorrectRewriteHeaders(Sequence<Pointer<Music> >& Systems,
   Value& Report, String TimeSigRaw, mica::Concept KeySig, bool RebeamToTimeSig)
 {
   AutocorrectRewriteHeaders(Systems, Report, TimeSigRaw, KeySig,
     RebeamToTimeSig, false);
 }
 
-void AutocorrectRewriteHeaders(List<Pointer<Music> >& Systems,
+void AutocorrectRewriteHeaders(Sequence<Pointer<Music> >& Systems,
   Value& Report, String TimeSigRaw, mica::Concept KeySig, bool RebeamToTimeSig,
   bool OmitTimeSig)
 {
@@ -639,7 +639,7 @@ void AutocorrectRewriteHeaders(List<Pointer<Music> >& Systems,
   AutocorrectRestoreStaffPositions(Systems);
 }
 
-void AutocorrectSaveStaffPositions(List<Pointer<Music> >& Systems)
+void AutocorrectSaveStaffPositions(Sequence<Pointer<Music> >& Systems)
 {
   for(count i = 0; i < Systems.n(); i++)
   {
@@ -674,12 +674,12 @@ void AutocorrectSaveStaffPositions(List<Pointer<Music> >& Systems)
   }
 }
 
-void AutocorrectScore(List<Pointer<Music> >& Systems)
+void AutocorrectScore(Sequence<Pointer<Music> >& Systems)
 {
   AutocorrectScore(Systems, false);
 }
 
-void AutocorrectScore(List<Pointer<Music> >& Systems,
+void AutocorrectScore(Sequence<Pointer<Music> >& Systems,
   bool SystemAutocorrectionOnly)
 {
   Value Report;
@@ -743,7 +743,7 @@ Pointer<const Geometry> ReparseGeometry(Pointer<const Music> MusicSystem)
   return G;
 }
 
-bool SystemsAreBraced(List<Pointer<Music> >& Systems)
+bool SystemsAreBraced(Sequence<Pointer<Music> >& Systems)
 {
   bool BraceFound = false;
   for(count i = 0; i < Systems.n() and not BraceFound; i++)
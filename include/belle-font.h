@@ -275,41 +275,175 @@ namespace BELLE_NAMESPACE
       return 0.0;
     }
 
-    ///Loads a typeface from a JSON string.
-    void ImportFromJSON(const String& JSONData)
+    private:
+
+    /**Streams the events of a typeface JSON document straight into the glyphs
+    of a typeface, so that the document is never built as a Value. Only the
+    markers of each glyph are collected as a Value, since they are stored as
+    one.*/
+    class JSONImporter : public JSON::Handler
     {
-      Clear();
-      Value v;
-      JSON::Import(JSONData, v);
-      TypographicHeight = v["TypographicHeight"].AsNumber();
-      TypographicAscender = v["TypographicAscender"].AsNumber();
-      TypographicDescender = v["TypographicDescender"].AsNumber();
-      Array<Value> GlyphsKeys;
-      v["Glyphs"].EnumerateKeys(GlyphsKeys);
-      for(count i = 0, n = GlyphsKeys.n(); i < n; i++)
+      ///The typeface being imported
+      Typeface& Target;
+
+      ///The key under which each open container was opened
+      Array<String> Scope;
+
+      ///The most recent key of the innermost object
+      String Key;
+
+      ///The glyph being imported
+      Pointer<Glyph> CurrentGlyph;
+
+      ///Collects the markers of the current glyph
+      Pointer<JSON::ValueBuilder> Markers;
+
+      public:
+
+      ///Creates an importer for the given typeface.
+      JSONImporter(Typeface& Target_) : Target(Target_) {}
+
+      bool OnBeginObject()
+      {
+        if(Markers)
+          return Forward(Markers->OnBeginObject());
+        if(InGlyphs())
+          CurrentGlyph = Target.Add(unicode(count(Key.ToNumber())));
+        Scope.Add() = Key;
+        return true;
+      }
+
+      bool OnEndObject()
+      {
+        if(Markers)
+          return Forward(Markers->OnEndObject());
+        if(InGlyph())
+          CurrentGlyph = Pointer<Glyph>();
+        Scope.Pop();
+        return true;
+      }
+
+      bool OnBeginArray()
+      {
+        if(Markers)
+          return Forward(Markers->OnBeginArray());
+        Scope.Add() = Key;
+        Key = "";
+        return true;
+      }
+
+      bool OnEndArray()
+      {
+        if(Markers)
+          return Forward(Markers->OnEndArray());
+        Scope.Pop();
+        return true;
+      }
+
+      bool OnKey(const StringView& Text)
+      {
+        if(Markers)
+          return Forward(Markers->OnKey(Text));
+        Key = String(Text);
+        if(InGlyph() and Key == "Markers")
+          Markers = new JSON::ValueBuilder(CurrentGlyph->Markers);
+        return true;
+      }
+
+      bool OnString(const StringView& Text)
+      {
+        if(Markers)
+          return Forward(Markers->OnString(Text));
+        if(InGlyph() and Key == "Path")
+          SVGHelper::ImportData(*CurrentGlyph, String(Text));
+        else if(InGlyph() and Key == "Collision")
+        {
+          Path Collision;
+          SVGHelper::ImportData(Collision, String(Text));
+          if(Collision.Outline().n())
+            CurrentGlyph->Collision = Collision.Outline().a();
+        }
+        return true;
+      }
+
+      bool OnInteger(integer x)
+      {
+        if(Markers)
+          return Forward(Markers->OnInteger(x));
+        return OnNumber(number(x));
+      }
+
+      bool OnNumber(number x)
       {
-        Value Unicode = GlyphsKeys[i];
-        Pointer<Glyph> g = Add(unicode(Unicode.AsCount()));
-        SVGHelper::ImportData(*g, v["Glyphs"][Unicode]["Path"].AsString());
-        Path Collision;
-        SVGHelper::ImportData(Collision,
-          v["Glyphs"][Unicode]["Collision"].AsString());
-        if(Collision.Outline().n())
-          g->Collision = Collision.Outline().a();
-
-        g->AdvanceWidth = v["Glyphs"][Unicode]["AdvanceWidth"].AsNumber();
-        g->Markers = v["Glyphs"][Unicode]["Markers"];
-        Value Kerning = v["Glyphs"][Unicode]["Kerning"];
-        Array<Value> KerningKeys;
-        Kerning.EnumerateKeys(KerningKeys);
-        for(count j = 0; j < KerningKeys.n(); j++)
+        if(Markers)
+          return Forward(Markers->OnNumber(x));
+        if(Scope.n() == 1 and Key == "TypographicHeight")
+          Target.TypographicHeight = x;
+        else if(Scope.n() == 1 and Key == "TypographicAscender")
+          Target.TypographicAscender = x;
+        else if(Scope.n() == 1 and Key == "TypographicDescender")
+          Target.TypographicDescender = x;
+        else if(InGlyph() and Key == "AdvanceWidth")
+          CurrentGlyph->AdvanceWidth = x;
+        else if(InKerning())
         {
           Glyph::Kerning k;
-          k.FollowingCharacter = unicode(KerningKeys[j].AsCount());
-          k.HorizontalAdjustment = Kerning[KerningKeys[j]];
-          g->Kern.Add(k);
+          k.FollowingCharacter = unicode(count(Key.ToNumber()));
+          k.HorizontalAdjustment = x;
+          CurrentGlyph->Kern.Add(k);
         }
+        return true;
+      }
+
+      bool OnBoolean(bool x)
+      {
+        return Markers ? Forward(Markers->OnBoolean(x)) : true;
+      }
+
+      bool OnNull()
+      {
+        return Markers ? Forward(Markers->OnNull()) : true;
+      }
+
+      private:
+
+      ///Stops collecting markers once their value is complete.
+      bool Forward(bool Continue)
+      {
+        if(Markers->Finished())
+          Markers = Pointer<JSON::ValueBuilder>();
+        return Continue;
+      }
+
+      ///Returns whether the innermost container is the glyph table.
+      bool InGlyphs() const
+      {
+        return Scope.n() == 2 and Scope[1] == "Glyphs";
+      }
+
+      ///Returns whether the innermost container is a glyph.
+      bool InGlyph() const
+      {
+        return Scope.n() == 3 and Scope[1] == "Glyphs" and CurrentGlyph;
+      }
+
+      ///Returns whether the innermost container is the kerning of a glyph.
+      bool InKerning() const
+      {
+        return Scope.n() == 4 and Scope[1] == "Glyphs" and
+          Scope[3] == "Kerning" and CurrentGlyph;
       }
+    };
+
+    public:
+
+    ///Loads a typeface from a JSON string.
+    void ImportFromJSON(const String& JSONData)
+    {
+      Clear();
+      JSONImporter Importer(*this);
+      if(not JSON::Parse(JSONData, Importer))
+        Clear();
     }
 
     ///Saves a typeface to a JSON string.
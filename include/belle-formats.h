@@ -46,7 +46,12 @@ String ConvertToXML(const String& MusicInput,
   const Array<byte>& MusicXMLValidationZip)
 {
   String Input = MusicInput;
-  if(Input.StartsWith("PK"))
+  if(Music::IsBinary(Input))
+  {
+    Music BinaryGraph;
+    return BinaryGraph.ImportBinary(Input) ? BinaryGraph.ExportXML() : String();
+  }
+  else if(Input.StartsWith("PK"))
   {
     bool Unzipped = false;
 #ifdef PRIM_WITH_SHELL
@@ -0,0 +1,236 @@
+/*
+  ==============================================================================
+
+  Copyright 2007-2013, 2017 Andi
+  Copyright 2013-2016 Robert Taub
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+
+  ==============================================================================
+*/
+
+#ifndef BELLE_ENGRAVER_FROZEN_MUSIC_H
+#define BELLE_ENGRAVER_FROZEN_MUSIC_H
+
+namespace BELLE_NAMESPACE
+{
+  /**Immutable snapshot of the topology of a music graph. The nodes are given
+  dense IDs from zero to n() - 1 in address order, and the edges leaving and
+  arriving at each node are stored contiguously in compressed-sparse-row form
+  with their types in a separate column. Next(), Previous(), Children() and
+  Parents() follow the same rules as the traversal methods of the graph with a
+  filter of the given type: the edges are visited in the same order and Next()
+  and Previous() return no node if more than one edge matches. Node IDs are -1
+  when there is no node.
+
+  The snapshot keeps a handle to each node so that passes may read and write
+  the state of the labels, but it is not updated when nodes or edges are added,
+  removed, or relabeled, so it should be made after the graph is complete.*/
+  class FrozenMusic
+  {
+    ///Handles of the nodes by ID
+    Array<Music::ConstNode> Nodes;
+
+    ///Type of each node
+    Array<mica::Concept> NodeTypes;
+
+    ///Kind of each node
+    Array<mica::Concept> NodeKinds;
+
+    ///Start of the departing edges of each node, followed by the total count
+    Array<count> OutBegin;
+
+    ///Node that each departing edge arrives at
+    Array<count> OutNode;
+
+    ///Type of each departing edge
+    Array<mica::Concept> OutType;
+
+    ///Start of the arriving edges of each node, followed by the total count
+    Array<count> InBegin;
+
+    ///Node that each arriving edge departs from
+    Array<count> InNode;
+
+    ///Type of each arriving edge
+    Array<mica::Concept> InType;
+
+    ///Looks up the ID of a node by the address of its object.
+    HashMap<const Music::Graph::Object*, count> IDs;
+
+    ///ID of the root node
+    count RootID; PRIM_PAD(count)
+
+    ///Adds the edges of one direction of a node to the edge columns.
+    static void AddEdges(const Array<Music::ConstEdge>& Edges, bool Forwards,
+      const HashMap<const Music::Graph::Object*, count>& IDs,
+      Array<count>& EdgeNode, Array<mica::Concept>& EdgeType)
+    {
+      for(count i = 0; i < Edges.n(); i++)
+      {
+        Music::ConstNode Other = Forwards ? Edges[i]->Head() : Edges[i]->Tail();
+        EdgeNode.Add() = IDs[Other.Raw()];
+        EdgeType.Add() = Edges[i]->Get(mica::Type);
+      }
+    }
+
+    ///Returns the only node along an edge of the given type or -1.
+    static count Single(const Array<count>& Begin,
+      const Array<count>& EdgeNode, const Array<mica::Concept>& EdgeType,
+      count n, mica::Concept Type)
+    {
+      count Result = -1;
+      if(n < 0 or n >= Begin.n() - 1)
+        return Result;
+      for(count i = Begin[n], End = Begin[n + 1]; i < End; i++)
+      {
+        if(EdgeType[i] != Type)
+          continue;
+        if(Result >= 0)
+          return -1;
+        Result = EdgeNode[i];
+      }
+      return Result;
+    }
+
+    ///Fills an array with the nodes along the edges of the given type.
+    static void Every(const Array<count>& Begin,
+      const Array<count>& EdgeNode, const Array<mica::Concept>& EdgeType,
+      count n, mica::Concept Type, Array<count>& Result)
+    {
+      Result.Clear();
+      if(n < 0 or n >= Begin.n() - 1)
+        return;
+      for(count i = Begin[n], End = Begin[n + 1]; i < End; i++)
+        if(EdgeType[i] == Type)
+          Result.Add() = EdgeNode[i];
+    }
+
+    public:
+
+    ///Takes a snapshot of the graph.
+    FrozenMusic(const Music::Graph& G) : RootID(-1)
+    {
+      Sortable::Array<Music::ConstNode> AllNodes = G.Nodes();
+      count NodeCount = AllNodes.n();
+      Nodes.n(NodeCount);
+      NodeTypes.n(NodeCount);
+      NodeKinds.n(NodeCount);
+      IDs.Reserve(NodeCount);
+      for(count i = 0; i < NodeCount; i++)
+      {
+        Nodes[i] = AllNodes[i];
+        NodeTypes[i] = AllNodes[i]->Get(mica::Type);
+        NodeKinds[i] = AllNodes[i]->Get(mica::Kind);
+        IDs[AllNodes[i].Raw()] = i;
+      }
+      if(Music::ConstNode Root = G.Root())
+        RootID = IDs[Root.Raw()];
+
+      OutBegin.n(NodeCount + 1);
+      InBegin.n(NodeCount + 1);
+      for(count i = 0; i < NodeCount; i++)
+      {
+        OutBegin[i] = OutNode.n();
+        AddEdges(Nodes[i]->Children(MusicLabel(), true), true, IDs, OutNode,
+          OutType);
+        InBegin[i] = InNode.n();
+        AddEdges(Nodes[i]->Parents(MusicLabel(), true), false, IDs, InNode,
+          InType);
+      }
+      OutBegin[NodeCount] = OutNode.n();
+      InBegin[NodeCount] = InNode.n();
+    }
+
+    ///Returns the number of nodes.
+    count n() const {return Nodes.n();}
+
+    ///Returns the ID of the root node or -1 if there is none.
+    count Root() const {return RootID;}
+
+    ///Returns the ID of a node or -1 if it is not in the snapshot.
+    count ID(Music::ConstNode Node) const
+    {
+      return Node and IDs.Contains(Node.Raw()) ? IDs[Node.Raw()] : count(-1);
+    }
+
+    ///Returns the node with the given ID.
+    Music::ConstNode Node(count n) const
+    {
+      return n >= 0 and n < Nodes.n() ? Nodes[n] : Music::ConstNode();
+    }
+
+    ///Returns the type of the node with the given ID.
+    mica::Concept Type(count n) const
+    {
+      return n >= 0 and n < Nodes.n() ? NodeTypes[n] : mica::Concept();
+    }
+
+    ///Returns the kind of the node with the given ID.
+    mica::Concept Kind(count n) const
+    {
+      return n >= 0 and n < Nodes.n() ? NodeKinds[n] : mica::Concept();
+    }
+
+    /**Returns the node following the only departing edge of the given type,
+    or -1 if there is no such edge or more than one.*/
+    count Next(count n, mica::Concept EdgeType) const
+    {
+      return Single(OutBegin, OutNode, OutType, n, EdgeType);
+    }
+
+    /**Returns the node preceding the only arriving edge of the given type, or
+    -1 if there is no such edge or more than one.*/
+    count Previous(count n, mica::Concept EdgeType) const
+    {
+      return Single(InBegin, InNode, InType, n, EdgeType);
+    }
+
+    ///Fills an array with the nodes following departing edges of a type.
+    void Children(count n, mica::Concept EdgeType, Array<count>& Result) const
+    {
+      Every(OutBegin, OutNode, OutType, n, EdgeType, Result);
+    }
+
+    ///Fills an array with the nodes preceding arriving edges of a type.
+    void Parents(count n, mica::Concept EdgeType, Array<count>& Result) const
+    {
+      Every(InBegin, InNode, InType, n, EdgeType, Result);
+    }
+
+    ///Fills an array with the handles of the nodes with the given IDs.
+    void Handles(const Array<count>& IDArray,
+      Array<Music::ConstNode>& Result) const
+    {
+      Result.n(IDArray.n());
+      for(count i = 0; i < IDArray.n(); i++)
+        Result[i] = Node(IDArray[i]);
+    }
+  };
+
+  inline Pointer<const FrozenMusic> Music::Freeze() const
+  {
+    return new FrozenMusic(*this);
+  }
+}
+#endif
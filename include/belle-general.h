@@ -394,7 +394,8 @@ Ratio RhythmicDurationOfIsland(Music::ConstNode x)
   Ratio Duration;
   if(Chords.n())
   {
-    Duration = x->Label.GetState("PartState", "Voicing", "Duration").AsRatio();
+    Duration = x->Label.GetState(StateKey::PartState(), StateKey::Voicing(),
+      StateKey::Duration()).AsRatio();
     if(not (Duration > 0))
       Duration = RhythmicDurationOfChord(Chords.a());
   }
@@ -403,12 +404,12 @@ Ratio RhythmicDurationOfIsland(Music::ConstNode x)
 
 count PartIDOfIsland(Music::ConstNode x)
 {
-  return IsIsland(x) ? x->Label.GetState("PartID").AsCount() : -1;
+  return IsIsland(x) ? x->Label.GetState(StateKey::PartID()).AsCount() : -1;
 }
 
 count InstantIDOfIsland(Music::ConstNode x)
 {
-  return IsIsland(x) ? x->Label.GetState("InstantID").AsCount() : -1;
+  return IsIsland(x) ? x->Label.GetState(StateKey::InstantID()).AsCount() : -1;
 }
 
 void UnlinkUnnecessaryInstantwiseEdges(Music& G)
@@ -561,8 +562,8 @@ Value ChordStemIsUpInPartState(Music::ConstNode Chord)
   Music::ConstNode Island = IslandOfToken(Chord);
   Value v;
   if(Island and IsChord(Chord))
-    v = mica::Concept(Island->Label.GetState(
-      "PartState", "Chord")[Chord]["StemDirection"]) == mica::Up;
+    v = mica::Concept(Island->Label.GetState(StateKey::PartState(),
+      StateKey::Chord())[Chord][StateKey::StemDirection()]) == mica::Up;
   return v;
 }
 
@@ -570,7 +571,7 @@ number TypesetXOfIsland(Music::ConstNode Island)
 {
   Value v;
   if(IsIsland(Island))
-    v = Island->Label.GetState("IslandState", "TypesetX");
+    v = Island->Label.GetState(StateKey::IslandState(), StateKey::TypesetX());
   return v.IsNumber() ? v.AsNumber() : number(0.f);
 }
 
@@ -288,18 +288,23 @@ namespace BELLE_NAMESPACE
       if(mg.Root()->Previous(MusicLabel(mica::Instantwise)))
         return "Root is not top-most island";
 
+      Music::ConstNodeBuffer Adjacent;
       for(count i = 0; i < Islands.n(); i++)
       {
-        if(Islands[i]->Children(MusicLabel(mica::Partwise)).n() > 1)
+        Islands[i]->Children(MusicLabel(mica::Partwise), Adjacent);
+        if(Adjacent.n() > 1)
           return String("Island node " ) + String(Islands[i]) +
             " has more than one outgoing partwise edge";
-        if(Islands[i]->Parents(MusicLabel(mica::Partwise)).n() > 1)
+        Islands[i]->Parents(MusicLabel(mica::Partwise), Adjacent);
+        if(Adjacent.n() > 1)
           return String("Island node " ) + String(Islands[i]) +
             " has more than one incoming partwise edge";
-        if(Islands[i]->Children(MusicLabel(mica::Instantwise)).n() > 1)
+        Islands[i]->Children(MusicLabel(mica::Instantwise), Adjacent);
+        if(Adjacent.n() > 1)
           return String("Island node " ) + String(Islands[i]) +
             " has more than one outgoing instant-wise edge";
-        if(Islands[i]->Parents(MusicLabel(mica::Instantwise)).n() > 1)
+        Islands[i]->Parents(MusicLabel(mica::Instantwise), Adjacent);
+        if(Adjacent.n() > 1)
           return String("Island node " ) + String(Islands[i]) +
             " has more than one incoming instant-wise edge";
         if(not Islands[i]->Next(MusicLabel(mica::Partwise)) and
@@ -343,8 +348,9 @@ namespace BELLE_NAMESPACE
       IslandMatrix.mn(PartCount, InstantCount);
       for(count i = 0; i < Islands.n(); i++)
       {
-        count Instant = Islands[i]->Label.GetState("InstantID").AsCount();
-        count Part = Islands[i]->Label.GetState("PartID").AsCount();
+        count Instant =
+          Islands[i]->Label.GetState(StateKey::InstantID()).AsCount();
+        count Part = Islands[i]->Label.GetState(StateKey::PartID()).AsCount();
         IslandMatrix(Part, Instant) = Islands[i];
       }
     }
@@ -384,8 +390,8 @@ namespace BELLE_NAMESPACE
 
       //Go through each island and map its part.
       for(count i = 0; i < Islands.n(); i++)
-        Islands[i]->Label.SetState("PartID") =
-          PartMap[Islands[i]->Label.GetState("PartID").AsCount()];
+        Islands[i]->Label.SetState(StateKey::PartID()) =
+          PartMap[Islands[i]->Label.GetState(StateKey::PartID()).AsCount()];
 
       //Mark the part bounds.
       MarkPartBounds();
@@ -409,7 +415,7 @@ namespace BELLE_NAMESPACE
       Array<Music::ConstNode> FirstInstant;
       List<Music::ConstNode> LeadingEdge;
 
-      Tree<Music::ConstNode, bool> Visited;
+      HashSet<Music::ConstNode> Visited;
 
       //Gather the islands to the first instant.
       FirstInstant = t->Series(Music::Label(mica::Instantwise));
@@ -417,8 +423,8 @@ namespace BELLE_NAMESPACE
 
       //Define leading edge for the first instant.
       for(count i = 0; i < LeadingEdge.n(); i++)
-        LeadingEdge[i]->Label.SetState("InstantID") = 0,
-        Visited.Set(LeadingEdge[i]) = true;
+        LeadingEdge[i]->Label.SetState(StateKey::InstantID()) = 0,
+        Visited.Add(LeadingEdge[i]);
 
       //Define part count for first instant.
       PartsInInstant.Clear();
@@ -516,10 +522,10 @@ namespace BELLE_NAMESPACE
               }
             }
 
-            InstantGroup[j]->Label.SetState("InstantID") = InstantID;
+            InstantGroup[j]->Label.SetState(StateKey::InstantID()) = InstantID;
             if(Visited.Contains(InstantGroup[j]))
               return false;
-            Visited.Set(InstantGroup[j]) = true;
+            Visited.Add(InstantGroup[j]);
           }
 
           //Record the number of parts detected in this instant.
@@ -581,7 +587,7 @@ namespace BELLE_NAMESPACE
         //Tag all islands in a part strand with a part ID.
         while(Current)
         {
-          Current->Label.SetState("PartID") = PartIndex;
+          Current->Label.SetState(StateKey::PartID()) = PartIndex;
           Current = Current->Next(Music::Label(mica::Partwise));
         }
 
@@ -600,8 +606,8 @@ namespace BELLE_NAMESPACE
       bool FoundContradiction = false;
       for(count i = 0; i < Islands.n() and not FoundContradiction; i++)
         if((Next = Islands[i]->Next(Music::Label(mica::Instantwise))))
-          if(Islands[i]->Label.GetState("PartID") ==
-            Next->Label.GetState("PartID"))
+          if(Islands[i]->Label.GetState(StateKey::PartID()) ==
+            Next->Label.GetState(StateKey::PartID()))
               FoundContradiction = true;
       return not FoundContradiction;
     }
@@ -619,7 +625,7 @@ namespace BELLE_NAMESPACE
         Music::ConstNode Current = Islands[i];
 
         //Get the current part ID.
-        count PartID = Current->Label.GetState("PartID").AsCount();
+        count PartID = Current->Label.GetState(StateKey::PartID()).AsCount();
 
         //Look for a start.
         if(!Current->Previous(Music::Label(mica::Partwise)))
@@ -638,9 +644,9 @@ namespace BELLE_NAMESPACE
       for(count i = 0; i < PartBounds.n(); i++)
       {
         PartInstantRange[i].i() =
-          PartBounds[i].i()->Label.GetState("InstantID");
+          PartBounds[i].i()->Label.GetState(StateKey::InstantID());
         PartInstantRange[i].j() =
-          PartBounds[i].j()->Label.GetState("InstantID");
+          PartBounds[i].j()->Label.GetState(StateKey::InstantID());
       }
     }
 
@@ -652,8 +658,8 @@ namespace BELLE_NAMESPACE
         Music::ConstNode Current = Islands[i];
         Music::ConstNode Next;
         if((Next = Current->Next(Music::Label(mica::Instantwise))))
-          t.Set(Current->Label.GetState("PartID").AsCount(),
-            Next->Label.GetState("PartID").AsCount(),
+          t.Set(Current->Label.GetState(StateKey::PartID()).AsCount(),
+            Next->Label.GetState(StateKey::PartID()).AsCount(),
             TransitiveClosure::LessThan);
       }
     }
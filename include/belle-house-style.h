@@ -231,11 +231,12 @@ namespace BELLE_NAMESPACE
       if(!Island)
         return Value();
 
-      if(Island->Label.SetState()["HouseStyle"]["Local"].Contains(Key))
-        return Island->Label.SetState()["HouseStyle"]["Local"][Key];
+      Value& Style = Island->Label.SetState()[StateKey::HouseStyle()];
+      Value& Local = Style[StateKey::Local()];
+      if(Local.Contains(Key))
+        return Local[Key];
 
-      Pointer<Value::ConstReference> vr =
-        Island->Label.SetState()["HouseStyle"]["Global"].Object();
+      Pointer<Value::ConstReference> vr = Style[StateKey::Global()].Object();
       if(!vr)
         return Value();
       return vr->Get()[Key];
@@ -263,7 +264,8 @@ namespace BELLE_NAMESPACE
     {
       if(!Island)
         return Pointer<const Value::ConstReference>();
-      return Island->GetState("HouseStyle", "Global").ConstObject();
+      return Island->GetState(StateKey::HouseStyle(),
+        StateKey::Global()).ConstObject();
     }
 
     ///Returns the local house style on an island.
@@ -272,7 +274,8 @@ namespace BELLE_NAMESPACE
     {
       if(!Island)
         return Pointer<const Value::ConstReference>();
-      return Island->GetState("HouseStyle", "Local").ConstObject();
+      return Island->GetState(StateKey::HouseStyle(),
+        StateKey::Local()).ConstObject();
     }
 
     ///Returns the notation font specified on the island.
@@ -33,6 +33,7 @@
 ///@{
 Pointer<Music> AbridgeSystem(Pointer<const Music> M, count MaximumIslands);
 Pointer<Music> AbridgeSystem(String ScoreFile, count MaximumIslands);
+Pointer<Music> AbridgeSystemInPlace(Pointer<Music> M, count MaximumIslands);
 String AbridgeSystemAsSVG(String ScoreFile, Font NotationFont,
   count MaximumIslands, number InchesWidth,
   number InchesMargin, number SpaceHeight, bool FormatAsPDF);
@@ -61,7 +62,8 @@ String RenderIncipitAsSVG(Pointer<Music> Incipit, Font NotationFont,
 #ifdef BELLE_IMPLEMENTATION
 Pointer<Music> AbridgeSystem(Pointer<const Music> M, count MaximumIslands)
 {
-  return AbridgeSystem(M ? M->ExportXML() : String(), MaximumIslands);
+  return AbridgeSystemInPlace(M ? M->Clone() : Pointer<Music>(),
+    MaximumIslands);
 }
 
 Pointer<Music> AbridgeSystem(String ScoreFile, count MaximumIslands)
@@ -69,6 +71,11 @@ Pointer<Music> AbridgeSystem(String ScoreFile, count MaximumIslands)
   Pointer<Music> M;
   if(ScoreFile)
     M.New()->ImportXML(ConvertToXML(ScoreFile));
+  return AbridgeSystemInPlace(M, MaximumIslands);
+}
+
+Pointer<Music> AbridgeSystemInPlace(Pointer<Music> M, count MaximumIslands)
+{
   Music::Node BarlineToSnipAt;
   if(M)
   {
@@ -232,8 +239,8 @@ String RenderIncipitAsSVG(Pointer<Music> Incipit, Font NotationFont,
     IncipitScore.Canvases.Add() = IncipitPage.New();
     IncipitPage->Dimensions = OverallBounds.Size() +
       Vector(InchesMargin, InchesMargin) * 2.f;
-    List<Pointer<const Music> > Systems;
-    List<Vector> Positions;
+    Sequence<Pointer<const Music> > Systems;
+    Sequence<Vector> Positions;
     Systems.Add() = Incipit;
     Positions.Add() = Vector(InchesMargin - OverallBounds.Left(),
       InchesMargin - OverallBounds.Bottom());
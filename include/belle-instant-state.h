@@ -41,24 +41,25 @@ namespace BELLE_NAMESPACE
     /*Static interface -- instances not allowed*/ InstantState();
 
     ///Accumulates information into the instant state.
-    static void AccumulateStateForInstant(Music::ConstNode IslandNode)
+    static void AccumulateStateForInstant(const FrozenMusic& F, count Island)
     {
+      Music::ConstNode IslandNode = F.Node(Island);
       if(!IslandNode)
         return;
 
-      IslandNode->Label.SetState("InstantState").NewTree();
+      IslandNode->Label.SetState(StateKey::InstantState()).NewTree();
 
       if(Music::ConstNode Previous =
-        IslandNode->Previous(MusicLabel(mica::Instantwise)))
+        F.Node(F.Previous(Island, mica::Instantwise)))
       {
-        Value& PreviousState = Previous->Label.SetState("PartState");
-        Value& CurrentState = IslandNode->Label.SetState("PartState");
+        Value& PreviousState = Previous->Label.SetState(StateKey::PartState());
+        Value& CurrentState = IslandNode->Label.SetState(StateKey::PartState());
 
-        IslandNode->Label.SetState(
-          "InstantState", "BarlineConnectsToPreviousStaff") =
+        IslandNode->Label.SetState(StateKey::InstantState(),
+          StateKey::BarlineConnectsToPreviousStaff()) =
           PreviousState["Staff"]["Connects"];
-        IslandNode->Label.SetState(
-          "InstantState", "InteriorDistanceToPreviousStaff") =
+        IslandNode->Label.SetState(StateKey::InstantState(),
+          StateKey::InteriorDistanceToPreviousStaff()) =
           (+PreviousState["Staff"]["Offset"] -
           (+PreviousState["Staff"]["Lines"] - 1.f) / 2.f) -
           (+CurrentState["Staff"]["Offset"] +
@@ -73,14 +74,18 @@ namespace BELLE_NAMESPACE
     {
       //Validate parameters.
       if(!M) return;
+      Accumulate(*M->Freeze());
+    }
 
+    ///Accumulates instant state for each island of a frozen system.
+    static void Accumulate(const FrozenMusic& F)
+    {
       /*Start at the root and for each island heading instantwise, traverse
       partwise. #limitation : does not take into account non-grid scores.
       Should traverse by geometry.*/
-      Music::ConstNode m, n;
-      for(m = M->Root(); m; m = m->Next(MusicLabel(mica::Instantwise)))
-        for(n = m; n; n = n->Next(MusicLabel(mica::Partwise)))
-          AccumulateStateForInstant(n);
+      for(count m = F.Root(); m >= 0; m = F.Next(m, mica::Instantwise))
+        for(count n = m; n >= 0; n = F.Next(n, mica::Partwise))
+          AccumulateStateForInstant(F, n);
     }
   };
 }
@@ -63,38 +63,42 @@ namespace BELLE_NAMESPACE
     }
 
     ///Inspects an array of valid chord tokens.
-    static void AssumeChordTokensAndInspect(
-      const Array<Music::ConstNode>& Tokens, Value& IslandState)
+    static void AssumeChordTokensAndInspect(const FrozenMusic& F,
+      const Array<count>& Tokens, Value& IslandState)
     {
+      Array<count> NoteIDs;
+      Array<Music::ConstNode> Notes;
       for(count i = 0; i < Tokens.n(); i++)
       {
-        Music::ConstNode Token = Tokens[i];
-        Pointer<const Value::Base> TokenBase = Token;
+        Pointer<const Value::Base> TokenBase = F.Node(Tokens[i]);
+        F.Children(Tokens[i], mica::Note, NoteIDs);
+        F.Handles(NoteIDs, Notes);
         IslandState["Chord"][TokenBase]["DiatonicPitch"] =
-          Utility::GetPitchExtremes(Token->Children(MusicLabel(mica::Note)));
+          Utility::GetPitchExtremes(Notes);
       }
     }
 
     ///Inspects the tokens of a valid island node.
-    static void AssumeNodeAndInspectTokens(Music::ConstNode IslandNode,
+    static void AssumeNodeAndInspectTokens(const FrozenMusic& F, count Island,
       Value& IslandState)
     {
       //Gather all the tokens in the island.
-      Array<Music::ConstNode> Tokens =
-        IslandNode->Children(MusicLabel(mica::Token));
+      Array<count> Tokens;
+      F.Children(Island, mica::Token, Tokens);
 
       //If there are no tokens in the island, there is no part state.
       if(!Tokens.n()) return;
 
       //Handle chords.
-      if(Tokens.a()->Label.Get(mica::Kind) == mica::Chord)
-        AssumeChordTokensAndInspect(Tokens, IslandState);
+      if(F.Kind(Tokens.a()) == mica::Chord)
+        AssumeChordTokensAndInspect(F, Tokens, IslandState);
     }
 
     ///Accumulates information into the partwise state.
-    static void AccumulateStateForIsland(Music::ConstNode IslandNode)
+    static void AccumulateStateForIsland(const FrozenMusic& F, count Island)
     {
       //Validate parameters.
+      Music::ConstNode IslandNode = F.Node(Island);
       if(!IslandNode) return;
 
       //Create a new island state.
@@ -116,7 +120,7 @@ namespace BELLE_NAMESPACE
         "StaffConnects", "Connects", Value(true));
 
       //Inspect tokens and gather data related to the tokens.
-      AssumeNodeAndInspectTokens(IslandNode, IslandState);
+      AssumeNodeAndInspectTokens(F, Island, IslandState);
     }
 
     public:
@@ -126,14 +130,18 @@ namespace BELLE_NAMESPACE
     {
       //Validate parameters.
       if(!M) return;
+      Accumulate(*M->Freeze());
+    }
 
+    ///Accumulates partwise state for each island of a frozen system.
+    static void Accumulate(const FrozenMusic& F)
+    {
       /*Start at the root and for each island heading instantwise, traverse
       partwise. #limitation : does not take into account non-grid scores.
       Should traverse by geometry.*/
-      Music::ConstNode m, n;
-      for(m = M->Root(); m; m = m->Next(MusicLabel(mica::Instantwise)))
-        for(n = m; n; n = n->Next(MusicLabel(mica::Partwise)))
-          AccumulateStateForIsland(n);
+      for(count m = F.Root(); m >= 0; m = F.Next(m, mica::Instantwise))
+        for(count n = m; n >= 0; n = F.Next(n, mica::Partwise))
+          AccumulateStateForIsland(F, n);
     }
   };
 }
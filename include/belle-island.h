@@ -121,7 +121,7 @@ namespace BELLE_NAMESPACE
         {
           /*Create a new empty stamp. May want to reuse stamps later and only
           retypeset the ones that need it (for an editor situation).*/
-          n->Label.Stamp() = new Stamp;
+          n->Label.Stamp() = Pointer<Stamp>::Make();
           n->Label.SetState("HouseStyle", "Global") =
             new Value::ConstReference(H);
 
@@ -34,6 +34,42 @@
 
 namespace BELLE_NAMESPACE
 {
+  ///Declares an accessor returning the pre-interned symbol for the named key.
+#define BELLE_STATE_KEY(Name) \
+  static const Symbol& Name() {static const Symbol Key(#Name); return Key;}
+
+  /**Pre-interned symbols for the state keys used on the hot engraving paths.
+  Passing these to MusicLabel::SetState() and GetState() avoids interning the
+  key text on each call. Each accessor is named after its key text, for
+  example StateKey::PartID() is the symbol for "PartID".*/
+  class StateKey
+  {
+    public:
+
+    BELLE_STATE_KEY(BarlineConnectsToPreviousStaff)
+    BELLE_STATE_KEY(Chord)
+    BELLE_STATE_KEY(Clef)
+    BELLE_STATE_KEY(Duration)
+    BELLE_STATE_KEY(Global)
+    BELLE_STATE_KEY(HouseStyle)
+    BELLE_STATE_KEY(InstantID)
+    BELLE_STATE_KEY(InstantState)
+    BELLE_STATE_KEY(InteriorDistanceToPreviousStaff)
+    BELLE_STATE_KEY(IslandState)
+    BELLE_STATE_KEY(Lines)
+    BELLE_STATE_KEY(Local)
+    BELLE_STATE_KEY(PartID)
+    BELLE_STATE_KEY(PartState)
+    BELLE_STATE_KEY(Staff)
+    BELLE_STATE_KEY(Stamp)
+    BELLE_STATE_KEY(Stem)
+    BELLE_STATE_KEY(StemDirection)
+    BELLE_STATE_KEY(TypesetX)
+    BELLE_STATE_KEY(Voicing)
+  };
+
+#undef BELLE_STATE_KEY
+
   //Class to store music concepts and custom strings
   class MusicLabel : public Value::Base
   {
@@ -54,23 +90,23 @@ namespace BELLE_NAMESPACE
     Value& SetState() const {return StateValue;}
 
     ///Returns a 1-key state property.
-    Value& SetState(const String& a) const {return SetState()[a];}
+    Value& SetState(const Symbol& a) const {return SetState()[a];}
 
     ///Returns a 2-key state property.
-    Value& SetState(const String& a, const String& b) const
+    Value& SetState(const Symbol& a, const Symbol& b) const
     {
       return SetState()[a][b];
     }
 
     ///Returns a 3-key state property.
-    Value& SetState(const String& a, const String& b, const String& c) const
+    Value& SetState(const Symbol& a, const Symbol& b, const Symbol& c) const
     {
       return SetState()[a][b][c];
     }
 
     ///Returns a 4-key state property.
-    Value& SetState(const String& a, const String& b, const String& c,
-      const String& d) const
+    Value& SetState(const Symbol& a, const Symbol& b, const Symbol& c,
+      const Symbol& d) const
     {
       return SetState()[a][b][c][d];
     }
@@ -79,43 +115,32 @@ namespace BELLE_NAMESPACE
     Value GetState() const {return StateValue;}
 
     ///Returns a 1-key state property.
-    Value GetState(const String& a) const
+    Value GetState(const Symbol& a) const
     {
-      bool KeyExists = false;
-      if(StateValue.Contains(Value(a)))
-        KeyExists = true;
-      return KeyExists ? StateValue[a] : Value();
+      const Value& State = StateValue;
+      return State[a];
     }
 
     ///Returns a 2-key state property.
-    Value GetState(const String& a, const String& b) const
+    Value GetState(const Symbol& a, const Symbol& b) const
     {
-      bool KeyExists = false;
-      if(StateValue.Contains(Value(a)) and StateValue[a].Contains(Value(b)))
-        KeyExists = true;
-      return KeyExists ? StateValue[a][b] : Value();
+      const Value& State = StateValue;
+      return State[a][b];
     }
 
     ///Returns a 3-key state property.
-    Value GetState(const String& a, const String& b, const String& c) const
+    Value GetState(const Symbol& a, const Symbol& b, const Symbol& c) const
     {
-      bool KeyExists = false;
-      if(StateValue.Contains(Value(a)) and StateValue[a].Contains(Value(b)) and
-        StateValue[a][b].Contains(Value(c)))
-          KeyExists = true;
-      return KeyExists ? StateValue[a][b][c] : Value();
+      const Value& State = StateValue;
+      return State[a][b][c];
     }
 
     ///Returns a 4-key state property.
-    Value GetState(const String& a, const String& b, const String& c,
-      const String& d) const
+    Value GetState(const Symbol& a, const Symbol& b, const Symbol& c,
+      const Symbol& d) const
     {
-      bool KeyExists = false;
-      if(StateValue.Contains(Value(a)) and StateValue[a].Contains(Value(b)) and
-        StateValue[a][b].Contains(Value(c)) and
-        StateValue[a][b][c].Contains(Value(d)))
-          KeyExists = true;
-      return KeyExists ? StateValue[a][b][c][d] : Value();
+      const Value& State = StateValue;
+      return State[a][b][c][d];
     }
 
     ///Clears the information in the internal state.
@@ -127,7 +152,7 @@ namespace BELLE_NAMESPACE
     ///Returns a value reference to the stamp on this object.
     Value& Stamp() const
     {
-      return SetState("Stamp");
+      return SetState(StateKey::Stamp());
     }
 
     private:
@@ -227,6 +252,30 @@ namespace BELLE_NAMESPACE
       return Values;
     }
 
+    ///Returns the concept keys and their values in key order.
+    void ConceptKeysAndValues(Array<mica::Concept>& Keys,
+      Array<mica::Concept>& Values) const
+    {
+      Concepts.Keys(Keys);
+      Concepts.Values(Values);
+    }
+
+    ///Returns the string keys and their values in key order.
+    void StringKeysAndValues(Array<String>& Keys, Array<String>& Values) const
+    {
+      Strings.Keys(Keys);
+      Strings.Values(Values);
+    }
+
+    /**Returns the kind of edge for the adjacency index of the graph. Since an
+    edge is only equivalent to a filter with a type if it has the same type, the
+    kind is taken from the high word of the type, or zero if there is none.*/
+    uint64 EdgeKind() const
+    {
+      mica::Concept t = Concepts.Get(mica::Type);
+      return mica::undefined(t) ? 0 : t.high;
+    }
+
     ///For equivalence, the label is only checked against the items in filter.
     bool EdgeEquivalent(const MusicLabel& Filter) const
     {
@@ -318,6 +367,14 @@ namespace BELLE_NAMESPACE
       return *this;
     }
 
+    /**Assigns the concepts and strings of another label without copying its
+    typesetting state, which is left as it was.*/
+    void AssignProperties(const MusicLabel& Other)
+    {
+      Concepts = Other.Concepts;
+      Strings = Other.Strings;
+    }
+
     ///Creates a label with a given type.
     MusicLabel(mica::Concept LabelType)
     {
@@ -87,7 +87,7 @@ Value LedgerLinesForMultichord(Music::ConstNode Island, const Value& Multichord)
 Pointer<Path> LedgerLinePathForMultichord(Music::ConstNode Island,
   const Value& Multichord)
 {
-  Pointer<Path> p = new Path;
+  Pointer<Path> p = Pointer<Path>::Make();
   Value Lines = LedgerLinesForMultichord(Island, Multichord);
   Array<Value> Positions;
   Lines.EnumerateKeys(Positions);
@@ -117,8 +117,7 @@ Array<Value> MIDIGenerateFromSystem(MIDI::File& f, const Music& M,
     NewObjectIfEmpty<class Geometry>();
   if(not G or not G->GetNumberOfParts() or not G->GetNumberOfInstants())
   {
-    Pointer<Music> S;
-    S.New()->ImportXML(M.ExportXML());
+    Pointer<Music> S = M.Clone();
     Tree<Music::ConstNode, VectorInt> NodeToIndexLookup;
     GetRhythmicOnsetInfo(S, NodeMatrix, RhythmMatrix, NodeToIndexLookup);
   }
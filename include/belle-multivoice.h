@@ -185,7 +185,7 @@ void EngraveMultichordBrace(Music::ConstNode Island, number MaxOffset)
   number Thickness = 0.1f;
   if(MaxOffset > 3.f)
   {
-    Pointer<Path> p = new Path;
+    Pointer<Path> p = Pointer<Path>::Make();
     Box R;
     if(Bounds.Top() > -Bounds.Bottom())
     {
@@ -217,7 +217,7 @@ void EngraveAsBox(Music::ConstNode IslandNode)
   //Get the island stamp.
   Pointer<Stamp> IslandStamp = IslandNode->Label.Stamp().Object();
 
-  Pointer<Path> TemporaryObject = new Path;
+  Pointer<Path> TemporaryObject = Pointer<Path>::Make();
   Shapes::AddBox(*TemporaryObject, Box(Vector(-1.0f, -1.0f),
     Vector(1.0f, 1.0f)));
   IslandStamp->Add()->p = TemporaryObject;
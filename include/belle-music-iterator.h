@@ -116,7 +116,7 @@ namespace BELLE_NAMESPACE
     {
       Value v;
       if(Island())
-        v = Island()->Label.GetState("PartID");
+        v = Island()->Label.GetState(StateKey::PartID());
       return v.IsInteger() ? v.AsCount() : count(-1);
     }
 
@@ -124,7 +124,7 @@ namespace BELLE_NAMESPACE
     {
       Value v;
       if(Island())
-        v = Island()->Label.GetState("InstantID");
+        v = Island()->Label.GetState(StateKey::InstantID());
       return v.IsInteger() ? v.AsCount() : count(-1);
     }
 
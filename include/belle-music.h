@@ -39,6 +39,9 @@ namespace BELLE_NAMESPACE
     Pointer<GraphT<MusicLabel>::Object> Island, mica::Concept Placement);
   MusicLabel TraverseFloatStack(mica::Concept Placement);
 
+  //Read-only snapshot of a music graph (see belle-frozen-music.h)
+  class FrozenMusic;
+
   class Music : public GraphT<MusicLabel>
   {
     public:
@@ -54,29 +57,413 @@ namespace BELLE_NAMESPACE
     typedef Pointer<const GraphT<MusicLabel>::Object> ConstEdge;
     typedef Pointer<const GraphT<MusicLabel>::Object> ConstNode;
 
+    ///Inline buffer for short traversal results such as the tokens of an island
+    typedef InlineArray<ConstNode, 8> ConstNodeBuffer;
+
     ///Converts the graph to a string.
     operator String() const
     {
       return String(*static_cast<const Graph*>(this));
     }
 
+    /**Returns a copy of the nodes, edges, and labels of the graph. As with a
+    round trip through ExportXML() and ImportXML(), the typesetting state of the
+    labels is not copied.*/
+    Pointer<Music> Clone() const
+    {
+      return Clone(KeepEverything());
+    }
+
     ///Returns subgraph with only islands and partwise and instant-wise edges.
     Pointer<Music> GeometrySubgraph() const
+    {
+      return Clone(KeepGeometry());
+    }
+
+    private:
+
+    ///Filter for Clone() that keeps every node and edge
+    class KeepEverything
+    {
+      public:
+      bool operator () (const ConstNode&) const {return true;}
+    };
+
+    ///Filter for GeometrySubgraph() that keeps the islands and their edges
+    class KeepGeometry
+    {
+      public:
+      bool operator () (const ConstNode& x) const
+      {
+        mica::Concept Type = x->Get(mica::Type);
+        return x->IsNode() ? Type == mica::Island :
+          Type == mica::Partwise or Type == mica::Instantwise;
+      }
+    };
+
+    ///Label copier for Clone() that leaves the typesetting state behind
+    class CopyProperties
+    {
+      public:
+      void operator () (MusicLabel& Destination, const MusicLabel& Source) const
+      {
+        Destination.AssignProperties(Source);
+      }
+    };
+
+    ///Clones the graph with a filter without copying the typesetting state.
+    template <class Filter>
+    Pointer<Music> Clone(const Filter& Keep) const
     {
       Pointer<Music> m;
-      m.New()->ImportXML(ExportXML());
-      Sortable::Array<Node> mNodes = m->Nodes();
-      for(count i = 0; i < mNodes.n(); i++)
-        if(mNodes[i]->Label.Get(mica::Type) != mica::Island)
-          m->Remove(mNodes[i]);
-      Sortable::Array<ConstEdge> mEdges = m->Edges();
-      for(count i = 0; i < mEdges.n(); i++)
-        if(mEdges[i]->Label.Get(mica::Type) != mica::Partwise and
-          mEdges[i]->Label.Get(mica::Type) != mica::Instantwise)
-            m->Remove(m->Promote(mEdges[i]));
+      CloneInto(*m.New(), Keep, CopyProperties());
       return m;
     }
 
+    public:
+
+    /**Returns an immutable snapshot of the topology of the graph for passes
+    that only read it. The snapshot is not updated when the graph changes.*/
+    Pointer<const FrozenMusic> Freeze() const;
+
+    //-------------//
+    //Binary Format//
+    //-------------//
+
+    /*Binary graph format (.belleg)
+
+    A compact alternative to ExportXML() in which the concepts of the labels are
+    stored as their 128-bit identifiers, so that importing does not parse any
+    markup or look up any concept names. The layout is:
+
+      magic        the eight bytes 'B' 'E' 'L' 'L' 'E' 'G' 1 0
+      concepts     varint count, then each concept as its high word followed by
+                   its low word, each a little-endian uint64
+      strings      varint count, then each string as a varint length followed
+                   by the bytes
+      nodes        varint count, varint index of the root plus one (or zero if
+                   there is no root), and then the label of each node
+      edges        varint count, then each edge as the varint index of its from
+                   node, the varint index of its to node, and its label
+
+    A label is a varint count of concept pairs followed by the dictionary index
+    of the key and value of each pair, and then the same for the string pairs.
+    Varints are unsigned little-endian base-128. As with ExportXML(), the nodes
+    are in the order of Nodes(), the edges are grouped by departing node, and
+    the typesetting state of the labels is not stored.*/
+
+    ///Returns the eight bytes that begin a binary graph.
+    static const byte* BinaryMagic()
+    {
+      static const byte Magic[8] = {'B', 'E', 'L', 'L', 'E', 'G', 1, 0};
+      return Magic;
+    }
+
+    ///Returns whether the data begins like a binary graph.
+    static bool IsBinary(const byte* Data, count Length)
+    {
+      if(not Data or Length < 8)
+        return false;
+      for(count i = 0; i < 8; i++)
+        if(Data[i] != BinaryMagic()[i])
+          return false;
+      return true;
+    }
+
+    ///Returns whether the string data begins like a binary graph.
+    static bool IsBinary(const String& Data)
+    {
+      return IsBinary(reinterpret_cast<const byte*>(Data.Merge()), Data.n());
+    }
+
+    ///Returns the graph in the binary graph format.
+    Array<byte> ExportBinary() const
+    {
+      //Number the nodes in the order of Nodes().
+      Array<ConstNode> NodeArray = Nodes();
+      HashMap<const Graph::Object*, count> NodeIDs;
+      NodeIDs.Reserve(NodeArray.n());
+      for(count i = 0; i < NodeArray.n(); i++)
+        NodeIDs[NodeArray[i].Raw()] = i;
+
+      //Write the nodes and edges while building the dictionaries.
+      BinaryDictionary Dictionary;
+      Array<byte> Body;
+      WriteBinaryVarint(Body, uint64(NodeArray.n()));
+      WriteBinaryVarint(Body, Root() ? uint64(NodeIDs.Get(Root().Raw()) + 1) :
+        uint64(0));
+      Array<ConstEdge> EdgeArray;
+      for(count i = 0; i < NodeArray.n(); i++)
+      {
+        Dictionary.WriteLabel(Body, NodeArray[i]->Label);
+        EdgeArray.Append(NodeArray[i]->Children(Label(), true));
+      }
+      WriteBinaryVarint(Body, uint64(EdgeArray.n()));
+      for(count i = 0; i < EdgeArray.n(); i++)
+      {
+        ConstEdge e = EdgeArray[i];
+        WriteBinaryVarint(Body, uint64(NodeIDs.Get(e->Tail().Raw())));
+        WriteBinaryVarint(Body, uint64(NodeIDs.Get(e->Head().Raw())));
+        Dictionary.WriteLabel(Body, EdgeArray[i]->Label);
+      }
+
+      //Assemble the magic, the dictionaries, and the body.
+      Array<byte> Data;
+      for(count i = 0; i < 8; i++)
+        Data.Add(BinaryMagic()[i]);
+      Dictionary.Write(Data);
+      Data.Append(Body);
+      return Data;
+    }
+
+    ///Writes the graph to a file in the binary graph format.
+    bool ExportBinaryFile(const ascii* Filename) const
+    {
+      return File::Write(Filename, ExportBinary());
+    }
+
+    /**Clears the current graph and imports a graph exported with
+    ExportBinary(). If the data is malformed, the graph is left empty and false
+    is returned.*/
+    bool ImportBinary(const byte* Begin, const byte* End)
+    {
+      Clear();
+      if(not ImportBinaryGraph(Begin, End))
+      {
+        C::Error() >> "Error: malformed binary graph.";
+        Clear();
+        return false;
+      }
+      return true;
+    }
+
+    ///Clears the current graph and imports the data of ExportBinary().
+    bool ImportBinary(const Array<byte>& Data)
+    {
+      const byte* Begin = Data.n() ? &Data.a() : 0;
+      return ImportBinary(Begin, Begin + Data.n());
+    }
+
+    ///Clears the current graph and imports ExportBinary() data from a string.
+    bool ImportBinary(const String& Data)
+    {
+      const byte* Begin = reinterpret_cast<const byte*>(Data.Merge());
+      return ImportBinary(Begin, Begin + Data.n());
+    }
+
+    /**Clears the current graph and imports a file written by
+    ExportBinaryFile(). With PRIM_WITH_MEMORY_MAP the file is decoded directly
+    from a read-only mapping instead of being copied into memory first.*/
+    bool ImportBinaryFile(const ascii* Filename)
+    {
+#ifdef PRIM_WITH_MEMORY_MAP
+      MemoryMap Map;
+      if(Map.Open(Filename))
+      {
+        const byte* Begin = reinterpret_cast<const byte*>(Map.a());
+        return ImportBinary(Begin, Begin + Map.n());
+      }
+#else
+      Array<byte> Data;
+      if(File::Read(Filename, Data))
+        return ImportBinary(Data);
+#endif
+      Clear();
+      return false;
+    }
+
+    private:
+
+    ///Dictionary of the concepts and strings of the labels being exported.
+    class BinaryDictionary
+    {
+      Array<mica::Concept> Concepts;
+      HashMap<mica::Concept, count> ConceptIDs;
+      Array<String> Strings;
+      HashMap<String, count> StringIDs;
+
+      ///Returns the index of a concept, adding it if it is new.
+      count Of(const mica::Concept& x)
+      {
+        count& i = ConceptIDs[x];
+        if(i < 0)
+        {
+          i = Concepts.n();
+          Concepts.Add(x);
+        }
+        return i;
+      }
+
+      ///Returns the index of a string, adding it if it is new.
+      count Of(const String& x)
+      {
+        count& i = StringIDs[x];
+        if(i < 0)
+        {
+          i = Strings.n();
+          Strings.Add(x);
+        }
+        return i;
+      }
+
+      public:
+
+      ///Writes a label as dictionary indices.
+      void WriteLabel(Array<byte>& Out, const MusicLabel& x)
+      {
+        Array<mica::Concept> ConceptKeys, ConceptValues;
+        x.ConceptKeysAndValues(ConceptKeys, ConceptValues);
+        WriteBinaryVarint(Out, uint64(ConceptKeys.n()));
+        for(count i = 0; i < ConceptKeys.n(); i++)
+        {
+          WriteBinaryVarint(Out, uint64(Of(ConceptKeys[i])));
+          WriteBinaryVarint(Out, uint64(Of(ConceptValues[i])));
+        }
+
+        Array<String> StringKeys, StringValues;
+        x.StringKeysAndValues(StringKeys, StringValues);
+        WriteBinaryVarint(Out, uint64(StringKeys.n()));
+        for(count i = 0; i < StringKeys.n(); i++)
+        {
+          WriteBinaryVarint(Out, uint64(Of(StringKeys[i])));
+          WriteBinaryVarint(Out, uint64(Of(StringValues[i])));
+        }
+      }
+
+      ///Writes the concept and string dictionaries.
+      void Write(Array<byte>& Out) const
+      {
+        WriteBinaryVarint(Out, uint64(Concepts.n()));
+        for(count i = 0; i < Concepts.n(); i++)
+        {
+          uint64 Words[2] = {Concepts[i].high, Concepts[i].low};
+          Endian::ConvertToLittleEndian(Words, 2);
+          const byte* p = reinterpret_cast<const byte*>(Words);
+          for(count j = 0; j < 16; j++)
+            Out.Add(p[j]);
+        }
+        WriteBinaryVarint(Out, uint64(Strings.n()));
+        for(count i = 0; i < Strings.n(); i++)
+        {
+          WriteBinaryVarint(Out, uint64(Strings[i].n()));
+          const byte* p = reinterpret_cast<const byte*>(Strings[i].Merge());
+          for(count j = 0; j < Strings[i].n(); j++)
+            Out.Add(p[j]);
+        }
+      }
+    };
+
+    ///Appends a varint to the data.
+    static void WriteBinaryVarint(Array<byte>& Out, uint64 x)
+    {
+      for(; x >= 0x80; x >>= 7)
+        Out.Add(byte(x | 0x80));
+      Out.Add(byte(x));
+    }
+
+    /**Reads a varint that is at most the given limit and returns the end of it,
+    or null if it is malformed or out of range.*/
+    static const byte* ReadBinaryVarint(const byte* p, const byte* End,
+      count& x, count Limit)
+    {
+      uint64 v = 0;
+      for(count Shift = 0; p and p < End and Shift < 64; Shift += 7)
+      {
+        byte b = *p++;
+        v |= uint64(b & 0x7f) << Shift;
+        if(not (b & 0x80))
+        {
+          if(Limit < 0 or v > uint64(Limit))
+            return 0;
+          x = count(v);
+          return p;
+        }
+      }
+      return 0;
+    }
+
+    ///Reads a label from dictionary indices and returns the end of it.
+    static const byte* ReadBinaryLabel(const byte* p, const byte* End,
+      MusicLabel& x, const Array<mica::Concept>& Concepts,
+      const Array<String>& Strings)
+    {
+      count Pairs = 0, k = 0, v = 0;
+      p = ReadBinaryVarint(p, End, Pairs, count(End - p));
+      for(count i = 0; p and i < Pairs; i++)
+        if((p = ReadBinaryVarint(p, End, k, Concepts.n() - 1)) and
+          (p = ReadBinaryVarint(p, End, v, Concepts.n() - 1)))
+            x.Set(Concepts[k]) = Concepts[v];
+      if(p)
+        p = ReadBinaryVarint(p, End, Pairs, count(End - p));
+      for(count i = 0; p and i < Pairs; i++)
+        if((p = ReadBinaryVarint(p, End, k, Strings.n() - 1)) and
+          (p = ReadBinaryVarint(p, End, v, Strings.n() - 1)))
+            x.Set(Strings[k].Merge()) = Strings[v];
+      return p;
+    }
+
+    ///Reads the graph for ImportBinary() and returns whether it is well-formed.
+    bool ImportBinaryGraph(const byte* p, const byte* End)
+    {
+      if(not IsBinary(p, count(End - p)))
+        return false;
+      p += 8;
+
+      //Read the concept dictionary.
+      count n = 0;
+      if(not (p = ReadBinaryVarint(p, End, n, count(End - p) / 16)))
+        return false;
+      Array<mica::Concept> Concepts(n);
+      for(count i = 0; i < n; i++, p += 16)
+      {
+        uint64 Words[2];
+        Memory::MemCopy(Words, p, 16);
+        Endian::ConvertToLittleEndian(Words, 2);
+        Concepts[i].high = Words[0];
+        Concepts[i].low = Words[1];
+      }
+
+      //Read the string dictionary.
+      if(not (p = ReadBinaryVarint(p, End, n, count(End - p))))
+        return false;
+      Array<String> Strings(n);
+      for(count i = 0; i < n; i++)
+      {
+        count Length = 0;
+        if(not (p = ReadBinaryVarint(p, End, Length, count(End - p))))
+          return false;
+        Strings[i].Append(p, Length);
+        p += Length;
+      }
+
+      //Read the nodes.
+      count RootID = 0;
+      if(not (p = ReadBinaryVarint(p, End, n, count(End - p))) or
+        not (p = ReadBinaryVarint(p, End, RootID, n)))
+          return false;
+      Array<Node> NodeArray(n);
+      for(count i = 0; i < n; i++)
+        if(not (p = ReadBinaryLabel(p, End, (NodeArray[i] = Add())->Label,
+          Concepts, Strings)))
+            return false;
+      if(RootID)
+        Root(NodeArray[RootID - 1]);
+
+      //Read the edges.
+      count Edges = 0, From = 0, To = 0;
+      if(not (p = ReadBinaryVarint(p, End, Edges, count(End - p))))
+        return false;
+      for(count i = 0; i < Edges; i++)
+        if(not (p = ReadBinaryVarint(p, End, From, n - 1)) or
+          not (p = ReadBinaryVarint(p, End, To, n - 1)) or
+          not (p = ReadBinaryLabel(p, End, Connect(NodeArray[From],
+            NodeArray[To])->Label, Concepts, Strings)))
+              return false;
+      return p == End;
+    }
+
+    public:
+
     //-------------//
     //Node Creation//
     //-------------//
@@ -193,7 +193,7 @@ Pointer<Value::ConstReference> GlobalHouseStyleFromIsland(
   Music::ConstNode Island)
 {
   return Pointer<Value::ConstReference>(Island->Label.GetState(
-    "HouseStyle", "Global").Object());
+    StateKey::HouseStyle(), StateKey::Global()).Object());
 }
 
 /**Constructs a half-note notehead given the island and note state. The note
@@ -214,17 +214,18 @@ namespace internals
   {
     Music::ConstNode Island = IslandOfToken(Chord);
     if(IsIsland(Island) and IsChord(Chord))
-      Island->Label.SetState("PartState", "Chord")[Chord]["StemDirection"] =
-        StemDirection;
+      Island->Label.SetState(StateKey::PartState(),
+        StateKey::Chord())[Chord][StateKey::StemDirection()] = StemDirection;
   }
 
   void UpdateStemDirectionFromStaffPosition(Music::ConstNode Chord)
   {
     Music::ConstNode Island = IslandOfToken(Chord);
     if(IsIsland(Island) and IsChord(Chord))
-      Island->Label.SetState("PartState", "Chord")[Chord]["StemDirection"] =
-        Island->Label.GetState(
-          "PartState", "Chord")[Chord]["StemDirectionSingleVoice"];
+      Island->Label.SetState(StateKey::PartState(),
+        StateKey::Chord())[Chord][StateKey::StemDirection()] =
+        Island->Label.GetState(StateKey::PartState(),
+          StateKey::Chord())[Chord]["StemDirectionSingleVoice"];
   }
 
   void UpdateStemDirectionsByStrandID(
@@ -271,14 +272,15 @@ namespace internals
       /*Save the previous staff state before merging in the incoming island
       staff state so that they can be compared later to look for changes.*/
       IslandNode->Label.SetState("PartState", "PreviousStaff") =
-        IslandNode->Label.GetState("PartState", "Staff");
+        IslandNode->Label.GetState(StateKey::PartState(), StateKey::Staff());
 
       //Merge in the current island-staff state.
-      IslandNode->Label.SetState("PartState", "Staff").Merge(
-        IslandNode->Label.GetState("IslandState", "Staff"));
+      IslandNode->Label.SetState(StateKey::PartState(),
+        StateKey::Staff()).Merge(IslandNode->Label.GetState(
+          StateKey::IslandState(), StateKey::Staff()));
 
       //Accumulate state for the particular type of token.
-      Value& PartStateValue = IslandNode->Label.SetState("PartState");
+      Value& PartStateValue = IslandNode->Label.SetState(StateKey::PartState());
 
       /*The chord state from the previous island needs to be cleared. Chord
       state is the exception to the part-state copy-to-next rule.*/
@@ -309,7 +311,7 @@ namespace internals
     Array<Music::ConstNode> Tokens = TokensOfIsland(IslandNode);
     if(Tokens.n())
     {
-      Value& PartStateValue = IslandNode->Label.SetState("PartState");
+      Value& PartStateValue = IslandNode->Label.SetState(StateKey::PartState());
       UpdateVoicingState(IslandNode, PartStateValue);
       for(count i = 0; i < Tokens.n(); i++)
         if(Tokens[i]->Label.Get(mica::Kind) == mica::Chord)
@@ -340,9 +342,9 @@ namespace internals
     Value PreviousPartState;
     for(Music::ConstNode n = Island; n; n = n->Next(MusicLabel(mica::Partwise)))
     {
-      n->Label.SetState("PartState") = PreviousPartState;
+      n->Label.SetState(StateKey::PartState()) = PreviousPartState;
       AccumulatePartStateForIsland(n);
-      PreviousPartState = n->Label.GetState("PartState");
+      PreviousPartState = n->Label.GetState(StateKey::PartState());
     }
   }
 
@@ -351,9 +353,11 @@ namespace internals
     Value PreviousVoiceState;
     for(Music::ConstNode n = Island; n; n = n->Next(MusicLabel(mica::Partwise)))
     {
-      n->Label.SetState("PartState", "Voicing") = PreviousVoiceState;
+      n->Label.SetState(StateKey::PartState(), StateKey::Voicing()) =
+        PreviousVoiceState;
       AccumulateVoiceStateForIsland(n);
-      PreviousVoiceState = n->Label.GetState("PartState", "Voicing");
+      PreviousVoiceState = n->Label.GetState(StateKey::PartState(),
+        StateKey::Voicing());
     }
   }
 
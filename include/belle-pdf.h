@@ -1058,10 +1058,10 @@ namespace BELLE_NAMESPACE
       return x;
     }
 
-    void Rasterize(String t)
+    void Rasterize(const StringBuilder& t)
     {
       if(RasterObject)
-        RasterObject->Content >> t;
+        RasterObject->Content >> t.View();
     }
 
     //---------------------//
@@ -1075,7 +1075,7 @@ namespace BELLE_NAMESPACE
 
       //Create the transform code.
       number CTMMultiplier = PDFProperties->CTMMultiplier;
-      String t;
+      StringBuilder t;
       t >> "q" >> Check(a.a) << " " << Check(a.b) << " " << Check(a.c) << " " <<
         Check(a.d) << " " << Check(a.e * CTMMultiplier) << " " <<
         Check(a.f * CTMMultiplier) << " cm";
@@ -1090,7 +1090,7 @@ namespace BELLE_NAMESPACE
       Painter::Revert(TransformationsToRevert);
 
       //Create the revert code.
-      String t;
+      StringBuilder t;
       for(count i = 0; i < TransformationsToRevert; i++)
         t >> "Q";
       Rasterize(t);
@@ -1105,7 +1105,7 @@ namespace BELLE_NAMESPACE
     {
       State = NewState;
 
-      String t;
+      StringBuilder t;
 
       t >> Check(NewState.StrokeColor.R);
       t << " " << Check(NewState.StrokeColor.G);
@@ -1126,7 +1126,7 @@ namespace BELLE_NAMESPACE
 
     virtual void Draw(const Path& p, const Affine& a)
     {
-      String t;
+      StringBuilder t;
       number CTMMultiplier = PDFProperties->CTMMultiplier;
 
       if(State.StrokeWidth != 0.f)
@@ -1179,9 +1179,6 @@ namespace BELLE_NAMESPACE
       else
         t >> "n"; //"No-op"
 
-      //Collapse the temporary operator string.
-      t.Merge();
-
       Transform(a);
       Rasterize(t);
       Revert(1);
@@ -1253,7 +1250,7 @@ namespace BELLE_NAMESPACE
       /*Add the image painting operator. Note that image space is defined by the
       PDF specification to be from [0, 0] to [1, 1]. Thus the proper common
       transformation matrix must be used for the image to scale correctly.*/
-      String t;
+      StringBuilder t;
       Scale(Vector(Width, Height));
       t << "/Im" << ImageResourceIndex << " Do";
       Rasterize(t);
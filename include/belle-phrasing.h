@@ -276,7 +276,7 @@ namespace BELLE_NAMESPACE
 
       Pointer<Stamp> StampStart = TieStartIsland->Label.Stamp().Object();
 
-      Pointer<Path> p = new Path;
+      Pointer<Path> p = Pointer<Path>::Make();
       p->Append(Slur);
       StampStart->Add()->p = p;
       StampStart->z()->Spans = true;
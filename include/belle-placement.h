@@ -41,7 +41,7 @@ namespace BELLE_NAMESPACE
 
     static Pointer<Path> GlyphByIndex(Pointer<const Typeface> t, count i)
     {
-      Pointer<Path> p = new Path;
+      Pointer<Path> p = Pointer<Path>::Make();
       if(t && t->LookupGlyph(unicode(i)))
         *p = *t->LookupGlyph(unicode(i));
       return p;
@@ -38,10 +38,10 @@ namespace BELLE_NAMESPACE
   class Page : public Canvas
   {
     ///Systems to be painted on this page.
-    List<Pointer<const Music> > Systems;
+    Sequence<Pointer<const Music> > Systems;
 
     ///Positions of systems on this page.
-    List<Vector> Positions;
+    Sequence<Vector> Positions;
 
     public:
 
@@ -49,8 +49,9 @@ namespace BELLE_NAMESPACE
     Page() {}
 
     ///Sets the systems and their positions for this page.
-    void SetSystemsAndPositions(List<Pointer<const Music> > Systems_,
-      List<Vector> Positions_)
+    void SetSystemsAndPositions(
+      const Sequence<Pointer<const Music> >& Systems_,
+      const Sequence<Vector>& Positions_)
     {
       Systems = Systems_;
       Positions = Positions_;
@@ -104,7 +105,7 @@ namespace BELLE_NAMESPACE
     Font NotationFont;
 
     ///List of music graph pointers, each one representing a single system.
-    List<Pointer<Music> > Systems;
+    Sequence<Pointer<Music> > Systems;
 
     ///Various system width metrics reported by engraver.
     Value SystemWidths;
@@ -307,13 +308,13 @@ namespace BELLE_NAMESPACE
       while(StartSystem < Systems.n())
       {
         PageNumber++;
-        List<Pointer<const Music> > PageSpecificSystems;
-        List<Vector> SystemPositions;
+        Sequence<Pointer<const Music> > PageSpecificSystems;
+        Sequence<Vector> SystemPositions;
 
         //Determine the maximum number of systems that can be placed on page.
         number LargestWidth = SystemWidth;
         {
-          List<Pointer<const Music> > SystemsToTry;
+          Sequence<Pointer<const Music> > SystemsToTry;
           for(count i = StartSystem; i < Systems.n(); i++)
           {
             //Add the next available system.
@@ -330,7 +331,7 @@ namespace BELLE_NAMESPACE
             }
 
             //See if the list of systems can be spaced given the parameters.
-            List<number> Positions = System::SpaceSystems(SystemsToTry,
+            Sequence<number> Positions = System::SpaceSystems(SystemsToTry,
               BottomMargin, PaperSize.y - TopMargin, SpaceHeight,
               SpacesStaffToStaffDistance, SpacesMinimumSystemToSystem,
               SpacesMaximumSystemToSystem);
@@ -386,16 +387,16 @@ namespace BELLE_NAMESPACE
     }
 
     ///Returns the list of const systems.
-    List<Pointer<const Music> > ConstSystems() const
+    Sequence<Pointer<const Music> > ConstSystems() const
     {
-      List<Pointer<const Music> > s;
+      Sequence<Pointer<const Music> > s;
       for(count i = 0; i < Systems.n(); i++)
         s.Add() = Systems[i].Const();
       return s;
     }
 
     ///Returns the list of mutable systems.
-    List<Pointer<Music> > MutableSystems()
+    Sequence<Pointer<Music> > MutableSystems()
     {
       return Systems;
     }
@@ -406,13 +407,13 @@ namespace BELLE_NAMESPACE
       C::Out() >> "Wrapping...";
       const number CostPower = 2.f;
       Engrave(false, 0, true, RelaxFactor);
-      List<Pointer<Music> > NewScoreSystems;
+      Sequence<Pointer<Music> > NewScoreSystems;
       for(Counter s; s.z(Systems); s++)
       {
         Pointer<const Music> System = Systems[s].Const();
         Value PotentialBreaks = WrapPotentialBreaks(System);
-        List<VectorInt> BestBreaks = WrapCalculateOptimalBreaks(PotentialBreaks,
-          MaximumWidth, MaximumWidth, CostPower);
+        Sequence<VectorInt> BestBreaks = WrapCalculateOptimalBreaks(
+          PotentialBreaks, MaximumWidth, MaximumWidth, CostPower);
         if(ForceBreaks == "info")
           C::Out() >> "Default breaks: " << BestBreaks;
         else if(ForceBreaks)
@@ -427,7 +428,7 @@ namespace BELLE_NAMESPACE
             Left = Right;
           }
         }
-        List<Pointer<Music> > NewSystems = WrapBreakGraph(
+        Sequence<Pointer<Music> > NewSystems = WrapBreakGraph(
           System, PotentialBreaks, BestBreaks);
         for(Counter i; i.z(NewSystems); i++)
           NewScoreSystems.Add() = NewSystems[i];
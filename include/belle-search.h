@@ -65,8 +65,7 @@ number SearchHistogramError(const Value& HistogramA, const Value& HistogramB)
 
 void SearchHistogramOfStaffPositions(Pointer<const Music> M, Histogram& H)
 {
-  Pointer<Music> MMutable;
-  MMutable.New()->ImportXML(M->ExportXML());
+  Pointer<Music> MMutable = M->Clone();
   Array<Music::Node> AllNodes = MMutable->Nodes();
   if(MMutable and MMutable->Root())
   {
@@ -65,7 +65,7 @@ namespace BELLE_NAMESPACE
 
     static void UpdateBordersForStamp(Music::ConstNode Island,
       Pointer<Stamp> IslandStamp, Box::Side S, number HorizontalOffset,
-      List<Vector>& Borders)
+      Sequence<Vector>& Borders)
     {
       if(IslandStamp)
       {
@@ -79,11 +79,11 @@ namespace BELLE_NAMESPACE
       }
     }
 
-    static Array<List<Vector> > GetInstantBorders(
+    static Array<Sequence<Vector> > GetInstantBorders(
       const Array<Music::ConstNode>& Instant, Box::Side S,
       number HorizontalOffset)
     {
-      Array<List<Vector> > InstantBorders(Instant.n());
+      Array<Sequence<Vector> > InstantBorders(Instant.n());
       for(count Part = 0; Part < Instant.n(); Part++)
       {
         if(Music::ConstNode Island = Instant[Part])
@@ -95,7 +95,7 @@ namespace BELLE_NAMESPACE
       return InstantBorders;
     }
 
-    static void OffsetInstantBorders(Array<List<Vector> >& InstantBorders,
+    static void OffsetInstantBorders(Array<Sequence<Vector> >& InstantBorders,
       number Offset)
     {
       for(count i = 0; i < InstantBorders.n(); i++)
@@ -103,8 +103,8 @@ namespace BELLE_NAMESPACE
           InstantBorders[i][j] += Vector(Offset, 0.f);
     }
 
-    static void AppendInstantBorders(Array<List<Vector> >& Anchor,
-      Array<List<Vector> > Incoming)
+    static void AppendInstantBorders(Array<Sequence<Vector> >& Anchor,
+      Array<Sequence<Vector> > Incoming)
     {
       for(count i = 0; i < Incoming.n(); i++)
       {
@@ -114,15 +114,16 @@ namespace BELLE_NAMESPACE
       }
     }
 
-    static void OffsetAndAppendInstantBorders(Array<List<Vector> >& Anchor,
-      Array<List<Vector> > Incoming, number Offset)
+    static void OffsetAndAppendInstantBorders(Array<Sequence<Vector> >& Anchor,
+      Array<Sequence<Vector> > Incoming, number Offset)
     {
       OffsetInstantBorders(Incoming, Offset);
       AppendInstantBorders(Anchor, Incoming);
     }
 
-    static number GetClosestInstantOffset(const Array<List<Vector> >& Anchor,
-      const Array<List<Vector> >& Mover)
+    static number GetClosestInstantOffset(
+      const Array<Sequence<Vector> >& Anchor,
+      const Array<Sequence<Vector> >& Mover)
     {
       number MaximumOffset = Limits<number>::NegativeInfinity();
 
@@ -203,8 +204,9 @@ namespace BELLE_NAMESPACE
       if(!A || !B)
         return 0.f;
 
-      Array<Music::ConstNode> ATokens = A->Children(MusicLabel(mica::Token));
-      Array<Music::ConstNode> BTokens = B->Children(MusicLabel(mica::Token));
+      Music::ConstNodeBuffer ATokens, BTokens;
+      A->Children(MusicLabel(mica::Token), ATokens);
+      B->Children(MusicLabel(mica::Token), BTokens);
 
       if(!ATokens.n() || !BTokens.n())
         return 0.f;
@@ -320,7 +322,7 @@ namespace BELLE_NAMESPACE
 
       /*Create the leading edge for the first instant, which does not need to
       take into account any past instants.*/
-      Array<List<Vector> > LeadingEdge =
+      Array<Sequence<Vector> > LeadingEdge =
         GetInstantBorders(RhythmOrderedRegion.a(), Box::RightSide,
         TypesetX.a() = 0.f);
 
@@ -337,7 +339,7 @@ namespace BELLE_NAMESPACE
             LeadingEdge[Part][i].x += MinimumDistances(Part, Instant);
 
         //Find the closest this instant may be placed next to the leading edge.
-        Array<List<Vector> > InstantBordersLeft = GetInstantBorders(
+        Array<Sequence<Vector> > InstantBordersLeft = GetInstantBorders(
           RhythmOrderedRegion[Instant], Box::LeftSide, 0.f);
         number Offset = GetClosestInstantOffset(
           LeadingEdge, InstantBordersLeft);
@@ -347,7 +349,7 @@ namespace BELLE_NAMESPACE
           Offset = Max(Offset, TypesetX[Instant - 1] + 1.5f);
 
         TypesetX[Instant] = Offset;
-        Array<List<Vector> > InstantBordersRight = GetInstantBorders(
+        Array<Sequence<Vector> > InstantBordersRight = GetInstantBorders(
           RhythmOrderedRegion[Instant], Box::RightSide,
           Offset);
 
@@ -84,6 +84,9 @@ namespace BELLE_NAMESPACE
       return SpringPart == Filter.SpringPart;
     }
 
+    ///Spring edges have no kind, so every edge is checked for equivalence.
+    uint64 EdgeKind() const {return 0;}
+
     ///Returns the calculated x-value of this node.
     number CalculatedX() const
     {
@@ -94,7 +94,8 @@ namespace BELLE_NAMESPACE
     ///Indicates whether the stamp needs to be retypeset before displaying it.
     bool Typeset; PRIM_PAD(bool)
 
-    static void PaintVerticalBorders(Painter& Painter, List<Vector> L)
+    static void PaintVerticalBorders(Painter& Painter,
+      const Sequence<Vector>& L)
     {
       for(count i = 0; i < L.n() - 1; i++)
       {
@@ -111,7 +112,8 @@ namespace BELLE_NAMESPACE
       }
     }
 
-    static void PaintHorizontalBorders(Painter& Painter, List<Vector> L)
+    static void PaintHorizontalBorders(Painter& Painter,
+      const Sequence<Vector>& L)
     {
       for(count i = 0; i < L.n() - 1; i++)
       {
@@ -255,7 +257,7 @@ namespace BELLE_NAMESPACE
     ///Adds a graphic to the stamp and returns a reference to it.
     Pointer<Graphic> Add()
     {
-      Graphics.Add() = new Graphic;
+      Graphics.Add() = Pointer<Graphic>::Make();
       return Graphics.z();
     }
 
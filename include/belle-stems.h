@@ -60,8 +60,8 @@ void AccumulateStemInformationForChord(const Value& Chord,
 
   Music::ConstNode ChordNode = Chord.a().a()["Chord"].ConstObject();
   if(IsChord(ChordNode)){
-    IslandOfToken(ChordNode)->SetState(
-      "PartState", "Chord")[ChordNode]["Stem"] = Stem;
+    IslandOfToken(ChordNode)->SetState(StateKey::PartState(),
+      StateKey::Chord())[ChordNode][StateKey::Stem()] = Stem;
     Stem["Chord"] = Value(ChordNode);
   }
 
@@ -64,8 +64,8 @@ namespace BELLE_NAMESPACE
     ///Saves the portfolio pointer during painting so draw calls can access it.
     Portfolio* CachedPortfolio;
 
-    ///String containing the current SVG page.
-    String CurrentSVGPage;
+    ///Builder containing the current SVG page.
+    StringBuilder CurrentSVGPage;
 
     ///Dimensions of the current SVG page.
     Inches CurrentSize;
@@ -88,7 +88,8 @@ namespace BELLE_NAMESPACE
       SVG >> ">";
       SVG++;
       SVG >> "<!--Path data for each glyph-->";
-      CurrentSVGPage = SVG;
+      CurrentSVGPage.Clear();
+      CurrentSVGPage << SVG;
       CurrentSize = Size;
     }
 
@@ -135,7 +136,7 @@ namespace BELLE_NAMESPACE
         FinalizeSVGPage();
 
         //Add the SVG page to the output.
-        SVGProperties->Output.Add() = CurrentSVGPage;
+        SVGProperties->Output.Add() = CurrentSVGPage.ToString();
 
         //Reset the page number to indicate painting is finished.
         ResetPageNumber();
@@ -169,7 +170,7 @@ namespace BELLE_NAMESPACE
         Affine::Translate(Vector(0, -CurrentSize.y));
       Affine A = B * CurrentSpace();
 
-      String SVG;
+      StringBuilder& SVG = CurrentSVGPage;
       SVG >> "<path";
       SVG << " d=\"";
       for(count j = 0; j < p.n(); j++)
@@ -216,7 +217,6 @@ namespace BELLE_NAMESPACE
         SVG << " style=\"stroke:none; stroke-width:0\"";
 
       SVG << "/>";
-      CurrentSVGPage >> SVG;
       Revert();
     }
 
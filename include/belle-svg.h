@@ -193,8 +193,9 @@ namespace BELLE_NAMESPACE
     static void ImportData(Path& p, const ascii* SVGData)
     {
       /*The parsing algorithm used in this method goes character by character,
-      and builds up state and command arguments. It is entirely incremental, and
-      so it is fast since it does not parse numbers as separate tokens.*/
+      and builds up state and command arguments. It is entirely incremental:
+      it only remembers where each number starts, and once the number ends its
+      span is converted in place by String::ParseNumber().*/
 
       //Iteration of the string is by pointer arithmetic.
       const ascii* Data = SVGData;
@@ -215,14 +216,7 @@ namespace BELLE_NAMESPACE
       //The parsing state.
       InputType CurrentType = WhiteSpace;
       InputType PreviousType = WhiteSpace;
-      float64 CurrentNumber = 0.0;
-      float64 CurrentSign = 1.0;
-      float64 CurrentExponentialSign = 1.0;
-      float64 CurrentExponential = 0.0;
-      bool ParsingExponential = false;
-      bool ParsingDecimal = false;
-      float64 DecimalValue = 0.0;
-      float64 DecimalSize = 1.0;
+      const ascii* NumberStart = Data;
       float64 NumberState[7];
       count NumberIndex = 0;
       count TotalNumberIndex = 0;
@@ -246,21 +240,9 @@ namespace BELLE_NAMESPACE
             case Command:
             case NumberDigit:
             case NumberPeriod:
-            /*Note that the following code is used three times identically in
-            this method. It really ought to be a helper method, but the number
-            of arguments that would need to be passed makes it not worth it.*/
             //----------------------Flush Current Number*---------------------//
-            NumberState[NumberIndex++] = CurrentSign * (CurrentNumber +
-              (DecimalValue / DecimalSize)) * Power(10.0,
-              CurrentExponentialSign * CurrentExponential);
-            CurrentNumber = 0.0;
-            CurrentSign = 1.0;
-            CurrentExponentialSign = 1.0;
-            CurrentExponential = 0.0;
-            ParsingExponential = false;
-            ParsingDecimal = false;
-            DecimalValue = 0.0;
-            DecimalSize = 1.0;
+            NumberState[NumberIndex++] = PreviousType == Command ? 0.0 :
+              ImportDataNumber(NumberStart, Data - 1);
             TotalNumberIndex++;
             ImportDataFlush(p, &NumberState[0], NumberIndex,
               TotalNumberIndex, CurrentCommand, CurrentPosition);
@@ -282,30 +264,10 @@ namespace BELLE_NAMESPACE
         else if(d >= '0' && d <= '9') //Number digit
         {
           CurrentType = NumberDigit;
-          switch(PreviousType)
-          {
-            case Command:
-            case WhiteSpace:
-            case NumberExponential:
-            case NumberPeriod:
-            case NumberDigit:
-            case NumberSign:
-            //Add to existing number.
-            if(ParsingExponential)
-            {
-              CurrentExponential = CurrentExponential * 10. +
-                float64(d - '0');
-            }
-            else if(ParsingDecimal)
-            {
-              DecimalValue = DecimalValue * 10. + float64(d - '0');
-              DecimalSize = DecimalSize * 10.;
-            }
-            else
-            {
-              CurrentNumber = CurrentNumber * 10. + float64(d - '0');
-            }
-          }
+
+          //A digit after a command or white space starts a new number.
+          if(PreviousType == Command || PreviousType == WhiteSpace)
+            NumberStart = Data - 1;
         }
         else if(d == '-' || d == '+') //Number sign
         {
@@ -315,67 +277,30 @@ namespace BELLE_NAMESPACE
             case NumberDigit:
             case NumberPeriod:
             //----------------------Flush Current Number----------------------//
-            NumberState[NumberIndex++] = CurrentSign * (CurrentNumber +
-              (DecimalValue / DecimalSize)) * Power(10.0,
-              CurrentExponentialSign * CurrentExponential);
-            CurrentNumber = 0.0;
-            CurrentExponentialSign = 1.0;
-            CurrentExponential = 0.0;
-            ParsingExponential = false;
-            ParsingDecimal = false;
-            DecimalValue = 0.0;
-            DecimalSize = 1.0;
+            NumberState[NumberIndex++] = ImportDataNumber(NumberStart,
+              Data - 1);
             TotalNumberIndex++;
             if(ImportDataFlush(p, &NumberState[0], NumberIndex,
               TotalNumberIndex, CurrentCommand, CurrentPosition))
                 NumberIndex = 0;
             //--------------------End Flush Current Number--------------------//
-            CurrentSign = (d == '+' ? 1.0 : -1.0); break;
-            /*Note: above was modified to remove unnecessary assignment to
-            CurrentSign since it is overwritten.*/
+            NumberStart = Data - 1; break;
             case Command:
             case WhiteSpace:
-            CurrentSign = (d == '+' ? 1.0 : -1.0); break;
-            case NumberExponential:
-            CurrentExponentialSign = (d == '+' ? 1.0 : -1.0); break;
+            NumberStart = Data - 1; break;
+            case NumberExponential: break; //Part of the exponent
             case NumberSign: break; //Invalid
           }
         }
         else if(d == 'e' || d == 'E') //Exponential sign
-        {
           CurrentType = NumberExponential;
-
-          switch(PreviousType)
-          {
-            case NumberDigit:
-            case NumberPeriod:
-            CurrentExponential = 0.0;
-            CurrentExponentialSign = 1.0; //(default to +)
-            ParsingExponential = true;
-            break;
-            case NumberSign: break; //Invalid
-            case NumberExponential: break; //Invalid
-            case WhiteSpace: break; //Invalid
-            case Command: break; //Invalid
-          }
-        }
         else if(d == '.') //Number decimal period
         {
           CurrentType = NumberPeriod;
 
-          switch(PreviousType)
-          {
-            case Command:
-            case WhiteSpace:
-            case NumberDigit:
-            case NumberSign:
-            ParsingDecimal = true;
-            DecimalValue = 0.0;
-            DecimalSize = 1.0;
-            break;
-            case NumberExponential: break; //Invalid
-            case NumberPeriod: break; //Invalid
-          }
+          //A period after a command or white space starts a new number.
+          if(PreviousType == Command || PreviousType == WhiteSpace)
+            NumberStart = Data - 1;
         }
         else //White space (or any other character in the stream)
         {
@@ -387,17 +312,7 @@ namespace BELLE_NAMESPACE
             if(CurrentCommand != 'Z' && CurrentCommand != 'z')
               break;
             //----------------------Flush Current Number----------------------//
-            NumberState[NumberIndex++] = CurrentSign * (CurrentNumber +
-              (DecimalValue / DecimalSize)) * Power(10.0,
-              CurrentExponentialSign * CurrentExponential);
-            CurrentNumber = 0.0;
-            CurrentSign = 1.0;
-            CurrentExponentialSign = 1.0;
-            CurrentExponential = 0.0;
-            ParsingExponential = false;
-            ParsingDecimal = false;
-            DecimalValue = 0.0;
-            DecimalSize = 1.0;
+            NumberState[NumberIndex++] = 0.0;
             TotalNumberIndex++;
             if(ImportDataFlush(p, &NumberState[0], NumberIndex,
               TotalNumberIndex, CurrentCommand, CurrentPosition))
@@ -407,17 +322,8 @@ namespace BELLE_NAMESPACE
             case NumberPeriod:
             case NumberDigit:
             //----------------------Flush Current Number----------------------//
-            NumberState[NumberIndex++] = CurrentSign * (CurrentNumber +
-              (DecimalValue / DecimalSize)) * Power(10.0,
-              CurrentExponentialSign * CurrentExponential);
-            CurrentNumber = 0.0;
-            CurrentSign = 1.0;
-            CurrentExponentialSign = 1.0;
-            CurrentExponential = 0.0;
-            ParsingExponential = false;
-            ParsingDecimal = false;
-            DecimalValue = 0.0;
-            DecimalSize = 1.0;
+            NumberState[NumberIndex++] = ImportDataNumber(NumberStart,
+              Data - 1);
             TotalNumberIndex++;
             if(ImportDataFlush(p, &NumberState[0], NumberIndex,
               TotalNumberIndex, CurrentCommand, CurrentPosition))
@@ -441,6 +347,17 @@ namespace BELLE_NAMESPACE
 
     private:
 
+    /**Helper method for ImportData() to convert the span of a number. A span
+    that does not hold a number, such as the flush after a close path command,
+    converts to zero.*/
+    static float64 ImportDataNumber(const ascii* Begin, const ascii* End)
+    {
+      number Result = 0;
+      String::ParseNumber(reinterpret_cast<const byte*>(Begin),
+        reinterpret_cast<const byte*>(End), Result);
+      return float64(Result);
+    }
+
     ///Helper method for ImportData() to do the actual path creation.
     static bool ImportDataFlush(Path& p, const float64* NumberState,
       count NumberIndex, count TotalNumberIndex,
@@ -46,9 +46,10 @@ namespace BELLE_NAMESPACE
     {
       Value v;
       if(!M or not MutableGeometry(M)->Parse(*M)) return v;
-      IslandState::Accumulate(M);
+      Pointer<const FrozenMusic> F = M->Freeze();
+      IslandState::Accumulate(*F);
       AccumulatePartState(M);
-      InstantState::Accumulate(M);
+      InstantState::Accumulate(*F);
       Island::EngraveIslands(M, GetHouseStyle(M));
       v = SpaceJustify(M);
       MeasureRestEngraveAll(M);
@@ -311,19 +312,20 @@ namespace BELLE_NAMESPACE
     }
 
     ///Perform simple system vertical spacing.
-    static List<number> SpaceSystems(List<Pointer<const Music> > Systems,
+    static Sequence<number> SpaceSystems(
+      const Sequence<Pointer<const Music> >& Systems,
       number yPositionOfBottomStaff, number yPositionOfTopStaff,
       number SpaceHeight, number SpacesStaffToStaffDistance,
       number SpacesMinimumSystemToSystem, number SpacesMaximumSystemToSystem)
     {
       if(!Systems.n())
-        return List<number>();
+        return Sequence<number>();
       //Calculate the space-wise height available.
       number HeightAvailableInSpaces = (yPositionOfTopStaff -
         yPositionOfBottomStaff) / SpaceHeight;
 
       //First space the staves within the systems and get the system heights.
-      List<number> SystemHeights;
+      Sequence<number> SystemHeights;
       for(count i = 0; i < Systems.n(); i++)
       {
         //Get the staff count of the system and determine the system
@@ -332,7 +334,7 @@ namespace BELLE_NAMESPACE
         //Count the number of staves and return if a system has no staves.
         count Staves = Max(StaffCount(M), count(1));
         if(!Staves)
-          return List<number>();
+          return Sequence<number>();
 
         SystemHeights.Add() = number(Staves - 1) * SpacesStaffToStaffDistance;
 
@@ -356,11 +358,11 @@ namespace BELLE_NAMESPACE
 
       //Check to see whether the unpadded systems exceed available space.
       if(TotalSystemHeight > HeightAvailableInSpaces)
-        return List<number>(); //System spacing failed.
+        return Sequence<number>(); //System spacing failed.
 
       /*Calculate the spaced system positions starting with the first system at
       the top of the page.*/
-      List<number> SystemPositions;
+      Sequence<number> SystemPositions;
       SystemPositions.Add() = yPositionOfTopStaff;
 
       //If just one system, then it will simply print at the top of the page.
@@ -376,7 +378,7 @@ namespace BELLE_NAMESPACE
 
       //Check to see if the minimum spacing overflows the page.
       if(MinimumSpacingHeight > HeightAvailableInSpaces)
-        return List<number>(); //System spacing failed.
+        return Sequence<number>(); //System spacing failed.
 
       {
         /*Check to see if the maximum spacing underflows the page, otherwise
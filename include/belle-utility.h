@@ -144,8 +144,8 @@ namespace BELLE_NAMESPACE
       bool IslandIsRhythmic = false;
       if(n)
       {
-        Array<Music::ConstNode> Tokens =
-          n->Children(Music::Label(mica::Token));
+        Music::ConstNodeBuffer Tokens;
+        n->Children(Music::Label(mica::Token), Tokens);
         if(Tokens.n() and Tokens.a()->Get(mica::Kind) == mica::Chord)
           IslandIsRhythmic = true;
       }
@@ -185,13 +185,13 @@ namespace BELLE_NAMESPACE
     ///Determines whether an island has chords with ties heading to the right.
     static bool IslandChordsHaveTies(Music::ConstNode Island)
     {
-      Array<Music::ConstNode> Tokens = Island->Children(
-        MusicLabel(mica::Token));
+      Music::ConstNodeBuffer Tokens, Notes;
+      Island->Children(MusicLabel(mica::Token), Tokens);
       bool ChordsHaveTies = false;
       for(count i = 0; !ChordsHaveTies && i < Tokens.n(); i++)
       {
         Music::ConstNode t = Tokens[i];
-        Array<Music::ConstNode> Notes = t->Children(MusicLabel(mica::Note));
+        t->Children(MusicLabel(mica::Note), Notes);
         for(count j = 0; !ChordsHaveTies && j < Notes.n(); j++)
           ChordsHaveTies = Notes[j]->Next(MusicLabel(mica::Tie));
       }
@@ -90,5 +90,15 @@ namespace PRIM_NAMESPACE
   {
     return *this = BELLE_NAMESPACE::ValueHelper::AsValue(mica::Concept(x));
   }
+
+  ///Hashes a MICA concept by both words of its identifier.
+  template <> class Hash<mica::Concept>
+  {
+    public:
+    static uint64 Of(const mica::Concept& x)
+    {
+      return HashFunction::Mix(x.high ^ HashFunction::Mix(x.low));
+    }
+  };
 }
 #endif
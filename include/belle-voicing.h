@@ -225,7 +225,8 @@ count NumberOfVoicesInIsland(Music::ConstNode x)
   count Voices = 0;
   if(IsIsland(x))
   {
-    Array<Music::ConstNode> Chords = x->Children(MusicLabel(mica::Token));
+    Music::ConstNodeBuffer Chords;
+    x->Children(MusicLabel(mica::Token), Chords);
     for(count i = 0; i < Chords.n(); i++)
       Voices += IsChord(Chords[i]);
   }
@@ -237,7 +238,8 @@ Array<Music::ConstNode> ChordsBeginningVoicesInIsland(Music::ConstNode x)
   Array<Music::ConstNode> BeginningVoices;
   if(IsIsland(x))
   {
-    Array<Music::ConstNode> Chords = x->Children(MusicLabel(mica::Token));
+    Music::ConstNodeBuffer Chords;
+    x->Children(MusicLabel(mica::Token), Chords);
     for(count i = 0; i < Chords.n(); i++)
       if(ChordBeginsVoice(Chords[i]))
         BeginningVoices.Add() = Chords[i];
@@ -250,7 +252,8 @@ bool IslandBeginsMultivoiceRegion(Music::ConstNode x)
   bool IslandBeginsMultivoice = false;
   if(IsIsland(x))
   {
-    Array<Music::ConstNode> Chords = x->Children(MusicLabel(mica::Token));
+    Music::ConstNodeBuffer Chords;
+    x->Children(MusicLabel(mica::Token), Chords);
     IslandBeginsMultivoice = Chords.n();
     for(count i = 0; i < Chords.n(); i++)
       if(!ChordBeginsVoice(Chords[i]))
@@ -31,31 +31,30 @@
 
 ///@name System wrap
 ///@{
-List<Pointer<Music> > WrapBreakGraph(Pointer<const Music> M,
-  Value PotentialBreaks, List<VectorInt> Distribution);
+Sequence<Pointer<Music> > WrapBreakGraph(Pointer<const Music> M,
+  Value PotentialBreaks, const Sequence<VectorInt>& Distribution);
 void WrapBreakTies(Pointer<Music> M, Pointer<const class Geometry> G,
   count FirstInstant, count LastInstant);
-List<number> WrapCalculateBreakWidths(Value PotentialBreaks);
-List<VectorInt> WrapCalculateOptimalBreaks(Value PotentialBreaks,
+Sequence<number> WrapCalculateBreakWidths(Value PotentialBreaks);
+Sequence<VectorInt> WrapCalculateOptimalBreaks(Value PotentialBreaks,
   number FirstLineWidth, number RemainingLineWidths, number CostPower);
 Value WrapCreateBreak(count Instant, Music::ConstNode Island, number TypesetX);
-List<VectorInt> WrapDistributeMeasures(List<number> MeasureWidths,
-  number FirstLineWidth, number RemainingLineWidths, number CostPower);
+Sequence<VectorInt> WrapDistributeMeasures(
+  const Sequence<number>& MeasureWidths, number FirstLineWidth,
+  number RemainingLineWidths, number CostPower);
 count WrapFindInstantOfLastHeaderItem(Pointer<const Music> M);
 Value WrapPotentialBreaks(Pointer<const Music> M);
 ///@}
 
 #ifdef BELLE_IMPLEMENTATION
 
-List<Pointer<Music> > WrapBreakGraph(Pointer<const Music> M,
-  Value PotentialBreaks, List<VectorInt> Distribution)
+Sequence<Pointer<Music> > WrapBreakGraph(Pointer<const Music> M,
+  Value PotentialBreaks, const Sequence<VectorInt>& Distribution)
 {
-  List<Pointer<Music> > SeparatedGraphs;
-  const String Original = M->ExportXML();
+  Sequence<Pointer<Music> > SeparatedGraphs;
   for(Counter d; d.z(Distribution); d++)
   {
-    Pointer<Music> Copy;
-    Copy.New()->ImportXML(Original);
+    Pointer<Music> Copy = M->Clone();
     if(System::MutableGeometry(Copy)->Parse(*Copy))
     {
       Pointer<const class Geometry> G = System::Geometry(Copy);
@@ -157,20 +156,20 @@ class WrapCostLabel : public GraphTLabel<String>
   bool EdgeEquivalent(const GraphTLabel<String>& L) {(void)L; return true;}
 };
 
-List<number> WrapCalculateBreakWidths(Value PotentialBreaks)
+Sequence<number> WrapCalculateBreakWidths(Value PotentialBreaks)
 {
-  List<number> MeasureWidths;
+  Sequence<number> MeasureWidths;
   for(Counter i; i.y(PotentialBreaks); i++)
     MeasureWidths.Add() =
       +PotentialBreaks[i + 1]["TypesetX"] - +PotentialBreaks[i]["TypesetX"];
   return MeasureWidths;
 }
 
-List<VectorInt> WrapCalculateOptimalBreaks(Value PotentialBreaks,
+Sequence<VectorInt> WrapCalculateOptimalBreaks(Value PotentialBreaks,
   number FirstLineWidth, number RemainingLineWidths, number CostPower)
 {
-  List<number> MeasureWidths = WrapCalculateBreakWidths(PotentialBreaks);
-  List<VectorInt> MeasureBreaks = WrapDistributeMeasures(MeasureWidths,
+  Sequence<number> MeasureWidths = WrapCalculateBreakWidths(PotentialBreaks);
+  Sequence<VectorInt> MeasureBreaks = WrapDistributeMeasures(MeasureWidths,
     FirstLineWidth, RemainingLineWidths, CostPower);
   return MeasureBreaks;
 }
@@ -184,14 +183,15 @@ Value WrapCreateBreak(count Instant, Music::ConstNode Island, number TypesetX)
   return v;
 }
 
-List<VectorInt> WrapDistributeMeasures(List<number> MeasureWidths,
-  number FirstLineWidth, number RemainingLineWidths, number CostPower)
+Sequence<VectorInt> WrapDistributeMeasures(
+  const Sequence<number>& MeasureWidths, number FirstLineWidth,
+  number RemainingLineWidths, number CostPower)
 {
   typedef GraphT<WrapCostLabel> CostGraph;
   typedef Pointer<GraphT<WrapCostLabel>::Object> CostNode;
   typedef Pointer<const GraphT<WrapCostLabel>::Object> ConstCostNode;
 
-  List<VectorInt> Distribution;
+  Sequence<VectorInt> Distribution;
   if(MeasureWidths.n() > 0 and MeasureWidths > 0.f and
     FirstLineWidth > 0.f and RemainingLineWidths > 0.f)
   {
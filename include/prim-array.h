@@ -461,13 +461,34 @@ namespace PRIM_NAMESPACE
       Add(NewElement);
     }
 
+#ifdef PRIM_11
+    ///Adds an element to the array by moving it into place.
+    void Add(T&& NewElement)
+    {
+#ifndef __clang_analyzer__
+      n(ApparentSize + 1);
+      Data[ApparentSize - 1] = Move(NewElement);
+#endif
+    }
+
+    ///Alias for Add
+    void Push(T&& NewElement)
+    {
+      Add(Move(NewElement));
+    }
+#endif
+
     ///Pop preserves API compatibility with other classes
     T Pop()
     {
       T Copy = Nothing<T>();
       if(n())
       {
+#ifdef PRIM_11
+        Copy = Move(z());
+#else
         Copy = z();
+#endif
         n(n() - 1);
       }
       return Copy;
@@ -482,6 +503,28 @@ namespace PRIM_NAMESPACE
         ith(OriginalSize + i) = Other[i];
     }
 
+#ifdef PRIM_11
+    /**Appends the contents of another array to this one by moving each of the
+    elements. If this array is empty, the storage of the other array is taken
+    over directly. The other array is left empty.*/
+    void Append(Array&& Other)
+    {
+      if(&Other == this)
+        return;
+      if(not ApparentSize)
+      {
+        SwapWith(Other);
+        Other.n(0);
+        return;
+      }
+      count OriginalSize = n();
+      n(OriginalSize + Other.n());
+      for(count i = 0, n = Other.n(); i < n; i++)
+        Data[OriginalSize + i] = Move(Other.Data[i]);
+      Other.n(0);
+    }
+#endif
+
     ///Reverses the elements in the array.
     void Reverse()
     {
@@ -689,6 +732,29 @@ namespace PRIM_NAMESPACE
       return *this;
     }
 
+#ifdef PRIM_11
+    /**Move constructor takes over the storage of the other array without
+    touching the elements. The other array is left empty.*/
+    Array(Array&& Other) noexcept : Data(Other.Data),
+      ApparentSize(Other.ApparentSize), RealSize(Other.RealSize)
+    {
+      Other.Data = 0;
+      Other.ApparentSize = Other.RealSize = 0;
+    }
+
+    /**Move assignment releases the current elements and takes over the storage
+    of the other array. The other array is left empty.*/
+    Array& operator = (Array&& Other) noexcept
+    {
+      if(&Other != this)
+      {
+        n(0);
+        SwapWith(Other);
+      }
+      return *this;
+    }
+#endif
+
     ///Returns whether the contents of this array are identical to another.
     bool operator == (const Array<T>& Other) const
     {
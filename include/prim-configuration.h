@@ -92,17 +92,38 @@ completely out of the build. Currently used by String.
 */
 //#define PRIM_DEBUG_INTERNAL
 
+/*                            Value Copy Statistics
+
+Counts the number of values deep-copied by Value so that the cost of copying
+and assignment can be measured (see Value::DeepCopies()). An array or tree that
+is copied by sharing its storage is not counted, but its elements are once the
+storage is cloned. The counter is not synchronized and is only meant for
+profiling single-threaded runs.
+*/
+//#define PRIM_VALUE_COPY_STATISTICS
+
 /*                            std::thread (C++11)
 
 Use std::thread instead of POSIX threads when the thread module is activated.
 */
 //#define PRIM_THREAD_USE_STD_THREAD
 
+/*                           Atomic Pointer Counts
+
+Use atomic operations for the reference counts of Pointer so that handles to
+the same object may be copied and released on different threads. This requires
+a compiler that provides the __atomic builtins (GCC or Clang).
+*/
+//#define PRIM_POINTER_USE_ATOMICS
+
 /*                                C++11 Support
 
-Enable C++11 features in prim.
+Enable C++11 features in prim. These are turned on automatically when the
+compiler reports C++11 support (see prim-language.h). Define PRIM_NO_11 to keep
+prim in its C++98 subset regardless of the compiler.
 */
 //#define PRIM_11
+//#define PRIM_NO_11
 
 /*                          Cryptographic Randomness
 
@@ -110,6 +131,13 @@ Use /dev/random for Random::SystemNoise() and for seeding Random.
 */
 //#define PRIM_USE_DEV_RANDOM
 
+/*                              Vectorized Search
+
+String search uses SSE2 (or AVX2 when the compiler targets it) on x86 and a
+scalar memchr-based loop elsewhere. Define PRIM_NO_SIMD to force the scalar path.
+*/
+//#define PRIM_NO_SIMD
+
 /*                                  Modules
 
 Enable platform-specific modules with PRIM_WITH_<MODULENAME>. See below for a
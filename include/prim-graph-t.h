@@ -110,7 +110,13 @@ namespace PRIM_NAMESPACE
   class. A node is an Object that stores connected edges and an edge is an
   Object that stores its connected nodes. All nodes and edges are of the same
   type and rely on expressive labels rather than node subclassing to
-  differentiate types of node information.*/
+  differentiate types of node information.
+
+  Const traversals are not thread-safe on their own. The adjacency index of a
+  node is rebuilt by the first traversal that needs it after an edge of the
+  node is connected, disconnected or relabeled, even through a const graph.
+  Call Reindex() after the last change so that threads can then traverse the
+  same graph concurrently.*/
   template<typename L>
   class GraphT
   {
@@ -144,6 +150,9 @@ namespace PRIM_NAMESPACE
       //Give the Graph class access to this class.
       template <class U> friend class GraphT;
 
+      ///Lets GraphT create objects in a single allocation with Pointer::Make.
+      friend class Pointer<Object>;
+
       ///Connected edges in the case of the object being a node.
       Tree<Pointer<Object>, bool> Edges;
 
@@ -159,7 +168,165 @@ namespace PRIM_NAMESPACE
       prevent itself from being garbage collected.*/
       typename Pointer<Object>::Weak Self;
 
-      /*Only GraphT may construct an Object.*/ Object() : Label(*this) {}
+      ///Range of the adjacency index holding the edges of one kind.
+      struct Bucket
+      {
+        uint64 Kind;
+        count Begin;
+        count End;
+        bool Forwards; PRIM_PAD(bool)
+      };
+
+      /**Adjacency index of a node. The edges that have a nonzero kind (see
+      GraphTLabel::EdgeKind()) are grouped into buckets by direction and kind,
+      keeping the order of Edges within each bucket. The index refers to the
+      keys of Edges, so it is rebuilt the first time it is needed after an edge
+      of the node is connected, disconnected, or relabeled (or by
+      GraphT::Reindex()).*/
+      mutable Array<const Pointer<Object>*> IndexedEdges;
+
+      ///Buckets of the adjacency index
+      mutable Array<Bucket> Buckets;
+
+      ///Whether the adjacency index is up-to-date with the edges.
+      mutable bool Indexed; PRIM_PAD(bool)
+
+      /*Only GraphT may construct an Object.*/
+      Object() : Indexed(false), Label(*this) {}
+
+      ///Returns the bucket for the given direction and kind or null if empty.
+      Bucket* FindBucket(uint64 Kind, bool Forwards) const
+      {
+        for(count i = 0; i < Buckets.n(); i++)
+          if(Buckets[i].Kind == Kind and Buckets[i].Forwards == Forwards)
+            return &Buckets[i];
+        return 0;
+      }
+
+      ///Adds an edge to the bucket count for the given direction and kind.
+      void CountInBucket(uint64 Kind, bool Forwards) const
+      {
+        if(Bucket* b = FindBucket(Kind, Forwards))
+          b->End++;
+        else
+        {
+          Bucket& New = Buckets.Add();
+          New.Kind = Kind, New.Begin = 0, New.End = 1, New.Forwards = Forwards;
+        }
+      }
+
+      ///Rebuilds the adjacency index from the edges.
+      void Reindex() const
+      {
+        typename Tree<Pointer<Object>, bool>::Iterator It;
+        Buckets.Clear();
+        for(It.Begin(Edges); It.Iterating(); It.Next())
+        {
+          const Pointer<Object>& Edge = It.Key();
+          if(uint64 Kind = Edge->Label.EdgeKind())
+          {
+            if(Edge->From == Self) CountInBucket(Kind, true);
+            if(Edge->To == Self) CountInBucket(Kind, false);
+          }
+        }
+
+        //Lay out the buckets one after another and fill them in edge order.
+        count Total = 0;
+        for(count i = 0; i < Buckets.n(); i++)
+        {
+          count Size = Buckets[i].End;
+          Buckets[i].Begin = Buckets[i].End = Total;
+          Total += Size;
+        }
+        IndexedEdges.n(Total);
+        for(It.Begin(Edges); It.Iterating(); It.Next())
+        {
+          const Pointer<Object>& Edge = It.Key();
+          if(uint64 Kind = Edge->Label.EdgeKind())
+          {
+            if(Edge->From == Self)
+              IndexedEdges[FindBucket(Kind, true)->End++] = &Edge;
+            if(Edge->To == Self)
+              IndexedEdges[FindBucket(Kind, false)->End++] = &Edge;
+          }
+        }
+        Indexed = true;
+      }
+
+      ///Marks the adjacency index of the nodes of an edge as out-of-date.
+      void Relabeled()
+      {
+        if(not IsEdge()) return;
+        From->Indexed = false;
+        To->Indexed = false;
+      }
+
+      /**Visits the edges leaving (or arriving at) a node that could be
+      edge-equivalent to a filter. If the filter has an edge kind, only the
+      bucket of that kind is visited. Otherwise each edge of the node is.*/
+      class Candidates
+      {
+        const Object& Node;
+        typename Tree<Pointer<Object>, bool>::Iterator It;
+        const Pointer<Object>* const* At;
+        const Pointer<Object>* const* End;
+        bool Forwards; PRIM_PAD(bool)
+        bool Scanning; PRIM_PAD(bool)
+
+        ///Skips the edges that are not in the direction being visited.
+        void SkipOtherDirection()
+        {
+          while(It.Iterating() and
+            not ((Forwards ? It.Key()->From : It.Key()->To) == Node.Self))
+              It.Next();
+        }
+
+        public:
+
+        ///Starts visiting the candidate edges of the node.
+        Candidates(const Object& Node_, const L& Filter, bool Forwards_) :
+          Node(Node_), At(0), End(0), Forwards(Forwards_), Scanning(false)
+        {
+          uint64 Kind = Filter.EdgeKind();
+          if(not Kind)
+          {
+            Scanning = true;
+            It.Begin(Node.Edges);
+            SkipOtherDirection();
+            return;
+          }
+
+          if(not Node.Indexed)
+            Node.Reindex();
+          if(const Bucket* b = Node.FindBucket(Kind, Forwards))
+          {
+            At = &Node.IndexedEdges[b->Begin];
+            End = At + (b->End - b->Begin);
+          }
+        }
+
+        ///Returns whether there is a current edge.
+        bool Iterating() const
+        {
+          return Scanning ? It.Iterating() : At != End;
+        }
+
+        ///Returns the current edge.
+        const Pointer<Object>& Edge() const
+        {
+          return Scanning ? It.Key() : **At;
+        }
+
+        ///Moves to the next edge.
+        void Next()
+        {
+          if(Scanning)
+            It.Next(), SkipOtherDirection();
+          else
+            At++;
+        }
+      };
+      friend class Candidates;
 
       /**Returns a copy of the array with unconst pointers. This is used in
       special circumstances to prevent code duplication between const and
@@ -181,6 +348,105 @@ namespace PRIM_NAMESPACE
         return reinterpret_cast<const Pointer<Object>&>(ConstPointer);
       }
 
+      /**Fills a buffer with the nodes (or edges) adjacent to this node along
+      edges that match the filter. If Forwards is true the children are
+      collected, otherwise the parents. The buffer may be any array type with
+      Clear() and Add().*/
+      template <class Buffer>
+      void Adjacent(const L& Filter, Buffer& Result, bool Forwards,
+        bool ReturnEdges) const
+      {
+        Result.Clear();
+        if(IsEdge()) return;
+
+        /*Iterate through each candidate edge in the given direction and look
+        for the ones whose label is edge-equivalent to the filter.*/
+        for(Candidates c(*this, Filter, Forwards); c.Iterating(); c.Next())
+        {
+          const Pointer<Object>& Edge = c.Edge();
+          if(Edge->Label.EdgeEquivalent(Filter))
+            Result.Add(ReturnEdges ? Edge :
+              (Forwards ? Edge->To : Edge->From));
+        }
+      }
+
+      ///Returns the next (or previous) node along an edge matching the filter.
+      Pointer<const Object> Step(const L& Filter, bool Forwards) const
+      {
+        return Forwards ? Next(Filter) : Previous(Filter);
+      }
+
+      /**Follows the edges that match the filter forwards (or backwards) from
+      the node and returns the last node reached before the series ends or comes
+      back to a node it already reached. Loops are found with Brent's algorithm
+      so that the traversal needs no visited set and writes nothing.*/
+      Pointer<const Object> SeriesEnd(const L& Filter, bool Forwards) const
+      {
+        if(not IsNode()) return Pointer<const Object>();
+
+        //Walk the series, moving a mark to every power-of-two step.
+        Pointer<const Object> Mark = Self.Const(), Current = Mark, Following;
+        count Power = 1, Length = 0;
+        for(;;)
+        {
+          if(not (Following = Current->Step(Filter, Forwards)))
+            return Current;
+          Current = Following, Length++;
+          if(Current == Mark)
+            break;
+          if(Length == Power)
+            Mark = Current, Power *= 2, Length = 0;
+        }
+
+        /*The series loops with the found length. A walker started that many
+        steps ahead of another first meets it where the loop closes, and the
+        node it just left is the end of the series.*/
+        Pointer<const Object> Lead = Self.Const(), Trail = Lead, Before;
+        for(count i = 0; i < Length; i++)
+          Before = Lead, Lead = Lead->Step(Filter, Forwards);
+        while(Lead != Trail)
+        {
+          Before = Lead, Lead = Lead->Step(Filter, Forwards);
+          Trail = Trail->Step(Filter, Forwards);
+        }
+        return Before;
+      }
+
+      /**Fills a buffer with the series of a node by following edges that match
+      the filter. The buffer may be any array type with Clear(), Add() and
+      n().*/
+      template <class Buffer>
+      void SeriesInto(const L& Filter, Buffer& Result, bool Backup) const
+      {
+        Result.Clear();
+        if(not IsNode()) return;
+
+        //Back the node up as far as it can go.
+        Pointer<const Object> Current = Backup ? First(Filter) : Self.Const();
+
+        /*Traverse series add each element to the array. If the series loops,
+        a mark that is moved to every power-of-two step is met again (Brent's
+        algorithm), so no visited set is needed and no node is written to.*/
+        Pointer<const Object> Mark = Current;
+        count Power = 1, Length = 0;
+        Result.Add(Current);
+        while((Current = Current->Next(Filter)))
+        {
+          Result.Add(Current), Length++;
+          if(Current == Mark)
+          {
+            //Cut the series before the first node that the loop comes back to.
+            count Start = 0;
+            while(Result[Start] != Result[Start + Length])
+              Start++;
+            Result.n(Start + Length);
+            return;
+          }
+          if(Length == Power)
+            Mark = Current, Power *= 2, Length = 0;
+        }
+      }
+
       public:
 
       ///Reference to the label.
@@ -195,17 +461,19 @@ namespace PRIM_NAMESPACE
       ///Constant key-value lookup
       template <class U> U Get(const U& K) const {return Label.Get(K);}
 
-      ///Mutable key-value lookup
-      template <class U> U& Set(const U& K) {return Label.Set(K);}
+      /**Mutable key-value lookup. Changes to the label of an edge that could
+      change its kind must be made through Set() and before the next traversal
+      so that the adjacency index of its nodes is rebuilt.*/
+      template <class U> U& Set(const U& K) {Relabeled(); return Label.Set(K);}
 
       ///Constant key-value lookup overload
       String Get(const ascii* K) const {return Label.Get(K);}
 
       ///Mutable key-value lookup overload
-      String& Set(const ascii* K) {return Label.Set(K);}
+      String& Set(const ascii* K) {Relabeled(); return Label.Set(K);}
 
       ///Mutable key-value lookup overload
-      void Set(const ascii* K, const ascii* V) {Label.Set(K, V);}
+      void Set(const ascii* K, const ascii* V) {Relabeled(); Label.Set(K, V);}
 
       ///String conversion
       operator String() const {return L::operator String();}
@@ -253,14 +521,13 @@ namespace PRIM_NAMESPACE
       {
         if(not IsNode()) return Pointer<Object>();
 
-        /*Iterate through each edge and look for a forwards one whose label is
-        edge-equivalent to the filter.*/
+        /*Iterate through each candidate forwards edge and look for one whose
+        label is edge-equivalent to the filter.*/
         Pointer<const Object> Result;
-        typename Tree<Pointer<Object>, bool>::Iterator It;
-        for(It.Begin(Edges); It.Iterating(); It.Next())
+        for(Candidates c(*this, Filter, true); c.Iterating(); c.Next())
         {
-          Pointer<const Object> Edge = It.Key();
-          if(Edge->From == Self and Edge->Label.EdgeEquivalent(Filter))
+          Pointer<const Object> Edge = c.Edge();
+          if(Edge->Label.EdgeEquivalent(Filter))
           {
             /*If multiple matching nodes are found, return null. Caller must use
             the Children() method instead.*/
@@ -291,14 +558,13 @@ namespace PRIM_NAMESPACE
       {
         if(not IsNode()) return Pointer<Object>();
 
-        /*Iterate through each edge and look for a backwards one whose label is
-        edge-equivalent to the filter.*/
+        /*Iterate through each candidate backwards edge and look for one whose
+        label is edge-equivalent to the filter.*/
         Pointer<const Object> Result;
-        typename Tree<Pointer<Object>, bool>::Iterator It;
-        for(It.Begin(Edges); It.Iterating(); It.Next())
+        for(Candidates c(*this, Filter, false); c.Iterating(); c.Next())
         {
-          Pointer<const Object> Edge = It.Key();
-          if(Edge->To == Self and Edge->Label.EdgeEquivalent(Filter))
+          Pointer<const Object> Edge = c.Edge();
+          if(Edge->Label.EdgeEquivalent(Filter))
           {
             /*If multiple matching nodes are found, return null. Caller must use
             the Children() method instead.*/
@@ -324,15 +590,11 @@ namespace PRIM_NAMESPACE
       ///Finds the first instance of a node in a series that matches a filter.
       Pointer<const Object> First(const L& Filter) const
       {
-        Tree<Pointer<const Object>, bool> Visited;
-        Pointer<const Object> p = Self, r;
-        if(IsNode()) do Visited[r = p] = true; while(
-          (p = r->Previous(Filter)) and not Visited.Contains(p));
-        return r;
+        return SeriesEnd(Filter, false);
       }
 
       ///Finds the first instance of a node in a series that matches a filter.
-      Array<Pointer<Object> > First(const L& Filter)
+      Pointer<Object> First(const L& Filter)
       {
         return ForceUnconst(static_cast<const Object&>(*this).First(Filter));
       }
@@ -340,15 +602,11 @@ namespace PRIM_NAMESPACE
       ///Finds the last instance of a node in a series that matches a filter.
       Pointer<const Object> Last(const L& Filter) const
       {
-        Tree<Pointer<const Object>, bool> Visited;
-        Pointer<const Object> n = Self, r;
-        if(IsNode()) do Visited[r = n] = true; while(
-          (n = r->Next(Filter)) and not Visited.Contains(n));
-        return r;
+        return SeriesEnd(Filter, true);
       }
 
       ///Finds the last instance of a node in a series that matches a filter.
-      Array<Pointer<Object> > Last(const L& Filter)
+      Pointer<Object> Last(const L& Filter)
       {
         return ForceUnconst(static_cast<const Object&>(*this).Last(Filter));
       }
@@ -359,24 +617,21 @@ namespace PRIM_NAMESPACE
       Array<Pointer<const Object> > Series(const L& Filter,
         bool Backup = true) const
       {
-        //Create an array of the series.
         Array<Pointer<const Object> > SeriesNodes;
-        Tree<Pointer<const Object>, bool> Visited;
-
-        if(not IsNode()) return Array<Pointer<const Object> >();
-
-        //Back the node up as far as it can go.
-        Pointer<const Object> Current = Backup ? First(Filter) : Self.Const();
-
-        //Traverse series add each element to the array.
-        SeriesNodes.Add() = Current, Visited[Current] = true;
-        while((Current = Current->Next(Filter)) and
-          not Visited.Contains(Current))
-            Visited[SeriesNodes.Add() = Current] = true;
-
+        SeriesInto(Filter, SeriesNodes, Backup);
         return SeriesNodes;
       }
 
+      /**Fills a caller-supplied buffer with the series of a node by following
+      edges that match the filter. See Series().*/
+      template <count N>
+      void Series(const L& Filter,
+        InlineArray<Pointer<const Object>, N>& Result,
+        bool Backup = true) const
+      {
+        SeriesInto(Filter, Result, Backup);
+      }
+
       /**Returns the series of a node by following edges that match the filter.
       If Backup is true, then traversal will start from the first in the
       series. Otherwise, traversal starts from the current node.*/
@@ -391,20 +646,29 @@ namespace PRIM_NAMESPACE
         bool ReturnEdges = false) const
       {
         Array<Pointer<const Object> > ChildNodes;
-        if(IsEdge()) return ChildNodes;
+        Adjacent(Filter, ChildNodes, true, ReturnEdges);
+        return ChildNodes;
+      }
 
-        /*Iterate through each edge and look for forwards edges whose label is
-        edge-equivalent to the filter.*/
-        typename Tree<Pointer<Object>, bool>::Iterator It;
-        for(It.Begin(Edges); It.Iterating(); It.Next())
-        {
-          Pointer<const Object> Edge = It.Key();
-          if(Edge->From == Self and Edge->Label.EdgeEquivalent(Filter))
-            ChildNodes.Add(ReturnEdges ? Edge : Edge->To.Const());
-        }
+      /**Fills a caller-supplied buffer with the children of a node following
+      edges that match the filter. With enough inline storage in the buffer no
+      memory is allocated.*/
+      template <count N>
+      void Children(const L& Filter,
+        InlineArray<Pointer<const Object>, N>& Result,
+        bool ReturnEdges = false) const
+      {
+        Adjacent(Filter, Result, true, ReturnEdges);
+      }
 
-        //No edge matched the filter so return an empty node.
-        return ChildNodes;
+      /**Fills a caller-supplied buffer with the children of a node following
+      edges that match the filter. With enough inline storage in the buffer no
+      memory is allocated.*/
+      template <count N>
+      void Children(const L& Filter, InlineArray<Pointer<Object>, N>& Result,
+        bool ReturnEdges = false)
+      {
+        Adjacent(Filter, Result, true, ReturnEdges);
       }
 
       ///Returns the children of a node following edges that match the filter.
@@ -420,20 +684,29 @@ namespace PRIM_NAMESPACE
         bool ReturnEdges = false) const
       {
         Array<Pointer<const Object> > ParentNodes;
-        if(IsEdge()) return ParentNodes;
+        Adjacent(Filter, ParentNodes, false, ReturnEdges);
+        return ParentNodes;
+      }
 
-        /*Iterate through each edge and look for forwards edges whose label is
-        edge-equivalent to the filter.*/
-        typename Tree<Pointer<Object>, bool>::Iterator It;
-        for(It.Begin(Edges); It.Iterating(); It.Next())
-        {
-          Pointer<const Object> Edge = It.Key();
-          if(Edge->To == Self and Edge->Label.EdgeEquivalent(Filter))
-            ParentNodes.Add(ReturnEdges ? Edge : Edge->From.Const());
-        }
+      /**Fills a caller-supplied buffer with the parents of a node following
+      edges that match the filter. With enough inline storage in the buffer no
+      memory is allocated.*/
+      template <count N>
+      void Parents(const L& Filter,
+        InlineArray<Pointer<const Object>, N>& Result,
+        bool ReturnEdges = false) const
+      {
+        Adjacent(Filter, Result, false, ReturnEdges);
+      }
 
-        //No edge matched the filter so return an empty node.
-        return ParentNodes;
+      /**Fills a caller-supplied buffer with the parents of a node following
+      edges that match the filter. With enough inline storage in the buffer no
+      memory is allocated.*/
+      template <count N>
+      void Parents(const L& Filter, InlineArray<Pointer<Object>, N>& Result,
+        bool ReturnEdges = false)
+      {
+        Adjacent(Filter, Result, false, ReturnEdges);
       }
 
       ///Returns the parents of a node following edges that match the filter.
@@ -456,18 +729,18 @@ namespace PRIM_NAMESPACE
     Pointer<Object> Add()
     {
       //Create a new node.
-      Pointer<Object> n = new Object;
+      Pointer<Object> n = Pointer<Object>::Make();
 
       /*Cache the auto-pointer handle in the object so that it can recover an
       auto-pointer handle to itself.*/
       n->Self = n;
 
       //Set the node as root if it is the first in the graph.
-      if(NodeTree.Empty())
+      if(NodeSet.Empty())
         RootNode = n;
 
-      //Add the node to the node tree.
-      NodeTree[n] = true;
+      //Add the node to the node set.
+      NodeSet.Add(n);
 
       //Return the new node.
       return n;
@@ -483,14 +756,14 @@ namespace PRIM_NAMESPACE
         return 0;
 
       //Create the edge.
-      Pointer<Object> e(new Object);
+      Pointer<Object> e = Pointer<Object>::Make();
       e->From = x;
       e->To = y;
 
       //Add a reference to the edge in both nodes.
-      x->Edges[e] = true;
+      x->Edges[e] = true, x->Indexed = false;
       if(y != x)
-        y->Edges[e] = true;
+        y->Edges[e] = true, y->Indexed = false;
 
       //Return the new edge.
       return e;
@@ -511,9 +784,9 @@ namespace PRIM_NAMESPACE
 
         /*Disconnect the two nodes sharing the edge. This pops an element off
         the current tree.*/
-        n->From->Edges.Remove(n);
+        n->From->Edges.Remove(n), n->From->Indexed = false;
         if(n->To != n->From)
-          n->To->Edges.Remove(n);
+          n->To->Edges.Remove(n), n->To->Indexed = false;
       }
       else
       {
@@ -530,9 +803,9 @@ namespace PRIM_NAMESPACE
 
           /*Disconnect the two nodes sharing the edge. This pops an element off
           the current tree.*/
-          e->From->Edges.Remove(e);
+          e->From->Edges.Remove(e), e->From->Indexed = false;
           if(e->To != e->From)
-            e->To->Edges.Remove(e);
+            e->To->Edges.Remove(e), e->To->Indexed = false;
 
           //Once e goes out of scope, the edge will be deleted.
         }
@@ -553,9 +826,9 @@ namespace PRIM_NAMESPACE
       //Disconnect the node or edge first.
       Disconnect(n);
 
-      //If it is a node, then remove its entry in the node tree.
+      //If it is a node, then remove its entry in the node set.
       if(WasNode)
-        NodeTree.Remove(n);
+        NodeSet.Remove(n);
 
       //Once the last pointer to n goes out of scope, the node is deleted.
     }
@@ -568,9 +841,11 @@ namespace PRIM_NAMESPACE
     void Clear()
     {
       //Disconnect each node from the graph.
-      while(not NodeTree.Empty())
+      Array<Pointer<Object> > NodeArray;
+      NodeSet.Keys(NodeArray);
+      for(count i = 0; i < NodeArray.n(); i++)
       {
-        Pointer<Object> n = NodeTree.Last();
+        Pointer<Object> n = NodeArray[i];
 
         /*By zeroing out the label pointer, it will automatically destroy the
         label. This is necessary because the label could contain auto-pointers
@@ -581,26 +856,37 @@ namespace PRIM_NAMESPACE
 
         //Disconnect the node from any other nodes, leaving it isolated.
         Disconnect(n);
-
-        NodeTree.RemoveLast();
       }
+      NodeSet.RemoveAll();
       RootNode = Pointer<Object>();
     }
 
+    /**Brings the adjacency index of every node up to date. Since a const
+    traversal may otherwise rebuild the index of a node that has changed, call
+    this after the last change to the graph before traversing it from several
+    threads at once.*/
+    void Reindex()
+    {
+      typename HashSet<Pointer<Object> >::Iterator It;
+      for(It.Begin(NodeSet); It.Iterating(); It.Next())
+        if(not It.Key()->Indexed)
+          It.Key()->Reindex();
+    }
+
     ///Returns whether a node or an edge belongs to the graph.
     bool Belongs(Pointer<const Object> n) const
     {
       /*Check for null. Technically there should not be any null pointers in the
-      node tree, but this saves having to check the tree.*/
+      node set, but this saves having to check the set.*/
       if(not n)
         return false;
 
       if(n->IsNode())
       {
-        /*Look for the node in tree and report whether it exists.
+        /*Look for the node in the set and report whether it exists.
         #voodoo Note the forced const object conversion is to enable looking up
-        in the non-const object tree.*/
-        return NodeTree[*reinterpret_cast<Pointer<Object>*>(&n)];
+        in the non-const object set.*/
+        return NodeSet.Contains(*reinterpret_cast<Pointer<Object>*>(&n));
       }
 
       //Determine if the edge nodes belong to the graph.
@@ -622,20 +908,20 @@ namespace PRIM_NAMESPACE
     ///Returns an array of all the nodes in the graph.
     Sortable::Array<Pointer<Object> > Nodes()
     {
-      //Initialize a node array and size it to match the node tree size.
+      //Initialize a node array and size it to match the node set size.
       Sortable::Array<Pointer<Object> >
-        NodeArray(NodeTree.n());
+        NodeArray(NodeSet.n());
 
-      //Fill a node array with the keys of the node tree.
-      typename Tree<Pointer<Object>, bool>::Iterator It;
+      //Fill a node array with the keys of the node set.
+      typename HashSet<Pointer<Object> >::Iterator It;
       count i = 0;
-      for(It.Begin(NodeTree); It.Iterating(); It.Next())
+      for(It.Begin(NodeSet); It.Iterating(); It.Next())
       {
         Pointer<Object> k = It.Key();
         NodeArray[i++] = k;
       }
 
-      //Sort the array before returning (should already be sorted).
+      //Sort the array so that the nodes are returned in address order.
       NodeArray.Sort();
 
       //Return the node array containing all the nodes in the graph.
@@ -645,20 +931,20 @@ namespace PRIM_NAMESPACE
     ///Returns an array of all the nodes in the graph.
     Sortable::Array<Pointer<const Object> > Nodes() const
     {
-      //Initialize a node array and size it to match the node tree size.
+      //Initialize a node array and size it to match the node set size.
       Sortable::Array<Pointer<const Object> >
-        NodeArray(NodeTree.n());
+        NodeArray(NodeSet.n());
 
-      //Fill a node array with the keys of the node tree.
-      typename Tree<Pointer<Object>, bool>::Iterator It;
+      //Fill a node array with the keys of the node set.
+      typename HashSet<Pointer<Object> >::Iterator It;
       count i = 0;
-      for(It.Begin(NodeTree); It.Iterating(); It.Next())
+      for(It.Begin(NodeSet); It.Iterating(); It.Next())
       {
         Pointer<const Object> k = It.Key();
         NodeArray[i++] = k;
       }
 
-      //Sort the array before returning (should already be sorted).
+      //Sort the array so that the nodes are returned in address order.
       NodeArray.Sort();
 
       //Return the node array containing all the nodes in the graph.
@@ -668,33 +954,33 @@ namespace PRIM_NAMESPACE
     ///Returns an array of all the edges in the graph.
     Sortable::Array<Pointer<const Object> > Edges() const
     {
-      //Create an edge tree with all the edges in the graph.
-      Tree<Pointer<Object>, bool> EdgeTree;
+      //Create an edge set with all the edges in the graph.
+      HashSet<Pointer<Object> > EdgeSet;
 
-      //Populate an edge tree with all the edges in the graph.
+      //Populate an edge set with all the edges in the graph.
       {
-        typename Tree<Pointer<Object>, bool>::Iterator It;
-        for(It.Begin(NodeTree); It.Iterating(); It.Next())
+        typename HashSet<Pointer<Object> >::Iterator It;
+        for(It.Begin(NodeSet); It.Iterating(); It.Next())
         {
           Pointer<Object> Current = It.Key();
           typename Tree<Pointer<Object>, bool>::Iterator Jt;
           for(Jt.Begin(Current->Edges); Jt.Iterating(); Jt.Next())
           {
             Pointer<Object> Edge = Jt.Key();
-            EdgeTree[Edge] = true;
+            EdgeSet.Add(Edge);
           }
         }
       }
 
-      //Initialize a edge array and size it to match the edge tree size.
+      //Initialize a edge array and size it to match the edge set size.
       Sortable::Array<Pointer<const Object> >
-        EdgeArray(EdgeTree.n());
+        EdgeArray(EdgeSet.n());
 
-      //Fill a edge array with the keys of the node tree.
+      //Fill a edge array with the keys of the edge set.
       {
-        typename Tree<Pointer<Object>, bool>::Iterator It;
+        typename HashSet<Pointer<Object> >::Iterator It;
         count i = 0;
-        for(It.Begin(EdgeTree); It.Iterating(); It.Next())
+        for(It.Begin(EdgeSet); It.Iterating(); It.Next())
         {
           Pointer<const Object> Edge = It.Key();
           EdgeArray[i++] = Edge;
@@ -833,52 +1119,92 @@ namespace PRIM_NAMESPACE
     ///Returns the first found cycle of the given edge filter if one exists.
     Array<Pointer<const Object> > Cycle(const L& Filter) const
     {
-      Array<count> Path, DFS;
+      /*Search depth-first from each unvisited node, keeping the current path
+      and the children still to visit at each step of it. A child that is on
+      the path closes a cycle. Since each node is finished once and each of its
+      edges is followed once, the search is O(V + E).*/
+      enum {Unvisited, OnPath, Finished};
       Array<Pointer<const Object> > FoundCycle;
-
-      Sortable::Array<Pointer<const Object> > Vertices = Nodes();
-
-      Array<bool> Visited(Vertices.n()); Visited.Zero();
-      Array<bool> InPath(Vertices.n()); InPath.Zero();
-      Array<count> Predecessor(Vertices.n()); Predecessor.Zero();
+      HashMap<const Object*, count> Numbers;
+      Array<Pointer<const Object> > Vertices = NumberNodes(Numbers);
+      Array<byte> Color(Vertices.n()); Color.Zero();
+      Array<count> Path, PathChildren, Children;
 
       for(count i = 0; i < Vertices.n() and not FoundCycle.n(); i++)
       {
-        Path.Clear();
-        InPath.Zero();
-        if(not Visited[i])
+        if(Color[i] != Unvisited) continue;
+        Color[i] = OnPath;
+        Path.Push(i);
+        PathChildren.Push(Children.n());
+        PushChildren(*Vertices[i], Filter, Numbers, Children);
+
+        while(Path.n() and not FoundCycle.n())
         {
-          DFS.Push(i);
-          while(DFS.n() and not FoundCycle.n())
+          //Once the children of the last node on the path are done, back up.
+          if(Children.n() == PathChildren.z())
           {
-            count Vertex = DFS.Pop();
-            if(not Visited[Vertex])
-            {
-              Visited[Vertex] = true;
-
-              if(Path.n() and Path.z() != Predecessor[Vertex])
-                InPath[Path.Pop()] = false;
-
-              Path.Push(Vertex);
-              InPath[Path.z()] = true;
+            Color[Path.Pop()] = Finished;
+            PathChildren.Pop();
+            continue;
+          }
 
-              Array<Pointer<const Object> > Adjacencies =
-                Vertices[Vertex]->Children(Filter);
-              for(count j = 0; j < Adjacencies.n(); j++)
-              {
-                DFS.Push(Vertices.Search(Adjacencies[j]));
-                Predecessor[DFS.z()] = Vertex;
-              }
-            }
-            else if(InPath[Vertex])
-              for(count j = Path.Search(Vertex); j < Path.n(); j++)
-                FoundCycle.Push(Vertices[Path[j]]);
+          count Child = Children.Pop();
+          if(Color[Child] == OnPath)
+          {
+            count j = Path.n() - 1;
+            while(Path[j] != Child) j--;
+            for(; j < Path.n(); j++)
+              FoundCycle.Push(Vertices[Path[j]]);
+          }
+          else if(Color[Child] == Unvisited)
+          {
+            Color[Child] = OnPath;
+            Path.Push(Child);
+            PathChildren.Push(Children.n());
+            PushChildren(*Vertices[Child], Filter, Numbers, Children);
           }
         }
+        Path.Clear();
+        PathChildren.Clear();
+        Children.Clear();
       }
       return FoundCycle;
     }
 
+    /**Numbers the nodes of the graph densely from zero in the order of the node
+    set and returns them by number. The numbers are kept in a map owned by the
+    caller, so a traversal can index its own arrays by node without writing
+    anything to the graph, as long as the graph does not change.*/
+    Array<Pointer<const Object> > NumberNodes(
+      HashMap<const Object*, count>& Numbers) const
+    {
+      Array<Pointer<const Object> > NodeArray(NodeSet.n());
+      typename HashSet<Pointer<Object> >::Iterator It;
+      count i = 0;
+      Numbers.RemoveAll();
+      Numbers.Reserve(NodeSet.n());
+      for(It.Begin(NodeSet); It.Iterating(); It.Next(), i++)
+      {
+        Numbers.Set(It.Key().Raw(), i);
+        NodeArray[i] = It.Key();
+      }
+      return NodeArray;
+    }
+
+    private:
+
+    ///Pushes the numbers of the children of a node along edges of the filter.
+    static void PushChildren(const Object& Node, const L& Filter,
+      const HashMap<const Object*, count>& Numbers, Array<count>& Children)
+    {
+      typename Object::Candidates c(Node, Filter, true);
+      for(; c.Iterating(); c.Next())
+        if(c.Edge()->Label.EdgeEquivalent(Filter))
+          Children.Push(Numbers.Get(c.Edge()->To.Raw()));
+    }
+
+    public:
+
     //-------------//
     //String Output//
     //-------------//
@@ -1051,7 +1377,10 @@ namespace PRIM_NAMESPACE
 
     static String ExportXMLEscapeAttribute(String x)
     {
+      x.Replace("&", "&amp;");
+      x.Replace("<", "&lt;");
       x.Replace("\"", "&quot;");
+      x.Replace("\r", "&#13;");
       return x;
     }
 
@@ -1125,158 +1454,293 @@ namespace PRIM_NAMESPACE
     ///Clears the current graph and imports a graph exported with ExportXML.
     bool ImportXML(const String& XMLData, String RootTag = "graph")
     {
+      /*The XML is read with a pull parser in two passes. The first creates the
+      nodes in document order and remembers where each node element begins.
+      The second revisits the node elements in the order of their ids to set
+      the node attributes and connect the edges.*/
       Clear();
-      //Read in the document.
-      XML::Document d;
-
-      //Attempt to read in the XML.
-      if(XML::Parser::Error ParsingError = d.ParseDocument(XMLData))
-      {
-        C::Error() >> ParsingError.GetDescription();
-        return false;
-      }
-
-      //Do sanity checks on the root node.
-      if(not d.Root)
-      {
-        C::Error() >> "Error: no root node.";
-        return false;
-      }
-      else if(d.Root->GetName() != RootTag)
-      {
-        C::Error() >> "Error: expected '" << RootTag << "' but '" <<
-          d.Root->GetName() << "' is the root.";
-        return false;
-      }
-
-      //Create a node tree.
-      Tree<String, XML::Element*> NodeTree_;
+      Tree<String, count> NodeOffsets;
       Tree<String, Pointer<Object> > GraphTree;
 
       //Make a node id tree.
-      const List<XML::Object*> Objects = d.Root->GetObjects();
-      for(count i = 0; i < Objects.n(); i++)
       {
-        //Skip over any objects that are not elements.
-        XML::Element* e = Objects[i]->IsElement();
-        if(not e) continue;
-
-        //Get the ID.
-        String NodeID = e->GetAttributeValue("id");
-        //Do some sanity checks on the incoming tag.
-        if(e->GetName() != "node")
-        {
-          C::Error() >> "Error: Unexpected element '" << e->GetName() << "'.";
-          Clear();
-          return false;
-        }
-        else if(not NodeID)
+        XML::PullParser p(XMLData);
+        bool SawRoot = false, InNode = false;
+        String NodeID;
+        count NodeOffset = 0;
+        for(;;)
         {
-          C::Error() >> "Error: '" << e->GetName() << "' element with no id.";
-          Clear();
-          return false;
+          XML::PullParser::Event e = p.Next();
+
+          //Once the attributes of a node are read, do some sanity checks.
+          if(InNode and e != XML::PullParser::Attribute)
+          {
+            InNode = false;
+            if(not NodeID)
+            {
+              C::Error() >> "Error: 'node' element with no id.";
+              Clear();
+              return false;
+            }
+            else if(GraphTree[NodeID])
+            {
+              C::Error() >> "Error: Duplicate 'node' with id '" << NodeID <<
+                "'";
+              Clear();
+              return false;
+            }
+
+            //Remember the node element and create a graph node.
+            NodeOffsets[NodeID] = NodeOffset;
+            GraphTree[NodeID] = Add();
+          }
+
+          if(e == XML::PullParser::Malformed)
+          {
+            C::Error() >> "Error: " << p.ErrorInfo();
+            Clear();
+            return false;
+          }
+          else if(e == XML::PullParser::EndDocument or
+            (e == XML::PullParser::EndElement and p.Depth() == 1))
+              break;
+          else if(e == XML::PullParser::StartElement and p.Depth() == 1)
+          {
+            //Do sanity checks on the root node.
+            if(p.Name() != StringView(RootTag))
+            {
+              C::Error() >> "Error: expected '" << RootTag << "' but '" <<
+                p.Name() << "' is the root.";
+              return false;
+            }
+            SawRoot = true;
+          }
+          else if(e == XML::PullParser::StartElement and p.Depth() == 2)
+          {
+            if(p.Name() != "node")
+            {
+              C::Error() >> "Error: Unexpected element '" << p.Name() << "'.";
+              Clear();
+              return false;
+            }
+            InNode = true;
+            NodeID.Clear();
+            NodeOffset = p.Offset();
+          }
+          else if(e == XML::PullParser::Attribute and InNode and
+            p.Name() == "id")
+              NodeID = p.Decoded();
         }
-        else if(NodeTree_[NodeID])
+
+        if(not SawRoot)
         {
-          C::Error() >> "Error: Duplicate '" << e->GetName() << "' with id '" <<
-            NodeID << "'";
-          Clear();
+          C::Error() >> "Error: no root node.";
           return false;
         }
-
-        //Add the node element to the node tree and create a graph node.
-        NodeTree_[NodeID] = e;
-        GraphTree[NodeID] = Add();
       }
 
       //Create all the nodes in the graph, isolated at first.
-      Tree<String, XML::Element*>::Iterator It;
-      for(It.Begin(NodeTree_); It.Iterating(); It.Next())
+      const byte* Markup = reinterpret_cast<const byte*>(XMLData.Merge());
+      const byte* MarkupEnd = Markup + XMLData.n();
+      Array<StringView> EdgeKeys, EdgeValues;
+      Tree<String, count>::Iterator It;
+      for(It.Begin(NodeOffsets); It.Iterating(); It.Next())
       {
         //Parse attributes into node label.
-        XML::Element* n = It.Value();
-        Pointer<Object> From = GraphTree[n->GetAttributeValue("id")];
-        const List<XML::Element::Attribute>& NodeAttributes =
-          n->GetAttributes();
-        for(count j = 0; j < NodeAttributes.n(); j++)
+        Pointer<Object> From = GraphTree[It.Key()];
+        XML::PullParser p(Markup + It.Value(), MarkupEnd);
+        p.Next();
+        bool InEdge = false;
+        for(;;)
         {
-          if(NodeAttributes[j].Name == "id") continue;
-          if(NodeAttributes[j].Name == "root")
+          XML::PullParser::Event e = p.Next();
+
+          //Once the attributes of an edge are read, recreate the edge.
+          if(InEdge and e != XML::PullParser::Attribute)
           {
-            if(NodeAttributes[j].Value != "root")
+            InEdge = false;
+            if(not ImportXMLEdge(From, EdgeKeys, EdgeValues, GraphTree))
             {
-              C::Error() >>
-                "Error: Expected value 'root' for attribute 'root'.";
               Clear();
               return false;
             }
-            Root(From);
-            continue;
           }
-          From->Set(NodeAttributes[j].Name, NodeAttributes[j].Value);
-        }
-
-        //Recreate each edge in the node.
-        const List<XML::Object*> EdgeList = n->GetObjects();
-        for(count j = 0; j < EdgeList.n(); j++)
-        {
-          //Skip over any objects that are not elements.
-          XML::Element* e = EdgeList[j]->IsElement();
-          if(not e) continue;
 
-          //Get the id of the to node.
-          String ToID = e->GetAttributeValue("to");
-
-          //Do some sanity checks on the incoming tag.
-          if(e->GetName() != "edge")
+          if(e == XML::PullParser::EndDocument or
+            e == XML::PullParser::Malformed or
+            (e == XML::PullParser::EndElement and p.Depth() == 1))
+              break;
+          else if(e == XML::PullParser::Attribute and p.Depth() == 1)
           {
-            C::Error() >> "Error: Unexpected element '" << e->GetName() << "'.";
-            Clear();
-            return false;
+            if(p.Name() == "id") continue;
+            if(p.Name() == "root")
+            {
+              if(p.Decoded() != "root")
+              {
+                C::Error() >>
+                  "Error: Expected value 'root' for attribute 'root'.";
+                Clear();
+                return false;
+              }
+              Root(From);
+              continue;
+            }
+            From->Set(String(p.Name()), p.Decoded());
           }
-          else if(not ToID)
+          else if(e == XML::PullParser::StartElement and p.Depth() == 2)
           {
-            C::Error() >> "Error: '" << e->GetName() << "' element with no id.";
-            Clear();
-            return false;
+            if(p.Name() != "edge")
+            {
+              C::Error() >> "Error: Unexpected element '" << p.Name() << "'.";
+              Clear();
+              return false;
+            }
+            InEdge = true;
+            EdgeKeys.Clear();
+            EdgeValues.Clear();
           }
-          else if(not NodeTree_[ToID])
+          else if(e == XML::PullParser::Attribute and InEdge)
           {
-            C::Error() >> "Error: no element found with id '" << ToID << "'.";
-            Clear();
-            return false;
+            EdgeKeys.Add(p.Name());
+            EdgeValues.Add(p.Raw());
           }
+        }
+      }
+      return true;
+    }
 
-          //Connect the nodes together.
-          Pointer<Object> NewEdge = Connect(From, GraphTree[ToID]);
+    private:
 
-          //Parse attributes into edge label.
-          const List<XML::Element::Attribute>& EdgeAttributes =
-            e->GetAttributes();
-          for(count k = 0; k < EdgeAttributes.n(); k++)
-          {
-            if(EdgeAttributes[k].Name == "to") continue;
-            NewEdge->Set(EdgeAttributes[k].Name, EdgeAttributes[k].Value);
-          }
-        }
+    /**Connects an edge read by ImportXML() from a node to the node given by
+    its 'to' attribute and sets its other attributes.*/
+    bool ImportXMLEdge(Pointer<Object> From, const Array<StringView>& Keys,
+      const Array<StringView>& Values, Tree<String, Pointer<Object> >& NodeTree)
+    {
+      //Get the id of the to node.
+      String ToID;
+      for(count i = 0; i < Keys.n() and not ToID; i++)
+        if(Keys[i] == "to")
+          XML::PullParser::Decode(Values[i], true, ToID);
+
+      //Do some sanity checks on the incoming tag.
+      if(not ToID)
+      {
+        C::Error() >> "Error: 'edge' element with no id.";
+        return false;
+      }
+      else if(not NodeTree[ToID])
+      {
+        C::Error() >> "Error: no element found with id '" << ToID << "'.";
+        return false;
+      }
+
+      //Connect the nodes together and parse attributes into edge label.
+      Pointer<Object> NewEdge = Connect(From, NodeTree[ToID]);
+      for(count i = 0; i < Keys.n(); i++)
+      {
+        if(Keys[i] == "to") continue;
+        String DecodedValue;
+        XML::PullParser::Decode(Values[i], true, DecodedValue);
+        NewEdge->Set(String(Keys[i]), DecodedValue);
       }
       return true;
     }
 
+    public:
+
     /**Merges the nodes and edges from another graph into this one. Returns the
     root node of the incoming graph (which is no longer the root node). Note
     that the incoming graph will be empty at the end of this call.*/
     Pointer<Object> Merge(GraphT& Other)
     {
-      typename Tree<Pointer<Object>, bool>::Iterator It;
-      for(It.Begin(Other.NodeTree); It.Iterating(); It.Next())
-        NodeTree[It.Key()] = It.Value();
-      Other.NodeTree.RemoveAll();
+      typename HashSet<Pointer<Object> >::Iterator It;
+      for(It.Begin(Other.NodeSet); It.Iterating(); It.Next())
+        NodeSet.Add(It.Key());
+      Other.NodeSet.RemoveAll();
       Pointer<Object> OtherRoot = Other.RootNode;
       Other.RootNode = Pointer<Object>::Weak();
       return OtherRoot;
     }
 
+    /**Clears the given graph and copies the nodes and edges of this graph into
+    it. The labels of the copy are assigned from the originals, and the root of
+    the copy is the copy of the root.*/
+    void CloneInto(GraphT& Clone) const
+    {
+      CloneInto(Clone, KeepEverything());
+    }
+
+    /**Clears the given graph and copies into it only what passes the filter,
+    which is called with a Pointer<const Object> and returns whether to keep
+    it. Each node is tested, and then each edge between two nodes that were
+    kept. Nodes are copied in address order and the edges of each node in the
+    order of its edges, as ImportXML() would for the output of ExportXML().*/
+    template <class Filter>
+    void CloneInto(GraphT& Clone, const Filter& Keep) const
+    {
+      CloneInto(Clone, Keep, AssignLabel());
+    }
+
+    /**Clears the given graph and copies into it only what passes the filter,
+    copying each label with Copy(Destination, Source) instead of assigning it.
+    This allows part of the label, such as cached state, to be left behind.*/
+    template <class Filter, class Copier>
+    void CloneInto(GraphT& Clone, const Filter& Keep, const Copier& Copy) const
+    {
+      if(&Clone == this) return;
+      Clone.Clear();
+
+      //Copy the nodes that are kept and remember their copies.
+      Array<Pointer<const Object> > NodeArray = Nodes();
+      HashMap<const Object*, Pointer<Object> > Remap;
+      Remap.Reserve(NodeArray.n());
+      for(count i = 0; i < NodeArray.n(); i++)
+      {
+        if(not Keep(NodeArray[i])) continue;
+        Pointer<Object> n = Clone.Add();
+        Copy(n->Label, NodeArray[i]->Label);
+        Remap[NodeArray[i].Raw()] = n;
+      }
+      Clone.RootNode = Root() ? Remap.Get(Root().Raw()) : Pointer<Object>();
+
+      //Copy the departing edges of each node that are kept.
+      for(count i = 0; i < NodeArray.n(); i++)
+      {
+        Pointer<Object> From = Remap.Get(NodeArray[i].Raw());
+        if(not From) continue;
+        typename Tree<Pointer<Object>, bool>::Iterator It;
+        for(It.Begin(NodeArray[i]->Edges); It.Iterating(); It.Next())
+        {
+          Pointer<const Object> Edge = It.Key();
+          if(NodeArray[i] != Edge->From) continue;
+          Pointer<Object> To = Remap.Get(Edge->To.Raw());
+          if(To and Keep(Edge))
+            Copy(Clone.Connect(From, To)->Label, Edge->Label);
+        }
+      }
+    }
+
+    private:
+
+    ///Filter for CloneInto() that keeps every node and edge
+    class KeepEverything
+    {
+      public:
+      bool operator () (const Pointer<const Object>&) const {return true;}
+    };
+
+    ///Label copier for CloneInto() that assigns the whole label
+    class AssignLabel
+    {
+      public:
+      void operator () (L& Destination, const L& Source) const
+      {
+        Destination = Source;
+      }
+    };
+
+    public:
+
     /**Finds the shortest path from start to end nodes given the edge cost.
     Complexity is approximately O(n^2).*/
     List<Pointer<const Object> > ShortestPath(Pointer<const Object> Start,
@@ -1286,13 +1750,14 @@ namespace PRIM_NAMESPACE
       if(Belongs(Start) and Belongs(End) and Start->IsNode() and End->IsNode())
       {
         Array<Pointer<const Object> > Vertices = Nodes();
-        Tree<Pointer<const Object>, count> Indices;
+        HashMap<Pointer<const Object>, count> Indices;
         Array<number> Distances(Vertices.n());
         Array<count> Previous(Vertices.n());
         PriorityQueue<count, number> PriorityVertices;
         Array<bool> Scanned(Vertices.n());
         count EndIndex = 0;
 
+        Indices.Reserve(Vertices.n());
         for(count i = 0; i < Vertices.n(); i++)
         {
           PriorityVertices.AddWithPriority(i, (Distances[i] =
@@ -1344,8 +1809,8 @@ namespace PRIM_NAMESPACE
     if no root has been set or if the root node was deleted.*/
     typename Pointer<Object>::Weak RootNode;
 
-    ///Tree of all the nodes in the graph.
-    Tree<Pointer<Object>, bool> NodeTree;
+    ///Set of all the nodes in the graph.
+    HashSet<Pointer<Object> > NodeSet;
   };
 
   /**A basic label container for a GraphT node or edge. As long as the below
@@ -1399,6 +1864,14 @@ namespace PRIM_NAMESPACE
       return Data == EdgeType.Data;
     }
 
+    /**Returns the kind of edge that the label describes. GraphT groups the
+    edges of each node by kind so that a traversal with a filter of nonzero kind
+    only has to visit the edges of that kind. Any edge that is edge-equivalent
+    to such a filter must then have the same kind. Zero means that the label
+    has no kind, and a filter of kind zero is checked against every edge. The
+    default is to give no kind.*/
+    uint64 EdgeKind() const {return 0;}
+
     /**Indicates the cost of the label for shortest-path finding. The default
     is to treat all costs as the same.*/
     number Cost() const {return 1.0;}
@@ -0,0 +1,589 @@
+/*
+  ==============================================================================
+
+  Copyright 2007-2013, 2017 Andi
+  Copyright 2013-2016 Robert Taub
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+
+  ==============================================================================
+*/
+
+
+#ifndef PRIM_INCLUDE_HASH_MAP_H
+#define PRIM_INCLUDE_HASH_MAP_H
+
+#ifndef PRIM_LIBRARY
+#error This file can not be included individually. Include prim.h instead.
+#endif
+
+namespace PRIM_NAMESPACE
+{
+  ///Helpers shared by the Hash specializations.
+  class HashFunction
+  {
+    public:
+
+    /**Scrambles the bits of a 64-bit integer so that nearby inputs (such as
+    consecutive integers or aligned addresses) spread over the whole range. This
+    is the finalizer of the SplitMix64 generator.*/
+    static uint64 Mix(uint64 x)
+    {
+      const uint64 a = (uint64(0xbf58476dU) << 32) | uint64(0x1ce4e5b9U);
+      const uint64 b = (uint64(0x94d049bbU) << 32) | uint64(0x133111ebU);
+      x ^= x >> 30, x *= a;
+      x ^= x >> 27, x *= b;
+      x ^= x >> 31;
+      return x;
+    }
+
+    ///Hashes a run of bytes using 64-bit FNV-1a.
+    static uint64 Bytes(const byte* Data, count Length)
+    {
+      const uint64 Prime = (uint64(0x100U) << 32) | uint64(0x1b3U);
+      uint64 h = (uint64(0xcbf29ce4U) << 32) | uint64(0x84222325U);
+      for(count i = 0; i < Length; i++)
+        h ^= uint64(Data[i]), h *= Prime;
+      return h;
+    }
+  };
+
+  /**Hash function for a key type. Each supported key type specializes this
+  class with a static Of() method returning a 64-bit hash. Types without a
+  specialization can not be used as HashMap keys.*/
+  template <class T> class Hash;
+
+#define PRIM_HASH_INTEGER(T) \
+  template <> class Hash<T> \
+  { \
+    public: \
+    static uint64 Of(T x) {return HashFunction::Mix(uint64(x));} \
+  };
+  PRIM_HASH_INTEGER(int8)
+  PRIM_HASH_INTEGER(uint8)
+  PRIM_HASH_INTEGER(int16)
+  PRIM_HASH_INTEGER(uint16)
+  PRIM_HASH_INTEGER(int32)
+  PRIM_HASH_INTEGER(uint32)
+  PRIM_HASH_INTEGER(int64)
+  PRIM_HASH_INTEGER(uint64)
+#undef PRIM_HASH_INTEGER
+
+  ///Hashes a raw pointer by its address.
+  template <class T> class Hash<T*>
+  {
+    public:
+    static uint64 Of(const T* x) {return HashFunction::Mix(uint64(uintptr(x)));}
+  };
+
+  ///Hashes a reference-counted pointer by the address of the owned object.
+  template <class T> class Hash<Pointer<T> >
+  {
+    public:
+    static uint64 Of(const Pointer<T>& x)
+    {
+      return HashFunction::Mix(uint64(uintptr(x.Raw())));
+    }
+  };
+
+  ///Hashes a string by its UTF-8 bytes.
+  template <> class Hash<String>
+  {
+    public:
+    static uint64 Of(const String& x)
+    {
+      return HashFunction::Bytes(reinterpret_cast<const byte*>(x.Merge()),
+        x.n());
+    }
+  };
+
+  /**Hash map using open addressing with linear probing. All key-values live in
+  a single flat slot array whose capacity is a power of two, so a lookup is
+  usually one hash and one or two adjacent slot comparisons. Unlike Tree, the
+  iteration order is unspecified and may change whenever the map grows, so use
+  Tree when the keys need to be visited in order.
+
+  The key type must have a Hash specialization and an == operator. Removed
+  slots are reset to the Nothing values of the key and value types so that
+  reference-counted keys and values are released immediately.*/
+  template <class K, class V>
+  class HashMap
+  {
+    ///Slot states
+    enum SlotState
+    {
+      Vacant = 0,
+      Full,
+      Removed
+    };
+
+    ///Stores a key-value and its slot state.
+    class Slot
+    {
+      public:
+
+      ///Stores the key.
+      K Key; PRIM_PAD(K)
+
+      ///Stores the value.
+      V Value; PRIM_PAD(V)
+
+      ///Stores the slot state.
+      byte State;
+
+      ///Creates an empty slot.
+      Slot() : Key(EmptyKey()), Value(EmptyValue()), State(Vacant) {}
+    };
+
+    ///Slot array whose size is Capacity
+    Slot* Slots;
+
+    ///Number of slots (zero or a power of two)
+    count Capacity;
+
+    ///Number of full slots
+    count Elements;
+
+    ///Number of removed slots that still interrupt probe sequences
+    count Tombstones;
+
+    ///Empty value to return when a key does not exist.
+    V EmptyValueObject; PRIM_PAD(V)
+
+    ///Returns the value being used for an empty key.
+    static K EmptyKey()
+    {
+      return Nothing<K>();
+    }
+
+    ///Returns the value being used for an empty value.
+    static V EmptyValue()
+    {
+      return Nothing<V>();
+    }
+
+    ///Returns the first slot to probe for a key.
+    count Home(const K& Key) const
+    {
+      return count(Hash<K>::Of(Key) & uint64(Capacity - 1));
+    }
+
+    ///Returns the slot index of the key or -1 if it does not exist.
+    count Find(const K& Key) const
+    {
+      if(not Elements)
+        return -1;
+      for(count i = Home(Key); ; i = (i + 1) & (Capacity - 1))
+      {
+        const Slot& s = Slots[i];
+        if(s.State == Vacant)
+          return -1;
+        if(s.State == Full and s.Key == Key)
+          return i;
+      }
+    }
+
+    /**Reallocates the slot array with a new capacity and reinserts the full
+    slots, dropping any tombstones.*/
+    void Rehash(count NewCapacity)
+    {
+      Slot* OldSlots = Slots;
+      count OldCapacity = Capacity;
+      Slots = NewCapacity ? new Slot[NewCapacity] : 0;
+      Capacity = NewCapacity;
+      Tombstones = 0;
+      for(count i = 0; i < OldCapacity; i++)
+      {
+        Slot& Old = OldSlots[i];
+        if(Old.State != Full)
+          continue;
+        count j = Home(Old.Key);
+        while(Slots[j].State != Vacant)
+          j = (j + 1) & (Capacity - 1);
+#ifdef PRIM_11
+        Slots[j].Key = Move(Old.Key);
+        Slots[j].Value = Move(Old.Value);
+#else
+        Slots[j].Key = Old.Key;
+        Slots[j].Value = Old.Value;
+#endif
+        Slots[j].State = Full;
+      }
+      delete [] OldSlots;
+    }
+
+    ///Returns the smallest capacity that holds the elements below the load.
+    static count CapacityFor(count ElementsToHold)
+    {
+      count NewCapacity = 8;
+      while(NewCapacity * 3 <= ElementsToHold * 4)
+        NewCapacity *= 2;
+      return NewCapacity;
+    }
+
+    ///Returns the slot of the key, inserting an empty value if necessary.
+    count Insert(const K& Key)
+    {
+      //Keep full and removed slots under three-quarters of the capacity.
+      if((Elements + Tombstones + 1) * 4 > Capacity * 3)
+        Rehash(CapacityFor(Elements + 1));
+
+      count FirstRemoved = -1;
+      count i = Home(Key);
+      for(; Slots[i].State != Vacant; i = (i + 1) & (Capacity - 1))
+      {
+        if(Slots[i].State == Full and Slots[i].Key == Key)
+          return i;
+        if(Slots[i].State == Removed and FirstRemoved < 0)
+          FirstRemoved = i;
+      }
+
+      //Reuse the first tombstone of the probe sequence if there was one.
+      if(FirstRemoved >= 0)
+        i = FirstRemoved, Tombstones--;
+      Slots[i].Key = Key;
+      Slots[i].State = Full;
+      Elements++;
+      return i;
+    }
+
+    ///Deep-copies the slots of another map.
+    void CopyFrom(const HashMap& Other)
+    {
+      RemoveAll();
+      if(not Other.Elements)
+        return;
+      Slots = new Slot[Other.Capacity];
+      Capacity = Other.Capacity;
+      Elements = Other.Elements;
+      Tombstones = Other.Tombstones;
+      for(count i = 0; i < Capacity; i++)
+        Slots[i] = Other.Slots[i];
+    }
+
+    public:
+
+    ///Creates an empty map.
+    HashMap() : Slots(0), Capacity(0), Elements(0), Tombstones(0),
+      EmptyValueObject(EmptyValue()) {}
+
+    ///Removes all elements and destroys the map.
+    ~HashMap() {delete [] Slots;}
+
+    ///Copy-constructor that creates a deep-copy of another map.
+    HashMap(const HashMap& Other) : Slots(0), Capacity(0), Elements(0),
+      Tombstones(0), EmptyValueObject(EmptyValue())
+    {
+      CopyFrom(Other);
+    }
+
+    ///Assignment operator creates a deep-copy of another map.
+    HashMap& operator = (const HashMap& Other)
+    {
+      if(&Other != this)
+        CopyFrom(Other);
+      return *this;
+    }
+
+#ifdef PRIM_11
+    ///Move constructor takes over the slots of the other map.
+    HashMap(HashMap&& Other) noexcept : Slots(Other.Slots),
+      Capacity(Other.Capacity), Elements(Other.Elements),
+      Tombstones(Other.Tombstones), EmptyValueObject(EmptyValue())
+    {
+      Other.Slots = 0;
+      Other.Capacity = Other.Elements = Other.Tombstones = 0;
+    }
+
+    ///Move assignment removes the current slots and takes over the other's.
+    HashMap& operator = (HashMap&& Other) noexcept
+    {
+      if(&Other != this)
+      {
+        delete [] Slots;
+        Slots = Other.Slots, Other.Slots = 0;
+        Capacity = Other.Capacity, Other.Capacity = 0;
+        Elements = Other.Elements, Other.Elements = 0;
+        Tombstones = Other.Tombstones, Other.Tombstones = 0;
+      }
+      return *this;
+    }
+#endif
+
+    ///Returns whether the maps have identical key-value pairs.
+    bool operator == (const HashMap& Other) const
+    {
+      if(Elements != Other.Elements)
+        return false;
+      for(count i = 0; i < Capacity; i++)
+      {
+        if(Slots[i].State != Full)
+          continue;
+        count j = Other.Find(Slots[i].Key);
+        if(j < 0 or Other.Slots[j].Value != Slots[i].Value)
+          return false;
+      }
+      return true;
+    }
+
+    ///Returns whether the maps do not have identical key-value pairs.
+    bool operator != (const HashMap& Other) const
+    {
+      return not (*this == Other);
+    }
+
+    ///Determines whether the key exists in the map.
+    bool Contains(const K& Key) const
+    {
+      return Find(Key) >= 0;
+    }
+
+    ///Returns whether the map is empty.
+    bool Empty() const
+    {
+      return not Elements;
+    }
+
+    /**Gets the value at a given key. If the key does not exist, the Nothing
+    value for the value type is returned.*/
+    const V& Get(const K& Key) const
+    {
+      count i = Find(Key);
+      return i >= 0 ? Slots[i].Value : EmptyValueObject;
+    }
+
+    ///Sets a key-value.
+    void Set(const K& Key, const V& Value)
+    {
+      count i = Insert(Key);
+      Slots[i].Value = Value;
+    }
+
+    ///Lazily sets a key-value.
+    V& Set(const K& Key)
+    {
+      //Insert first since it may reallocate the slots.
+      count i = Insert(Key);
+      return Slots[i].Value;
+    }
+
+    /**Returns the value at a given key. If the key does not exist, the Nothing
+    value for the value type is returned.*/
+    const V& operator [] (const K& Key) const {return Get(Key);}
+
+    /**Lazily sets a key-value. The initial value for new keys is the Nothing
+    value for the value type.*/
+    V& operator [] (const K& Key) {return Set(Key);}
+
+    ///Returns the number of elements in the map.
+    count n() const
+    {
+      return Elements;
+    }
+
+    ///Returns the number of slots currently allocated.
+    count SlotCount() const
+    {
+      return Capacity;
+    }
+
+    ///Allocates enough slots to hold a number of elements without growing.
+    void Reserve(count ElementsToHold)
+    {
+      if((ElementsToHold + Tombstones) * 4 > Capacity * 3)
+        Rehash(CapacityFor(Max(ElementsToHold, Elements)));
+    }
+
+    ///Removes an element by key. If the key does not exist, no change is made.
+    void Remove(const K& Key)
+    {
+      count i = Find(Key);
+      if(i < 0)
+        return;
+      Slots[i].Key = EmptyKey();
+      Slots[i].Value = EmptyValue();
+      Slots[i].State = Removed;
+      Elements--, Tombstones++;
+    }
+
+    ///Removes all of the elements from the map and releases the slots.
+    void RemoveAll()
+    {
+      delete [] Slots;
+      Slots = 0;
+      Capacity = Elements = Tombstones = 0;
+    }
+
+    ///Fills an array with the keys of the map in iteration order.
+    void Keys(Array<K>& KeyArray) const
+    {
+      KeyArray.n(Elements);
+      count k = 0;
+      for(count i = 0; i < Capacity; i++)
+        if(Slots[i].State == Full)
+          KeyArray[k++] = Slots[i].Key;
+    }
+
+    ///Fills an array with the values of the map in iteration order.
+    void Values(Array<V>& ValueArray) const
+    {
+      ValueArray.n(Elements);
+      count k = 0;
+      for(count i = 0; i < Capacity; i++)
+        if(Slots[i].State == Full)
+          ValueArray[k++] = Slots[i].Value;
+    }
+
+    //Give the iterator direct access to the slots.
+    friend class Iterator;
+
+    /**Sequential iterator for the HashMap class. The map must not be modified
+    while it is being iterated.*/
+    class Iterator
+    {
+      ///Map being iterated
+      const HashMap* Map;
+
+      ///Index of the current slot
+      count Index;
+
+      ///Moves to the next full slot at or after the given index.
+      void Seek(count i)
+      {
+        while(i < Map->Capacity and Map->Slots[i].State != Full)
+          i++;
+        Index = i;
+      }
+
+      public:
+
+      ///Creates an empty iterator.
+      Iterator() : Map(0), Index(0) {}
+
+      ///Begins iterating a given map.
+      void Begin(const HashMap& M)
+      {
+        Map = &M;
+        Seek(0);
+      }
+
+      ///Returns true if there are no more elements to visit.
+      bool Ending() const
+      {
+        return not Map or Index >= Map->Capacity;
+      }
+
+      ///Returns true if there are still elements to visit.
+      bool Iterating() const
+      {
+        return not Ending();
+      }
+
+      ///Moves to the next element.
+      void Next()
+      {
+        if(Iterating())
+          Seek(Index + 1);
+      }
+
+      ///Returns the key of the current element.
+      const K& Key() const
+      {
+        return Map->Slots[Index].Key;
+      }
+
+      ///Returns the value of the current element.
+      const V& Value() const
+      {
+        return Map->Slots[Index].Value;
+      }
+    };
+  };
+
+  /**Hash set using open addressing. This is a HashMap whose values are unused;
+  see HashMap for the requirements on the key type.*/
+  template <class K>
+  class HashSet
+  {
+    ///Map from each key to true
+    HashMap<K, bool> Map;
+
+    public:
+
+    ///Returns whether the sets contain the same keys.
+    bool operator == (const HashSet& Other) const {return Map == Other.Map;}
+
+    ///Returns whether the sets do not contain the same keys.
+    bool operator != (const HashSet& Other) const {return Map != Other.Map;}
+
+    ///Adds a key to the set.
+    void Add(const K& Key) {Map.Set(Key) = true;}
+
+    ///Determines whether the key exists in the set.
+    bool Contains(const K& Key) const {return Map.Contains(Key);}
+
+    ///Returns whether the set is empty.
+    bool Empty() const {return Map.Empty();}
+
+    ///Returns the number of keys in the set.
+    count n() const {return Map.n();}
+
+    ///Allocates enough slots to hold a number of keys without growing.
+    void Reserve(count KeysToHold) {Map.Reserve(KeysToHold);}
+
+    ///Removes a key. If the key does not exist, no change is made.
+    void Remove(const K& Key) {Map.Remove(Key);}
+
+    ///Removes all of the keys from the set.
+    void RemoveAll() {Map.RemoveAll();}
+
+    ///Fills an array with the keys of the set in iteration order.
+    void Keys(Array<K>& KeyArray) const {Map.Keys(KeyArray);}
+
+    /**Sequential iterator for the HashSet class. The set must not be modified
+    while it is being iterated.*/
+    class Iterator
+    {
+      ///Iterator of the underlying map
+      typename HashMap<K, bool>::Iterator It;
+
+      public:
+
+      ///Begins iterating a given set.
+      void Begin(const HashSet& S) {It.Begin(S.Map);}
+
+      ///Returns true if there are no more keys to visit.
+      bool Ending() const {return It.Ending();}
+
+      ///Returns true if there are still keys to visit.
+      bool Iterating() const {return It.Iterating();}
+
+      ///Moves to the next key.
+      void Next() {It.Next();}
+
+      ///Returns the current key.
+      const K& Key() const {return It.Key();}
+    };
+  };
+}
+#endif
@@ -46,6 +46,7 @@ are the portable headers. Non-portable or compiler-specific headers are included
 in modules instead.*/
 #include <cctype>
 #include <climits>
+#include <clocale>
 #include <cmath>
 #include <cstdarg>
 #include <cstddef>
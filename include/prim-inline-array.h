@@ -0,0 +1,333 @@
+/*
+  ==============================================================================
+
+  Copyright 2007-2013, 2017 Andi
+  Copyright 2013-2016 Robert Taub
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+
+  ==============================================================================
+*/
+
+
+#ifndef PRIM_INCLUDE_INLINE_ARRAY_H
+#define PRIM_INCLUDE_INLINE_ARRAY_H
+
+#ifndef PRIM_LIBRARY
+#error This file can not be included individually. Include prim.h instead.
+#endif
+
+namespace PRIM_NAMESPACE
+{
+  /**Array that stores its first N elements inline. Short arrays never touch
+  the heap; once the array outgrows the inline buffer, the elements move to a
+  heap block that grows by doubling. The elements are always contiguous.
+
+  Unlike Array, shrinking or clearing keeps the current storage so that the
+  same buffer can be refilled in a loop without reallocating. Elements that
+  fall outside the apparent size are reset to their default value so that any
+  resources they hold are released.*/
+  template <class T, count N>
+  class InlineArray
+  {
+    ///Inline storage for the first N elements
+    T Inline[N];
+
+    ///Heap storage once the array has outgrown the inline buffer, or null
+    T* Heap;
+
+    ///Number of elements in the array
+    count ApparentSize;
+
+    ///Number of elements that fit in the current storage
+    count RealSize;
+
+    ///Empty item in case of bad access.
+    mutable T Empty; PRIM_PAD(T)
+
+    ///Returns the current storage.
+    T* Data() {return Heap ? Heap : Inline;}
+
+    ///Returns the current const storage.
+    const T* Data() const {return Heap ? Heap : Inline;}
+
+    ///Resets the elements in a range to their default value.
+    void Reset(count Start, count End)
+    {
+      T* d = Data();
+      for(count i = Start; i < End; i++)
+        d[i] = T();
+    }
+
+    ///Copies the elements of another inline array.
+    void CopyFrom(const InlineArray& Other)
+    {
+      n(Other.ApparentSize);
+      T* d = Data();
+      const T* o = Other.Data();
+      for(count i = 0; i < ApparentSize; i++)
+        d[i] = o[i];
+    }
+
+    public:
+
+    ///Creates an empty array using the inline storage.
+    InlineArray() : Heap(0), ApparentSize(0), RealSize(N) {}
+
+    ///Creates a copy of another inline array.
+    InlineArray(const InlineArray& Other) : Heap(0), ApparentSize(0),
+      RealSize(N)
+    {
+      CopyFrom(Other);
+    }
+
+    ///Assigns a copy of another inline array.
+    InlineArray& operator = (const InlineArray& Other)
+    {
+      if(&Other != this)
+        CopyFrom(Other);
+      return *this;
+    }
+
+#ifdef PRIM_11
+    /**Move constructor takes over the heap storage of the other array, or moves
+    the elements if the other array is using its inline storage.*/
+    InlineArray(InlineArray&& Other) noexcept : Heap(0), ApparentSize(0),
+      RealSize(N)
+    {
+      *this = Move(Other);
+    }
+
+    /**Move assignment takes over the heap storage of the other array, or moves
+    the elements if the other array is using its inline storage. The other array
+    is left empty.*/
+    InlineArray& operator = (InlineArray&& Other) noexcept
+    {
+      if(&Other == this)
+        return *this;
+      if(Other.Heap)
+      {
+        Clear();
+        delete [] Heap;
+        Heap = Other.Heap, Other.Heap = 0;
+        ApparentSize = Other.ApparentSize, Other.ApparentSize = 0;
+        RealSize = Other.RealSize, Other.RealSize = N;
+      }
+      else
+      {
+        n(Other.ApparentSize);
+        T* d = Data();
+        for(count i = 0; i < ApparentSize; i++)
+          d[i] = Move(Other.Inline[i]);
+        Other.n(0);
+      }
+      return *this;
+    }
+#endif
+
+    ///Releases the heap storage if any.
+    ~InlineArray() {delete [] Heap;}
+
+    //--------------//
+    //Element Access//
+    //--------------//
+
+    /**Returns the i-th element by index. If the index is out-of-bounds an empty
+    value is returned.*/
+    inline T& ith(count i)
+    {
+      if(uint64(i) >= uint64(ApparentSize))
+      {
+        Empty = Nothing<T>();
+        return Empty;
+      }
+      return Data()[i];
+    }
+
+    /**Returns the i-th const element by index. If the index is out-of-bounds an
+    empty value is returned.*/
+    inline const T& ith(count i) const
+    {
+      if(uint64(i) >= uint64(ApparentSize))
+      {
+        Empty = Nothing<T>();
+        return Empty;
+      }
+      return Data()[i];
+    }
+
+    ///Returns the indexed element. Internally inlines ith().
+    inline T& operator [] (count i) {return ith(i);}
+
+    ///Returns the const indexed element. Internally inlines ith().
+    inline const T& operator [] (count i) const {return ith(i);}
+
+    ///Returns the first element.
+    inline T& a() {return ith(0);}
+
+    ///Returns the first const element.
+    inline const T& a() const {return ith(0);}
+
+    ///Returns the last element or an element with respect to the last.
+    inline T& z(count ItemsFromEnd = 0)
+    {
+      return ith(ApparentSize - 1 - ItemsFromEnd);
+    }
+
+    ///Returns the last const element or an element with respect to the last.
+    inline const T& z(count ItemsFromEnd = 0) const
+    {
+      return ith(ApparentSize - 1 - ItemsFromEnd);
+    }
+
+    //----//
+    //Size//
+    //----//
+
+    ///Returns the size of the array.
+    inline count n() const {return ApparentSize;}
+
+    /**Sets the size of the array. New elements have their default value. If the
+    new size does not fit the current storage, then the elements are moved to a
+    larger heap block.*/
+    void n(count NewSize)
+    {
+      if(NewSize < 0)
+        NewSize = 0;
+      if(NewSize < ApparentSize)
+        Reset(NewSize, ApparentSize);
+      else if(NewSize > RealSize)
+        Reserve(NewSize);
+      ApparentSize = NewSize;
+    }
+
+    ///Returns the number of elements that fit without reallocating.
+    count Capacity() const {return RealSize;}
+
+    ///Returns whether the elements are still stored inline.
+    bool IsInline() const {return not Heap;}
+
+    ///Ensures that a number of elements fit without reallocating.
+    void Reserve(count Elements)
+    {
+      if(Elements <= RealSize)
+        return;
+      count NewRealSize = Max(Elements, RealSize * 2);
+      T* NewHeap = new T[NewRealSize];
+      T* d = Data();
+      for(count i = 0; i < ApparentSize; i++)
+      {
+#ifdef PRIM_11
+        NewHeap[i] = Move(d[i]);
+#else
+        NewHeap[i] = d[i];
+#endif
+        d[i] = T();
+      }
+      delete [] Heap;
+      Heap = NewHeap;
+      RealSize = NewRealSize;
+    }
+
+    /**Removes all the elements while keeping the current storage. The return
+    value is always false to match Array::Clear().*/
+    bool Clear()
+    {
+      n(0);
+      return false;
+    }
+
+    ///Removes all the elements while keeping the current storage.
+    void RemoveAll() {Clear();}
+
+    //------//
+    //Adding//
+    //------//
+
+    ///Adds an element to the array and returns a reference to that element.
+    T& Add()
+    {
+      n(ApparentSize + 1);
+      return Data()[ApparentSize - 1];
+    }
+
+    ///Adds a copy of an element to the array.
+    void Add(const T& NewElement)
+    {
+      if(ApparentSize == RealSize)
+      {
+        //The element may belong to this array, so copy it before growing.
+        T Copy = NewElement;
+        Add() = Copy;
+      }
+      else
+        Add() = NewElement;
+    }
+
+    ///Alias for Add
+    void Push(const T& NewElement) {Add(NewElement);}
+
+    ///Removes the last element and returns it.
+    T Pop()
+    {
+      T Copy = Nothing<T>();
+      if(ApparentSize)
+      {
+#ifdef PRIM_11
+        Copy = Move(z());
+#else
+        Copy = z();
+#endif
+        n(ApparentSize - 1);
+      }
+      return Copy;
+    }
+
+    //---------//
+    //Searching//
+    //---------//
+
+    ///Returns index of first element matching key or -1 if there is no match.
+    count Search(const T& Key) const
+    {
+      const T* d = Data();
+      for(count i = 0; i < ApparentSize; i++)
+        if(d[i] == Key)
+          return i;
+      return -1;
+    }
+
+    ///Returns whether the array contains the key.
+    bool Contains(const T& Key) const
+    {
+      return Search(Key) != -1;
+    }
+
+    ///Copies the elements into an Array.
+    void CopyTo(Array<T>& Other) const
+    {
+      Other.CopyFrom(Data(), ApparentSize);
+    }
+  };
+}
+#endif
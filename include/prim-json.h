@@ -109,6 +109,11 @@ namespace PRIM_NAMESPACE
       return Is<C>(unicode(a));
     }
 
+    template <JSONCharacter C> static bool Is(byte b)
+    {
+      return Is<C>(unicode(b));
+    }
+
     /**This method is templated based on the JSON character type to allow for
     the compiler to statically optimize away the switch.*/
     template <JSONCharacter C> static bool Is(unicode u)
@@ -208,246 +213,259 @@ namespace PRIM_NAMESPACE
       return false;
     }
 
-    ///Possible states during parse
-    enum JSONParseState
+
+    public:
+
+    //------//
+    //Events//
+    //------//
+
+    /**Receives the events of a JSON parse in document order. Each event
+    returns whether the parse should continue, so a handler may stop early by
+    returning false. Keys and strings are passed as views that are only valid
+    for the duration of the call: when the text has no escapes the view refers
+    to the JSON data itself, and otherwise to a scratch buffer.*/
+    class Handler
     {
-      Beginning,
-      WaitingForFirstValue,
-      WaitingForName,
-      WaitingForValue,
-      WaitingForNameSeparator,
-      WaitingForArrayEnd,
-      WaitingForObjectEnd,
-      ValueFalse2,
-      ValueFalse3,
-      ValueFalse4,
-      ValueFalse5,
-      ValueNull2,
-      ValueNull3,
-      ValueNull4,
-      ValueTrue2,
-      ValueTrue3,
-      ValueTrue4,
-      Ending,
-      Abort
-    };
+      public:
+
+      ///Virtual destructor
+      virtual ~Handler() {}
+
+      ///Called when an object begins.
+      virtual bool OnBeginObject() {return true;}
+
+      ///Called when an object ends.
+      virtual bool OnEndObject() {return true;}
+
+      ///Called when an array begins.
+      virtual bool OnBeginArray() {return true;}
+
+      ///Called when an array ends.
+      virtual bool OnEndArray() {return true;}
 
-    //Give friendship to the Nothing since JSONParseState is private.
-    friend class Nothing<JSON::JSONParseState>;
+      ///Called with the name of the next value in an object.
+      virtual bool OnKey(const StringView&) {return true;}
 
-    ///Stores the entire state of the parser.
-    class JSONParseContext
+      ///Called for a string value.
+      virtual bool OnString(const StringView&) {return true;}
+
+      /**Called for a number that has no decimal point and is exactly
+      representable as an integer. By default it is passed on to OnNumber().*/
+      virtual bool OnInteger(integer x) {return OnNumber(number(x));}
+
+      ///Called for any other number.
+      virtual bool OnNumber(number) {return true;}
+
+      ///Called for true and false.
+      virtual bool OnBoolean(bool) {return true;}
+
+      ///Called for null.
+      virtual bool OnNull() {return true;}
+    };
+
+    /**Builds a Value from parse events. This is the handler used by Import(),
+    and other handlers may forward the events of a subtree to one of these to
+    collect only that part of the document as a Value.*/
+    class ValueBuilder : public Handler
     {
+      ///The value being built
+      Value& Root;
+
+      ///The containers that are currently open
+      List<Value*> Stack;
+
+      ///The key of the next value in the innermost object
+      Value Key;
+
+      ///Whether the root value has been started
+      bool Started; Pad<bool> Started_padding;
+
       public:
 
-      const byte* Start;
-      const byte* s;
-      const byte* p;
-      const byte* e;
-      unicode d; Pad<unicode> d_padding;
-      Value* v;
-      JSONParseState State; Pad<JSONParseState> State_padding;
-      Value StateValueDummy;
+      ///Describes why the builder stopped the parse.
       String ErrorInfo;
-      List<Value*> Stack;
-      List<Value> StackKeys;
-      List<JSONParseState> States;
 
-      JSONParseContext() : s(0), p(0), e(0), d(0), v(0), State(Beginning) {}
+      ///Creates a builder that clears and then fills the given value.
+      ValueBuilder(Value& Target) : Root(Target), Started(false)
+      {
+        Root.Clear();
+      }
 
-      ///Returns error string for the current state and updates the error info.
-      String GetErrorString()
+      ///Returns whether a complete value has been built.
+      bool Finished() const
       {
-        if(State != Abort)
-        {
-          ErrorInfo = "Value Stack: ";
-          ErrorInfo << Stack.n() << ", Parse Stack: " << States.n();
-          return "JSON parser encountered unterminated values";
-        }
-        else if(not ErrorInfo)
-          ErrorInfo = "Unexpected character";
-        String Snippet;
-        Snippet << reinterpret_cast<const ascii*>(s - 1);
-        Snippet.Erase(60, Snippet.n() - 1);
-        Snippet.Replace("\n", " ");
-        String ErrorString;
-        ErrorString << "JSON parser aborted at '" << Snippet <<
-          "' (character " << integer(s - Start - 1) << ")";
-        return ErrorString;
+        return Started and not Stack.n();
       }
-    };
 
-    //Chomps the a JSON string.
-    static bool ChompString(JSONParseContext& C)
-    {
-      bool Escaped = false;
-      unicode SurrogateLead = 0;
-      String Text;
-
-      //First check for a vanilla string so that it can be copied efficiently.
-      bool IsVanillaString = true;
-      {
-        const byte* s = C.s;
-        const byte* e = C.e;
-        const byte* LastSeen = s;
-        unicode d;
-        while(IsVanillaString && s < e && (d = String::Decode(s, e)) != 0)
-        {
-          if(Is<Escape>(d))
-            IsVanillaString = false;
-          else if(Is<QuotationMark>(d))
-            break;
-          else
-            LastSeen = s;
-        }
+      bool OnBeginObject()
+      {
+        Value* v = Next();
+        if(not v)
+          return false;
+        Stack.Push(&v->NewTree());
+        return true;
+      }
 
-        if(IsVanillaString)
-          Text.Append(C.s, count(LastSeen - C.s));
+      bool OnEndObject()
+      {
+        Stack.Pop();
+        return true;
       }
 
-      while(C.s < C.e && (C.d = String::Decode(C.s, C.e)) != 0)
+      bool OnBeginArray()
       {
-        if(not Escaped)
+        Value* v = Next();
+        if(not v)
+          return false;
+        Stack.Push(&v->NewArray());
+        return true;
+      }
+
+      bool OnEndArray()
+      {
+        CoerceSpecialType(*Stack.Pop());
+        return true;
+      }
+
+      bool OnKey(const StringView& Text)
+      {
+        SetText(Key, Text);
+        return true;
+      }
+
+      bool OnString(const StringView& Text)
+      {
+        Value* v = Next();
+        if(v)
+          SetText(*v, Text);
+        return v != 0;
+      }
+
+      bool OnInteger(integer x)
+      {
+        Value* v = Next();
+        if(v)
+          *v = x;
+        return v != 0;
+      }
+
+      bool OnNumber(number x)
+      {
+        Value* v = Next();
+        if(v)
+          *v = x;
+        return v != 0;
+      }
+
+      bool OnBoolean(bool x)
+      {
+        Value* v = Next();
+        if(v)
+          *v = x;
+        return v != 0;
+      }
+
+      bool OnNull()
+      {
+        return Next() != 0;
+      }
+
+      private:
+
+      /**Returns the location of the next value, or null if the key of the next
+      value has already been defined.*/
+      Value* Next()
+      {
+        if(not Stack.n())
         {
-          if(Is<Escape>(C.d))
+          if(Started)
           {
-            C.p = C.s;
-            Escaped = true;
+            ErrorInfo = "Multiple root values";
+            return 0;
           }
-          else if(SurrogateLead)
-          {
-            C.s = C.p;
-            C.ErrorInfo = "Lead surrogate followed by unescaped character";
-            C.State = Abort;
-            break;
-          }
-          else if(Is<QuotationMark>(C.d))
-            break;
-          else if(not IsVanillaString)
-            Text << C.d;
+          Started = true;
+          return &Root;
         }
-        else
-        {
-          Escaped = false;
-          if(Is<EscapedCodepoint>(C.d))
-          {
-            unicode HexDigits[4] = {16, 16, 16, 16};
-            for(count i = 0; i < 4; i++)
-              if(C.s < C.e)
-                HexDigits[i] = Unicode::HexDigitValue(String::Decode(C.s, C.e));
 
-            if(HexDigits[0] < 16 and HexDigits[1] < 16 and
-              HexDigits[2] < 16 and HexDigits[3] < 16)
-            {
-              unicode u = (HexDigits[0] << 12) + (HexDigits[1] << 8) +
-                (HexDigits[2] << 4) + HexDigits[3];
+        Value& Top = *Stack.z();
+        if(Top.IsArray())
+          return &Top.Add();
 
-              if(Unicode::IsLeadSurrogate(u))
-              {
-                if(SurrogateLead)
-                {
-                  C.s = C.p;
-                  C.ErrorInfo = "Lead surrogate followed by lead surrogate";
-                  C.State = Abort;
-                  break;
-                }
-                else
-                  SurrogateLead = u;
-              }
-              else if(Unicode::IsTrailSurrogate(u))
-              {
-                if(not SurrogateLead)
-                {
-                  C.s = C.p;
-                  C.ErrorInfo = "Trail surrogate with no lead surrogate";
-                  C.State = Abort;
-                  break;
-                }
-                Text << Unicode::FromSurrogatePair(SurrogateLead, u);
-                SurrogateLead = 0;
-              }
-              else if(SurrogateLead)
-              {
-                C.s = C.p;
-                C.ErrorInfo = "Lead surrogate not followed by tail";
-                C.State = Abort;
-                break;
-              }
-              else
-                Text << u;
-            }
-            else
-            {
-              C.s = C.p;
-              C.ErrorInfo = "Non-hex digits in escaped Unicode character";
-              C.State = Abort;
-              break;
-            }
-          }
-          else if(SurrogateLead)
-          {
-            C.s = C.p;
-            C.ErrorInfo = "Lead surrogate not followed by \\uXXXX";
-            C.State = Abort;
-            break;
-          }
-          else if(Is<EscapedQuotationMark>(C.d))
-            Text << "\x22";
-          else if(Is<EscapedReverseSolidus>(C.d))
-            Text << "\\";
-          else if(Is<EscapedSolidus>(C.d))
-            Text << "/";
-          else if(Is<EscapedBackspace>(C.d))
-            Text << "\b";
-          else if(Is<EscapedFormFeed>(C.d))
-            Text << "\f";
-          else if(Is<EscapedLineFeed>(C.d))
-            Text << "\n";
-          else if(Is<EscapedCarriageReturn>(C.d))
-            Text << "\r";
-          else if(Is<EscapedTab>(C.d))
-            Text << "\t";
+        Value& Slot = Top[Key];
+        if(not Slot.IsNil())
+        {
+          ErrorInfo = "Key redefined: ";
+          ErrorInfo << Key;
+          return 0;
         }
+        return &Slot;
       }
-      if(C.State == Abort)
-        return false;
 
-      //Coerce to ratio if it is in the canonical form and non-empty.
-      Ratio TextAsRatio;
-      if(Text.Contains("/"))
+      ///Stores text, coercing it to a ratio if it is in the canonical form.
+      static void SetText(Value& v, const StringView& Text)
       {
-        TextAsRatio = Ratio::FromString(Text);
-        if(TextAsRatio.ToString() != Text)
-          TextAsRatio = Ratio();
+        String s = Text;
+        if(Text.Contains("/"))
+        {
+          Ratio TextAsRatio = Ratio::FromString(s);
+          if(not TextAsRatio.IsEmpty() and TextAsRatio.ToString() == s)
+          {
+            v = TextAsRatio;
+            return;
+          }
+        }
+#ifdef PRIM_11
+        v = Move(s);
+#else
+        v = s;
+#endif
       }
 
-      if(C.StackKeys.z().IsNil())
+      ///Coerces a tagged array to a vector or rectangle.
+      static void CoerceSpecialType(Value& v)
       {
-        if(TextAsRatio.IsEmpty())
-          C.StackKeys.z() = Text;
-        else
-          C.StackKeys.z() = TextAsRatio;
-      }
-      else
-      {
-        if(not (*C.v)[C.StackKeys.z()].IsNil())
-        {
-          C.ErrorInfo = "Key redefined: ";
-          C.ErrorInfo << C.StackKeys.z();
-          C.State = Abort;
-          return false;
-        }
-        if(TextAsRatio.IsEmpty())
-          (*C.v)[C.StackKeys.z()] = Text;
-        else
-          (*C.v)[C.StackKeys.z()] = TextAsRatio;
+        const Value& v_const = v;
+        if((v_const.n() != 3 and v_const.n() != 5) or
+          not v_const[0].IsString())
+            return;
+        if(v_const.n() == 3 and v_const[0].AsString() == "_JSONVector")
+          v = Vector(v_const[1].AsNumber(), v_const[2].AsNumber());
+        else if(v_const.n() == 5 and v_const[0].AsString() == "_JSONRectangle")
+          v = Box(
+            Vector(v_const[1].AsNumber(), v_const[2].AsNumber()),
+            Vector(v_const[3].AsNumber(), v_const[4].AsNumber()));
       }
-      C.State = C.States.Pop();
-      return true;
-    }
+    };
+
+    private:
+
+    //-------//
+    //Parsing//
+    //-------//
+
+    /*Parsing takes place in two stages. First, IndexStructure() finds the
+    position of every structural character outside of a string, every opening
+    quotation mark, and the first byte of every other scalar. It classifies 64
+    bytes at a time using SIMD comparisons where available, and it determines
+    which bytes are inside strings with a prefix-xor of the unescaped quotation
+    marks. Second, the Parser walks the index, validating the grammar and
+    sending events to a Handler. It never visits whitespace, and it finds the
+    end of a string with a vector search, only decoding the string character by
+    character if it contains escapes or invalid UTF-8.*/
+
+    /**Appends the byte positions of the structural characters to the index.
+    The index is assumed to be empty.*/
+    static void IndexStructure(const byte* Begin, const byte* End,
+      Array<count>& Index);
+
+    /**Classifies a block of 64 bytes by setting the bit for each byte that is
+    a quotation mark, backslash, operator, or whitespace.*/
+    static void ClassifyBlock(const byte* Block, uint64& Quote,
+      uint64& Backslash, uint64& Operator, uint64& Whitespace);
 
     ///Checks whether a number is formatted according to the specification.
-    static bool IsNumberCorrectlyFormatted(const ascii* n)
+    static bool IsNumberCorrectlyFormatted(const byte* n, const byte* End)
     {
       /* JSON specification for numbers:
       Number        = [ Minus ] Integer [ Fraction ] [ Exponent ]
@@ -463,23 +481,23 @@ namespace PRIM_NAMESPACE
       */
 
       //Check for optional minus sign.
-      if(Is<Minus>(*n))
+      if(n < End and Is<Minus>(*n))
         n++;
 
       //Chomp integer.
-      if(Is<Zero>(*n))
+      if(n < End and Is<Zero>(*n))
         n++;
-      else if(Is<Digit1To9>(*n))
+      else if(n < End and Is<Digit1To9>(*n))
       {
         n++;
-        while(Is<Digit>(*n))
+        while(n < End and Is<Digit>(*n))
           n++;
       }
       else
         return false;
 
       //If no more characters, then it is an integer.
-      if(not *n)
+      if(n == End)
         return true;
 
       //If next character is decimal, chomp the fraction.
@@ -489,15 +507,15 @@ namespace PRIM_NAMESPACE
         n++;
 
         //Next character must be a digit.
-        if(not Is<Digit>(*n++))
+        if(n == End or not Is<Digit>(*n++))
           return false;
 
         //Chomp remaining digits.
-        while(Is<Digit>(*n))
+        while(n < End and Is<Digit>(*n))
           n++;
 
         //If no more characters, then it is a simple decimal number.
-        if(not *n)
+        if(n == End)
           return true;
       }
 
@@ -506,314 +524,559 @@ namespace PRIM_NAMESPACE
         return false;
 
       //Next character must be plus or minus or a digit.
-      if(Is<Plus>(*n) or Is<Minus>(*n))
+      if(n < End and (Is<Plus>(*n) or Is<Minus>(*n)))
         n++; //Chomp the plus/minus
-      else if(not Is<Digit>(*n))
-        return false;
 
       //Next character must be a digit.
-      if(not Is<Digit>(*n++))
+      if(n == End or not Is<Digit>(*n++))
         return false;
 
       //Chomp remaining digits.
-      while(Is<Digit>(*n))
+      while(n < End and Is<Digit>(*n))
         n++;
 
-      //Final character must be null-terminator.
-      if(*n)
-        return false;
-
-      return true;
+      //Number must end at the end of the span.
+      return n == End;
     }
 
-    ///Chomps a JSON number.
-    static bool ChompNumeric(JSONParseContext& C)
+
+    ///Walks the structural index, validating the grammar and sending events.
+    class Parser
     {
-      /*Take advantage of the fact that only whitespace, comma, end bracket,
-      and end brace can follow a number. None of these characters are permitted
-      within a number, so the number can quickly be chomped according to the
-      character set for representing numbers.
-
-      To ensure that the number is correctly formatted, the
-      IsNumberCorrectlyFormatted() takes the chomped number and parses it
-      according to the actual specification.*/
-
-      //Chomp all the numeric characters.
-      String n;
-      bool ForceFloatingPoint = false;
-      n << C.d;
-      C.p = C.s;
-      while(C.s < C.e && (C.d = String::Decode(C.s, C.e)) != 0)
-      {
-        if(not Is<Numeric>(C.d))
-          break;
-        if(Is<DecimalPoint>(C.d))
-          ForceFloatingPoint = true; //If expressed with a . force as number.
-        n << C.d;
-        C.p = C.s; //Backup to avoid chomping beyond the number.
-      }
+      public:
 
-      //Validate the number according to the specification.
-      if(not IsNumberCorrectlyFormatted(n.Merge()))
+      ///Possible states during the parse
+      enum ParseState
       {
-        C.ErrorInfo = "Invalid number: ";
-        C.ErrorInfo << n;
-        C.State = Abort;
-        return false;
-      }
+        WaitingForRoot,
+        WaitingForFirstValue,
+        WaitingForValue,
+        WaitingForName,
+        WaitingForNameSeparator,
+        WaitingForValueEnd,
+        Ending
+      };
+
+      const byte* Begin;
+      const byte* End;
+      const byte* At;
+      Handler& Events;
+      ParseState State; Pad<ParseState> State_padding;
+      Array<byte> Nesting;
+      String Scratch;
+      String ErrorInfo;
+      bool Unterminated; Pad<bool> Unterminated_padding;
+
+      ///Creates a parser for the given range of bytes.
+      Parser(const byte* Begin_, const byte* End_, Handler& Events_) :
+        Begin(Begin_), End(End_), At(Begin_), Events(Events_),
+        State(WaitingForRoot), Unterminated(false) {}
 
-      //Store number as integer if it loses no precision.
-      number Result = n.ToNumber();
-      integer ResultAsInteger = integer(Result);
-      if(not (*C.v)[C.StackKeys.z()].IsNil())
+      ///Parses the document and returns whether it was valid.
+      bool Parse()
       {
-        C.ErrorInfo = "Key redefined: ";
-        C.ErrorInfo << C.StackKeys.z();
-        C.State = Abort;
+        Array<count> Index;
+        IndexStructure(Begin, End, Index);
+        for(count i = 0, n = Index.n(); i < n; i++)
+        {
+          At = Begin + Index[i];
+          if(not Step(*At))
+          {
+            if(not ErrorInfo)
+              ErrorInfo = "Stopped by handler";
+            return false;
+          }
+        }
+        At = End;
+        if(State == Ending)
+          return true;
+        ErrorInfo = "Open arrays and objects: ";
+        ErrorInfo << Nesting.n();
+        Unterminated = true;
         return false;
       }
-      if(not ForceFloatingPoint and
-        Limits<number>::IsEqual(Result, number(ResultAsInteger)))
-        (*C.v)[C.StackKeys.z()] = ResultAsInteger; //Number is an integer.
-      else
-        (*C.v)[C.StackKeys.z()] = Result; //Number is a floating-point.
 
-      //Revert the state.
-      C.State = C.States.Pop();
+      ///Returns the error string for the current state.
+      String GetErrorString() const
+      {
+        if(Unterminated)
+          return "JSON parser encountered unterminated values";
+        String Snippet;
+        Snippet.Append(At, Min(count(End - At), count(60)));
+        Snippet.Replace("\n", " ");
+        String ErrorString;
+        ErrorString << "JSON parser aborted at '" << Snippet <<
+          "' (character " << integer(At - Begin) << ")";
+        return ErrorString;
+      }
 
-      /*Back up to the previous character so that the outer while loop will
-      correctly continue with the first non-numeric character.*/
-      C.s = C.p;
+      private:
 
-      return true;
-    }
+      ///Records an error at the given position.
+      bool Fail(const byte* Where, const ascii* Info)
+      {
+        At = Where;
+        ErrorInfo = Info;
+        return false;
+      }
 
-    ///Chomps a JSON value.
-    static bool ChompValue(JSONParseContext& C)
-    {
-      if(Is<Whitespace>(C.d));
-      else if(Is<False1>(C.d))
+      ///Handles the next structural character.
+      bool Step(byte c)
       {
-        if(not (*C.v)[C.StackKeys.z()].IsNil())
+        switch(State)
         {
-          C.ErrorInfo = "Key redefined: ";
-          C.ErrorInfo << C.StackKeys.z();
-          C.State = Abort;
-          return false;
+        case WaitingForRoot:
+          if(not Is<BeginArray>(c) and not Is<BeginObject>(c))
+            return Fail(At, "Unexpected character");
+          return ChompValue(c);
+
+        case WaitingForFirstValue:
+          return Is<EndArray>(c) ? ChompEnd(c) : ChompValue(c);
+
+        case WaitingForValue:
+          return ChompValue(c);
+
+        case WaitingForName:
+          //A trailing value separator in an object is tolerated.
+          if(Is<EndObject>(c))
+            return ChompEnd(c);
+          return ChompName(c);
+
+        case WaitingForNameSeparator:
+          if(not Is<NameSeparator>(c))
+            return Fail(At, "Expected name-value separator");
+          State = WaitingForValue;
+          return true;
+
+        case WaitingForValueEnd:
+          if(Is<ValueSeparator>(c))
+          {
+            State = Is<BeginArray>(Nesting.z()) ? WaitingForValue :
+              WaitingForName;
+            return true;
+          }
+          else if(Is<EndArray>(c) or Is<EndObject>(c))
+            return ChompEnd(c);
+          return Fail(At, "Unexpected character");
+
+        case Ending:
+          break;
         }
-        (*C.v)[C.StackKeys.z()] = false;
-        C.State = ValueFalse2;
+        return Fail(At, "Unexpected character");
       }
-      else if(Is<Null1>(C.d))
+
+      ///Chomps the end of an array or object.
+      bool ChompEnd(byte c)
       {
-        if(not (*C.v)[C.StackKeys.z()].IsNil())
-        {
-          C.ErrorInfo = "Key redefined: ";
-          C.ErrorInfo << C.StackKeys.z();
-          C.State = Abort;
-          return false;
-        }
-        (*C.v)[C.StackKeys.z()].Clear();
-        C.State = ValueNull2;
+        if(Is<EndArray>(c) != Is<BeginArray>(Nesting.z()))
+          return Fail(At, "Unexpected character");
+        Nesting.Pop();
+        State = Nesting.n() ? WaitingForValueEnd : Ending;
+        return Is<EndArray>(c) ? Events.OnEndArray() : Events.OnEndObject();
       }
-      else if(Is<True1>(C.d))
+
+      ///Chomps the name of a name-value pair.
+      bool ChompName(byte c)
       {
-        if(not (*C.v)[C.StackKeys.z()].IsNil())
-        {
-          C.ErrorInfo = "Key redefined: ";
-          C.ErrorInfo << C.StackKeys.z();
-          C.State = Abort;
+        StringView Text;
+        if(not Is<QuotationMark>(c))
+          return Fail(At, "Expected name string");
+        if(not ChompString(Text))
           return false;
-        }
-        (*C.v)[C.StackKeys.z()] = true;
-        C.State = ValueTrue2;
+        State = WaitingForNameSeparator;
+        return Events.OnKey(Text);
       }
-      else if(Is<BeginArray>(C.d))
+
+      ///Chomps a value beginning with the given character.
+      bool ChompValue(byte c)
       {
-        if(not (*C.v)[C.StackKeys.z()].IsNil())
+        if(Is<BeginArray>(c))
         {
-          C.ErrorInfo = "Key redefined: ";
-          C.ErrorInfo << C.StackKeys.z();
-          C.State = Abort;
-          return false;
+          Nesting.Add(c);
+          State = WaitingForFirstValue;
+          return Events.OnBeginArray();
         }
-        (*C.v)[C.StackKeys.z()].NewArray();
-        C.Stack.Push(&(*C.v)[C.StackKeys.z()]);
-        C.State = WaitingForFirstValue;
-        C.StackKeys.Push(Value(0));
-        C.States.Push(WaitingForArrayEnd);
-      }
-      else if(Is<BeginObject>(C.d))
-      {
-        if(not (*C.v)[C.StackKeys.z()].IsNil())
+        else if(Is<BeginObject>(c))
         {
-          C.ErrorInfo = "Key redefined: ";
-          C.ErrorInfo << C.StackKeys.z();
-          C.State = Abort;
-          return false;
+          Nesting.Add(c);
+          State = WaitingForName;
+          return Events.OnBeginObject();
         }
-        (*C.v)[C.StackKeys.z()].NewTree();
-        C.Stack.Push(&(*C.v)[C.StackKeys.z()]);
-        C.State = WaitingForName;
-        C.StackKeys.Push(Value()); //Nil indicates to create new key.
-        C.States.Push(WaitingForObjectEnd);
-      }
-      else if(Is<QuotationMark>(C.d))
-      {
-        if(not ChompString(C))
-          return false;
-      }
-      else if(Is<Numeric>(C.d))
-      {
-        if(not ChompNumeric(C))
-          return false;
-      }
-      else
-      {
-        C.ErrorInfo = "Unexpected character";
-        C.State = Abort;
-      }
-      return true;
-    }
 
-    ///Chomps the beginning of a JSON stream.
-    static bool ChompBeginning(JSONParseContext& C)
-    {
-      if(Is<Whitespace>(C.d));
-      else if(Is<BeginArray>(C.d))
-      {
-        C.Stack.z()->NewArray();
-        C.StackKeys.Push(Value(0));
-        C.State = WaitingForFirstValue;
-        C.States.Push(WaitingForArrayEnd);
+        State = WaitingForValueEnd;
+        if(Is<QuotationMark>(c))
+        {
+          StringView Text;
+          return ChompString(Text) and Events.OnString(Text);
+        }
+        else if(Is<False1>(c))
+          return ChompLiteral("false") and Events.OnBoolean(false);
+        else if(Is<Null1>(c))
+          return ChompLiteral("null") and Events.OnNull();
+        else if(Is<True1>(c))
+          return ChompLiteral("true") and Events.OnBoolean(true);
+        else if(Is<Numeric>(c))
+          return ChompNumeric();
+        return Fail(At, "Unexpected character");
       }
-      else if(Is<BeginObject>(C.d))
+
+      /**Returns whether a scalar may end before the given position. Whatever
+      follows it must be something the index will see.*/
+      bool IsScalarEnd(const byte* p) const
       {
-        C.Stack.z()->NewTree();
-        C.StackKeys.Push(Value()); //Nil indicates to create new key.
-        C.State = WaitingForName;
-        C.States.Push(WaitingForObjectEnd);
+        return p == End or Is<Whitespace>(*p) or Is<QuotationMark>(*p) or
+          Is<BeginArray>(*p) or Is<BeginObject>(*p) or Is<EndArray>(*p) or
+          Is<EndObject>(*p) or Is<NameSeparator>(*p) or
+          Is<ValueSeparator>(*p);
       }
-      else
+
+      ///Chomps one of the literal names.
+      bool ChompLiteral(const ascii* Name)
       {
-        C.ErrorInfo = "Unexpected character";
-        C.State = Abort;
+        const byte* p = At;
+        for(; *Name; Name++, p++)
+          if(p == End or *p != byte(*Name))
+            return Fail(p, "Unexpected character");
+        return IsScalarEnd(p) or Fail(p, "Unexpected character");
       }
-      return true;
-    }
 
-    ///Chomps the name of an name-value pair.
-    static bool ChompName(JSONParseContext& C)
-    {
-      if(Is<QuotationMark>(C.d))
+      ///Chomps a JSON number.
+      bool ChompNumeric()
       {
-        if(not ChompString(C))
+        /*All of the characters of a number are ASCII, so the number can be
+        chomped as a span of bytes according to the character set for
+        representing numbers. IsNumberCorrectlyFormatted() then checks the span
+        against the actual specification, and it is converted in place.*/
+        const byte* NumberEnd = At;
+        bool ForceFloatingPoint = false;
+        while(NumberEnd < End and Is<Numeric>(*NumberEnd))
+        {
+          if(Is<DecimalPoint>(*NumberEnd))
+            ForceFloatingPoint = true; //If expressed with a . force as number.
+          NumberEnd++;
+        }
+
+        number Result = 0;
+        if(not IsNumberCorrectlyFormatted(At, NumberEnd) or
+          String::ParseNumber(At, NumberEnd, Result) != NumberEnd)
+        {
+          ErrorInfo = "Invalid number: ";
+          ErrorInfo.Append(At, count(NumberEnd - At));
           return false;
-        C.States.Push(WaitingForObjectEnd);
-        C.State = WaitingForNameSeparator;
-      }
-      else if(Is<Whitespace>(C.d))
-      {
+        }
+        if(not IsScalarEnd(NumberEnd))
+          return Fail(NumberEnd, "Unexpected character");
+
+        //Store number as integer if it loses no precision.
+        integer ResultAsInteger = integer(Result);
+        if(not ForceFloatingPoint and
+          Limits<number>::IsEqual(Result, number(ResultAsInteger)))
+            return Events.OnInteger(ResultAsInteger);
+        return Events.OnNumber(Result);
       }
-      else if(Is<EndObject>(C.d))
+
+      /**Chomps a string starting at the quotation mark. A string without
+      escapes that is valid UTF-8 is returned as a view of the JSON data.*/
+      bool ChompString(StringView& Text)
       {
-        C.Stack.Pop();
-        C.StackKeys.Pop();
-        C.States.Pop(); //Pop twice since object ended without any keys.
-        C.State = C.States.Pop();
-        return true;
+        const byte* s = At + 1;
+        const byte* Close = StringView::FindByte(s, count(End - s), '"');
+        if(Close and not StringView::FindByte(s, count(Close - s), 0x5c))
+        {
+          count Length = count(Close - s);
+          if(StringView::CountASCII(s, Length) == Length or
+            String::ValidateUTF8(s, Close) == Close)
+          {
+            Text = StringView(s, Length);
+            return true;
+          }
+        }
+        return ChompEscapedString(Text);
       }
-      else
+
+      /**Chomps a string character by character, interpreting the escapes and
+      replacing invalid UTF-8 with the bad character.*/
+      bool ChompEscapedString(StringView& Text)
       {
-        C.ErrorInfo = "Expected name string";
-        C.State = Abort;
+        bool Escaped = false;
+        unicode SurrogateLead = 0;
+        const byte* s = At + 1;
+        const byte* p = s;
+        Scratch.Clear();
+
+        while(s < End)
+        {
+          //Copy runs of unescaped ASCII directly.
+          if(not Escaped and not SurrogateLead)
+          {
+            const byte* Run = s;
+            while(s < End and *s < 128 and not Is<QuotationMark>(*s) and
+              not Is<Escape>(*s))
+                s++;
+            Scratch.Append(Run, count(s - Run));
+            if(s == End)
+              break;
+          }
+
+          unicode d = String::DecodeNext(s, End);
+          if(not Escaped)
+          {
+            if(Is<Escape>(d))
+              p = s, Escaped = true;
+            else if(SurrogateLead)
+              return Fail(p,
+                "Lead surrogate followed by unescaped character");
+            else if(Is<QuotationMark>(d))
+            {
+              Text = StringView(Scratch);
+              return true;
+            }
+            else
+              Scratch << d;
+          }
+          else
+          {
+            Escaped = false;
+            if(Is<EscapedCodepoint>(d))
+            {
+              unicode HexDigits[4] = {16, 16, 16, 16};
+              for(count i = 0; i < 4; i++)
+                if(s < End)
+                  HexDigits[i] = Unicode::HexDigitValue(
+                    String::DecodeNext(s, End));
+
+              if(HexDigits[0] >= 16 or HexDigits[1] >= 16 or
+                HexDigits[2] >= 16 or HexDigits[3] >= 16)
+                  return Fail(p, "Non-hex digits in escaped Unicode character");
+
+              unicode u = (HexDigits[0] << 12) + (HexDigits[1] << 8) +
+                (HexDigits[2] << 4) + HexDigits[3];
+
+              if(Unicode::IsLeadSurrogate(u))
+              {
+                if(SurrogateLead)
+                  return Fail(p, "Lead surrogate followed by lead surrogate");
+                SurrogateLead = u;
+              }
+              else if(Unicode::IsTrailSurrogate(u))
+              {
+                if(not SurrogateLead)
+                  return Fail(p, "Trail surrogate with no lead surrogate");
+                Scratch << Unicode::FromSurrogatePair(SurrogateLead, u);
+                SurrogateLead = 0;
+              }
+              else if(SurrogateLead)
+                return Fail(p, "Lead surrogate not followed by tail");
+              else
+                Scratch << u;
+            }
+            else if(SurrogateLead)
+              return Fail(p, "Lead surrogate not followed by \\uXXXX");
+            else if(Is<EscapedQuotationMark>(d))
+              Scratch << "\x22";
+            else if(Is<EscapedReverseSolidus>(d))
+              Scratch << "\\";
+            else if(Is<EscapedSolidus>(d))
+              Scratch << "/";
+            else if(Is<EscapedBackspace>(d))
+              Scratch << "\b";
+            else if(Is<EscapedFormFeed>(d))
+              Scratch << "\f";
+            else if(Is<EscapedLineFeed>(d))
+              Scratch << "\n";
+            else if(Is<EscapedCarriageReturn>(d))
+              Scratch << "\r";
+            else if(Is<EscapedTab>(d))
+              Scratch << "\t";
+          }
+        }
+        return Fail(At, "Unterminated string");
       }
-      return true;
+    };
+
+    public:
+
+    /**Parses JSON data and sends its events to a handler. Returns false if the
+    data is invalid or if the handler stopped the parse, in which case the
+    error strings describe where and why.*/
+    static bool Parse(const String& JSONData, Handler& Events,
+      String& ErrorString, String& ErrorInfo)
+    {
+      //As with a C string, the data ends at the first null byte.
+      const byte* Begin = reinterpret_cast<const byte*>(JSONData.Merge());
+      const byte* End = StringView::FindByte(Begin, JSONData.n(), 0);
+      if(not End)
+        End = Begin + JSONData.n();
+
+      Parser p(Begin, End, Events);
+      bool Valid = p.Parse();
+      ErrorString = Valid ? String() : p.GetErrorString();
+      ErrorInfo = p.ErrorInfo;
+      return Valid;
     }
 
-    ///Chomps the name separator in an object name-value pair.
-    static bool ChompNameSeparator(JSONParseContext& C)
+    ///Parses JSON data and sends its events to a handler.
+    static bool Parse(const String& JSONData, Handler& Events)
     {
-      if(Is<NameSeparator>(C.d))
-        C.State = WaitingForValue;
-      else if(not Is<Whitespace>(C.d))
-      {
-        C.ErrorInfo = "Expected name-value separator";
-        C.State = Abort;
-      }
-      return true;
+      String ErrorString, ErrorInfo;
+      return Parse(JSONData, Events, ErrorString, ErrorInfo);
     }
 
-    ///Chomps the first value in an array.
-    static bool ChompFirstValue(JSONParseContext& C)
+    public:
+
+    //-------//
+    //Writing//
+    //-------//
+
+    ///Receives the output of a Writer in order, one buffer at a time.
+    class Sink
     {
-      if(Is<EndArray>(C.d))
+      public:
+
+      ///Virtual destructor
+      virtual ~Sink() {}
+
+      ///Consumes the next bytes of output and returns whether it succeeded.
+      virtual bool Write(const byte* Data, count Bytes) = 0;
+    };
+
+    ///Appends the output to a string.
+    class StringSink : public Sink
+    {
+      String& Target;
+
+      public:
+
+      ///Creates a sink that appends to the given string.
+      StringSink(String& Target_) : Target(Target_) {}
+
+      bool Write(const byte* Data, count Bytes)
       {
-        C.Stack.Pop();
-        C.StackKeys.Pop();
-        C.States.Pop(); //Pop twice since array ended early.
-        C.State = C.States.Pop();
+        Target.Append(Data, Bytes);
         return true;
       }
-      ChompValue(C);
-      return true;
-    }
+    };
 
-    ///Chomps the end of an object.
-    static bool ChompObjectEnd(JSONParseContext& C)
+    ///Writes the output to a file, replacing any existing file.
+    class FileSink : public Sink
     {
-      if(Is<Whitespace>(C.d));
-      else if(Is<ValueSeparator>(C.d))
-      {
-        C.StackKeys.z() = Value();
-        C.State = WaitingForName;
-        C.States.Push(WaitingForObjectEnd);
-      }
-      else if(Is<EndObject>(C.d))
-      {
-        C.Stack.Pop();
-        C.StackKeys.Pop();
-        C.State = C.States.Pop();
-      }
-      else
-      {
-        C.ErrorInfo = "Unexpected character";
-        C.State = Abort;
-      }
-      return true;
-    }
+      ///Handle of the open file, or null if it could not be opened
+      void* Handle;
+
+      public:
+
+      ///Opens the file for writing.
+      FileSink(const ascii* Filename);
+
+      ///Closes the file if it is still open.
+      ~FileSink() {Close();}
+
+      ///Returns whether the file is open.
+      bool IsOpen() const {return Handle != 0;}
 
-    ///Chomps the end of an array.
-    static bool ChompArrayEnd(JSONParseContext& C)
+      ///Closes the file and returns whether all of the output was written.
+      bool Close();
+
+      bool Write(const byte* Data, count Bytes);
+    };
+
+    ///Passes the output to a callback function.
+    class CallbackSink : public Sink
     {
-      if(Is<Whitespace>(C.d));
-      else if(Is<ValueSeparator>(C.d))
-      {
-        C.StackKeys.z() = integer(C.StackKeys.z()) + 1;
-        C.State = WaitingForValue;
-        C.States.Push(WaitingForArrayEnd);
-      }
-      else if(Is<EndArray>(C.d))
+      public:
+
+      ///Callback receiving the output and the context given to the sink
+      typedef bool (*Function)(const byte* Data, count Bytes, void* Context);
+
+      private:
+
+      Function Callback;
+      void* Context;
+
+      public:
+
+      ///Creates a sink that calls the function with the given context.
+      CallbackSink(Function Callback_, void* Context_ = 0) :
+        Callback(Callback_), Context(Context_) {}
+
+      bool Write(const byte* Data, count Bytes)
       {
-        C.Stack.Pop();
-        C.StackKeys.Pop();
-        C.State = C.States.Pop();
+        return Callback(Data, Bytes, Context);
       }
-      else
+    };
+
+    /**Writes values as JSON to a sink. The text is formatted in a buffer that
+    is passed to the sink whenever it fills, so the memory used stays bounded
+    by the buffer size and the largest single string regardless of the size of
+    the value. The output is the same as that of Value::ExportJSON().*/
+    class Writer
+    {
+      ///Destination of the output
+      Sink& Output;
+
+      ///Output that has not yet been passed to the sink
+      StringBuilder Buffer;
+
+      ///Whether to indent and separate the output with whitespace
+      bool WithWhitespace; Pad<bool> WithWhitespace_padding;
+
+      ///Whether the sink has failed
+      bool Failed; Pad<bool> Failed_padding;
+
+      public:
+
+      ///Creates a writer for the given sink.
+      Writer(Sink& Output_, bool WithWhitespace_ = true) :
+        Output(Output_), Buffer(BufferSize + 256),
+        WithWhitespace(WithWhitespace_), Failed(false) {}
+
+      ///Passes any remaining output to the sink.
+      ~Writer() {Flush();}
+
+      /**Writes a value and flushes the output. Unless WithRoot is false,
+      values that are not arrays or objects are wrapped in an array so that
+      the output is a valid JSON text. Returns whether the sink accepted all of
+      the output.*/
+      bool Write(const Value& v, bool WithRoot = true);
+
+      ///Passes the buffered output to the sink and returns whether it worked.
+      bool Flush();
+
+      private:
+
+      ///Size at which the buffer is passed to the sink
+      static const count BufferSize = 4096;
+
+      ///Writes a value at the given level of indentation.
+      void WriteValue(const Value& v, count Level);
+
+      ///Writes a number, using null for infinities and NaN.
+      void WriteNumber(float64 x);
+
+      ///Writes a quoted and escaped string.
+      void WriteString(const StringView& s);
+
+      ///Writes the key of a tree entry followed by the name separator.
+      void WriteKey(const Value& Key);
+
+      ///Starts a new line at the given level of indentation.
+      void NewLine(count Level)
       {
-        C.ErrorInfo = "Unexpected character";
-        C.State = Abort;
+        if(not WithWhitespace)
+          return;
+        Buffer << '\n';
+        for(count i = 0; i < Level; i++)
+          Buffer << "  ";
       }
-      return true;
-    }
-
-    public:
+    };
 
     ///Exports a value to JSON data.
     static void Export(const Value& ValueToExport, String& JSONData,
       bool WithWhitespace, bool WithRoot = true)
     {
-      JSONData = ValueToExport.ExportJSON(WithWhitespace, WithRoot);
+      JSONData.Clear();
+      StringSink Output(JSONData);
+      Writer(Output, WithWhitespace).Write(ValueToExport, WithRoot);
     }
 
     ///Exports a value to JSON data.
@@ -828,37 +1091,18 @@ namespace PRIM_NAMESPACE
       return ValueToExport.ExportJSON(false, false);
     }
 
-    private:
-
-    ///Coerces any vector and rectangle data to actual vectors and rectangles.
-    static void CoerceSpecialTypes(Value& v)
+    /**Exports a value to a JSON file without building the text in memory.
+    Returns whether the file was written.*/
+    static bool ExportFile(const ascii* Filename, const Value& ValueToExport,
+      bool WithWhitespace = true)
     {
-      const Value& v_const = v;
-      if(v_const.IsArray())
-      {
-        if(v_const.n() == 3 and v_const[0].AsString() == "_JSONVector")
-          v = Vector(v_const[1].AsNumber(), v_const[2].AsNumber());
-        else if(v_const.n() == 5 and v_const[0].AsString() == "_JSONRectangle")
-          v = Box(
-            Vector(v_const[1].AsNumber(), v_const[2].AsNumber()),
-            Vector(v_const[3].AsNumber(), v_const[4].AsNumber()));
-        else
-        {
-          //Recurse through array and coerce each element.
-          for(count i = 0, n = v_const.n(); i < n; i++)
-            CoerceSpecialTypes(v[i]);
-        }
-      }
-      else if(v_const.IsTree())
-      {
-        //Enumerate tree and coerce each element.
-        Array<Value> Keys;
-        v_const.EnumerateKeys(Keys);
-        for(count i = 0; i < Keys.n(); i++)
-          CoerceSpecialTypes(v[Keys[i]]);
-      }
+      FileSink Output(Filename);
+      return Output.IsOpen() and
+        Writer(Output, WithWhitespace).Write(ValueToExport) and
+        Output.Close();
     }
 
+
     public:
 
     /**Imports a value from JSON data. Check for the key _JSONError to see if
@@ -898,64 +1142,16 @@ namespace PRIM_NAMESPACE
         }
       }
 
-      JSONParseContext C;
-      C.p = C.s = C.Start = reinterpret_cast<const byte*>(JSONData.Merge());
-      C.e = &C.s[JSONData.n()];
-      C.Stack.Add() = &ImportedValue;
-      C.Stack.z()->Clear();
-      C.States.Push(Ending);
-      C.State = Beginning;
-      while(C.State != Abort && C.s < C.e &&
-        (C.d = String::Decode(C.s, C.e)) != 0)
-      {
-        C.v = (C.Stack.n() ? C.Stack.z() : &C.StateValueDummy);
-        switch(C.State)
-        {
-        //Chomp the beginning of the stream.
-        case Beginning:               ChompBeginning(C);     break;
-
-        //Chomp values for objects and arrays.
-        case WaitingForFirstValue:    ChompFirstValue(C);    break;
-        case WaitingForValue:         ChompValue(C);         break;
-        case WaitingForArrayEnd:      ChompArrayEnd(C);      break;
-
-        //Chomp object name-value pairs.
-        case WaitingForName:          ChompName(C);          break;
-        case WaitingForNameSeparator: ChompNameSeparator(C); break;
-        case WaitingForObjectEnd:     ChompObjectEnd(C);     break;
-
-        //Chomp through the rest of the literal text enforcing each letter.
-        case ValueFalse2:C.State=(Is<False2>(C.d) ? ValueFalse3 : Abort); break;
-        case ValueFalse3:C.State=(Is<False3>(C.d) ? ValueFalse4 : Abort); break;
-        case ValueFalse4:C.State=(Is<False4>(C.d) ? ValueFalse5 : Abort); break;
-        case ValueFalse5:C.State=(Is<False5>(C.d) ? C.States.Pop():Abort);break;
-        case ValueNull2: C.State=(Is<Null2>(C.d) ? ValueNull3 : Abort);   break;
-        case ValueNull3: C.State=(Is<Null3>(C.d) ? ValueNull4 : Abort);   break;
-        case ValueNull4: C.State=(Is<Null4>(C.d) ? C.States.Pop():Abort); break;
-        case ValueTrue2: C.State=(Is<True2>(C.d) ? ValueTrue3 : Abort);   break;
-        case ValueTrue3: C.State=(Is<True3>(C.d) ? ValueTrue4 : Abort);   break;
-        case ValueTrue4: C.State=(Is<True4>(C.d) ? C.States.Pop():Abort); break;
-
-        //Chomp through trailing whitespace.
-        case Ending: if(not Is<Whitespace>(C.d)) C.State = Abort; break;
-
-        //In case of abort condition, break.
-        case Abort: break;
-        }
-      }
-
-      if(C.State == Abort or C.Stack.n() or C.States.n())
-      {
-        ImportedValue.Clear();
-        ImportedValue["_JSONError"] = C.GetErrorString();
-        ImportedValue["_JSONErrorInfo"] = C.ErrorInfo;
-        return false;
-      }
-
-      //Coerce special tagged arrays to vectors and rectangles.
-      CoerceSpecialTypes(ImportedValue);
+      ValueBuilder Builder(ImportedValue);
+      String ErrorString, ErrorInfo;
+      if(Parse(JSONData, Builder, ErrorString, ErrorInfo))
+        return true;
 
-      return true;
+      ImportedValue.Clear();
+      ImportedValue["_JSONError"] = ErrorString;
+      ImportedValue["_JSONErrorInfo"] =
+        Builder.ErrorInfo ? Builder.ErrorInfo : ErrorInfo;
+      return false;
     }
 
     ///Imports a JSON result even if not wrapped in array or object.
@@ -976,8 +1172,380 @@ namespace PRIM_NAMESPACE
     }
   };
 
-  //Set the default JSONParseState.
-  template <> inline Nothing<PRIM_NAMESPACE::JSON::JSONParseState>::operator
-    JSON::JSONParseState() const {return JSON::Abort;}
+#ifdef PRIM_COMPILE_INLINE
+  JSON::FileSink::FileSink(const ascii* Filename) :
+    Handle(reinterpret_cast<void*>(std::fopen(Filename, "wb"))) {}
+
+  bool JSON::FileSink::Close()
+  {
+    if(not Handle)
+      return false;
+    bool Closed = std::fclose(reinterpret_cast<std::FILE*>(Handle)) == 0;
+    Handle = 0;
+    return Closed;
+  }
+
+  bool JSON::FileSink::Write(const byte* Data, count Bytes)
+  {
+    return Handle and std::fwrite(Data, 1, size_t(Bytes),
+      reinterpret_cast<std::FILE*>(Handle)) == size_t(Bytes);
+  }
+
+  bool JSON::Writer::Write(const Value& v, bool WithRoot)
+  {
+    //Write outside container as an array.
+    if(v.IsArray() or v.IsBox() or v.IsVector() or v.IsTree() or
+      not WithRoot)
+        WriteValue(v, 0);
+    else
+    {
+      Buffer << '[';
+      if(WithWhitespace) Buffer << '\n';
+      WriteValue(v, 1);
+      if(WithWhitespace) Buffer << '\n';
+      Buffer << ']';
+    }
+    return Flush();
+  }
+
+  bool JSON::Writer::Flush()
+  {
+    if(Buffer.n() and not Failed)
+      Failed = not Output.Write(Buffer.View().Begin(), Buffer.n());
+    Buffer.Clear();
+    return not Failed;
+  }
+
+  void JSON::Writer::WriteValue(const Value& v, count Level)
+  {
+    if(Buffer.n() >= BufferSize)
+      Flush();
+
+    const ascii* Separator = WithWhitespace ? ", " : ",";
+    switch(v.ValueType)
+    {
+    case Value::ValueTypeNil:
+      Buffer << "null";
+      break;
+    case Value::ValueTypeBoolean:
+      Buffer << (v.DataBooleanValue ? "true" : "false");
+      break;
+    case Value::ValueTypeInteger:
+      Buffer.Append(int64(v.DataIntegerValue));
+      break;
+    case Value::ValueTypeNumber:
+      WriteNumber(float64(v.DataNumberValue));
+      break;
+    case Value::ValueTypeRatio:
+      {
+        Ratio r = v.InternalRatio();
+        Buffer << '"';
+        Buffer.Append(int64(r.Numerator()));
+        Buffer << '/';
+        Buffer.Append(int64(r.Denominator()));
+        Buffer << '"';
+      }
+      break;
+    case Value::ValueTypeVector:
+      {
+        Vector x = v.InternalVector();
+        Buffer << "[\"_JSONVector\"" << Separator;
+        WriteNumber(float64(x.x));
+        Buffer << Separator;
+        WriteNumber(float64(x.y));
+        Buffer << ']';
+      }
+      break;
+    case Value::ValueTypeBox:
+      {
+        const Box& x = v.AssumeAndGet<Box>();
+        Buffer << "[\"_JSONRectangle\"" << Separator;
+        WriteNumber(float64(x.a.x));
+        Buffer << Separator;
+        WriteNumber(float64(x.a.y));
+        Buffer << Separator;
+        WriteNumber(float64(x.b.x));
+        Buffer << Separator;
+        WriteNumber(float64(x.b.y));
+        Buffer << ']';
+      }
+      break;
+    case Value::ValueTypeString:
+      WriteString(v.InternalStringView());
+      break;
+    case Value::ValueTypeArray:
+      {
+        const Value::ArrayType& a = v.AssumeAndGet<Value::ArrayType>();
+        Buffer << '[';
+        for(count i = 0, n = a.n(); i < n; i++)
+        {
+          if(i)
+            Buffer << ',';
+          NewLine(Level + 1);
+          WriteValue(a[i], Level + 1);
+        }
+        NewLine(Level);
+        Buffer << ']';
+      }
+      break;
+    case Value::ValueTypeTree:
+      {
+        Value::TreeType::Iterator It;
+        bool First = true;
+        Buffer << '{';
+        for(It.Begin(v.AssumeAndGet<Value::TreeType>()); It.Iterating();
+          It.Next(), First = false)
+        {
+          if(not First)
+            Buffer << ',';
+          NewLine(Level + 1);
+          WriteKey(It.Key());
+          WriteValue(It.Value(), Level + 1);
+        }
+        NewLine(Level);
+        Buffer << '}';
+      }
+      break;
+    case Value::ValueTypeObject:
+      {
+        const Value::Base* RawPointer = v.ConstObject().Raw();
+        String s;
+        s << "_JSONObject<";
+        s << (RawPointer ? RawPointer->Name().Merge() : "null");
+        s << ", " << reinterpret_cast<const void*>(RawPointer) << ">";
+        WriteString(s);
+      }
+      break;
+    }
+  }
+
+  void JSON::Writer::WriteNumber(float64 x)
+  {
+    if(Limits<float64>::IsNaN(x) or
+      Limits<float64>::IsEqual(x, Limits<float64>::Infinity()) or
+      Limits<float64>::IsEqual(x, Limits<float64>::NegativeInfinity()))
+    {
+      Buffer << "null";
+      return;
+    }
+
+    //Numbers always carry a decimal point so they import as numbers.
+    count Start = Buffer.n();
+    Buffer.Append(x, 17, true);
+    StringView Digits = Buffer.View();
+    if(not StringView::FindByte(Digits.Begin() + Start, Buffer.n() - Start,
+      '.'))
+        Buffer << ".0";
+  }
+
+  void JSON::Writer::WriteString(const StringView& s)
+  {
+    static const ascii Hex[] = "0123456789abcdef";
+    const byte* p = s.Begin();
+    const byte* End = s.End();
+    Buffer << '"';
+    while(p < End)
+    {
+      //Copy runs of characters that need no escape directly.
+      const byte* Run = p;
+      while(p < End and *p >= 0x20 and *p != '"' and *p != 0x5c)
+        p++;
+      Buffer.Append(Run, count(p - Run));
+      if(p == End)
+        break;
+
+      byte c = *p++;
+      if(c == '"')
+        Buffer << "\\\"";
+      else if(c == 0x5c)
+        Buffer << "\\\\";
+      else if(c == '\t')
+        Buffer << "\\t";
+      else if(c == '\n')
+        Buffer << "\\n";
+      else if(c == '\r')
+        Buffer << "\\r";
+      else
+        Buffer << "\\u00" << Hex[c >> 4] << Hex[c & 15];
+    }
+    Buffer << '"';
+  }
+
+  void JSON::Writer::WriteKey(const Value& Key)
+  {
+    if(Key.IsString())
+      WriteString(Key.InternalStringView());
+    else
+    {
+      //Other keys are written as the string of their compact JSON.
+      String KeyJSON;
+      StringSink KeyOutput(KeyJSON);
+      Writer(KeyOutput, WithWhitespace).Write(Key, false);
+      WriteString(KeyJSON);
+    }
+    Buffer << ':';
+    if(WithWhitespace)
+      Buffer << ' ';
+  }
+
+  String Value::ExportJSON(bool WithWhitespace, bool WithRoot) const
+  {
+    String s;
+    JSON::StringSink Output(s);
+    JSON::Writer(Output, WithWhitespace).Write(*this, WithRoot);
+    return s;
+  }
+
+  void JSON::ClassifyBlock(const byte* Block, uint64& Quote,
+    uint64& Backslash, uint64& Operator, uint64& Whitespace)
+  {
+    Quote = Backslash = Operator = Whitespace = 0;
+#if defined(PRIM_STRING_AVX2)
+    for(count i = 0; i < 64; i += 32)
+    {
+      __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(
+        Block + i));
+
+      //Setting bit 5 folds the brackets onto the braces.
+      __m256i Folded = _mm256_or_si256(x, _mm256_set1_epi8(0x20));
+      __m256i Op = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(Folded, _mm256_set1_epi8('{')),
+          _mm256_cmpeq_epi8(Folded, _mm256_set1_epi8('}'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(':')),
+          _mm256_cmpeq_epi8(x, _mm256_set1_epi8(','))));
+      __m256i Space = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(' ')),
+          _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\n'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\r')),
+          _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\t'))));
+
+      Quote |= uint64(uint32(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(x, _mm256_set1_epi8('"'))))) << i;
+      Backslash |= uint64(uint32(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(x, _mm256_set1_epi8(0x5c))))) << i;
+      Operator |= uint64(uint32(_mm256_movemask_epi8(Op))) << i;
+      Whitespace |= uint64(uint32(_mm256_movemask_epi8(Space))) << i;
+    }
+#elif defined(PRIM_STRING_SSE2)
+    for(count i = 0; i < 64; i += 16)
+    {
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + i));
+
+      //Setting bit 5 folds the brackets onto the braces.
+      __m128i Folded = _mm_or_si128(x, _mm_set1_epi8(0x20));
+      __m128i Op = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(Folded, _mm_set1_epi8('{')),
+          _mm_cmpeq_epi8(Folded, _mm_set1_epi8('}'))),
+        _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(':')),
+          _mm_cmpeq_epi8(x, _mm_set1_epi8(','))));
+      __m128i Space = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')),
+          _mm_cmpeq_epi8(x, _mm_set1_epi8('\n'))),
+        _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('\r')),
+          _mm_cmpeq_epi8(x, _mm_set1_epi8('\t'))));
+
+      Quote |= uint64(uint32(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(x, _mm_set1_epi8('"'))))) << i;
+      Backslash |= uint64(uint32(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(x, _mm_set1_epi8(0x5c))))) << i;
+      Operator |= uint64(uint32(_mm_movemask_epi8(Op))) << i;
+      Whitespace |= uint64(uint32(_mm_movemask_epi8(Space))) << i;
+    }
+#else
+    for(count i = 0; i < 64; i++)
+    {
+      uint64 Bit = uint64(1) << i;
+      byte c = Block[i];
+      if(Is<QuotationMark>(c))
+        Quote |= Bit;
+      else if(Is<Escape>(c))
+        Backslash |= Bit;
+      else if(Is<BeginArray>(c) or Is<BeginObject>(c) or Is<EndArray>(c) or
+        Is<EndObject>(c) or Is<NameSeparator>(c) or Is<ValueSeparator>(c))
+          Operator |= Bit;
+      else if(Is<JSON::Whitespace>(c))
+        Whitespace |= Bit;
+    }
+#endif
+  }
+
+  void JSON::IndexStructure(const byte* Begin, const byte* End,
+    Array<count>& Index)
+  {
+    count Used = 0;
+
+    //State carried from one block to the next
+    uint64 InString = 0; //All ones if the last block ended inside a string
+    uint64 Escaping = 0; //One if the last block ended with an open escape
+    uint64 Boundary = 1; //One if a scalar may start at the next byte
+
+    for(const byte* Block = Begin; Block < End; Block += 64)
+    {
+      uint64 Quote, Backslash, Operator, Whitespace;
+      if(End - Block >= 64)
+        ClassifyBlock(Block, Quote, Backslash, Operator, Whitespace);
+      else
+      {
+        //Pad the final block with whitespace.
+        byte Padded[64];
+        Memory::Clear(Padded, 64, byte(' '));
+        Memory::Copy(Padded, Block, count(End - Block));
+        ClassifyBlock(Padded, Quote, Backslash, Operator, Whitespace);
+      }
+
+      /*Find the bytes that follow an unescaped backslash. Backslashes are
+      rare, so they are simply visited one at a time.*/
+      uint64 Escaped = Escaping;
+      uint64 Backslashes = Backslash & ~Escaping;
+      Escaping = 0;
+      while(Backslashes)
+      {
+        uint64 Bit = Backslashes & (~Backslashes + 1);
+        Backslashes ^= Bit;
+        if(Bit >> 63)
+          Escaping = 1;
+        else
+        {
+          Escaped |= Bit << 1;
+          Backslashes &= ~(Bit << 1);
+        }
+      }
+      Quote &= ~Escaped;
+
+      /*The prefix-xor of the quotation marks sets the bits from each opening
+      quotation mark up to, but not including, its closing quotation mark.*/
+      uint64 Inside = Quote;
+      Inside ^= Inside << 1;
+      Inside ^= Inside << 2;
+      Inside ^= Inside << 4;
+      Inside ^= Inside << 8;
+      Inside ^= Inside << 16;
+      Inside ^= Inside << 32;
+      Inside ^= InString;
+      InString = uint64(0) - (Inside >> 63);
+
+      /*A scalar starts at any other byte outside of a string that follows an
+      operator, whitespace, or a closing quotation mark. Anything following a
+      string is indexed so that the parser can reject it.*/
+      Operator &= ~Inside;
+      Whitespace &= ~Inside;
+      uint64 Ends = Operator | Whitespace | (Quote & ~Inside);
+      uint64 Scalar = ~(Ends | Inside);
+      uint64 Structural = Operator | (Quote & Inside) |
+        (Scalar & ((Ends << 1) | Boundary));
+      Boundary = Ends >> 63;
+
+      //Append the positions of the structural bytes.
+      if(Index.n() < Used + 64)
+        Index.n(Used + 64);
+      count* Out = &Index[Used];
+      count Base = count(Block - Begin);
+      for(; Structural; Structural &= Structural - 1)
+        *Out++ = Base + StringView::LowestSetBit(Structural);
+      Used = count(Out - &Index.a());
+    }
+    Index.n(Used);
+  }
+#endif
 }
 #endif
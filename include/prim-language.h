@@ -36,6 +36,13 @@
 #error This file can not be included individually. Include prim.h instead.
 #endif
 
+//Detect C++11 support unless it has been explicitly turned off.
+#if not defined(PRIM_11) and not defined(PRIM_NO_11)
+#if __cplusplus >= 201103L or (defined(_MSC_VER) and _MSC_VER >= 1900)
+#define PRIM_11
+#endif
+#endif
+
 //Enable default constructor delete if C++11 support is enabled.
 #ifdef PRIM_11
 #define PRIM_11_DELETE_DEFAULT = delete
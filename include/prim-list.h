@@ -48,8 +48,12 @@ namespace PRIM_NAMESPACE
 
   This indexing optimization does not make random access more efficient. If
   random or contiguous access is a requirement, then the Array would be a better
-  choice.*/
-  template <class T>
+  choice.
+
+  The allocation policy determines how links are allocated. By default each
+  link is a separate heap allocation. With PooledAllocation links are recycled
+  through a pool owned by the list.*/
+  template <class T, class P = HeapAllocation>
   class List
   {
     protected:
@@ -103,6 +107,9 @@ namespace PRIM_NAMESPACE
     ///Number of items in the list
     count Items;
 
+    ///Allocator for the links
+    typename P::template Allocator<DoubleLink> Links;
+
     ///Returns a pointer to the link containing the given data.
     DoubleLink* GetLinkFromItem(const T& i)
     {
@@ -328,18 +335,18 @@ namespace PRIM_NAMESPACE
   public:
 
     ///Constructor initializes empty list.
-    List<T>() : First(0), Last(0), LastReferenced(0), LastReferencedIndex(0),
+    List() : First(0), Last(0), LastReferenced(0), LastReferencedIndex(0),
       Items(0) {}
 
     ///Destructor
-    ~List<T>()
+    ~List()
     {
       //Traverse the list and delete all of the elements.
       DoubleLink* Current = First;
       for(count i = 0; i < Items; i++)
       {
         DoubleLink* Next = Current->Next;
-        delete Current;
+        Links.Delete(Current);
         Current = Next;
       }
     }
@@ -385,7 +392,7 @@ namespace PRIM_NAMESPACE
     T& ith(count i)
     {
       //Using const-cast in order to avoid duplicating the above code.
-      return const_cast<T&>(static_cast<const List<T>*>(this)->ith(i));
+      return const_cast<T&>(static_cast<const List*>(this)->ith(i));
     }
 
     ///Gets a const element reference using the familiar bracket notation.
@@ -429,7 +436,7 @@ namespace PRIM_NAMESPACE
     ///Appends an element to the end of the list by copying the argument.
     void Append(const T& NewElement)
     {
-      DoubleLink* NewLink = new DoubleLink;
+      DoubleLink* NewLink = Links.New();
       if(not Items)
         Last = First = NewLink;
       else
@@ -449,10 +456,24 @@ namespace PRIM_NAMESPACE
       Append(NewElement);
     }
 
+#ifdef PRIM_11
+    ///Appends an element to the end of the list by moving the argument.
+    void Append(T&& NewElement)
+    {
+      Add() = Move(NewElement);
+    }
+
+    ///Pushes an element to the end of the list by moving the argument.
+    inline void Push(T&& NewElement)
+    {
+      Append(Move(NewElement));
+    }
+#endif
+
     ///Adds an element to the list using its default constructor.
     T& Add()
     {
-      DoubleLink* NewLink = new DoubleLink;
+      DoubleLink* NewLink = Links.New();
 
       if(not Items)
         Last = First = NewLink;
@@ -474,10 +495,20 @@ namespace PRIM_NAMESPACE
       return z();
     }
 
+#ifdef PRIM_11
+    ///Adds an existing element to the list by moving it into the new element.
+    T& Add(T&& x)
+    {
+      T& NewElement = Add();
+      NewElement = Move(x);
+      return NewElement;
+    }
+#endif
+
     ///Prepends an element to the beginning of the list.
     void Prepend(const T& NewElement)
     {
-      DoubleLink* NewLink = new DoubleLink;
+      DoubleLink* NewLink = Links.New();
 
       if(not Items)
         Last = First = NewLink;
@@ -517,7 +548,7 @@ namespace PRIM_NAMESPACE
       //Determine the correct links to squeeze the new element between.
       DoubleLink* LeftLink = LastReferenced->Prev;
       DoubleLink* RightLink = LastReferenced;
-      DoubleLink* NewLink = new DoubleLink;
+      DoubleLink* NewLink = Links.New();
 
       //Update the link pointers.
       RightLink->Prev = LeftLink->Next = NewLink;
@@ -556,7 +587,7 @@ namespace PRIM_NAMESPACE
       //Determine the correct links to squeeze the new element between.
       DoubleLink* LeftLink = LastReferenced;
       DoubleLink* RightLink = LastReferenced->Next;
-      DoubleLink* NewLink = new DoubleLink;
+      DoubleLink* NewLink = Links.New();
 
       //Update the link pointers.
       RightLink->Prev = LeftLink->Next = NewLink;
@@ -607,7 +638,7 @@ namespace PRIM_NAMESPACE
         Items--;
       }
 
-      delete LastReferenced;
+      Links.Delete(LastReferenced);
 
       if(LeftLink != 0)
       {
@@ -640,7 +671,11 @@ namespace PRIM_NAMESPACE
     {
       T Copy = Nothing<T>();
       if(n())
+#ifdef PRIM_11
+        Copy = Move(ith(n() - 1));
+#else
         Copy = ith(n() - 1);
+#endif
       Remove(n() - 1);
       return Copy;
     }
@@ -701,7 +736,7 @@ namespace PRIM_NAMESPACE
     }
 
     ///Copy constructor to create deep copy of another list.
-    List<T>(const List<T>& Other) : First(0), Last(0), LastReferenced(0),
+    List(const List& Other) : First(0), Last(0), LastReferenced(0),
       LastReferencedIndex(0), Items(0)
     {
       count ItemCount = Other.Items;
@@ -710,7 +745,7 @@ namespace PRIM_NAMESPACE
     }
 
     ///Assigns this list a deep copy of another list.
-    List<T>& operator = (const List<T>& Other)
+    List& operator = (const List& Other)
     {
       //Exit if the other list is the same as this one.
       if(&Other == this)
@@ -727,6 +762,35 @@ namespace PRIM_NAMESPACE
       return *this;
     }
 
+#ifdef PRIM_11
+    ///Move constructor takes over the links of the other list.
+    List(List&& Other) noexcept : First(Other.First), Last(Other.Last),
+      LastReferenced(Other.LastReferenced),
+      LastReferencedIndex(Other.LastReferencedIndex), Items(Other.Items)
+    {
+      Links.Swap(Other.Links);
+      Other.First = Other.Last = Other.LastReferenced = 0;
+      Other.LastReferencedIndex = 0;
+      Other.Items = 0;
+    }
+
+    /**Move assignment removes the current elements and takes over the links of
+    the other list.*/
+    List& operator = (List&& Other) noexcept
+    {
+      if(&Other == this)
+        return *this;
+      RemoveAll();
+      Links.Swap(Other.Links);
+      Memory::Swap(First, Other.First);
+      Memory::Swap(Last, Other.Last);
+      Memory::Swap(LastReferenced, Other.LastReferenced);
+      Memory::Swap(LastReferencedIndex, Other.LastReferencedIndex);
+      Memory::Swap(Items, Other.Items);
+      return *this;
+    }
+#endif
+
     //------------------//
     //Element Comparison//
     //------------------//
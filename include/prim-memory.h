@@ -152,6 +152,38 @@ namespace PRIM_NAMESPACE
     }
   };
 
+#ifdef PRIM_11
+  namespace meta
+  {
+    ///Strips the reference from a type so that Move() can name the value type.
+    template <class T> struct RemoveReference {typedef T Type;};
+
+    ///Strips an lvalue reference.
+    template <class T> struct RemoveReference<T&> {typedef T Type;};
+
+    ///Strips an rvalue reference.
+    template <class T> struct RemoveReference<T&&> {typedef T Type;};
+  }
+
+  /**Casts an object to an rvalue reference so that its contents may be moved
+  instead of copied. This is equivalent to std::move, but does not require the
+  standard library headers to be visible outside of the compiled translation
+  unit.*/
+  template <class T>
+  inline typename meta::RemoveReference<T>::Type&& Move(T&& Object)
+  {
+    return static_cast<typename meta::RemoveReference<T>::Type&&>(Object);
+  }
+
+  /**Passes an argument on with the value category it was given. This is
+  equivalent to std::forward.*/
+  template <class T>
+  inline T&& Forward(typename meta::RemoveReference<T>::Type& Object)
+  {
+    return static_cast<T&&>(Object);
+  }
+#endif
+
 #ifdef PRIM_COMPILE_INLINE
   void Memory::MemSet(void* Destination, uint8 ValueToSet, count BytesToSet)
   {
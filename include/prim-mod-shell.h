@@ -118,7 +118,9 @@ namespace PRIM_NAMESPACE
     {
       Value Result;
       if(SharedMemory)
-        JSON::ImportResult(String(SharedMemory), Result);
+        BinaryValue::Import(reinterpret_cast<const byte*>(SharedMemory),
+          reinterpret_cast<const byte*>(SharedMemory) + MaxSharedDataSize,
+          Result);
       return Result;
     }
 
@@ -134,18 +136,19 @@ namespace PRIM_NAMESPACE
     ///Returns the process result code.
     count  Result()      {return count(Status >> 8);}
 
-    /**Sets the value of the shared memory. If the serialized JSON string
-    exceeds the preallocated size of the buffer (currently 16 MB), then the data
-    will not be set and subsequent calls to GetSharedData() will return a nil
-    value.*/
+    /**Sets the value of the shared memory. The value is encoded in binary
+    directly into the buffer. If it exceeds the preallocated size of the buffer
+    (currently 16 MB), then the data will not be set and subsequent calls to
+    GetSharedData() will return a nil value.*/
     void SetSharedData(Value v)
     {
-      String s = JSON::ExportResult(v);
-      if(s.n() < MaxSharedDataSize)
-      {
-        Memory::MemCopy(SharedMemory, s.Merge(), s.n() + 1);
-        SyncSharedData(s.n() + 1);
-      }
+      if(not SharedMemory)
+        return;
+      byte* Destination = reinterpret_cast<byte*>(SharedMemory);
+      count Length = BinaryValue::Export(v, Destination, MaxSharedDataSize);
+      if(not Length)
+        Destination[Length++] = BinaryValue::TagNil;
+      SyncSharedData(Length);
     }
 
     ///Returns the process signal code if it failed and zero otherwise.
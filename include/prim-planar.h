@@ -616,7 +616,7 @@ namespace PRIM_NAMESPACE
     }
 
     ///Inserts the rectangle side into the segmented hull list.
-    static void InsertSide(List<Complex<T> >& L, BoxT R, Side S)
+    static void InsertSide(Sequence<Complex<T> >& L, BoxT R, Side S)
     {
       T SegmentToAddStart = Baseline(R.a, S);
       T SegmentToAddEnd   = Baseline(R.b, S);
@@ -674,7 +674,7 @@ namespace PRIM_NAMESPACE
     public:
 
     ///Converts the hull to an array of one-dimensional rectangles.
-    static Array<BoxT> HullAsBoxes(const List<Complex<T> >& Hull,
+    static Array<BoxT> HullAsBoxes(const Sequence<Complex<T> >& Hull,
       Side S)
     {
       Array<BoxT> Boxes(Hull.n() - 1);
@@ -685,8 +685,8 @@ namespace PRIM_NAMESPACE
     }
 
     ///Merges two hulls together to form a single hull.
-    static List<Complex<T> > MergeHulls(const List<Complex<T> >& A,
-      const List<Complex<T> >& B, Side S)
+    static Sequence<Complex<T> > MergeHulls(const Sequence<Complex<T> >& A,
+      const Sequence<Complex<T> >& B, Side S)
     {
       Array<BoxT> AllBoxes;
       AllBoxes.Append(HullAsBoxes(A, S));
@@ -695,10 +695,10 @@ namespace PRIM_NAMESPACE
     }
 
     ///Returns the segmented hull of a given side of a set of rectangles.
-    static List<Complex<T> > SegmentedHull(const Array<BoxT>& Boxes,
+    static Sequence<Complex<T> > SegmentedHull(const Array<BoxT>& Boxes,
       Side S)
     {
-      List<Complex<T> > L;
+      Sequence<Complex<T> > L;
       if(not Boxes.n())
         return L;
 
@@ -730,11 +730,11 @@ namespace PRIM_NAMESPACE
     }
 
     ///Gets closest two segmented hulls can be placed approached from a side.
-    static Complex<T> OffsetToPlaceOnSide(const List<Complex<T> >& Anchor_,
-      const List<Complex<T> >& Mover_, typename BoxT::Side S)
+    static Complex<T> OffsetToPlaceOnSide(const Sequence<Complex<T> >& Anchor_,
+      const Sequence<Complex<T> >& Mover_, typename BoxT::Side S)
     {
-      List<Complex<T> > Anchor = Anchor_;
-      List<Complex<T> > Mover  = Mover_;
+      Sequence<Complex<T> > Anchor = Anchor_;
+      Sequence<Complex<T> > Mover  = Mover_;
 
       bool DeltaExists = false;
       T FinalDelta = 0.f;
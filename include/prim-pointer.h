@@ -43,6 +43,100 @@ namespace PRIM_NAMESPACE
     //Forward declaration
     template <class T> class WeakPointer;
 
+#ifdef PRIM_POINTER_USE_ATOMICS
+    /**Reference count that is incremented and decremented atomically. Plain
+    increments are relaxed since they are made from a handle that already
+    holds a count. A strong handle made from a weak one must use
+    IncrementIfNonzero() so that an object that is being destroyed can not be
+    revived. The decrements synchronize so that the last handle to be released
+    sees all writes made through the other handles before the object is
+    deleted.*/
+    class PointerCount
+    {
+      count Value;
+
+      public:
+
+      ///Initializes the count.
+      PointerCount(count InitialValue = 0) : Value(InitialValue) {}
+
+      ///Increments the count and returns the new value.
+      count operator ++ ()
+      {
+        return __atomic_add_fetch(&Value, 1, __ATOMIC_RELAXED);
+      }
+
+      ///Decrements the count and returns the new value.
+      count operator -- ()
+      {
+        return __atomic_sub_fetch(&Value, 1, __ATOMIC_ACQ_REL);
+      }
+
+      ///Returns the current value of the count.
+      operator count () const
+      {
+        return __atomic_load_n(&Value, __ATOMIC_ACQUIRE);
+      }
+
+      ///Increments the count unless it is zero and returns whether it did.
+      bool IncrementIfNonzero()
+      {
+        count Expected = __atomic_load_n(&Value, __ATOMIC_RELAXED);
+        while(Expected)
+          if(__atomic_compare_exchange_n(&Value, &Expected, Expected + 1, true,
+            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+              return true;
+        return false;
+      }
+    };
+
+    /**Flag that is read and written atomically, so that a weak handle can
+    check whether the object exists while the last strong handle releases it.*/
+    class PointerFlag
+    {
+      bool Value; PRIM_PAD(bool)
+
+      public:
+
+      ///Initializes the flag.
+      PointerFlag(bool InitialValue = false) : Value(InitialValue) {}
+
+      ///Sets the flag.
+      PointerFlag& operator = (bool NewValue)
+      {
+        __atomic_store_n(&Value, NewValue, __ATOMIC_RELEASE);
+        return *this;
+      }
+
+      ///Returns the current value of the flag.
+      operator bool () const
+      {
+        return __atomic_load_n(&Value, __ATOMIC_ACQUIRE);
+      }
+    };
+
+    ///Increments a count unless it is zero and returns whether it did.
+    inline bool IncrementIfNonzero(PointerCount& Count)
+    {
+      return Count.IncrementIfNonzero();
+    }
+#else
+    ///Reference count. Define PRIM_POINTER_USE_ATOMICS for atomic counts.
+    typedef count PointerCount;
+
+    ///Existence flag. Define PRIM_POINTER_USE_ATOMICS for an atomic flag.
+    typedef bool PointerFlag;
+
+    ///Increments a count unless it is zero and returns whether it did.
+    inline bool IncrementIfNonzero(PointerCount& Count)
+    {
+      if(not Count)
+        return false;
+      ++Count;
+      return true;
+    }
+#endif
+
     /**Internal storage class for keeping track of ownership to an object. One
     of these is held per owned object. There is no reason to use this class
     directly.*/
@@ -50,18 +144,53 @@ namespace PRIM_NAMESPACE
     {
       public:
 
-      ///Pointer to the owned object.
-      bool OwnedPointerExists; PRIM_PAD(bool)
+      ///Whether the owned object still exists.
+      PointerFlag OwnedPointerExists;
 
       ///Reference count of strong and weak handles to the owner object.
-      count OwnerReferenceCount;
+      PointerCount OwnerReferenceCount;
 
       ///Reference count of strong handles to the actual owned object.
-      count ReferenceCount;
+      PointerCount ReferenceCount;
 
       ///Constructor to take ownership of a pointer.
       PointerOwner() : OwnedPointerExists(true), OwnerReferenceCount(1),
         ReferenceCount(1) {}
+
+      ///Virtual destructor so that owners holding the object inline are freed.
+      virtual ~PointerOwner() {}
+
+      /**Destroys the owned object if it is stored inside the owner and returns
+      whether it did so. Otherwise the object is deleted by the pointer.*/
+      virtual bool DestroyInlineObject() {return false;}
+    };
+
+    /**Owner that stores the object in the same allocation. The object is
+    constructed by Pointer<T>::Make() and destroyed as soon as the last strong
+    handle is released, while the memory is kept until the last weak handle is
+    released.*/
+    template <class T> class PointerOwnerWithObject : public PointerOwner
+    {
+      ///Storage for the object aligned for any of the fundamental types
+      union
+      {
+        byte Bytes[sizeof(T)];
+        uint64 AlignInteger;
+        float80 AlignNumber;
+        void* AlignPointer;
+      } Storage;
+
+      public:
+
+      ///Returns the address at which the object is constructed.
+      void* Address() {return &Storage.Bytes[0];}
+
+      ///Destroys the object in place.
+      bool DestroyInlineObject()
+      {
+        static_cast<T*>(Address())->~T();
+        return true;
+      }
     };
   }
 
@@ -130,8 +259,6 @@ namespace PRIM_NAMESPACE
 
       //Create a new owner for the object and initialize its state.
       Reference = new meta::PointerOwner;
-      Reference->OwnerReferenceCount = 1;
-      Reference->ReferenceCount = 1;
     }
 
     ///Copy constructor to increment reference counts.
@@ -160,6 +287,44 @@ namespace PRIM_NAMESPACE
       return *this;
     }
 
+#ifdef PRIM_11
+    ///Move constructor takes over the reference without touching the counts.
+    Pointer(Pointer<T>&& PointerToTake) noexcept :
+      Reference(PointerToTake.Reference),
+      CachedPointer(PointerToTake.CachedPointer)
+    {
+      PointerToTake.Reference = 0;
+      PointerToTake.CachedPointer = 0;
+    }
+
+    /**Constructs from an expiring weak pointer. The weak reference can not be
+    taken over, so the pointer is shared as in the copy constructor.*/
+    Pointer(meta::WeakPointer<T>&& PointerToShare) : Reference(0),
+      CachedPointer(0)
+    {
+      Share(PointerToShare, false);
+    }
+
+    ///Move assignment releases the current reference and takes over the other.
+    Pointer<T>& operator = (Pointer<T>&& PointerToTake) noexcept
+    {
+      if(this != &PointerToTake)
+      {
+        Unshare(false);
+        Swap(PointerToTake);
+      }
+      return *this;
+    }
+
+    ///Assigns an expiring weak pointer by sharing it as in copy assignment.
+    Pointer<T>& operator = (meta::WeakPointer<T>&& PointerToShare)
+    {
+      if(Raw() != PointerToShare.Raw())
+        Share(PointerToShare, false);
+      return *this;
+    }
+#endif
+
     ///Assignment operator for recently pointer to new object.
     Pointer<T>& operator = (T* PointerToOwn)
     {
@@ -176,8 +341,6 @@ namespace PRIM_NAMESPACE
 
       //Create a new owner for the object and set initialize its state.
       Reference = new meta::PointerOwner;
-      Reference->OwnerReferenceCount = 1;
-      Reference->ReferenceCount = 1;
       CachedPointer = PointerToOwn;
       return *this;
     }
@@ -202,8 +365,50 @@ namespace PRIM_NAMESPACE
       return (Reference and Reference->OwnedPointerExists ? CachedPointer : 0);
     }
 
-    ///Creates a new object of the type given by the pointer.
-    Pointer<T> New() {*this = new T; return *this;}
+    /**Creates a new object of the type given by the pointer. The object and
+    its owner are allocated together as with Make().*/
+    Pointer<T> New() {*this = Make(); return *this;}
+
+#ifdef PRIM_11
+    /**Returns a pointer to a new object constructed from the given arguments.
+    The object is stored in the same allocation as its reference counts, so
+    only one allocation is made instead of two. This uses placement new, which
+    is declared in &lt;new&gt; (see Memory::PlacementNew).*/
+    template <class... Arguments>
+    static Pointer<T> Make(Arguments&&... Args)
+    {
+      meta::PointerOwnerWithObject<T>* Owner =
+        new meta::PointerOwnerWithObject<T>;
+      return Pointer<T>(Owner,
+        new (Owner->Address()) T(Forward<Arguments>(Args)...));
+    }
+#else
+    ///Returns a pointer to a new default-constructed object.
+    static Pointer<T> Make()
+    {
+      meta::PointerOwnerWithObject<T>* Owner =
+        new meta::PointerOwnerWithObject<T>;
+      return Pointer<T>(Owner, new (Owner->Address()) T);
+    }
+
+    ///Returns a pointer to a new object constructed from one argument.
+    template <class A>
+    static Pointer<T> Make(const A& a)
+    {
+      meta::PointerOwnerWithObject<T>* Owner =
+        new meta::PointerOwnerWithObject<T>;
+      return Pointer<T>(Owner, new (Owner->Address()) T(a));
+    }
+
+    ///Returns a pointer to a new object constructed from two arguments.
+    template <class A, class B>
+    static Pointer<T> Make(const A& a, const B& b)
+    {
+      meta::PointerOwnerWithObject<T>* Owner =
+        new meta::PointerOwnerWithObject<T>;
+      return Pointer<T>(Owner, new (Owner->Address()) T(a, b));
+    }
+#endif
 
     /**Returns a shared pointer of a base or derived type. The new pointer will
     have all the same ownership rights as source. A dynamic cast is used to
@@ -220,16 +425,17 @@ namespace PRIM_NAMESPACE
       //Create base (or derived) pointer.
       Pointer<BaseOrDerived> BasePointer;
 
-      //If not null then initialize the pointer and up the reference counts.
-      if(Reference and BaseCached and ReturnTripEnforce)
+      /*If not null then initialize the pointer and up the reference counts.
+      The strong count is only taken if the object is still alive.*/
+      if(Reference and BaseCached and ReturnTripEnforce and
+        meta::IncrementIfNonzero(Reference->ReferenceCount))
       {
         //Copy the pointer data over.
         BasePointer.Reference = Reference;
         BasePointer.CachedPointer = BaseCached;
 
-        //Increase the reference counts.
-        Reference->OwnerReferenceCount++;
-        Reference->ReferenceCount++;
+        //Increase the owner reference count.
+        ++Reference->OwnerReferenceCount;
       }
       return BasePointer;
     }
@@ -250,16 +456,18 @@ namespace PRIM_NAMESPACE
       //Create a const pointer already in an unshared state.
       Pointer<const T> Consted;
 
-      //Return immediately if null reference or null object.
-      if(not Reference or not Reference->OwnedPointerExists) return Consted;
+      /*Return immediately if null reference or null object. The strong count
+      is only taken if the object is still alive.*/
+      if(not Reference or not meta::IncrementIfNonzero(
+        Reference->ReferenceCount))
+          return Consted;
 
       //Copy the reference and cached pointer.
       Consted.Reference = Reference;
       Consted.CachedPointer = CachedPointer;
 
-      //Increment reference counts.
-      Reference->OwnerReferenceCount++;
-      Reference->ReferenceCount++;
+      //Increment the owner reference count.
+      ++Reference->OwnerReferenceCount;
 
       //Return the new const pointer.
       return Consted;
@@ -344,6 +552,10 @@ namespace PRIM_NAMESPACE
 
     protected:
 
+    ///Adopts a new owner that already counts this handle.
+    Pointer(meta::PointerOwner* Owner, T* Object) : Reference(Owner),
+      CachedPointer(Object) {}
+
     ///Stores a reference to the Pointer::Owner.
     meta::PointerOwner* Reference;
 
@@ -361,20 +573,20 @@ namespace PRIM_NAMESPACE
       CachedPointer = 0;
       if(not Reference)
         return;
-      CachedPointer = PointerToShare.CachedPointer;
 
-      //Do not propogate ownership of a null pointer.
-      if(not Reference->OwnedPointerExists)
+      /*Do not propogate ownership of a null pointer. A strong handle is only
+      taken if the object is still alive, so that one made from a weak handle
+      can not revive an object that the last strong handle is destroying.*/
+      if(Weak ? not Reference->OwnedPointerExists :
+        not meta::IncrementIfNonzero(Reference->ReferenceCount))
       {
         Reference = 0;
-        CachedPointer = 0;
         return;
       }
+      CachedPointer = PointerToShare.CachedPointer;
 
-      //Increment reference counts.
-      Reference->OwnerReferenceCount++;
-      if(not Weak)
-        Reference->ReferenceCount++;
+      //Increment the owner reference count.
+      ++Reference->OwnerReferenceCount;
     }
 
     /**Unshares the stored reference, possibly weakly. If no other pointers are
@@ -394,22 +606,18 @@ namespace PRIM_NAMESPACE
       }
 
       //Decrement object handle reference count and delete if no longer used.
-      if(not Weak)
+      if(not Weak and not --Reference->ReferenceCount)
       {
-        Reference->ReferenceCount--;
-        if(not Reference->ReferenceCount)
-        {
+        if(not Reference->DestroyInlineObject())
           delete CachedPointer;
-          Reference->OwnedPointerExists = false;
-        }
+        Reference->OwnedPointerExists = false;
       }
 
       //Uncache any existing pointer.
       CachedPointer = 0;
 
       //Decrement the owner handle reference count and delete if no longer used.
-      Reference->OwnerReferenceCount--;
-      if(not Reference->OwnerReferenceCount)
+      if(not --Reference->OwnerReferenceCount)
         delete Reference;
 
       //Clear the owner reference.
@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+  Copyright 2007-2013, 2017 Andi
+  Copyright 2013-2016 Robert Taub
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+
+  ==============================================================================
+*/
+
+
+#ifndef PRIM_INCLUDE_POOL_H
+#define PRIM_INCLUDE_POOL_H
+
+#ifndef PRIM_LIBRARY
+#error This file can not be included individually. Include prim.h instead.
+#endif
+
+namespace PRIM_NAMESPACE
+{
+  /**Free-list allocator for objects of a single type. Objects are created in
+  slabs of increasing size and are recycled through a free list instead of
+  being returned to the heap, so a container that repeatedly adds and removes
+  elements stops allocating once its pool is warm. Slab objects are constructed
+  with the default constructor when the slab is created and are only destroyed
+  when the pool is destroyed. Deleting an object resets it by assigning a
+  default-constructed object, so any resources it holds are released right
+  away.
+
+  A pool belongs to a single container. Copying a pool yields an empty pool, and
+  the container moves its pool along with its elements.*/
+  template <class T>
+  class Pool
+  {
+    ///Block of objects allocated at once
+    class Slab
+    {
+      public:
+
+      ///Objects in the slab
+      T* Objects;
+
+      ///Previously allocated slab
+      Slab* Previous;
+
+      ///Creates a slab with a given number of objects.
+      Slab(count Size, Slab* PreviousSlab) : Objects(new T[Size]),
+        Previous(PreviousSlab) {}
+
+      ///Deletes the objects in the slab.
+      ~Slab() {delete [] Objects;}
+    };
+
+    ///Most recently allocated slab
+    Slab* Slabs;
+
+    ///Number of objects in the most recent slab
+    count SlabSize;
+
+    ///Number of objects in the most recent slab that have been handed out
+    count SlabUsed;
+
+    ///Stack of recycled objects
+    T** FreeObjects;
+
+    ///Number of recycled objects on the stack
+    count Free;
+
+    ///Capacity of the recycled object stack
+    count FreeCapacity;
+
+    ///Number of objects currently handed out
+    count Live;
+
+    ///Size of the first slab
+    static count FirstSlabSize() {return 16;}
+
+    ///Size that slabs stop growing at
+    static count LargestSlabSize() {return 1024;}
+
+    ///Releases all slabs and the free stack.
+    void Release()
+    {
+      while(Slabs)
+      {
+        Slab* Previous = Slabs->Previous;
+        delete Slabs;
+        Slabs = Previous;
+      }
+      delete [] FreeObjects;
+      FreeObjects = 0;
+      SlabSize = SlabUsed = Free = FreeCapacity = Live = 0;
+    }
+
+    public:
+
+    ///Creates an empty pool.
+    Pool() : Slabs(0), SlabSize(0), SlabUsed(0), FreeObjects(0), Free(0),
+      FreeCapacity(0), Live(0) {}
+
+    ///Creates an empty pool (pools are never shared).
+    Pool(const Pool&) : Slabs(0), SlabSize(0), SlabUsed(0), FreeObjects(0),
+      Free(0), FreeCapacity(0), Live(0) {}
+
+    ///Leaves the pool unchanged (pools are never shared).
+    Pool& operator = (const Pool&) {return *this;}
+
+    ///Destroys all the objects in the pool.
+    ~Pool() {Release();}
+
+    ///Returns a default-constructed object from the pool.
+    T* New()
+    {
+      Live++;
+      if(Free)
+        return FreeObjects[--Free];
+      if(SlabUsed == SlabSize)
+      {
+        SlabSize = SlabSize ? Min(SlabSize * 2, LargestSlabSize()) :
+          FirstSlabSize();
+        Slabs = new Slab(SlabSize, Slabs);
+        SlabUsed = 0;
+      }
+      return &Slabs->Objects[SlabUsed++];
+    }
+
+    ///Resets an object and returns it to the pool.
+    void Delete(T* Object)
+    {
+      if(not Object)
+        return;
+      *Object = T();
+      if(Free == FreeCapacity)
+      {
+        count NewCapacity = FreeCapacity ? FreeCapacity * 2 : FirstSlabSize();
+        T** NewFreeObjects = new T*[NewCapacity];
+        Memory::Copy(NewFreeObjects, FreeObjects, Free);
+        delete [] FreeObjects;
+        FreeObjects = NewFreeObjects;
+        FreeCapacity = NewCapacity;
+      }
+      FreeObjects[Free++] = Object;
+      Live--;
+    }
+
+    ///Returns the number of objects currently handed out.
+    count n() const {return Live;}
+
+    ///Returns the number of objects waiting to be reused.
+    count Recycled() const {return Free;}
+
+    ///Swaps the contents of two pools.
+    void Swap(Pool& Other)
+    {
+      Memory::Swap(Slabs, Other.Slabs);
+      Memory::Swap(SlabSize, Other.SlabSize);
+      Memory::Swap(SlabUsed, Other.SlabUsed);
+      Memory::Swap(FreeObjects, Other.FreeObjects);
+      Memory::Swap(Free, Other.Free);
+      Memory::Swap(FreeCapacity, Other.FreeCapacity);
+      Memory::Swap(Live, Other.Live);
+    }
+  };
+
+  /**Allocation policy for List and Tree that creates each element separately
+  with new and deletes it with delete. This is the default policy.*/
+  class HeapAllocation
+  {
+    public:
+
+    ///Allocates objects on the heap.
+    template <class T>
+    class Allocator
+    {
+      public:
+
+      ///Allocates a default-constructed object.
+      T* New() {return new T;}
+
+      ///Deletes an object.
+      void Delete(T* Object) {delete Object;}
+
+      ///Heap allocators have no state to swap.
+      void Swap(Allocator&) {}
+    };
+  };
+
+  /**Allocation policy for List and Tree that allocates elements from a Pool
+  owned by the container. Tree nodes additionally store their key-value inline
+  instead of in a separate allocation. This suits containers that see a lot of
+  insertion and removal, at the cost of keeping the memory of removed elements
+  until the container is destroyed.*/
+  class PooledAllocation
+  {
+    public:
+
+    ///Allocates objects from a per-container pool.
+    template <class T>
+    class Allocator : public Pool<T> {};
+  };
+}
+#endif
@@ -654,7 +654,11 @@ namespace PRIM_NAMESPACE
     ///Reads a rational from a string.
     static Rational<IntegralType> FromString(const String& s)
     {
+      /*Scan the merged bytes directly instead of indexing the string, which
+      would otherwise walk its fragments for every character. The components
+      are read with integer arithmetic so that they are exact at any width.*/
       count Length = s.n();
+      const ascii* Data = s.Merge();
       IntegralType n = 0, d = 0;
       bool IsPastSlash = false;
       bool IsInvalid = false;
@@ -666,7 +670,7 @@ namespace PRIM_NAMESPACE
 
       //Look for initial negative sign.
       count Start = 0;
-      if(s[0] == '-')
+      if(Data[0] == '-')
       {
         Start = 1;
         IsNegative = true;
@@ -674,7 +678,7 @@ namespace PRIM_NAMESPACE
 
       for(count i = Start; i < Length; i++)
       {
-        ascii cr = ascii(s[i]);
+        ascii cr = Data[i];
         if(cr == '/')
         {
           //Invalid use of slash.
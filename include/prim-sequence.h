@@ -0,0 +1,540 @@
+/*
+  ==============================================================================
+
+  Copyright 2007-2013, 2017 Andi
+  Copyright 2013-2016 Robert Taub
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+
+  ==============================================================================
+*/
+
+
+#ifndef PRIM_INCLUDE_SEQUENCE_H
+#define PRIM_INCLUDE_SEQUENCE_H
+
+#ifndef PRIM_LIBRARY
+#error This file can not be included individually. Include prim.h instead.
+#endif
+
+namespace PRIM_NAMESPACE
+{
+  /**Chunked sequence with the same interface as List but constant-time random
+  access.
+
+  The elements are stored in fixed-size blocks that are reached through an
+  index of block pointers. Element i is found by dividing its position by the
+  block size, so indexing does not depend on the previous access pattern the
+  way List does. Appending and prepending only ever allocate a new block at one
+  end, and inserting or removing in the middle shifts the elements on whichever
+  side of the index is shorter. Elements never move between blocks when the
+  sequence grows at either end, so references to them remain valid until the
+  next middle insertion or removal.*/
+  template <class T>
+  class Sequence
+  {
+    ///Block geometry
+    enum
+    {
+      BlockBits = 5,
+      BlockSize = 1 << BlockBits,
+      BlockMask = BlockSize - 1
+    };
+
+    ///Index of block pointers
+    T** Blocks;
+
+    ///Number of slots in the block index
+    count Slots;
+
+    ///Slot of the first block in use
+    count FirstBlock;
+
+    ///Number of blocks in use
+    count UsedBlocks;
+
+    ///Position of the first element within the first block
+    count Start;
+
+    ///Number of elements in the sequence
+    count Items;
+
+    ///Empty item in case of bad access.
+    mutable T Empty; PRIM_PAD(T)
+
+    ///Returns the element at an index without checking bounds.
+    inline T& At(count i) const
+    {
+      count p = Start + i;
+      return Blocks[FirstBlock + (p >> BlockBits)][p & BlockMask];
+    }
+
+    ///Moves one element onto another, copying if moves are not available.
+    static void Transfer(T& Destination, T& Source)
+    {
+#ifdef PRIM_11
+      Destination = Move(Source);
+#else
+      Destination = Source;
+#endif
+    }
+
+    /**Rebuilds the block index with room for more blocks on both sides. The
+    blocks themselves are not touched.*/
+    void Reindex()
+    {
+      count NewSlots = Max(count(4), UsedBlocks * 2 + 2);
+      T** NewBlocks = new T*[NewSlots];
+      count NewFirstBlock = (NewSlots - UsedBlocks) / 2;
+      for(count i = 0; i < UsedBlocks; i++)
+        NewBlocks[NewFirstBlock + i] = Blocks[FirstBlock + i];
+      delete [] Blocks;
+      Blocks = NewBlocks;
+      Slots = NewSlots;
+      FirstBlock = NewFirstBlock;
+    }
+
+    ///Makes room for one more element at the end.
+    void GrowBack()
+    {
+      if(Start + Items == UsedBlocks * BlockSize)
+      {
+        if(FirstBlock + UsedBlocks == Slots)
+          Reindex();
+        Blocks[FirstBlock + UsedBlocks++] = new T[BlockSize];
+      }
+      Items++;
+    }
+
+    ///Makes room for one more element at the beginning.
+    void GrowFront()
+    {
+      if(not Start)
+      {
+        if(not FirstBlock)
+          Reindex();
+        Blocks[--FirstBlock] = new T[BlockSize];
+        UsedBlocks++;
+        Start = BlockSize;
+      }
+      Start--;
+      Items++;
+    }
+
+    ///Removes the first element, which must already have been reset.
+    void ShrinkFront()
+    {
+      Items--;
+      if(not Items)
+        ReleaseBlocks();
+      else if(++Start == BlockSize)
+      {
+        delete [] Blocks[FirstBlock++];
+        UsedBlocks--;
+        Start = 0;
+      }
+    }
+
+    ///Removes the last element, which must already have been reset.
+    void ShrinkBack()
+    {
+      Items--;
+      if(not Items)
+        ReleaseBlocks();
+      else if(Start + Items <= (UsedBlocks - 1) * BlockSize)
+        delete [] Blocks[FirstBlock + --UsedBlocks];
+    }
+
+    ///Deletes all the blocks and the block index.
+    void ReleaseBlocks()
+    {
+      for(count i = 0; i < UsedBlocks; i++)
+        delete [] Blocks[FirstBlock + i];
+      delete [] Blocks;
+      Blocks = 0;
+      Slots = FirstBlock = UsedBlocks = Start = Items = 0;
+    }
+
+    ///Copies the elements of another sequence to the end of this one.
+    void AppendFrom(const Sequence& Other)
+    {
+      for(count i = 0; i < Other.Items; i++)
+        Add() = Other.At(i);
+    }
+
+    public:
+
+    ///Constructor initializes an empty sequence.
+    Sequence() : Blocks(0), Slots(0), FirstBlock(0), UsedBlocks(0), Start(0),
+      Items(0) {}
+
+    ///Copy constructor to create a deep copy of another sequence.
+    Sequence(const Sequence& Other) : Blocks(0), Slots(0), FirstBlock(0),
+      UsedBlocks(0), Start(0), Items(0)
+    {
+      AppendFrom(Other);
+    }
+
+    ///Assigns this sequence a deep copy of another sequence.
+    Sequence& operator = (const Sequence& Other)
+    {
+      if(&Other != this)
+      {
+        RemoveAll();
+        AppendFrom(Other);
+      }
+      return *this;
+    }
+
+#ifdef PRIM_11
+    ///Move constructor takes over the blocks of the other sequence.
+    Sequence(Sequence&& Other) noexcept : Blocks(0), Slots(0), FirstBlock(0),
+      UsedBlocks(0), Start(0), Items(0)
+    {
+      *this = Move(Other);
+    }
+
+    /**Move assignment removes the current elements and takes over the blocks of
+    the other sequence.*/
+    Sequence& operator = (Sequence&& Other) noexcept
+    {
+      if(&Other == this)
+        return *this;
+      ReleaseBlocks();
+      Memory::Swap(Blocks, Other.Blocks);
+      Memory::Swap(Slots, Other.Slots);
+      Memory::Swap(FirstBlock, Other.FirstBlock);
+      Memory::Swap(UsedBlocks, Other.UsedBlocks);
+      Memory::Swap(Start, Other.Start);
+      Memory::Swap(Items, Other.Items);
+      return *this;
+    }
+#endif
+
+    ///Destructor
+    ~Sequence() {ReleaseBlocks();}
+
+    //--------------//
+    //Element Access//
+    //--------------//
+
+    ///Returns the number of items in the sequence.
+    inline count n() const {return Items;}
+
+    /**Returns a const item by index. If the index is out-of-bounds an empty
+    value is returned.*/
+    inline const T& ith(count i) const
+    {
+      if(uint64(i) >= uint64(Items))
+      {
+        Empty = Nothing<T>();
+        return Empty;
+      }
+      return At(i);
+    }
+
+    /**Returns an item by index. If the index is out-of-bounds an empty value is
+    returned.*/
+    inline T& ith(count i)
+    {
+      if(uint64(i) >= uint64(Items))
+      {
+        Empty = Nothing<T>();
+        return Empty;
+      }
+      return At(i);
+    }
+
+    ///Gets a const element reference using the familiar bracket notation.
+    inline const T& operator [] (count i) const {return ith(i);}
+
+    ///Gets an element reference using the familiar bracket notation.
+    inline T& operator [] (count i) {return ith(i);}
+
+    ///Shorthand for getting the first element.
+    inline const T& a() const {return ith(0);}
+
+    ///Shorthand for getting the first element.
+    inline T& a() {return ith(0);}
+
+    /**Shorthand for getting an element with respect to the end of the sequence.
+    ItemsFromEnd must be nonnegative.*/
+    inline const T& z(count ItemsFromEnd = 0) const
+    {
+      return ith(Items - 1 - ItemsFromEnd);
+    }
+
+    /**Shorthand for getting an element with respect to the end of the sequence.
+    ItemsFromEnd must be nonnegative.*/
+    inline T& z(count ItemsFromEnd = 0) {return ith(Items - 1 - ItemsFromEnd);}
+
+    ///Swaps the values of two elements.
+    void Swap(count i, count j)
+    {
+      if(i == j or i < 0 or j < 0 or i >= Items or j >= Items)
+        return;
+#ifdef PRIM_11
+      T x = Move(At(i));
+      At(i) = Move(At(j));
+      At(j) = Move(x);
+#else
+      Memory::Swap(At(i), At(j));
+#endif
+    }
+
+    //------//
+    //Adding//
+    //------//
+
+    ///Adds an element to the end using its default value.
+    T& Add()
+    {
+      GrowBack();
+      return At(Items - 1);
+    }
+
+    ///Adds an existing element to the end by assigning it to the new element.
+    T& Add(const T& x)
+    {
+      //Block storage is stable so x remains valid if it aliases an element.
+      T& NewElement = Add();
+      NewElement = x;
+      return NewElement;
+    }
+
+#ifdef PRIM_11
+    ///Adds an existing element to the end by moving it into the new element.
+    T& Add(T&& x)
+    {
+      T& NewElement = Add();
+      NewElement = Move(x);
+      return NewElement;
+    }
+#endif
+
+    ///Appends an element to the end of the sequence by copying the argument.
+    void Append(const T& NewElement) {Add(NewElement);}
+
+    ///Pushes an element to the end of the sequence as though it were a stack.
+    inline void Push(const T& NewElement) {Add(NewElement);}
+
+#ifdef PRIM_11
+    ///Appends an element to the end of the sequence by moving the argument.
+    void Append(T&& NewElement) {Add(Move(NewElement));}
+
+    ///Pushes an element to the end of the sequence by moving the argument.
+    inline void Push(T&& NewElement) {Add(Move(NewElement));}
+#endif
+
+    ///Prepends an element to the beginning of the sequence.
+    void Prepend(const T& NewElement)
+    {
+      GrowFront();
+      At(0) = NewElement;
+    }
+
+    /**Inserts an element before some other element referenced by index. The
+    elements on the shorter side of the index are shifted to make room.*/
+    void InsertBefore(const T& NewElement, count ElementAfter)
+    {
+      if(ElementAfter <= 0)
+        Prepend(NewElement);
+      else if(ElementAfter >= Items)
+        Append(NewElement);
+      else
+      {
+        //The element may belong to this sequence, so copy it before shifting.
+        T Copy = NewElement;
+        if(ElementAfter < Items / 2)
+        {
+          GrowFront();
+          for(count i = 0; i < ElementAfter; i++)
+            Transfer(At(i), At(i + 1));
+        }
+        else
+        {
+          GrowBack();
+          for(count i = Items - 1; i > ElementAfter; i--)
+            Transfer(At(i), At(i - 1));
+        }
+        Transfer(At(ElementAfter), Copy);
+      }
+    }
+
+    ///Inserts an element after some other element referenced by index.
+    void InsertAfter(const T& NewElement, count ElementBefore)
+    {
+      InsertBefore(NewElement, ElementBefore < 0 ? count(0) :
+        ElementBefore + 1);
+    }
+
+    //--------//
+    //Removing//
+    //--------//
+
+    /**Removes an item by its index. The elements on the shorter side of the
+    index are shifted to close the gap.*/
+    void Remove(count i)
+    {
+      if(i < 0 or i >= Items)
+        return;
+
+      if(i < Items / 2)
+      {
+        for(count j = i; j > 0; j--)
+          Transfer(At(j), At(j - 1));
+        At(0) = T();
+        ShrinkFront();
+      }
+      else
+      {
+        for(count j = i; j < Items - 1; j++)
+          Transfer(At(j), At(j + 1));
+        At(Items - 1) = T();
+        ShrinkBack();
+      }
+    }
+
+    /**Removes an element from the sequence and calls delete on it. Only use
+    this if the element is a pointer to an object on the heap.*/
+    void RemoveAndDelete(count i)
+    {
+      delete ith(i);
+      Remove(i);
+    }
+
+    ///Pops the element at the end off as though it were a stack.
+    T Pop()
+    {
+      T Copy = Nothing<T>();
+      if(Items)
+      {
+        Transfer(Copy, At(Items - 1));
+        At(Items - 1) = T();
+        ShrinkBack();
+      }
+      return Copy;
+    }
+
+    ///Pops off and deletes the element at the end of the sequence.
+    void PopAndDelete()
+    {
+      RemoveAndDelete(Items - 1);
+    }
+
+    ///Removes all the elements and releases their storage.
+    void RemoveAll() {ReleaseBlocks();}
+
+    /**Deletes all elements and then removes them from the sequence. Only call
+    this if the element is some kind of pointer to an object on the heap.*/
+    void RemoveAndDeleteAll()
+    {
+      for(count i = 0; i < Items; i++)
+        delete At(i);
+      RemoveAll();
+    }
+
+    ///Removes all elements greater than or equal to the index given.
+    void RemoveFrom(count i)
+    {
+      while(Items and Items > i)
+        Pop();
+    }
+
+    ///Removes and deletes elements greater or equal to the index given.
+    void RemoveAndDeleteFrom(count i)
+    {
+      while(Items and Items > i)
+        PopAndDelete();
+    }
+
+    //---------//
+    //Searching//
+    //---------//
+
+    ///Searches for the index of an item. Returns -1 if not found.
+    count Search(const T& ItemToSearchFor) const
+    {
+      for(count i = 0; i < Items; i++)
+        if(At(i) == ItemToSearchFor)
+          return i;
+      return -1;
+    }
+
+    ///Checks to see whether an item exists in the sequence.
+    bool Contains(const T& ItemToSearchFor) const
+    {
+      return Search(ItemToSearchFor) != -1;
+    }
+
+    //------------------//
+    //Element Comparison//
+    //------------------//
+
+    ///Returns whether all elements are less than a maximum.
+    bool operator < (const T& Maximum) const
+    {
+      for(count i = 0; i < Items; i++)
+        if(not (At(i) < Maximum))
+          return false;
+      return true;
+    }
+
+    ///Returns whether all elements are less than or equal to a maximum.
+    bool operator <= (const T& Maximum) const
+    {
+      for(count i = 0; i < Items; i++)
+        if(not (At(i) <= Maximum))
+          return false;
+      return true;
+    }
+
+    ///Returns whether all elements are the same as the value.
+    bool operator == (const T& Same) const
+    {
+      for(count i = 0; i < Items; i++)
+        if(not (At(i) == Same))
+          return false;
+      return true;
+    }
+
+    ///Returns whether all elements are greater than or equal to a minimum.
+    bool operator >= (const T& Minimum) const
+    {
+      for(count i = 0; i < Items; i++)
+        if(not (At(i) >= Minimum))
+          return false;
+      return true;
+    }
+
+    ///Returns whether all elements are greater than a minimum.
+    bool operator > (const T& Minimum) const
+    {
+      for(count i = 0; i < Items; i++)
+        if(not (At(i) > Minimum))
+          return false;
+      return true;
+    }
+  };
+}
+#endif
@@ -578,10 +578,889 @@ namespace PRIM_NAMESPACE
       return StoredChecksum.n() == 32 and StoredChecksum == ActualChecksum;
     }
   };
+
+  /**Compact tagged binary encoding of Value. Each value starts with a tag byte
+  that is followed by its data:
+
+    TagNil, TagFalse, TagTrue  nothing
+    TagInteger                 zigzag varint
+    TagNumber                  float64
+    TagRatio                   zigzag varint numerator and denominator
+    TagVector                  two float64 (x, y)
+    TagBox                     four float64 (a.x, a.y, b.x, b.y)
+    TagString                  varint length followed by the bytes
+    TagArray                   varint body length, varint count, and elements
+    TagTree                    varint body length, varint count, and each key
+                               followed by its value in key order
+    TagIndexedArray            as TagArray with an offset table after the count
+    TagIndexedTree             as TagTree with an offset table after the count
+
+  Varints are unsigned little-endian base-128, and float64 is stored in
+  little-endian order. The body length of a container counts the bytes after
+  it, so a Reader can step over a container without looking inside. Containers
+  with at least IndexThreshold entries also store the uint32 offset of each
+  element (or key) from the end of the table, so that a Reader can index an
+  array directly and binary search the string keys of a tree. Symbols are
+  written as strings and objects as nil since they can not be restored. Tree
+  entries with object keys are left out, since a nil key would not keep the
+  key order that lookups in the tree rely on.*/
+  class BinaryValue
+  {
+    public:
+
+    ///Tag byte that begins each encoded value
+    enum Tag
+    {
+      TagNil,
+      TagFalse,
+      TagTrue,
+      TagInteger,
+      TagNumber,
+      TagRatio,
+      TagVector,
+      TagBox,
+      TagString,
+      TagArray,
+      TagTree,
+      TagIndexedArray,
+      TagIndexedTree
+    };
+
+    ///Number of entries at which a container is given an offset table
+    static const count IndexThreshold = 8;
+
+    /**View of an encoded value that only decodes what is asked for. Arrays and
+    trees are searched in place, using their offset tables when they have them,
+    so a key can be looked up without decoding the rest of the data. The data
+    must outlive the reader. Missing keys and malformed data read as nil.*/
+    class Reader
+    {
+      ///Tag byte of the value, or null if nil
+      const byte* Begin;
+
+      ///End of the encoded value
+      const byte* End;
+
+      ///End of the enclosing container or data
+      const byte* Limit;
+
+      public:
+
+      ///Creates a nil reader.
+      Reader() : Begin(0), End(0), Limit(0) {}
+
+      ///Reads the value at the start of a span of bytes.
+      Reader(const byte* Begin_, const byte* Limit_) : Begin(Begin_),
+        End(Skip(Begin_, Limit_)), Limit(Limit_)
+      {
+        if(not End)
+          Begin = Limit = 0;
+      }
+
+      ///Reads the value at the start of an array of bytes.
+      Reader(const Array<byte>& Data) : Begin(0), End(0), Limit(0)
+      {
+        if(Data.n())
+          *this = Reader(&Data.a(), &Data.a() + Data.n());
+      }
+
+      ///Returns the tag of the value.
+      Tag Type() const {return Begin ? Tag(*Begin) : TagNil;}
+
+      ///Returns whether the value is nil.
+      bool IsNil() const {return Type() == TagNil;}
+
+      ///Returns whether the value is a string.
+      bool IsString() const {return Type() == TagString;}
+
+      ///Returns whether the value is an array.
+      bool IsArray() const
+      {
+        return Type() == TagArray or Type() == TagIndexedArray;
+      }
+
+      ///Returns whether the value is a tree.
+      bool IsTree() const
+      {
+        return Type() == TagTree or Type() == TagIndexedTree;
+      }
+
+      ///Returns the number of bytes used to encode the value.
+      count Size() const {return count(End - Begin);}
+
+      ///Returns the number of elements in an array or pairs in a tree.
+      count n() const
+      {
+        uint64 Count = 0;
+        const byte* Table = 0;
+        Contents(Count, Table);
+        return count(Count);
+      }
+
+      ///Returns the first element of an array or the first key of a tree.
+      Reader First() const
+      {
+        uint64 Count = 0;
+        const byte* Table = 0;
+        const byte* p = Contents(Count, Table);
+        return Count ? Reader(p, End) : Reader();
+      }
+
+      /**Returns the value that follows this one in its container. The keys and
+      values of a tree alternate. After the last one the result is nil, so
+      iterate using n() to tell that apart from a nil element.*/
+      Reader Next() const
+      {
+        return End and End < Limit ? Reader(End, Limit) : Reader();
+      }
+
+      ///Returns the value of a tree with the key or the element of an array.
+      template <class T> Reader operator [] (const T& Key) const
+      {
+        return Find(Value(Key));
+      }
+
+      /**Returns the value of a tree with the given key, or the element of an
+      array if the key is an integer. String keys are compared against the
+      encoded bytes without decoding the keys of the tree.*/
+      Reader Find(const Value& Key) const;
+
+      ///Returns the value as a boolean following the rules of Value.
+      bool AsBoolean() const;
+
+      ///Returns the value as an integer following the rules of Value.
+      integer AsInteger() const;
+
+      ///Returns the value as a number following the rules of Value.
+      number AsNumber() const;
+
+      ///Returns the value as a ratio following the rules of Value.
+      Ratio AsRatio() const {return ToValue().AsRatio();}
+
+      ///Returns the value as a vector following the rules of Value.
+      Vector AsVector() const {return ToValue().AsVector();}
+
+      ///Returns the value as a rectangle following the rules of Value.
+      Box AsBox() const {return ToValue().AsBox();}
+
+      ///Returns the value as a string following the rules of Value.
+      String AsString() const;
+
+      /**Returns a view of the bytes of a string without copying them. Other
+      types return an empty view.*/
+      StringView AsStringView() const
+      {
+        uint64 Length = 0;
+        const byte* p = IsString() ? ReadVarint(Begin + 1, End, Length) : 0;
+        return p ? StringView(p, count(Length)) : StringView();
+      }
+
+      ///Decodes the value with all of its contents.
+      Value ToValue() const
+      {
+        Value v;
+        if(Begin)
+          Decode(Begin, End, v);
+        return v;
+      }
+
+      private:
+
+      /**Returns the first element of an array or key of a tree, and reads the
+      count and the location of the offset table if there is one. Other types
+      return null with a count of zero.*/
+      const byte* Contents(uint64& Count, const byte*& Table) const;
+
+      /**Returns the element of an array or key of a tree at the index, which
+      is assumed to be in range.*/
+      Reader Entry(count i) const;
+
+      /**Compares the key of a tree with a string in the order of Value. Keys
+      of other types are ordered by their tag.*/
+      static int CompareKey(const Reader& k, const StringView& Key);
+    };
+
+    /**Encodes a value into a buffer of the given capacity. Returns the number
+    of bytes written, or zero if the encoding does not fit.*/
+    static count Export(const Value& ValueToExport, byte* Destination,
+      count Capacity);
+
+    ///Encodes a value into an array of bytes.
+    static void Export(const Value& ValueToExport, Array<byte>& Data);
+
+    ///Encodes a value into an array of bytes.
+    static Array<byte> Export(const Value& ValueToExport)
+    {
+      Array<byte> Data;
+      Export(ValueToExport, Data);
+      return Data;
+    }
+
+    ///Encodes a value to a file. Returns whether the file was written.
+    static bool ExportFile(const ascii* Filename, const Value& ValueToExport)
+    {
+      return File::Write(Filename, Export(ValueToExport));
+    }
+
+    /**Decodes the value at the start of a span of bytes. Returns false and
+    leaves the result nil if the data is malformed.*/
+    static bool Import(const byte* Begin, const byte* End, Value& Result)
+    {
+      Result.Clear();
+      const byte* ValueEnd = Begin ? Skip(Begin, End) : 0;
+      if(ValueEnd and Decode(Begin, ValueEnd, Result) == ValueEnd)
+        return true;
+      Result.Clear();
+      return false;
+    }
+
+    ///Decodes the value at the start of an array of bytes.
+    static Value Import(const Array<byte>& Data)
+    {
+      Value Result;
+      if(Data.n())
+        Import(&Data.a(), &Data.a() + Data.n(), Result);
+      return Result;
+    }
+
+    private:
+
+    /*Encoding takes place in two passes. Measure() finds the size of the body
+    of each array and tree in the order that they are written, and Write() then
+    fills a buffer of exactly the right size without having to go back and
+    patch any lengths.*/
+
+    /**Returns the size of an encoded value and records the size of the
+    elements of each container.*/
+    static count Measure(const Value& v, Array<count>& Elements);
+
+    ///Writes an encoded value using the container sizes from Measure().
+    static byte* Write(const Value& v, const Array<count>& Elements,
+      count& NextElements, byte* Out);
+
+    /**Returns whether a container is given an offset table, which requires
+    that the offsets of its entries fit in 32 bits.*/
+    static bool IsIndexed(count Entries, count ElementBytes)
+    {
+      return Entries >= IndexThreshold and
+        uint64(ElementBytes) <= uint64(0xffffffffu);
+    }
+
+    ///Returns the number of entries of a tree that do not have an object key.
+    static count EncodedEntries(const Value::TreeType& t)
+    {
+      count Entries = 0;
+      Value::TreeType::Iterator It;
+      for(It.Begin(t); It.Iterating(); It.Next())
+        if(not It.Key().IsObject())
+          Entries++;
+      return Entries;
+    }
+
+    ///Returns the size of the body of a container.
+    static count BodySize(count Entries, count ElementBytes)
+    {
+      return VarintSize(uint64(Entries)) + ElementBytes +
+        (IsIndexed(Entries, ElementBytes) ? 4 * Entries : 0);
+    }
+
+    /**Decodes the value at the start of a span that holds exactly one value.
+    Returns the end of the value or null if the data is malformed.*/
+    static const byte* Decode(const byte* p, const byte* End, Value& Result);
+
+    /**Returns the end of the value at the start of a span, or null if it does
+    not fit in the span. The contents of containers are not examined.*/
+    static const byte* Skip(const byte* p, const byte* End);
+
+    ///Returns the number of bytes needed to store a varint.
+    static count VarintSize(uint64 x)
+    {
+      count Size = 1;
+      while(x >>= 7)
+        Size++;
+      return Size;
+    }
+
+    ///Writes a varint and returns the end of it.
+    static byte* WriteVarint(byte* Out, uint64 x)
+    {
+      for(; x >= 0x80; x >>= 7)
+        *Out++ = byte(x | 0x80);
+      *Out++ = byte(x);
+      return Out;
+    }
+
+    ///Reads a varint and returns the end of it, or null if it is malformed.
+    static const byte* ReadVarint(const byte* p, const byte* End, uint64& x)
+    {
+      x = 0;
+      for(count Shift = 0; p and p < End and Shift < 64; Shift += 7)
+      {
+        byte b = *p++;
+        x |= uint64(b & 0x7f) << Shift;
+        if(not (b & 0x80))
+          return p;
+      }
+      return 0;
+    }
+
+    ///Maps signed integers to unsigned so that small magnitudes stay small.
+    static uint64 ZigZag(int64 x)
+    {
+      return (uint64(x) << 1) ^ uint64(x >> 63);
+    }
+
+    ///Reverses the zigzag mapping.
+    static int64 UnZigZag(uint64 x)
+    {
+      return int64(x >> 1) ^ -int64(x & 1);
+    }
+
+    ///Writes a little-endian float64 and returns the end of it.
+    static byte* WriteFloat(byte* Out, float64 x)
+    {
+      Endian::ConvertToLittleEndian(x);
+      Memory::MemCopy(Out, &x, count(sizeof(float64)));
+      return Out + sizeof(float64);
+    }
+
+    ///Reads a little-endian float64.
+    static float64 ReadFloat(const byte* p)
+    {
+      float64 x = 0.0;
+      Memory::MemCopy(&x, p, count(sizeof(float64)));
+      Endian::ConvertToLittleEndian(x);
+      return x;
+    }
+
+    ///Writes a little-endian offset into a table.
+    static void WriteOffset(byte* Table, count i, uint32 x)
+    {
+      Endian::ConvertToLittleEndian(x);
+      Memory::MemCopy(Table + 4 * i, &x, 4);
+    }
+
+    ///Reads a little-endian offset from a table.
+    static count ReadOffset(const byte* Table, count i)
+    {
+      uint32 x = 0;
+      Memory::MemCopy(&x, Table + 4 * i, 4);
+      Endian::ConvertToLittleEndian(x);
+      return count(x);
+    }
+  };
+
+#ifdef PRIM_WITH_MEMORY_MAP
+  /**Value document that is read in place from a file written by
+  BinaryValue::ExportFile(). The file is memory-mapped read-only and nothing is
+  decoded when it is opened. Keys and indices are resolved against the mapped
+  bytes using the offset tables of the containers, so only the pages that are
+  touched are ever read, and processes that map the same file share them. The
+  readers that are returned are only valid while the document is open.*/
+  class MappedValue
+  {
+    ///Memory map of the file
+    MemoryMap Map;
+
+    ///Root value of the document
+    BinaryValue::Reader Document;
+
+    ///Copying is not allowed.
+    MappedValue(const MappedValue&);
+
+    ///Assignment is not allowed.
+    MappedValue& operator = (const MappedValue&);
+
+    public:
+
+    ///Creates a closed document.
+    MappedValue() {}
+
+    ///Opens the document in a file.
+    MappedValue(const ascii* Filename) {Open(Filename);}
+
+    /**Maps a file and reads the value at its start. Returns false if the file
+    could not be mapped or does not begin with a complete value.*/
+    bool Open(const ascii* Filename)
+    {
+      Close();
+      if(not Map.Open(Filename))
+        return false;
+      const byte* Begin = reinterpret_cast<const byte*>(Map.a());
+      Document = BinaryValue::Reader(Begin, Begin + Map.n());
+      if(not Document.Size())
+        Close();
+      return IsOpen();
+    }
+
+    ///Closes the document.
+    void Close()
+    {
+      Document = BinaryValue::Reader();
+      Map.Close();
+    }
+
+    ///Returns whether a document is open.
+    bool IsOpen() const {return Document.Size() > 0;}
+
+    ///Returns the root value of the document.
+    const BinaryValue::Reader& Root() const {return Document;}
+
+    ///Returns the value of the root tree with the key or array element.
+    template <class T> BinaryValue::Reader operator [] (const T& Key) const
+    {
+      return Document[Key];
+    }
+
+    ///Returns the number of elements in the root value.
+    count n() const {return Document.n();}
+
+    ///Decodes the whole document.
+    Value ToValue() const {return Document.ToValue();}
+  };
+#endif
+
 #ifdef PRIM_COMPILE_INLINE
   //Avoid weak-vtable warning by putting at a virtual method out-of-line.
   Serial::~Serial() {}
   Serial::Object::~Object() {}
+
+  BinaryValue::Reader BinaryValue::Reader::Find(const Value& Key) const
+  {
+    if(IsArray())
+    {
+      count i = Key.IsInteger() ? count(Key.AsInteger()) : -1;
+      return i >= 0 and i < n() ? Entry(i) : Reader();
+    }
+    else if(not IsTree())
+      return Reader();
+
+    String KeyString;
+    if(Key.IsString())
+      KeyString = Key.AsString();
+    StringView KeyView(KeyString);
+
+    //With an offset table, the string keys can be binary searched.
+    uint64 Count = 0;
+    const byte* Table = 0;
+    Contents(Count, Table);
+    if(Table and Key.IsString())
+    {
+      count Low = 0, High = count(Count);
+      while(Low < High)
+      {
+        count Middle = Low + (High - Low) / 2;
+        Reader k = Entry(Middle);
+        int Compared = CompareKey(k, KeyView);
+        if(Compared < 0)
+          Low = Middle + 1;
+        else if(Compared > 0)
+          High = Middle;
+        else
+          return k.Next();
+      }
+      return Reader();
+    }
+
+    Reader k = First();
+    for(count i = count(Count); i > 0; i--)
+    {
+      Reader v = k.Next();
+      if(Key.IsString() ? k.IsString() and k.AsStringView() == KeyView :
+        not k.IsString() and k.ToValue() == Key)
+          return v;
+      k = v.Next();
+    }
+    return Reader();
+  }
+
+  const byte* BinaryValue::Reader::Contents(uint64& Count,
+    const byte*& Table) const
+  {
+    uint64 Body = 0;
+    Count = 0;
+    Table = 0;
+    if(not IsArray() and not IsTree())
+      return 0;
+    const byte* p = ReadVarint(ReadVarint(Begin + 1, End, Body), End, Count);
+    if(p and (Type() == TagIndexedArray or Type() == TagIndexedTree))
+    {
+      if(Count > uint64(End - p) / 4)
+      {
+        Count = 0;
+        return 0;
+      }
+      Table = p;
+      p += 4 * Count;
+    }
+    if(not p)
+      Count = 0;
+    return p;
+  }
+
+  BinaryValue::Reader BinaryValue::Reader::Entry(count i) const
+  {
+    uint64 Count = 0;
+    const byte* Table = 0;
+    const byte* p = Contents(Count, Table);
+    if(Table)
+    {
+      count Offset = ReadOffset(Table, i);
+      return Offset < count(End - p) ? Reader(p + Offset, End) : Reader();
+    }
+
+    //Without a table, step over the preceding entries.
+    Reader r(p, End);
+    for(count Steps = IsTree() ? i * 2 : i; Steps > 0; Steps--)
+      r = r.Next();
+    return r;
+  }
+
+  int BinaryValue::Reader::CompareKey(const Reader& k, const StringView& Key)
+  {
+    if(k.Type() != TagString)
+      return k.Type() < TagString ? -1 : 1;
+
+    //Strings are ordered as by strcmp(), which stops at a null byte.
+    StringView a = k.AsStringView(), b = Key;
+    if(const byte* Null = StringView::FindByte(a.Begin(), a.n(), 0))
+      a = StringView(a.Begin(), count(Null - a.Begin()));
+    if(const byte* Null = StringView::FindByte(b.Begin(), b.n(), 0))
+      b = StringView(b.Begin(), count(Null - b.Begin()));
+    return a < b ? -1 : b < a ? 1 : 0;
+  }
+
+  bool BinaryValue::Reader::AsBoolean() const
+  {
+    return Type() == TagTrue or (Type() != TagFalse and ToValue().AsBoolean());
+  }
+
+  integer BinaryValue::Reader::AsInteger() const
+  {
+    uint64 x = 0;
+    if(Type() == TagInteger and ReadVarint(Begin + 1, End, x))
+      return integer(UnZigZag(x));
+    return ToValue().AsInteger();
+  }
+
+  number BinaryValue::Reader::AsNumber() const
+  {
+    if(Type() == TagNumber)
+      return number(ReadFloat(Begin + 1));
+    return ToValue().AsNumber();
+  }
+
+  String BinaryValue::Reader::AsString() const
+  {
+    if(IsString())
+      return String(AsStringView());
+    return ToValue().AsString();
+  }
+
+  count BinaryValue::Export(const Value& ValueToExport, byte* Destination,
+    count Capacity)
+  {
+    Array<count> Elements;
+    count Size = Measure(ValueToExport, Elements);
+    if(Size > Capacity)
+      return 0;
+    count NextElements = 0;
+    Write(ValueToExport, Elements, NextElements, Destination);
+    return Size;
+  }
+
+  void BinaryValue::Export(const Value& ValueToExport, Array<byte>& Data)
+  {
+    Array<count> Elements;
+    Data.n(Measure(ValueToExport, Elements));
+    count NextElements = 0;
+    Write(ValueToExport, Elements, NextElements, &Data.a());
+  }
+
+  count BinaryValue::Measure(const Value& v, Array<count>& Elements)
+  {
+    switch(v.ValueType)
+    {
+    case Value::ValueTypeNil:
+    case Value::ValueTypeBoolean:
+    case Value::ValueTypeObject:
+      return 1;
+    case Value::ValueTypeInteger:
+      return 1 + VarintSize(ZigZag(int64(v.DataIntegerValue)));
+    case Value::ValueTypeNumber:
+      return 1 + count(sizeof(float64));
+    case Value::ValueTypeRatio:
+      {
+        Ratio r = v.InternalRatio();
+        return 1 + VarintSize(ZigZag(int64(r.Numerator()))) +
+          VarintSize(ZigZag(int64(r.Denominator())));
+      }
+    case Value::ValueTypeVector:
+      return 1 + 2 * count(sizeof(float64));
+    case Value::ValueTypeBox:
+      return 1 + 4 * count(sizeof(float64));
+    case Value::ValueTypeString:
+      {
+        count Length = v.InternalStringView().n();
+        return 1 + VarintSize(uint64(Length)) + Length;
+      }
+    case Value::ValueTypeArray:
+      {
+        const Value::ArrayType& a = v.AssumeAndGet<Value::ArrayType>();
+        count Slot = Elements.n(), Bytes = 0;
+        Elements.Add(0);
+        for(count i = 0, n = a.n(); i < n; i++)
+          Bytes += Measure(a[i], Elements);
+        Elements[Slot] = Bytes;
+        count Body = BodySize(a.n(), Bytes);
+        return 1 + VarintSize(uint64(Body)) + Body;
+      }
+    case Value::ValueTypeTree:
+      {
+        const Value::TreeType& t = v.AssumeAndGet<Value::TreeType>();
+        count Slot = Elements.n(), Bytes = 0;
+        Elements.Add(0);
+        Value::TreeType::Iterator It;
+        for(It.Begin(t); It.Iterating(); It.Next())
+          if(not It.Key().IsObject())
+            Bytes += Measure(It.Key(), Elements) +
+              Measure(It.Value(), Elements);
+        Elements[Slot] = Bytes;
+        count Body = BodySize(EncodedEntries(t), Bytes);
+        return 1 + VarintSize(uint64(Body)) + Body;
+      }
+    }
+    return 1;
+  }
+
+  byte* BinaryValue::Write(const Value& v, const Array<count>& Elements,
+    count& NextElements, byte* Out)
+  {
+    switch(v.ValueType)
+    {
+    case Value::ValueTypeNil:
+    case Value::ValueTypeObject:
+      *Out++ = TagNil;
+      break;
+    case Value::ValueTypeBoolean:
+      *Out++ = v.DataBooleanValue ? TagTrue : TagFalse;
+      break;
+    case Value::ValueTypeInteger:
+      *Out++ = TagInteger;
+      Out = WriteVarint(Out, ZigZag(int64(v.DataIntegerValue)));
+      break;
+    case Value::ValueTypeNumber:
+      *Out++ = TagNumber;
+      Out = WriteFloat(Out, float64(v.DataNumberValue));
+      break;
+    case Value::ValueTypeRatio:
+      {
+        Ratio r = v.InternalRatio();
+        *Out++ = TagRatio;
+        Out = WriteVarint(Out, ZigZag(int64(r.Numerator())));
+        Out = WriteVarint(Out, ZigZag(int64(r.Denominator())));
+      }
+      break;
+    case Value::ValueTypeVector:
+      {
+        Vector x = v.InternalVector();
+        *Out++ = TagVector;
+        Out = WriteFloat(Out, float64(x.x));
+        Out = WriteFloat(Out, float64(x.y));
+      }
+      break;
+    case Value::ValueTypeBox:
+      {
+        const Box& x = v.AssumeAndGet<Box>();
+        *Out++ = TagBox;
+        Out = WriteFloat(Out, float64(x.a.x));
+        Out = WriteFloat(Out, float64(x.a.y));
+        Out = WriteFloat(Out, float64(x.b.x));
+        Out = WriteFloat(Out, float64(x.b.y));
+      }
+      break;
+    case Value::ValueTypeString:
+      {
+        StringView s = v.InternalStringView();
+        *Out++ = TagString;
+        Out = WriteVarint(Out, uint64(s.n()));
+        Memory::MemCopy(Out, s.Begin(), s.n());
+        Out += s.n();
+      }
+      break;
+    case Value::ValueTypeArray:
+      {
+        const Value::ArrayType& a = v.AssumeAndGet<Value::ArrayType>();
+        count Bytes = Elements[NextElements++];
+        bool Indexed = IsIndexed(a.n(), Bytes);
+        *Out++ = Indexed ? TagIndexedArray : TagArray;
+        Out = WriteVarint(Out, uint64(BodySize(a.n(), Bytes)));
+        Out = WriteVarint(Out, uint64(a.n()));
+        byte* Table = Out;
+        if(Indexed)
+          Out += 4 * a.n();
+        const byte* First = Out;
+        for(count i = 0, n = a.n(); i < n; i++)
+        {
+          if(Indexed)
+            WriteOffset(Table, i, uint32(Out - First));
+          Out = Write(a[i], Elements, NextElements, Out);
+        }
+      }
+      break;
+    case Value::ValueTypeTree:
+      {
+        const Value::TreeType& t = v.AssumeAndGet<Value::TreeType>();
+        count Bytes = Elements[NextElements++], Entries = EncodedEntries(t);
+        bool Indexed = IsIndexed(Entries, Bytes);
+        *Out++ = Indexed ? TagIndexedTree : TagTree;
+        Out = WriteVarint(Out, uint64(BodySize(Entries, Bytes)));
+        Out = WriteVarint(Out, uint64(Entries));
+        byte* Table = Out;
+        if(Indexed)
+          Out += 4 * Entries;
+        const byte* First = Out;
+        Value::TreeType::Iterator It;
+        count i = 0;
+        for(It.Begin(t); It.Iterating(); It.Next())
+        {
+          if(It.Key().IsObject())
+            continue;
+          if(Indexed)
+            WriteOffset(Table, i++, uint32(Out - First));
+          Out = Write(It.Key(), Elements, NextElements, Out);
+          Out = Write(It.Value(), Elements, NextElements, Out);
+        }
+      }
+      break;
+    }
+    return Out;
+  }
+
+  const byte* BinaryValue::Decode(const byte* p, const byte* End,
+    Value& Result)
+  {
+    uint64 x = 0, y = 0;
+    switch(*p++)
+    {
+    case TagNil:
+      Result.Clear();
+      return p;
+    case TagFalse:
+      Result = false;
+      return p;
+    case TagTrue:
+      Result = true;
+      return p;
+    case TagInteger:
+      if((p = ReadVarint(p, End, x)))
+        Result = integer(UnZigZag(x));
+      return p;
+    case TagNumber:
+      Result = number(ReadFloat(p));
+      return p + sizeof(float64);
+    case TagRatio:
+      if((p = ReadVarint(ReadVarint(p, End, x), End, y)))
+        Result = Ratio(integer(UnZigZag(x)), integer(UnZigZag(y)));
+      return p;
+    case TagVector:
+      Result = Vector(number(ReadFloat(p)),
+        number(ReadFloat(p + sizeof(float64))));
+      return p + 2 * sizeof(float64);
+    case TagBox:
+      Result = Box(
+        Vector(number(ReadFloat(p)), number(ReadFloat(p + sizeof(float64)))),
+        Vector(number(ReadFloat(p + 2 * sizeof(float64))),
+          number(ReadFloat(p + 3 * sizeof(float64)))));
+      return p + 4 * sizeof(float64);
+    case TagString:
+      if((p = ReadVarint(p, End, x)))
+      {
+        Result.InternalSetString(p, count(x));
+        p += x;
+      }
+      return p;
+    case TagArray:
+    case TagTree:
+    case TagIndexedArray:
+    case TagIndexedTree:
+      {
+        Tag ContainerTag = Tag(p[-1]);
+        bool IsTree = ContainerTag == TagTree or ContainerTag == TagIndexedTree;
+        bool Indexed = ContainerTag == TagIndexedArray or
+          ContainerTag == TagIndexedTree;
+
+        /*Since every entry takes at least one byte, a count larger than the
+        body is rejected before anything is allocated.*/
+        p = ReadVarint(ReadVarint(p, End, x), End, y);
+        if(not p or y > uint64(End - p) / (Indexed ? 5 : 1))
+          return 0;
+        const byte* Table = p;
+        if(Indexed)
+          p += 4 * y;
+        const byte* First = p;
+
+        Value Key;
+        if(IsTree)
+          Result.NewTree();
+        else
+          Result.NewArray().n(count(y));
+        for(count i = 0; i < count(y); i++)
+        {
+          if(Indexed and ReadOffset(Table, i) != count(p - First))
+            return 0;
+          if(IsTree)
+          {
+            const byte* KeyEnd = Skip(p, End);
+            if(not KeyEnd or Decode(p, KeyEnd, Key) != KeyEnd)
+              return 0;
+            p = KeyEnd;
+          }
+          const byte* ValueEnd = Skip(p, End);
+          if(not ValueEnd or Decode(p, ValueEnd, IsTree ? Result[Key] :
+            Result.Get<Value::ArrayType, Value::ValueTypeArray>()[i]) !=
+            ValueEnd)
+              return 0;
+          p = ValueEnd;
+        }
+        return p;
+      }
+    }
+    return 0;
+  }
+
+  const byte* BinaryValue::Skip(const byte* p, const byte* End)
+  {
+    if(not p or p >= End)
+      return 0;
+    uint64 x = 0, y = 0;
+    count Remaining = count(End - p) - 1;
+    switch(*p++)
+    {
+    case TagNil:
+    case TagFalse:
+    case TagTrue:
+      return p;
+    case TagInteger:
+      return ReadVarint(p, End, x);
+    case TagNumber:
+      return Remaining >= 8 ? p + 8 : 0;
+    case TagRatio:
+      return ReadVarint(ReadVarint(p, End, x), End, y);
+    case TagVector:
+      return Remaining >= 16 ? p + 16 : 0;
+    case TagBox:
+      return Remaining >= 32 ? p + 32 : 0;
+    case TagString:
+    case TagArray:
+    case TagTree:
+    case TagIndexedArray:
+    case TagIndexedTree:
+      p = ReadVarint(p, End, x);
+      return p and x <= uint64(End - p) ? p + x : 0;
+    }
+    return 0;
+  }
 #endif
 }
 #endif
@@ -0,0 +1,284 @@
+/*
+  ==============================================================================
+
+  Copyright 2007-2013, 2017 Andi
+  Copyright 2013-2016 Robert Taub
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+
+  ==============================================================================
+*/
+
+
+#ifndef PRIM_INCLUDE_STRING_BUILDER_H
+#define PRIM_INCLUDE_STRING_BUILDER_H
+
+#ifndef PRIM_LIBRARY
+#error This file can not be included individually. Include prim.h instead.
+#endif
+
+namespace PRIM_NAMESPACE
+{
+  /**Contiguous buffer for building up text by appending. Unlike String, the
+  builder keeps no fragment bookkeeping: its bytes are always contiguous and
+  the buffer grows geometrically, so appending many small pieces costs little
+  more than copying them. Numbers are formatted exactly as String formats them.
+  When finished, read the result through View() or copy it out with
+  ToString().*/
+  class StringBuilder
+  {
+    ///Byte storage whose size is the capacity of the builder.
+    Array<byte, meta::LinearGrowthModel> Data;
+
+    ///Number of bytes in use.
+    count Length;
+
+    ///Precision of number to string conversions.
+    count NumberPrecision;
+
+    ///Makes room for more bytes and returns where they should be written.
+    byte* Extend(count Bytes)
+    {
+      count NewLength = Length + Bytes;
+      if(NewLength > Data.n())
+        Data.n(Max(Max(NewLength, Data.n() * 2), count(64)));
+      byte* Destination = &Data[Length];
+      Length = NewLength;
+      return Destination;
+    }
+
+    public:
+
+    ///Creates an empty builder.
+    StringBuilder() : Length(0), NumberPrecision(5) {}
+
+    ///Creates an empty builder with space for the given number of bytes.
+    StringBuilder(count Capacity) : Length(0), NumberPrecision(5)
+    {
+      Reserve(Capacity);
+    }
+
+    ///Ensures that the builder can hold the given number of bytes.
+    void Reserve(count Capacity)
+    {
+      if(Capacity > Data.n())
+        Data.n(Capacity);
+    }
+
+    ///Empties the builder but keeps its capacity for reuse.
+    void Clear() {Length = 0;}
+
+    ///Returns the number of bytes in the builder.
+    inline count n() const {return Length;}
+
+    ///Returns whether the builder is not empty.
+    inline operator bool() const {return Length > 0;}
+
+    ///Returns a view of the bytes, which is valid until the next append.
+    StringView View() const
+    {
+      return Length ? StringView(&Data[0], Length) : StringView();
+    }
+
+    ///Copies the bytes into a new string.
+    String ToString() const
+    {
+      return String(View());
+    }
+
+    ///Sets the precision of number to string conversions.
+    void Precision(count NewPrecision)
+    {
+      NumberPrecision = NewPrecision;
+    }
+
+    ///Returns the precision of number to string conversions.
+    count Precision() const
+    {
+      return NumberPrecision;
+    }
+
+    //-------//
+    //Appends//
+    //-------//
+
+    ///Appends a byte fragment of a certain length.
+    void Append(const byte* Fragment, count Length_)
+    {
+      if(Length_ > 0 and Fragment)
+        Memory::Copy(Extend(Length_), Fragment, Length_);
+    }
+
+    ///Appends a null-terminated string.
+    void Append(const ascii* s)
+    {
+      Append(reinterpret_cast<const byte*>(s), String::LengthOf(s));
+    }
+
+    ///Appends a number with a given precision and format.
+    void Append(float64 v, count Precision, bool ScientificNotation);
+
+    ///Appends an integer in decimal.
+    void Append(int64 v);
+
+    ///Appends an unsigned integer in decimal.
+    void Append(uint64 v);
+
+    ///Appends a letter.
+    StringBuilder& operator << (ascii c)
+    {
+      *Extend(1) = byte(c);
+      return *this;
+    }
+
+    ///Appends a null-terminated string.
+    StringBuilder& operator << (const ascii* s)
+    {
+      Append(s);
+      return *this;
+    }
+
+    ///Appends a string.
+    StringBuilder& operator << (const String& s)
+    {
+      Append(reinterpret_cast<const byte*>(s.Merge()), s.n());
+      return *this;
+    }
+
+    ///Appends the bytes of a view.
+    StringBuilder& operator << (const StringView& s)
+    {
+      Append(s.Begin(), s.n());
+      return *this;
+    }
+
+    ///Appends a boolean as True or False.
+    StringBuilder& operator << (bool v)
+    {
+      Append(v ? "True" : "False");
+      return *this;
+    }
+
+    ///Appends an integer.
+    StringBuilder& operator << (int32 v)
+    {
+      Append(int64(v));
+      return *this;
+    }
+
+    ///Appends an integer.
+    StringBuilder& operator << (int64 v)
+    {
+      Append(v);
+      return *this;
+    }
+
+    ///Appends an unsigned integer.
+    StringBuilder& operator << (uint64 v)
+    {
+      Append(v);
+      return *this;
+    }
+
+    ///Appends a number using the precision of the builder.
+    StringBuilder& operator << (float64 v)
+    {
+      Append(v, NumberPrecision, false);
+      return *this;
+    }
+
+    ///Appends a number using the precision of the builder.
+    StringBuilder& operator << (float32 v)
+    {
+      Append(float64(v), NumberPrecision, false);
+      return *this;
+    }
+
+    /**Appends any other object by formatting it with String. This is the slow
+    path and exists so that the builder accepts everything String accepts.*/
+    template <class T>
+    StringBuilder& operator << (const T& v)
+    {
+      String s;
+      s << v;
+      return *this << s;
+    }
+
+    ///Appends a newline if the builder is not empty and then applies <<.
+    template <class T>
+    StringBuilder& operator >> (const T& v)
+    {
+      if(Length)
+        Append(String::Newline);
+      return *this << v;
+    }
+
+    ///Appends a new line to the builder.
+    void operator ++ (int Dummy)
+    {
+      (void)Dummy;
+      Append(String::Newline);
+    }
+  };
+
+#ifdef PRIM_COMPILE_INLINE
+  void StringBuilder::Append(float64 v, count Precision,
+    bool ScientificNotation)
+  {
+    //Infinities and NaN are rare, so let String spell them.
+    if(Limits<float64>::IsNaN(v) or
+      Limits<float64>::IsEqual(v, Limits<float64>::Infinity()) or
+      Limits<float64>::IsEqual(v, Limits<float64>::NegativeInfinity()))
+    {
+      String s;
+      s.Append(v, Precision, ScientificNotation);
+      *this << s;
+      return;
+    }
+
+    ascii Buffer[64];
+    Append(reinterpret_cast<const byte*>(&Buffer[0]),
+      String::FormatNumber(v, Precision, ScientificNotation, Buffer));
+  }
+
+  void StringBuilder::Append(int64 v)
+  {
+    if(v < 0)
+    {
+      *this << '-';
+      Append(uint64(0) - uint64(v));
+    }
+    else
+      Append(uint64(v));
+  }
+
+  void StringBuilder::Append(uint64 v)
+  {
+    ascii Digits[24];
+    count i = 24;
+    do Digits[--i] = ascii('0' + v % 10); while(v /= 10);
+    Append(reinterpret_cast<const byte*>(&Digits[i]), 24 - i);
+  }
+#endif
+}
+#endif
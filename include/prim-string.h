@@ -36,6 +36,22 @@
 #error This file can not be included individually. Include prim.h instead.
 #endif
 
+//Byte searches are vectorized when the compiler targets x86 SIMD.
+#if !defined(PRIM_NO_SIMD) and (defined(__SSE2__) or defined(_M_X64))
+#define PRIM_STRING_SSE2
+#if defined(__AVX2__)
+#define PRIM_STRING_AVX2
+#endif
+#endif
+
+#ifdef PRIM_COMPILE_INLINE
+#if defined(PRIM_STRING_AVX2)
+#include <immintrin.h>
+#elif defined(PRIM_STRING_SSE2)
+#include <emmintrin.h>
+#endif
+#endif
+
 namespace PRIM_NAMESPACE
 {
   namespace meta
@@ -44,6 +60,130 @@ namespace PRIM_NAMESPACE
     static const unicode BadCharacter = 0xfffd; //Unicode replacement character
   }
 
+  class String;
+
+  /**Non-owning view of a contiguous run of bytes. A view is just a pointer and
+  a length, so slicing, searching, tokenizing, and comparing it never copy or
+  allocate. The viewed bytes must outlive the view; in particular, a view of a
+  String is only valid until that string is next modified.*/
+  class StringView
+  {
+    ///Pointer to the first byte of the view.
+    const byte* Data;
+
+    ///Number of bytes in the view.
+    count Length;
+
+    public:
+
+    ///Creates an empty view.
+    StringView() : Data(0), Length(0) {}
+
+    ///Creates a view of a byte span.
+    StringView(const byte* Data_, count Length_) : Data(Data_),
+      Length(Data_ and Length_ > 0 ? Length_ : 0) {}
+
+    ///Creates a view of a null-terminated string, not including the null.
+    StringView(const ascii* s);
+
+    ///Creates a view of a string, merging its fragments if necessary.
+    StringView(const String& s);
+
+    ///Returns the number of bytes in the view.
+    inline count n() const {return Length;}
+
+    ///Returns a pointer to the first byte.
+    inline const byte* Begin() const {return Data;}
+
+    ///Returns a pointer just past the last byte.
+    inline const byte* End() const {return Data + Length;}
+
+    ///Returns the byte at the index or zero if the index is out of bounds.
+    inline byte operator [] (count i) const
+    {
+      return i >= 0 and i < Length ? Data[i] : byte(0);
+    }
+
+    ///Returns whether the view is not empty.
+    inline operator bool() const {return Length > 0;}
+
+    /**Returns the part of the view between two indices inclusively. Invalid
+    indices return an empty view.*/
+    StringView Slice(count i, count j) const
+    {
+      if(i < 0 or j < i or j >= Length)
+        return StringView();
+      return StringView(Data + i, j - i + 1);
+    }
+
+    /**Finds the next occurrence of the source. Returns -1 if no match is found
+    or if StartIndex is negative.*/
+    count Find(const StringView& Source, count StartIndex = 0) const;
+
+    ///Returns whether the view contains the source.
+    bool Contains(const StringView& Source) const
+    {
+      return Find(Source) != -1;
+    }
+
+    ///Returns whether the view starts with the source.
+    bool StartsWith(const StringView& Source) const;
+
+    ///Returns whether the view ends with the source.
+    bool EndsWith(const StringView& Source) const;
+
+    /**Splits the view at each occurrence of the delimiter. The tokens are
+    views into the same bytes, so nothing is copied. An empty delimiter
+    returns no tokens.*/
+    List<StringView> Tokenize(const StringView& Delimiter,
+      bool RemoveEmptyEntries = false) const;
+
+    ///Returns the view without leading or trailing spaces, tabs, CR, or LF.
+    StringView Trimmed() const;
+
+    ///Attempts to convert the view to a number.
+    number ToNumber() const;
+
+    ///Returns whether the view matches the other byte for byte.
+    bool operator == (const StringView& Other) const;
+
+    ///Returns the opposite of the equivalence operator test.
+    bool operator != (const StringView& Other) const
+    {
+      return not (*this == Other);
+    }
+
+    ///Compares the views lexicographically by unsigned byte value.
+    bool operator < (const StringView& Other) const;
+
+    //-----------//
+    //Byte Search//
+    //-----------//
+
+    /**Returns the first occurrence of a byte or null if there is none. With
+    SSE2 or AVX2 a whole vector of bytes is compared at once.*/
+    static const byte* FindByte(const byte* Haystack, count HaystackLength,
+      byte Needle);
+
+    /**Returns the first occurrence of a byte sequence or null if there is
+    none. The first and last bytes of the needle are compared against a vector
+    of candidate positions at once, and the middle of the needle is only
+    compared where both of them match. Without SIMD, the candidates are found
+    by scanning for the first byte with memchr.*/
+    static const byte* FindBytes(const byte* Haystack, count HaystackLength,
+      const byte* Needle, count NeedleLength);
+
+    /**Returns the number of ASCII bytes at the beginning of the data. With
+    SSE2 or AVX2 the high bits of a whole vector of bytes are tested at once.*/
+    static count CountASCII(const byte* Data, count Length);
+
+    ///Returns the index of the lowest set bit of a non-zero mask.
+    static count LowestSetBit(uint32 Mask);
+
+    ///Returns the index of the lowest set bit of a non-zero mask.
+    static count LowestSetBit(uint64 Mask);
+  };
+
   /**Efficient flat container of linked substrings. The string is equally fast
   at append, prepend, insert, and erase, with nearly constant manipulation
   speed with respect to string length.*/
@@ -1060,6 +1200,33 @@ namespace PRIM_NAMESPACE
     ///Appends the fragment to the current attached stream.
     void AppendToStream(const byte* Fragment, count Length);
 
+    /**Writes a number in fixed notation with the given number of decimal places
+    and returns the length written. The decimal expansion is computed exactly
+    and rounded half-to-even, so the digits are the same as those of printf.
+    Returns zero if the scaled number does not fit in 64 bits, in which case
+    the caller should fall back to printf.*/
+    static count FormatFixed(float64 v, count Precision, ascii* Buffer);
+
+    /**Replaces the decimal point of the C locale in a number written by printf
+    with a period so that the text does not depend on LC_NUMERIC. Returns the
+    new length.*/
+    static count UseDecimalPeriod(ascii* Buffer, count Length);
+
+    /**Parses the number at the front of a byte span with strtod, first putting
+    the decimal point of the C locale in place of the period, since that is the
+    point strtod reads. Handles the forms that ParseNumber() leaves to strtod
+    so that they do not depend on LC_NUMERIC.*/
+    static number ParseWithDecimalPeriod(const byte* Begin, const byte* End);
+
+    /**Writes a finite number with the given precision and format to a buffer
+    of at least 64 bytes and returns the length written. The decimal point is
+    always a period regardless of the locale.*/
+    static count FormatNumber(float64 v, count Precision,
+      bool ScientificNotation, ascii* Buffer);
+
+    ///The builder shares the number formatting of the string.
+    friend class StringBuilder;
+
     public:
 
     /**Replaces a fragment with another string. The method first erases the
@@ -1095,55 +1262,18 @@ namespace PRIM_NAMESPACE
 
     /**Finds the next occurrence of the source string. Returns -1 if no match
     is found. Use StartIndex to start the find at a different position. Also,
-    if StartIndex is less than 0, then no find occurs and -1 is returned.*/
+    if StartIndex is less than 0, then no find occurs and -1 is returned. The
+    string is merged so that the search can run over contiguous bytes.*/
     count Find(const byte* Source, count SourceLength, count StartIndex) const
     {
-      if(not Source or SourceLength == 0 or InternalLength == 0 or
-        StartIndex < 0)
+      if(not Source or SourceLength <= 0 or StartIndex < 0 or
+        StartIndex > InternalLength - SourceLength)
           return -1;
 
-      count MaxCharacter = InternalLength - SourceLength;
-
-      if(Data.n() == 1 + 4 + 4 + InternalLength + 4)
-      {
-        //Take advantage of a merged string by randomly accessing.
-        const byte* StringStart =
-          reinterpret_cast<const byte*>(&(Merge()[StartIndex]));
-        for(count i = StartIndex; i <= MaxCharacter; i++, StringStart++)
-        {
-          bool MatchFound = true;
-          for(count j = 0; j < SourceLength; j++)
-          {
-            if(StringStart[j] != Source[j])
-            {
-              MatchFound = false;
-              break;
-            }
-          }
-          if(MatchFound)
-            return i;
-        }
-      }
-      else
-      {
-        /*If not merged use the slower but more string-manipulation friendly
-        find, which uses an iterator.*/
-        for(count i = StartIndex; i <= MaxCharacter; i++)
-        {
-          bool MatchFound = true;
-          for(count j = 0; j < SourceLength; j++)
-          {
-            if(Get(i + j) != Source[j])
-            {
-              MatchFound = false;
-              break;
-            }
-          }
-          if(MatchFound)
-            return i;
-        }
-      }
-      return -1;
+      const byte* Start = reinterpret_cast<const byte*>(Merge());
+      const byte* Found = StringView::FindBytes(Start + StartIndex,
+        InternalLength - StartIndex, Source, SourceLength);
+      return Found ? count(Found - Start) : -1;
     }
 
     ///Finds next occurrence of source string.
@@ -1160,11 +1290,9 @@ namespace PRIM_NAMESPACE
     }
 
     /**Globally replaces source string with destination string. Returns the
-    number of replacements made. Since global replacement can make a lot of
-    changes to the string, this can create many internal links. To prevent this
-    from slowing down replaces on a long string with many replaces, the string
-    must be merged at an interval of replacements that can be adjusted with
-    MergeEvery.*/
+    number of replacements made. Occurrences are found from left to right and
+    do not overlap. The MergeEvery argument is no longer needed since the string
+    is rebuilt in a single pass, and is kept for compatibility.*/
     count Replace(const ascii* Source, const ascii* Destination,
       count MergeEvery = 30)
     {
@@ -1179,24 +1307,35 @@ namespace PRIM_NAMESPACE
     count Replace(const byte* Source, count SourceLength,
       const byte* Destination, count DestinationLength, count MergeEvery = 30)
     {
-      //Make sure the merge every interval is reasonable.
-      MergeEvery = Max(count(1), Min(count(1000), MergeEvery));
+      (void)MergeEvery;
+      if(not Source or SourceLength <= 0 or InternalLength == 0)
+        return 0;
 
-      count Replacements = 0;
+      //Leave the string untouched if there is nothing to replace.
+      const byte* Start = reinterpret_cast<const byte*>(Merge());
+      const byte* End = Start + InternalLength;
+      const byte* Next = StringView::FindBytes(Start, InternalLength, Source,
+        SourceLength);
+      if(not Next)
+        return 0;
 
-      //For each occurrence of the source, replace it with the destination.
-      count Next = Find(Source, SourceLength, 0);
-      while(Next != -1)
+      //Copy the text between occurrences along with each replacement.
+      String Result;
+      count Replacements = 0;
+      for(; Next; Next = StringView::FindBytes(Start, count(End - Start),
+        Source, SourceLength), Replacements++)
       {
-        Replace(Next, SourceLength, Destination, DestinationLength);
-        Replacements++;
-
-        /*If there are a ton of replacements happening, then merge every now
-        and then to prevent iterations from taking up a lot of time.*/
-        if(Replacements % MergeEvery == 0)
-          Merge();
-        Next = Find(Source, SourceLength, Next + DestinationLength);
+        Result.Append(Start, count(Next - Start));
+        Result.Append(Destination, DestinationLength);
+        Start = Next + SourceLength;
       }
+      Result.Append(Start, count(End - Start));
+
+      //Take the new contents while keeping the stream and precision settings.
+      Data.SwapWith(Result.Data);
+      InternalLength = Result.InternalLength;
+      LastFragmentIndex = Result.LastFragmentIndex;
+      DefaultIterator.Reset();
 
       //Return the number of replacements made.
       return Replacements;
@@ -1291,31 +1430,15 @@ namespace PRIM_NAMESPACE
     }
 
     ///Tokenizes the string by a delimiter and returns a list of strings.
-    List<String> Tokenize(String Delimiter, bool RemoveEmptyEntries = false)
-      const
+    List<String> Tokenize(const StringView& Delimiter,
+      bool RemoveEmptyEntries = false) const
     {
-      //Make a copy of the string.
-      String s = *this;
-
-      //Add tokens at beginning and ending for using FindBetween.
-      s.Prepend(Delimiter.Merge());
-      s.Append(Delimiter.Merge());
-
-      //Parse the paths into a list.
+      //Split the merged bytes as views so each token is copied only once.
+      List<StringView> Tokens =
+        StringView(*this).Tokenize(Delimiter, RemoveEmptyEntries);
       List<String> Result;
-      String::Span Location;
-      String NextResult;
-      while((Location = s.FindBetween(Delimiter, Delimiter, NextResult,
-        Location.j())).j() != -1)
-          Result.Add(NextResult);
-
-      //Remove empty entries if requested.
-      if(RemoveEmptyEntries)
-        for(count i = Result.n() - 1; i >= 0; i--)
-          if(not Result[i])
-            Result.Remove(i);
-
-      //Return the list of tokenized strings.
+      for(count i = 0; i < Tokens.n(); i++)
+        Result.Add().Append(Tokens[i].Begin(), Tokens[i].n());
       return Result;
     }
 
@@ -1363,17 +1486,15 @@ namespace PRIM_NAMESPACE
     ///Returns whether the string starts with the source.
     bool StartsWith(const ascii* Source) const
     {
-      if(not Source) return false;
-      return Find(Source) == 0;
+      StringView v(Source);
+      return v and StringView(*this).StartsWith(v);
     }
 
     ///Returns whether the string ends with the source.
     bool EndsWith(const ascii* Source) const
     {
-      if(not Source) return false;
-      count SourceLength = LengthOf(Source);
-      return Find(reinterpret_cast<const byte*>(Source), SourceLength,
-        InternalLength - SourceLength) != -1;
+      StringView v(Source);
+      return v and StringView(*this).EndsWith(v);
     }
 
     ///Returns whether the string matches the other byte for byte.
@@ -1499,6 +1620,22 @@ namespace PRIM_NAMESPACE
       return *this;
     }
 
+    ///Appends a sequence to the stream in the same form as a list.
+    template <class T> String& operator << (const Sequence<T>& a)
+    {
+      String s;
+      s >> "{";
+      for(count i = 0; i < a.n(); i++)
+      {
+        if(i)
+          s << ", ";
+        s << a[i];
+      }
+      s << "}";
+      Append(s.Merge());
+      return *this;
+    }
+
     ///Appends a tree to the stream.
     template <class K, class V> String& operator << (const Tree<K, V>& a)
     {
@@ -1580,6 +1717,13 @@ namespace PRIM_NAMESPACE
       return *this;
     }
 
+    ///Appends the bytes of a view using the familiar << operator.
+    String& operator << (const StringView& s)
+    {
+      Append(s.Begin(), s.n());
+      return *this;
+    }
+
     ///Appends a newline if string is not empty and then applies << operator.
     template <class T>
     String& operator >> (const T& v)
@@ -1629,6 +1773,9 @@ namespace PRIM_NAMESPACE
     ///Copy constructor to initialize string with contents of other string.
     String(const byte* Other, count Length) {Clear(); Append(Other, Length);}
 
+    ///Constructor to copy the bytes of a view.
+    String(const StringView& Other) {Clear(); Append(Other.Begin(), Other.n());}
+
     ///Appends a bool during construction.
     String(bool v) {Clear(); (*this) << v;}
 
@@ -1694,6 +1841,40 @@ namespace PRIM_NAMESPACE
     ///Appends a matrix during construction.
     template <class T> String(const Matrix<T>& M) {Clear(); (*this) << M;}
 
+#ifdef PRIM_11
+    ///Copy constructor copies the fragment data of the other string.
+    String(const String&) = default;
+
+    ///Assignment operator copies the fragment data of the other string.
+    String& operator = (const String&) = default;
+
+    ///Move constructor takes over the fragment data of the other string.
+    String(String&& Other) noexcept : Data(Move(Other.Data)),
+      InternalLength(Other.InternalLength),
+      LastFragmentIndex(Other.LastFragmentIndex),
+      NumberPrecision(Other.NumberPrecision),
+      AttachedStream(Other.AttachedStream)
+    {
+      Other.Clear();
+    }
+
+    ///Move assignment takes over the fragment data of the other string.
+    String& operator = (String&& Other) noexcept
+    {
+      if(&Other != this)
+      {
+        Data = Move(Other.Data);
+        InternalLength = Other.InternalLength;
+        LastFragmentIndex = Other.LastFragmentIndex;
+        NumberPrecision = Other.NumberPrecision;
+        AttachedStream = Other.AttachedStream;
+        DefaultIterator.Reset();
+        Other.Clear();
+      }
+      return *this;
+    }
+#endif
+
     //----------//
     //Assignment//
     //----------//
@@ -1823,6 +2004,17 @@ namespace PRIM_NAMESPACE
     ///Attempts to convert the string to a number.
     number ToNumber() const;
 
+    /**Parses a decimal number from the front of a byte span without allocating.
+    The accepted form is an optional sign, digits with an optional fractional
+    part, and an optional exponent. The result is correctly rounded for float64:
+    the common case of at most 19 significant digits and a small exponent is
+    computed exactly with a single multiply or divide, and anything else is
+    handed to strtod with a period for the decimal point whatever the locale.
+    Returns the position just past the number, or Begin if no number could be
+    parsed (in which case Result is left unchanged).*/
+    static const byte* ParseNumber(const byte* Begin, const byte* End,
+      number& Result);
+
     //--------------//
     //Hex Conversion//
     //--------------//
@@ -2209,19 +2401,52 @@ namespace PRIM_NAMESPACE
       return Value;
     }
 
+    /**Decodes the next character like Decode(), except that an ASCII byte is
+    returned directly. Only the start of a multi-byte sequence goes through the
+    full decoder, so tokenizers that mostly see ASCII should use this.*/
+    static unicode DecodeNext(const byte*& Stream, const byte* StreamEnd)
+    {
+      return *Stream < 128 ? unicode(*Stream++) : Decode(Stream, StreamEnd);
+    }
+
+    /**Returns the first character in the byte range that does not decode as
+    valid UTF-8, or StreamEnd if the whole range is valid. Runs of ASCII are
+    skipped with StringView::CountASCII().*/
+    static const byte* ValidateUTF8(const byte* Stream, const byte* StreamEnd)
+    {
+      while(Stream < StreamEnd)
+      {
+        Stream += StringView::CountASCII(Stream, count(StreamEnd - Stream));
+        const byte* Character = Stream;
+        if(Stream < StreamEnd and Decode(Stream, StreamEnd) ==
+          meta::BadCharacter)
+            return Character;
+      }
+      return StreamEnd;
+    }
+
+    ///Counts the UTF-8 characters in a byte range.
+    static count CountCharacters(const byte* Stream, const byte* StreamEnd)
+    {
+      count Characters = 0;
+      while(Stream < StreamEnd)
+      {
+        count Run = StringView::CountASCII(Stream, count(StreamEnd - Stream));
+        Stream += Run, Characters += Run;
+        if(Stream < StreamEnd)
+          Decode(Stream, StreamEnd), Characters++;
+      }
+      return Characters;
+    }
+
     ///Reads the string to determine if it is a valid UTF-8 string.
     bool IsUTF8() const
     {
+      //As before, the string is only validated up to the first null byte.
       const byte* a = reinterpret_cast<const byte*>(Merge());
       const byte* z = a + n();
-      unicode d;
-      do
-      {
-        d = Decode(a, z);
-        if(d == meta::BadCharacter)
-          return false;
-      } while(d);
-      return true;
+      const byte* Bad = ValidateUTF8(a, z);
+      return Bad == z or StringView::FindByte(a, count(Bad - a), 0);
     }
 
     /**Reads the string to determine if it is a valid ASCII string. Note that
@@ -2502,15 +2727,7 @@ namespace PRIM_NAMESPACE
     count Characters() const
     {
       const byte* Start = reinterpret_cast<const byte*>(Merge());
-      const byte* ReadPosition = Start;
-      const byte* EndMarker = &Start[n()];
-      count CharacterCount = 0;
-      while(ReadPosition != EndMarker)
-      {
-        Decode(ReadPosition, EndMarker);
-        CharacterCount++;
-      }
-      return CharacterCount;
+      return CountCharacters(Start, &Start[n()]);
     }
 
     ///Calculates the number of UTF-8 characters in the string.
@@ -2530,8 +2747,14 @@ namespace PRIM_NAMESPACE
       count CharacterCount = 0;
       while(ReadPosition != EndMarker)
       {
-        Decode(ReadPosition, EndMarker);
-        if(++CharacterCount == c)
+        //Take a run of ASCII at once without passing the sought character.
+        count Run = StringView::CountASCII(ReadPosition,
+          Min(count(EndMarker - ReadPosition), c - CharacterCount));
+        if(Run)
+          ReadPosition += Run, CharacterCount += Run;
+        else
+          Decode(ReadPosition, EndMarker), CharacterCount++;
+        if(CharacterCount == c)
           return count(ReadPosition - Start);
       }
       return -1;
@@ -2561,7 +2784,7 @@ namespace PRIM_NAMESPACE
 
       Output.n(0);
       while(ReadPosition != EndMarker)
-        Output.Add(Decode(ReadPosition, EndMarker));
+        Output.Add(DecodeNext(ReadPosition, EndMarker));
     }
 
     ///Decodes the current string to a String::UTF32.
@@ -2640,7 +2863,249 @@ namespace PRIM_NAMESPACE
     }
   };
 
+  inline StringView::StringView(const ascii* s) :
+    Data(reinterpret_cast<const byte*>(s)), Length(String::LengthOf(s)) {}
+
+  inline StringView::StringView(const String& s) :
+    Data(reinterpret_cast<const byte*>(s.Merge())), Length(s.n()) {}
+
 #ifdef PRIM_COMPILE_INLINE
+  count StringView::Find(const StringView& Source, count StartIndex) const
+  {
+    if(not Source or StartIndex < 0 or StartIndex > Length - Source.n())
+      return -1;
+    const byte* Found = FindBytes(Data + StartIndex, Length - StartIndex,
+      Source.Data, Source.n());
+    return Found ? count(Found - Data) : -1;
+  }
+
+  count StringView::LowestSetBit(uint32 Mask)
+  {
+#if defined(__GNUC__)
+    return count(__builtin_ctz(Mask));
+#else
+    count i = 0;
+    while(not (Mask & 1))
+      Mask >>= 1, i++;
+    return i;
+#endif
+  }
+
+  count StringView::LowestSetBit(uint64 Mask)
+  {
+#if defined(__GNUC__)
+    return count(__builtin_ctzll(Mask));
+#else
+    count i = 0;
+    while(not (Mask & 1))
+      Mask >>= 1, i++;
+    return i;
+#endif
+  }
+
+  const byte* StringView::FindByte(const byte* Haystack, count HaystackLength,
+    byte Needle)
+  {
+    if(HaystackLength <= 0)
+      return 0;
+#if defined(PRIM_STRING_SSE2)
+    const byte* i = Haystack;
+    const byte* End = Haystack + HaystackLength;
+#if defined(PRIM_STRING_AVX2)
+    const __m256i N = _mm256_set1_epi8(char(Needle));
+    for(; End - i >= 32; i += 32)
+    {
+      uint32 Mask = uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i)), N)));
+      if(Mask)
+        return i + LowestSetBit(Mask);
+    }
+#else
+    const __m128i N = _mm_set1_epi8(char(Needle));
+    for(; End - i >= 16; i += 16)
+    {
+      uint32 Mask = uint32(_mm_movemask_epi8(_mm_cmpeq_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(i)), N)));
+      if(Mask)
+        return i + LowestSetBit(Mask);
+    }
+#endif
+    for(; i < End; i++)
+      if(*i == Needle)
+        return i;
+    return 0;
+#else
+    return reinterpret_cast<const byte*>(memchr(Haystack, Needle,
+      size_t(HaystackLength)));
+#endif
+  }
+
+  count StringView::CountASCII(const byte* Data, count Length)
+  {
+    const byte* i = Data;
+    const byte* End = Data + (Length > 0 ? Length : 0);
+#if defined(PRIM_STRING_AVX2)
+    for(; End - i >= 32; i += 32)
+    {
+      uint32 Mask = uint32(_mm256_movemask_epi8(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i))));
+      if(Mask)
+        return count(i - Data) + LowestSetBit(Mask);
+    }
+#elif defined(PRIM_STRING_SSE2)
+    for(; End - i >= 16; i += 16)
+    {
+      uint32 Mask = uint32(_mm_movemask_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(i))));
+      if(Mask)
+        return count(i - Data) + LowestSetBit(Mask);
+    }
+#else
+    //Test eight bytes at a time for any high bit.
+    for(; End - i >= 8; i += 8)
+    {
+      uint64 Word;
+      memcpy(&Word, i, 8);
+      if(Word & uint64(0x8080808080808080LL))
+        break;
+    }
+#endif
+    while(i < End and *i < 128)
+      i++;
+    return count(i - Data);
+  }
+
+  const byte* StringView::FindBytes(const byte* Haystack,
+    count HaystackLength, const byte* Needle, count NeedleLength)
+  {
+    if(NeedleLength <= 0 or NeedleLength > HaystackLength)
+      return 0;
+    if(NeedleLength == 1)
+      return FindByte(Haystack, HaystackLength, Needle[0]);
+
+    const byte* i = Haystack;
+    const byte* Last = Haystack + (HaystackLength - NeedleLength);
+    const byte First = Needle[0], Final = Needle[NeedleLength - 1];
+    const count Middle = NeedleLength - 2;
+
+#if defined(PRIM_STRING_SSE2)
+#if defined(PRIM_STRING_AVX2)
+    const count Width = 32;
+    const __m256i F = _mm256_set1_epi8(char(First));
+    const __m256i L = _mm256_set1_epi8(char(Final));
+#else
+    const count Width = 16;
+    const __m128i F = _mm_set1_epi8(char(First));
+    const __m128i L = _mm_set1_epi8(char(Final));
+#endif
+
+    //Test a vector of candidates that all lie at or before the last one.
+    for(; Last - i >= Width - 1; i += Width)
+    {
+#if defined(PRIM_STRING_AVX2)
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i));
+      __m256i z = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(i + NeedleLength - 1));
+      uint32 Mask = uint32(_mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(a, F), _mm256_cmpeq_epi8(z, L))));
+#else
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+      __m128i z = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(i + NeedleLength - 1));
+      uint32 Mask = uint32(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(a, F), _mm_cmpeq_epi8(z, L))));
+#endif
+      for(; Mask; Mask &= Mask - 1)
+      {
+        const byte* Candidate = i + LowestSetBit(Mask);
+        if(not Middle or
+          memcmp(Candidate + 1, Needle + 1, size_t(Middle)) == 0)
+            return Candidate;
+      }
+    }
+#endif
+
+    //Scan the remaining candidates for the first byte.
+    while(i <= Last)
+    {
+      i = reinterpret_cast<const byte*>(memchr(i, First,
+        size_t(Last - i + 1)));
+      if(not i)
+        return 0;
+      if(i[NeedleLength - 1] == Final and (not Middle or
+        memcmp(i + 1, Needle + 1, size_t(Middle)) == 0))
+          return i;
+      i++;
+    }
+    return 0;
+  }
+
+  bool StringView::StartsWith(const StringView& Source) const
+  {
+    return not Source or (Source.n() <= Length and
+      memcmp(Data, Source.Data, size_t(Source.n())) == 0);
+  }
+
+  bool StringView::EndsWith(const StringView& Source) const
+  {
+    return not Source or (Source.n() <= Length and
+      memcmp(Data + (Length - Source.n()), Source.Data,
+      size_t(Source.n())) == 0);
+  }
+
+  List<StringView> StringView::Tokenize(const StringView& Delimiter,
+    bool RemoveEmptyEntries) const
+  {
+    List<StringView> Result;
+    if(not Delimiter)
+      return Result;
+
+    count Start = 0, Next;
+    while((Next = Find(Delimiter, Start)) != -1)
+    {
+      if(Next > Start or not RemoveEmptyEntries)
+        Result.Add() = StringView(Data + Start, Next - Start);
+      Start = Next + Delimiter.n();
+    }
+    if(Length > Start or not RemoveEmptyEntries)
+      Result.Add() = StringView(Data + Start, Length - Start);
+    return Result;
+  }
+
+  StringView StringView::Trimmed() const
+  {
+    const byte* i = Data;
+    const byte* j = Data + Length;
+    while(i < j and (*i == ' ' or *i == '\n' or *i == '\r' or *i == '\t'))
+      i++;
+    while(j > i and (j[-1] == ' ' or j[-1] == '\n' or j[-1] == '\r' or
+      j[-1] == '\t'))
+        j--;
+    return StringView(i, count(j - i));
+  }
+
+  number StringView::ToNumber() const
+  {
+    StringView t = Trimmed();
+    number Result = 0;
+    if(String::ParseNumber(t.Begin(), t.End(), Result) == t.End())
+      return Result;
+    return String(*this).ToNumber();
+  }
+
+  bool StringView::operator == (const StringView& Other) const
+  {
+    return Length == Other.Length and
+      (not Length or memcmp(Data, Other.Data, size_t(Length)) == 0);
+  }
+
+  bool StringView::operator < (const StringView& Other) const
+  {
+    count Common = Min(Length, Other.Length);
+    int Compared = Common ? memcmp(Data, Other.Data, size_t(Common)) : 0;
+    return Compared < 0 or (Compared == 0 and Length < Other.Length);
+  }
+
   const ascii* String::LF = "\x0A"; //Practically equivalent to '\n'
   const ascii* String::CRLF = "\x0D\x0A"; //Practically equivalent to '\r\n'
 #ifdef PRIM_ENVIRONMENT_WINDOWS
@@ -2752,6 +3217,85 @@ namespace PRIM_NAMESPACE
     return *this;
   }
 
+  count String::FormatFixed(float64 v, count Precision, ascii* Buffer)
+  {
+    //Split the number into an integer mantissa and a binary exponent.
+    union {float64 Number; uint64 Bits;} x;
+    x.Number = v;
+    bool Negative = v < 0.0;
+    uint64 BiasedExponent = (x.Bits >> 52) & 0x7ff;
+    uint64 Mantissa = x.Bits & ((uint64(1) << 52) - 1);
+    if(BiasedExponent)
+      Mantissa |= uint64(1) << 52;
+    else
+      BiasedExponent = 1;
+    count Shift = 1075 - count(BiasedExponent);
+    if(Shift <= 0)
+      return 0;
+
+    //Scale the mantissa by the power of ten using 128-bit arithmetic.
+    uint64 Scale = 1;
+    for(count i = 0; i < Precision; i++)
+      Scale *= 10;
+    uint64 a0 = Mantissa & 0xffffffff, a1 = Mantissa >> 32;
+    uint64 b0 = Scale & 0xffffffff, b1 = Scale >> 32;
+    uint64 Cross = a1 * b0 + ((a0 * b0) >> 32);
+    uint64 Carry = (Cross & 0xffffffff) + a0 * b1;
+    uint64 High = a1 * b1 + (Cross >> 32) + (Carry >> 32);
+    uint64 Low = Mantissa * Scale;
+
+    //Shift the binary point out and round the remainder half-to-even.
+    uint64 Quotient = 0;
+    bool RoundUp = false;
+    if(Shift < 128)
+    {
+      uint64 RemainderHigh, RemainderLow, HalfHigh, HalfLow;
+      if(Shift < 64)
+      {
+        if(High >> Shift)
+          return 0;
+        Quotient = (Low >> Shift) | (High << (64 - Shift));
+        RemainderHigh = 0, RemainderLow = Low & ((uint64(1) << Shift) - 1);
+        HalfHigh = 0, HalfLow = uint64(1) << (Shift - 1);
+      }
+      else if(Shift == 64)
+      {
+        Quotient = High;
+        RemainderHigh = 0, RemainderLow = Low;
+        HalfHigh = 0, HalfLow = uint64(1) << 63;
+      }
+      else
+      {
+        Quotient = High >> (Shift - 64);
+        RemainderHigh = High & ((uint64(1) << (Shift - 64)) - 1);
+        RemainderLow = Low;
+        HalfHigh = uint64(1) << (Shift - 65), HalfLow = 0;
+      }
+      RoundUp = RemainderHigh > HalfHigh or (RemainderHigh == HalfHigh and
+        (RemainderLow > HalfLow or (RemainderLow == HalfLow and
+        (Quotient & 1))));
+    }
+    if(RoundUp and not ++Quotient)
+      return 0;
+
+    //Write the sign, the integer digits and the decimal digits.
+    ascii Digits[24];
+    count n = 0;
+    uint64 Integer = Quotient / Scale, Fraction = Quotient % Scale;
+    do Digits[n++] = ascii('0' + Integer % 10); while(Integer /= 10);
+    count Length = 0;
+    if(Negative)
+      Buffer[Length++] = '-';
+    while(n)
+      Buffer[Length++] = Digits[--n];
+    Buffer[Length++] = '.';
+    for(count i = Precision - 1; i >= 0; i--, Fraction /= 10)
+      Buffer[Length + i] = ascii('0' + Fraction % 10);
+    Length += Precision;
+    Buffer[Length] = 0;
+    return Length;
+  }
+
   void String::Append(float64 v, count Precision = 17,
     bool ScientificNotation = true)
   {
@@ -2771,43 +3315,53 @@ namespace PRIM_NAMESPACE
       return;
     }
 
+    ascii BufferData[64];
+    Append(reinterpret_cast<byte*>(&BufferData[0]),
+      FormatNumber(v, Precision, ScientificNotation, BufferData));
+  }
+
+  count String::UseDecimalPeriod(ascii* Buffer, count Length)
+  {
+    const ascii* Point = localeconv()->decimal_point;
+    count PointLength = LengthOf(Point);
+    if(not PointLength or (PointLength == 1 and Point[0] == '.'))
+      return Length;
+    for(count i = 0; i + PointLength <= Length; i++)
+    {
+      if(memcmp(Buffer + i, Point, size_t(PointLength)))
+        continue;
+      Buffer[i] = '.';
+      memmove(Buffer + i + 1, Buffer + i + PointLength,
+        size_t(Length - i - PointLength + 1));
+      return Length - PointLength + 1;
+    }
+    return Length;
+  }
+
+  count String::FormatNumber(float64 v, count Precision,
+    bool ScientificNotation, ascii* Buffer)
+  {
     if(Precision < 1)
       Precision = 1;
     else if(Precision > 17)
       Precision = 17;
-    if(ScientificNotation)
-    {
-      std::stringstream ss;
-      ss.precision(int(Precision));
-      ss << v;
-      char BufferData[32];
-      Memory::MemSet(BufferData, 0, 32);
-      ss.read(&BufferData[0], 32);
-      Append(reinterpret_cast<byte*>(&BufferData[0]), LengthOf(BufferData));
-    }
-    else
-    {
-      v = Chop(v, 1.0e-16);
-      if(Abs(v) >= 1.0e+16) v = 1.0e+16 * Sign(v);
-      std::stringstream ss;
-      ss.precision(int(Precision));
-      ss.setf(std::ios::fixed, std::ios::floatfield);
-      ss << v;
-      char BufferData[32];
-      Memory::MemSet(BufferData, 0, 32);
-      ss.read(&BufferData[0], 32);
-
-      //Remove trailing zeroes.
-      for(count i = LengthOf(BufferData) - 1; i > 1; i--)
-      {
-        if(BufferData[i] == '0' and BufferData[i - 1] != '.')
-          BufferData[i] = 0;
-        else
-          break;
-      }
 
-      Append(reinterpret_cast<byte*>(&BufferData[0]), LengthOf(BufferData));
-    }
+    if(ScientificNotation)
+      return UseDecimalPeriod(Buffer,
+        count(snprintf(Buffer, 64, "%.*g", int(Precision), v)));
+
+    v = Chop(v, 1.0e-16);
+    if(Abs(v) >= 1.0e+16) v = 1.0e+16 * Sign(v);
+    count Length = FormatFixed(v, Precision, Buffer);
+    if(not Length)
+      Length = UseDecimalPeriod(Buffer,
+        count(snprintf(Buffer, 64, "%.*f", int(Precision), v)));
+
+    //Remove trailing zeroes.
+    while(Length > 2 and Buffer[Length - 1] == '0' and
+      Buffer[Length - 2] != '.')
+        Length--;
+    return Length;
   }
 
   String& String::operator << (float64 v)
@@ -2843,7 +3397,133 @@ namespace PRIM_NAMESPACE
 
   number String::ToNumber() const
   {
-    return number(atof(Merge()));
+    //Parse in place and only defer to strtod for forms it alone understands.
+    const byte* Begin = reinterpret_cast<const byte*>(Merge());
+    const byte* End = Begin + n();
+    while(Begin < End and (*Begin == ' ' or (*Begin >= 9 and *Begin <= 13)))
+      Begin++;
+    number Result = 0;
+    if(ParseNumber(Begin, End, Result) == End)
+      return Result;
+    return ParseWithDecimalPeriod(Begin, End);
+  }
+
+  number String::ParseWithDecimalPeriod(const byte* Begin, const byte* End)
+  {
+    const ascii* Point = localeconv()->decimal_point;
+    count PointLength = LengthOf(Point);
+    const byte* Period = Begin;
+    while(Period < End and *Period != '.')
+      Period++;
+    if(Period == End or not PointLength)
+      Period = End, Point = ".", PointLength = 1;
+
+    //Copy the text with the point swapped in, on the stack if it fits.
+    count Before = count(Period - Begin);
+    count After = Period < End ? count(End - Period - 1) : 0;
+    ascii Buffer[64];
+    if(Before + PointLength + After < count(sizeof(Buffer)))
+    {
+      ascii* Out = &Buffer[0];
+      Memory::Copy(Out, reinterpret_cast<const ascii*>(Begin), Before);
+      Out += Before;
+      if(Period < End)
+      {
+        Memory::Copy(Out, Point, PointLength), Out += PointLength;
+        Memory::Copy(Out, reinterpret_cast<const ascii*>(Period + 1), After);
+        Out += After;
+      }
+      *Out = 0;
+      return number(strtod(&Buffer[0], 0));
+    }
+    String Long;
+    Long.Append(Begin, Before);
+    if(Period < End)
+      Long << Point, Long.Append(Period + 1, After);
+    return number(strtod(Long.Merge(), 0));
+  }
+
+  const byte* String::ParseNumber(const byte* Begin, const byte* End,
+    number& Result)
+  {
+    //Powers of ten that are exactly representable in a float64.
+    static const float64 ExactPowers[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+      1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+      1e19, 1e20, 1e21, 1e22};
+
+    const byte* i = Begin;
+    bool Negative = false;
+    if(i < End and (*i == '-' or *i == '+'))
+      Negative = *i++ == '-';
+
+    //Accumulate up to 19 significant digits, which always fit in 64 bits.
+    uint64 Mantissa = 0;
+    count Significant = 0, Digits = 0, Exponent = 0;
+    bool Inexact = false;
+    for(; i < End and *i >= '0' and *i <= '9'; i++, Digits++)
+    {
+      if(Significant < 19)
+      {
+        Mantissa = Mantissa * 10 + uint64(*i - '0');
+        if(Mantissa) Significant++;
+      }
+      else
+        Exponent++, Inexact = Inexact or *i != '0';
+    }
+    if(i < End and *i == '.')
+    {
+      i++;
+      for(; i < End and *i >= '0' and *i <= '9'; i++, Digits++)
+      {
+        if(Significant < 19)
+        {
+          Mantissa = Mantissa * 10 + uint64(*i - '0');
+          if(Mantissa) Significant++;
+          Exponent--;
+        }
+        else
+          Inexact = Inexact or *i != '0';
+      }
+    }
+    if(not Digits)
+      return Begin;
+
+    //Read the exponent only if it is complete.
+    if(i < End and (*i == 'e' or *i == 'E'))
+    {
+      const byte* j = i + 1;
+      bool NegativeExponent = false;
+      if(j < End and (*j == '-' or *j == '+'))
+        NegativeExponent = *j++ == '-';
+      if(j < End and *j >= '0' and *j <= '9')
+      {
+        count Explicit = 0;
+        for(; j < End and *j >= '0' and *j <= '9'; j++)
+          if(Explicit < 100000)
+            Explicit = Explicit * 10 + count(*j - '0');
+        Exponent += NegativeExponent ? -Explicit : Explicit;
+        i = j;
+      }
+    }
+
+    //Fast path: both the mantissa and the power of ten are exact.
+    if(not Mantissa)
+    {
+      Result = number(Negative ? -0.0 : 0.0);
+      return i;
+    }
+    if(not Inexact and Mantissa <= (uint64(1) << 53) and
+      Exponent >= -22 and Exponent <= 22)
+    {
+      float64 v = float64(Mantissa);
+      v = Exponent < 0 ? v / ExactPowers[-Exponent] : v * ExactPowers[Exponent];
+      Result = number(Negative ? -v : v);
+      return i;
+    }
+
+    //Slow path: let strtod round the exact decimal value.
+    Result = ParseWithDecimalPeriod(Begin, i);
+    return i;
   }
 
   const unicode String::CodepointBias[256] =
@@ -0,0 +1,260 @@
+/*
+  ==============================================================================
+
+  Copyright 2007-2013, 2017 Andi
+  Copyright 2013-2016 Robert Taub
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice,
+       this list of conditions and the following disclaimer.
+
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+  POSSIBILITY OF SUCH DAMAGE.
+
+  ==============================================================================
+*/
+
+#ifndef PRIM_INCLUDE_SYMBOL_H
+#define PRIM_INCLUDE_SYMBOL_H
+
+#ifndef PRIM_LIBRARY
+#error This file can not be included individually. Include prim.h instead.
+#endif
+
+namespace PRIM_NAMESPACE
+{
+  /**Interned string identified by a stable integer. All symbols with the same
+  text share a single process-wide copy of the string, so two symbols are equal
+  exactly when their identifiers are equal. Since the interned string is never
+  released, a symbol can be used as a Value key without allocating or copying
+  the string (see Value::Value(const Symbol&)).
+
+  Interning a string looks it up in a global table, so symbols that are used
+  repeatedly should be created once, for example as static constants. The table
+  is not synchronized: symbols should not be created concurrently from several
+  threads.*/
+  class Symbol
+  {
+    public:
+
+    /**Interned string along with its rank in text order. The string is the
+    first member so that the interned string pointer handed out by a symbol
+    also locates its entry.*/
+    class Entry
+    {
+      public:
+
+      ///Interned string
+      String Text;
+
+      /**Position of the string in text order (as C strings). Ranks are spaced
+      apart so that most new strings fit between their neighbors.*/
+      uint64 Rank;
+
+      ///Creates an entry for the text with an unassigned rank.
+      Entry(const String& Text_) : Text(Text_), Rank(0) {Text.Merge();}
+
+      ///Returns a view of the text up to the first null byte.
+      StringView View() const {return StringView(Text.Merge());}
+    };
+
+    ///Process-wide table of interned strings.
+    class Table
+    {
+      ///Maps the text of each interned string to its identifier.
+      HashMap<String, count> Identifiers;
+
+      ///Interned strings indexed by identifier.
+      Array<Entry*> Names;
+
+      ///Interned strings in text order
+      Array<Entry*> Ordered;
+
+      ///Inserts the entry into the text order and assigns its rank.
+      void Rank(Entry* Interned)
+      {
+        //Find the first entry not less than the new text.
+        StringView View = Interned->View();
+        count Low = 0, High = Ordered.n();
+        while(Low < High)
+        {
+          count Middle = Low + (High - Low) / 2;
+          if(Ordered[Middle]->View() < View)
+            Low = Middle + 1;
+          else
+            High = Middle;
+        }
+
+        Ordered.Add(Interned);
+        for(count i = Ordered.n() - 1; i > Low; i--)
+          Ordered[i] = Ordered[i - 1];
+        Ordered[Low] = Interned;
+
+        //Strings that are equal as C strings share a rank.
+        if(Low + 1 < Ordered.n() and Ordered[Low + 1]->View() == View)
+        {
+          Interned->Rank = Ordered[Low + 1]->Rank;
+          return;
+        }
+
+        //Take the midpoint of the neighboring ranks or else renumber them all.
+        uint64 Before = Low ? Ordered[Low - 1]->Rank : 0;
+        uint64 After = Low + 1 < Ordered.n() ? Ordered[Low + 1]->Rank :
+          Limits<uint64>::Max();
+        if(After - Before >= 2)
+          Interned->Rank = Before + (After - Before) / 2;
+        else
+        {
+          uint64 Next = 0;
+          for(count i = 0; i < Ordered.n(); i++)
+          {
+            if(not i or not (Ordered[i - 1]->View() == Ordered[i]->View()))
+              Next += uint64(1) << 32;
+            Ordered[i]->Rank = Next;
+          }
+        }
+      }
+
+      public:
+
+      ///Creates the table with the empty string as the first symbol.
+      Table()
+      {
+        Intern("");
+      }
+
+      ///Releases the interned strings.
+      ~Table()
+      {
+        for(count i = 0; i < Names.n(); i++)
+          delete Names[i];
+      }
+
+      ///Returns the identifier of the text, interning it if necessary.
+      count Intern(const String& Text)
+      {
+        if(Identifiers.Contains(Text))
+          return Identifiers.Get(Text);
+        Entry* Interned = new Entry(Text);
+        Names.Add(Interned);
+        Rank(Interned);
+        Identifiers.Set(Text, Names.n() - 1);
+        return Names.n() - 1;
+      }
+
+      ///Returns the interned string for an identifier.
+      const String* Name(count Identifier) const
+      {
+        return &Names[Identifier]->Text;
+      }
+
+      ///Returns the number of interned strings.
+      count n() const
+      {
+        return Names.n();
+      }
+    };
+
+    private:
+
+    ///Identifier of the interned string
+    count Identifier;
+
+    ///Pointer to the interned string
+    const String* Text;
+
+    ///Interns the text and stores its identifier and string.
+    void Intern(const String& TextToIntern)
+    {
+      Table& Symbols = Singleton<Table>::Instance();
+      Identifier = Symbols.Intern(TextToIntern);
+      Text = Symbols.Name(Identifier);
+    }
+
+    public:
+
+    ///Creates the empty symbol.
+    Symbol() : Identifier(0), Text(0) {Intern("");}
+
+    ///Creates a symbol by interning a string literal.
+    Symbol(const ascii* TextToIntern) : Identifier(0), Text(0)
+    {
+      Intern(TextToIntern);
+    }
+
+    ///Creates a symbol by interning a string.
+    Symbol(const String& TextToIntern) : Identifier(0), Text(0)
+    {
+      Intern(TextToIntern);
+    }
+
+    ///Returns the stable integer identifying the interned string.
+    count ID() const {return Identifier;}
+
+    ///Returns the interned string.
+    const String& Name() const {return *Text;}
+
+    /**Returns a pointer to the interned string. The pointer remains valid for
+    the lifetime of the process and is the same for all symbols with the same
+    text.*/
+    const String* InternedString() const {return Text;}
+
+    /**Returns the rank of an interned string in text order. Comparing the
+    ranks of two interned strings gives the same result as comparing their
+    text as C strings, without looking at the text. The rank may change as
+    other strings are interned, so it should not be stored.*/
+    static uint64 RankOf(const String* Interned)
+    {
+      return reinterpret_cast<const Entry*>(Interned)->Rank;
+    }
+
+    ///Returns the rank of the symbol in text order (see RankOf()).
+    uint64 Rank() const {return RankOf(Text);}
+
+    ///Returns whether two symbols are the same interned string.
+    bool operator == (const Symbol& Other) const
+    {
+      return Identifier == Other.Identifier;
+    }
+
+    ///Returns whether two symbols are different interned strings.
+    bool operator != (const Symbol& Other) const
+    {
+      return Identifier != Other.Identifier;
+    }
+
+    ///Orders symbols by identifier (the order in which they were interned).
+    bool operator < (const Symbol& Other) const
+    {
+      return Identifier < Other.Identifier;
+    }
+
+    ///Orders symbols by identifier (the order in which they were interned).
+    bool operator > (const Symbol& Other) const
+    {
+      return Identifier > Other.Identifier;
+    }
+
+    ///Returns the number of strings that have been interned so far.
+    static count InternedSymbols()
+    {
+      return Singleton<Table>::Instance().n();
+    }
+  };
+}
+#endif
@@ -34,10 +34,110 @@
 
 namespace PRIM_NAMESPACE
 {
+  namespace meta
+  {
+    /**Key-value storage of a tree node under the default allocation policy.
+    The key-value is allocated separately and the 1-bit necessary to store the
+    red-black color is kept in the LSB of its pointer using the BooleanPointer
+    class.*/
+    template <class KV, class P>
+    class TreeKeyValue
+    {
+      ///Combined pointer to the key-value and color of the node
+      BooleanPointer<KV> KeyValueAndColor;
+
+      public:
+
+      ///Deletes the key-value.
+      ~TreeKeyValue() {KeyValueAndColor.Delete();}
+
+      ///Creates the key-value with the given color.
+      template <class K, class V>
+      void Initialize(const K& Key, const V& Value, bool Color)
+      {
+        KeyValueAndColor.SetPointerAndBoolean(new KV(Key, Value), Color);
+      }
+
+      ///Gets the color.
+      bool GetColor() const {return KeyValueAndColor;}
+
+      ///Sets the color.
+      void SetColor(bool NewColor) {KeyValueAndColor.SetBoolean(NewColor);}
+
+      ///Gets the key-value.
+      KV& Get() {return *KeyValueAndColor;}
+
+      ///Gets the const key-value.
+      const KV& Get() const {return *KeyValueAndColor;}
+
+      ///Fast swaps the key-value data by pointer.
+      void Swap(TreeKeyValue& Other)
+      {
+        BooleanPointer<KV>::SwapPointer(KeyValueAndColor,
+          Other.KeyValueAndColor);
+      }
+    };
+
+    /**Key-value storage of a tree node under the pooled allocation policy. The
+    key-value is stored inline so that each node is a single pooled object.*/
+    template <class KV>
+    class TreeKeyValue<KV, PooledAllocation>
+    {
+      ///Key-value of the node
+      KV KeyValue;
+
+      ///Color of the node
+      bool Color;
+
+      public:
+
+      ///Creates an empty key-value.
+      TreeKeyValue() : Color(false) {}
+
+      ///Assigns the key-value and the color.
+      template <class K, class V>
+      void Initialize(const K& Key, const V& Value, bool NewColor)
+      {
+        KeyValue.Key = Key;
+        KeyValue.Value = Value;
+        Color = NewColor;
+      }
+
+      ///Gets the color.
+      bool GetColor() const {return Color;}
+
+      ///Sets the color.
+      void SetColor(bool NewColor) {Color = NewColor;}
+
+      ///Gets the key-value.
+      KV& Get() {return KeyValue;}
+
+      ///Gets the const key-value.
+      const KV& Get() const {return KeyValue;}
+
+      ///Swaps the key-value data (but not the color) with another node.
+      void Swap(TreeKeyValue& Other)
+      {
+#ifdef PRIM_11
+        KV Temporary(Move(KeyValue));
+        KeyValue = Move(Other.KeyValue);
+        Other.KeyValue = Move(Temporary);
+#else
+        Memory::Swap(KeyValue, Other.KeyValue);
+#endif
+      }
+    };
+  }
+
   /**Red-black tree. This implementation is closely modeled off the 2-3 tree
   presented by Sedgewick in his 2008 red-black tree update concerning 2-3-4
-  trees entitled "Left-leaning Red-Black Trees."*/
-  template <class K, class V = K>
+  trees entitled "Left-leaning Red-Black Trees."
+
+  The allocation policy determines how nodes are allocated. By default each
+  node and its key-value are separate heap allocations. With PooledAllocation
+  the key-value is stored inline in the node and nodes are recycled through a
+  pool owned by the tree.*/
+  template <class K, class V = K, class P = HeapAllocation>
   class Tree
   {
     //-------------------//
@@ -62,43 +162,44 @@ namespace PRIM_NAMESPACE
         ///Stores the value in a key-value pair.
         V Value; PRIM_PAD(V)
 
+        ///Constructs an empty key-value.
+        KV() : Key(), Value() {}
+
         ///Constructs the new key-value.
         KV(const K& NewKey, const V& NewValue) : Key(NewKey), Value(NewValue) {}
       };
 
-      /**Combined pointer to a key object and red-black color of this node. The
-      1-bit necessary to store the color is kept in the LSB of the pointer using
-      the BooleanPointer class.*/
-      BooleanPointer<KV> KeyValueAndColor;
+      /**Key-value and red-black color of this node. The storage depends on the
+      allocation policy of the tree.*/
+      meta::TreeKeyValue<KV, P> KeyValueAndColor;
 
       public:
 
       ///Gets the color of the node.
-      bool GetColor() const {return KeyValueAndColor;}
+      bool GetColor() const {return KeyValueAndColor.GetColor();}
 
       ///Sets the color of the node.
-      void SetColor(bool NewColor) {KeyValueAndColor.SetBoolean(NewColor);}
+      void SetColor(bool NewColor) {KeyValueAndColor.SetColor(NewColor);}
 
       ///Flips the color of the node.
       void FlipColor() {SetColor(not GetColor());}
 
       ///Gets a reference to the key of the node.
-      K& Key() {return KeyValueAndColor->Key;}
+      K& Key() {return KeyValueAndColor.Get().Key;}
 
       ///Gets a const reference to the key of the node.
-      const K& Key() const {return KeyValueAndColor->Key;}
+      const K& Key() const {return KeyValueAndColor.Get().Key;}
 
       ///Gets a reference to the value of the node.
-      V& Value() {return KeyValueAndColor->Value;}
+      V& Value() {return KeyValueAndColor.Get().Value;}
 
       ///Gets a const reference to the value of the node.
-      const V& Value() const {return KeyValueAndColor->Value;}
+      const V& Value() const {return KeyValueAndColor.Get().Value;}
 
-      ///Fast swaps the key-value data by pointer.
+      ///Fast swaps the key-value data.
       void SwapKeyValue(Node* Other)
       {
-        BooleanPointer<typename Node::KV>::SwapPointer(KeyValueAndColor,
-          Other->KeyValueAndColor);
+        KeyValueAndColor.Swap(Other->KeyValueAndColor);
       }
 
       ///Node with a key that compares less than the current node key
@@ -107,18 +208,29 @@ namespace PRIM_NAMESPACE
       ///Node with a key that compares greater than the current node key
       Node* Right;
 
-      ///Creates a new node with key and value.
-      Node(const K& NewKey, const V& NewValue) :
-        KeyValueAndColor(new KV(NewKey, NewValue), Red), Left(0), Right(0) {}
+      ///Creates an empty node. Initialize() must be called before use.
+      Node() : Left(0), Right(0) {}
 
-      ///Cleans up the key-value data.
-      ~Node()
+      ///Sets the key and value of a new node.
+      void Initialize(const K& NewKey, const V& NewValue)
       {
-        //Note: the Tree owns the children nodes and cleans up as necessary.
-        KeyValueAndColor.Delete();
+        KeyValueAndColor.Initialize(NewKey, NewValue, Red);
       }
     };
 
+    /**Allocates the nodes of the tree according to the allocation policy and
+    keeps count of them.*/
+    class NodeAllocator : public P::template Allocator<Node>
+    {
+      public:
+
+      ///Number of nodes allocated
+      count Elements;
+
+      ///Creates an empty allocator.
+      NodeAllocator() : Elements(0) {}
+    };
+
     //-------//
     //Members//
     //-------//
@@ -126,8 +238,8 @@ namespace PRIM_NAMESPACE
     ///Root of the red-black tree
     Node* Root;
 
-    ///Cached number of elements in the tree
-    count Elements;
+    ///Node allocator and cached number of elements in the tree
+    NodeAllocator Nodes;
 
     ///Key to return if the key does not exist.
     K EmptyKeyObject; PRIM_PAD(K)
@@ -152,22 +264,24 @@ namespace PRIM_NAMESPACE
     }
 
     ///Deletes an existing node and its children.
-    static void Delete(Node* x, count& Elements)
+    static void Delete(Node* x, NodeAllocator& Nodes)
     {
       if(x)
       {
-        Delete(x->Left, Elements);
-        Delete(x->Right, Elements);
-        Elements--;
-        delete x;
+        Delete(x->Left, Nodes);
+        Delete(x->Right, Nodes);
+        Nodes.Elements--;
+        Nodes.Delete(x);
       }
     }
 
     ///Creates a new node.
-    static Node* New(count& Elements, const K& Key, const V& Value)
+    static Node* New(NodeAllocator& Nodes, const K& Key, const V& Value)
     {
-      Elements++;
-      return new Node(Key, Value);
+      Nodes.Elements++;
+      Node* x = Nodes.New();
+      x->Initialize(Key, Value);
+      return x;
     }
 
     ///Comparator to check that a key is less than another.
@@ -323,13 +437,13 @@ namespace PRIM_NAMESPACE
     }
 
     ///Inserts a node given a key and value assuming incoming node is non-null.
-    static Node* InsertAssumeNode(Node* h, count& Elements, const K& Key,
+    static Node* InsertAssumeNode(Node* h, NodeAllocator& Nodes, const K& Key,
       const V& Value)
     {
       if(LessThan(Key, h->Key()))
-        h->Left = Insert(h->Left, Elements, Key, Value);
+        h->Left = Insert(h->Left, Nodes, Key, Value);
       else if(GreaterThan(Key, h->Key()))
-        h->Right = Insert(h->Right, Elements, Key, Value);
+        h->Right = Insert(h->Right, Nodes, Key, Value);
       else
         h->Value() = Value;
 
@@ -346,14 +460,15 @@ namespace PRIM_NAMESPACE
     }
 
     ///Inserts a node given a key and value.
-    static Node* Insert(Node* h, count& Elements, const K& Key, const V& Value)
+    static Node* Insert(Node* h, NodeAllocator& Nodes, const K& Key,
+      const V& Value)
     {
-      return h ? InsertAssumeNode(h, Elements, Key, Value) :
-        New(Elements, Key, Value);
+      return h ? InsertAssumeNode(h, Nodes, Key, Value) :
+        New(Nodes, Key, Value);
     }
 
     ///Removes the first node from the given node.
-    static Node* RemoveFirst(Node* h, count& Elements)
+    static Node* RemoveFirst(Node* h, NodeAllocator& Nodes)
     {
       Node* x;
 
@@ -362,12 +477,12 @@ namespace PRIM_NAMESPACE
         if(IsBlack(h->Left) and IsBlack(h->Left->Left))
           h = MoveRedLeft(h);
 
-        h->Left = RemoveFirst(h->Left, Elements);
+        h->Left = RemoveFirst(h->Left, Nodes);
         x = FixUp(h);
       }
       else
       {
-        Delete(h, Elements);
+        Delete(h, Nodes);
         x = 0;
       }
 
@@ -375,7 +490,7 @@ namespace PRIM_NAMESPACE
     }
 
     ///Removes the last node from the given node.
-    static Node* RemoveLast(Node* h, count& Elements)
+    static Node* RemoveLast(Node* h, NodeAllocator& Nodes)
     {
       Node* x;
 
@@ -384,7 +499,7 @@ namespace PRIM_NAMESPACE
 
       if(not h->Right)
       {
-        Delete(h, Elements);
+        Delete(h, Nodes);
         x = 0;
       }
       else
@@ -392,22 +507,23 @@ namespace PRIM_NAMESPACE
         if(IsBlack(h->Right) and IsBlack(h->Right->Left))
           h = MoveRedRight(h);
 
-        h->Right = RemoveLast(h->Right, Elements);
+        h->Right = RemoveLast(h->Right, Nodes);
         x = FixUp(h);
       }
 
       return x;
     }
 
-    static Node* RemoveLessThan(Node* h, count& Elements, const K& Key)
+    static Node* RemoveLessThan(Node* h, NodeAllocator& Nodes, const K& Key)
     {
       if(IsBlack(h->Left) and IsBlack(h->Left->Left))
         h = MoveRedLeft(h);
-      h->Left = Remove(h->Left, Elements, Key);
+      h->Left = Remove(h->Left, Nodes, Key);
       return FixUp(h);
     }
 
-    static Node* RemoveGreaterOrEqual(Node* h, count& Elements, const K& Key)
+    static Node* RemoveGreaterOrEqual(Node* h, NodeAllocator& Nodes,
+      const K& Key)
     {
       Node* x;
       if(IsRed(h->Left))
@@ -415,7 +531,7 @@ namespace PRIM_NAMESPACE
 
       if(EqualTo(Key, h->Key()) and not h->Right)
       {
-        Delete(h, Elements);
+        Delete(h, Nodes);
         x = 0;
       }
       else
@@ -426,10 +542,10 @@ namespace PRIM_NAMESPACE
         if(EqualTo(Key, h->Key()))
         {
           h->SwapKeyValue(First(h->Right));
-          h->Right = RemoveFirst(h->Right, Elements);
+          h->Right = RemoveFirst(h->Right, Nodes);
         }
         else
-          h->Right = Remove(h->Right, Elements, Key);
+          h->Right = Remove(h->Right, Nodes, Key);
 
         x = FixUp(h);
       }
@@ -437,31 +553,31 @@ namespace PRIM_NAMESPACE
     }
 
     ///Removes a node.
-    static Node* Remove(Node* h, count& Elements, const K& Key)
+    static Node* Remove(Node* h, NodeAllocator& Nodes, const K& Key)
     {
       return LessThan(Key, h->Key()) ?
-        RemoveLessThan(h, Elements, Key) :
-        RemoveGreaterOrEqual(h, Elements, Key);
+        RemoveLessThan(h, Nodes, Key) :
+        RemoveGreaterOrEqual(h, Nodes, Key);
     }
 
     //Creates node with a key-value pair from another node.
     static void DeepCopyCreateNode(Node*& Destination, const Node* Source,
-      count& Elements)
+      NodeAllocator& Nodes)
     {
-      Destination = New(Elements, Source->Key(), Source->Value());
+      Destination = New(Nodes, Source->Key(), Source->Value());
       Destination->SetColor(Source->GetColor());
-      DeepCopyLinks(Destination, Source, Elements);
+      DeepCopyLinks(Destination, Source, Nodes);
     }
 
     ///Copies linked nodes from another node.
     static void DeepCopyLinks(Node* Destination, const Node* Source,
-      count& Elements)
+      NodeAllocator& Nodes)
     {
       if(Source->Left)
-        DeepCopyCreateNode(Destination->Left, Source->Left, Elements);
+        DeepCopyCreateNode(Destination->Left, Source->Left, Nodes);
 
       if(Source->Right)
-        DeepCopyCreateNode(Destination->Right, Source->Right, Elements);
+        DeepCopyCreateNode(Destination->Right, Source->Right, Nodes);
     }
 
     ///Deep-copies two trees.
@@ -469,7 +585,7 @@ namespace PRIM_NAMESPACE
     {
       Destination.RemoveAll();
       if(Source.Root)
-        DeepCopyCreateNode(Destination.Root, Source.Root, Destination.Elements);
+        DeepCopyCreateNode(Destination.Root, Source.Root, Destination.Nodes);
     }
 
     ///Determines whether two trees contain identical key-value pairs.
@@ -495,14 +611,14 @@ namespace PRIM_NAMESPACE
     public:
 
     ///Creates an empty tree.
-    Tree() : Root(0), Elements(0), EmptyKeyObject(EmptyKey()),
+    Tree() : Root(0), EmptyKeyObject(EmptyKey()),
       EmptyValueObject(EmptyValue()) {}
 
     ///Removes all elements from the tree and destroys the tree.
     ~Tree() {RemoveAll();}
 
     ///Copy-constructor that creates a deep-copy of another tree.
-    Tree(const Tree& Other) : Root(0), Elements(0), EmptyKeyObject(EmptyKey()),
+    Tree(const Tree& Other) : Root(0), EmptyKeyObject(EmptyKey()),
       EmptyValueObject(EmptyValue())
     {
       DeepCopy(*this, Other);
@@ -515,6 +631,30 @@ namespace PRIM_NAMESPACE
       return *this;
     }
 
+#ifdef PRIM_11
+    ///Move constructor takes over the nodes of the other tree.
+    Tree(Tree&& Other) noexcept : Root(Other.Root),
+      EmptyKeyObject(EmptyKey()), EmptyValueObject(EmptyValue())
+    {
+      Nodes.Swap(Other.Nodes);
+      Nodes.Elements = Other.Nodes.Elements, Other.Nodes.Elements = 0;
+      Other.Root = 0;
+    }
+
+    ///Move assignment removes the current nodes and takes over the other's.
+    Tree& operator = (Tree&& Other) noexcept
+    {
+      if(&Other != this)
+      {
+        RemoveAll();
+        Root = Other.Root, Other.Root = 0;
+        Nodes.Swap(Other.Nodes);
+        Nodes.Elements = Other.Nodes.Elements, Other.Nodes.Elements = 0;
+      }
+      return *this;
+    }
+#endif
+
     ///Returns whether the trees have identical key-value pairs.
     bool operator == (const Tree& Other) const
     {
@@ -562,7 +702,7 @@ namespace PRIM_NAMESPACE
     ///Sets a key-value.
     void Set(const K& Key, const V& Value)
     {
-      Root = Insert(Root, Elements, Key, Value);
+      Root = Insert(Root, Nodes, Key, Value);
       Root->SetColor(Black);
     }
 
@@ -585,27 +725,27 @@ namespace PRIM_NAMESPACE
     ///Returns the number of elements in the tree.
     count n() const
     {
-      return Elements;
+      return Nodes.Elements;
     }
 
     ///Removes the first element.
     void RemoveFirst()
     {
-      if(Root && (Root = RemoveFirst(Root, Elements)) != 0)
+      if(Root && (Root = RemoveFirst(Root, Nodes)) != 0)
         Root->SetColor(Black);
     }
 
     ///Removes the last element.
     void RemoveLast()
     {
-      if(Root && (Root = RemoveLast(Root, Elements)) != 0)
+      if(Root && (Root = RemoveLast(Root, Nodes)) != 0)
         Root->SetColor(Black);
     }
 
     ///Removes all of the elements from the tree.
     void RemoveAll()
     {
-      Delete(Root, Elements);
+      Delete(Root, Nodes);
       Root = 0;
     }
 
@@ -613,7 +753,7 @@ namespace PRIM_NAMESPACE
     void Remove(const K& Key)
     {
       //Make sure the element exists before attempting to remove it.
-      if(Get(Root, Key) && (Root = Remove(Root, Elements, Key)) != 0)
+      if(Get(Root, Key) && (Root = Remove(Root, Nodes, Key)) != 0)
         Root->SetColor(Black);
     }
 
@@ -640,7 +780,7 @@ namespace PRIM_NAMESPACE
     ///Gets the maximum height of the tree based off the number of elements.
     count MaximumHeight() const
     {
-      return count(Ceiling(Log2(number(Elements) + 1.f) * 2.f));
+      return count(Ceiling(Log2(number(Nodes.Elements) + 1.f) * 2.f));
     }
 
     //Give the iterator direct access to the Tree.
@@ -48,6 +48,10 @@ namespace PRIM_NAMESPACE
   original constness of the incoming pointer.*/
   class Value
   {
+    ///The JSON writer and binary encoder read the internal representation.
+    friend class JSON;
+    friend class BinaryValue;
+
     public:
 
     /**Generic object handle. A Value can be assigned to store pointers to
@@ -133,11 +137,11 @@ namespace PRIM_NAMESPACE
       ValueTypeBoolean,   // .
       ValueTypeInteger,   // .
       ValueTypeNumber,    // .
-      ValueTypeRatio,     //Stored via pointer to object
+      ValueTypeRatio,     //Stored inline if small, otherwise via pointer
       ValueTypeVector,    // .
-      ValueTypeBox, // .
-      ValueTypeString,    // .
-      ValueTypeArray,     // .
+      ValueTypeBox,       //Stored via pointer to object
+      ValueTypeString,    //Stored inline if small, otherwise via pointer
+      ValueTypeArray,     //Stored via pointer to object
       ValueTypeTree,      // .
       ValueTypeObject     // .
     };
@@ -158,6 +162,48 @@ namespace PRIM_NAMESPACE
     //Alias for the const object type
     typedef Pointer<const Base> ConstObjectType;
 
+    /**Heap storage for an array or tree. Copies of a value share the storage
+    and only the reference count is incremented. The storage is cloned when a
+    value that shares it is modified, so copying a large value costs nothing
+    until one of the copies changes.
+
+    Storage from which a mutable reference into the container has been handed
+    out is marked as exposed until it is cloned. Copying a value invalidates
+    the references into it, as a write through one could be seen by the copy,
+    so copies still share exposed storage. The mark is only used to find the
+    values that an assignment could be writing into (see operator =). The
+    container is the first member so that the data pointer can be cast
+    directly to the container type.*/
+    template <class T> class Shared
+    {
+      public:
+
+      ///The container
+      T Container;
+
+      ///Number of values sharing the container
+      meta::PointerCount References;
+
+      ///Whether mutable references into the container have been handed out
+      bool Exposed; PRIM_PAD(bool)
+
+      ///Creates an empty container.
+      Shared() : References(1), Exposed(false) {}
+
+      ///Creates a copy of a container.
+      Shared(const T& Other) : Container(Other), References(1),
+        Exposed(false) {}
+    };
+
+    /**Field 2: Stores the value type according to a value type constant. It
+    comes first so that the bytes following the value type run contiguously
+    into field 1, where they are used for inline data.*/
+    union
+    {
+      ValueTypes ValueType;
+      int64      DataField2; //Used for padding and clearing.
+    };
+
     ///Field 1: Stores data or pointer to data.
     union
     {
@@ -168,13 +214,6 @@ namespace PRIM_NAMESPACE
       int64   DataField1; //Used for padding and clearing.
     };
 
-    ///Field 2: Stores the value type according to a value type constant.
-    union
-    {
-      ValueTypes ValueType;
-      int64      DataField2; //Used for padding and clearing.
-    };
-
     //----------------------//
     //Internal Data Handling//
     //----------------------//
@@ -185,16 +224,241 @@ namespace PRIM_NAMESPACE
       DataField1 = DataField2 = 0;
     }
 
+    ///Releases the current data and copies the fields of the other value.
+    void InternalCopyFields(const Value& Other)
+    {
+      InternalDeallocate();
+      DataField1 = Other.DataField1;
+      DataField2 = Other.DataField2;
+    }
+
+    /**Releases the current data and takes over the data of the other value,
+    leaving the other value nil. The other value is detached before the
+    current data is released, so it may be a descendant of this value.*/
+    void InternalTakeOver(Value& Other)
+    {
+      int64 OtherField1 = Other.DataField1;
+      int64 OtherField2 = Other.DataField2;
+      Other.InternalClear();
+      InternalDeallocate();
+      DataField1 = OtherField1;
+      DataField2 = OtherField2;
+    }
+
+    //-----------//
+    //Inline Data//
+    //-----------//
+
+    /*Ratios and vectors whose parts fit in 32 bits, and short strings, are
+    stored in the bytes that follow the value type instead of on the heap.
+    Inline ratios and vectors set the first of these bytes to one and keep
+    their parts in field 1. Inline strings have no null bytes and are padded
+    with nulls, so the first byte is either the first character or, if the
+    string is empty, zero along with the rest of the fields. Heap data leaves
+    the bytes clear, and its data pointer is never null.*/
+
+    ///The maximum length of a string that is stored inline
+    static count InlineStringCapacity()
+    {
+      return count(sizeof(DataField1) + sizeof(DataField2) -
+        sizeof(ValueTypes));
+    }
+
+    ///Returns the bytes available for inline data.
+    byte* InternalInline()
+    {
+      return reinterpret_cast<byte*>(&DataField2) + sizeof(ValueTypes);
+    }
+
+    ///Returns the bytes available for inline data.
+    const byte* InternalInline() const
+    {
+      return reinterpret_cast<const byte*>(&DataField2) + sizeof(ValueTypes);
+    }
+
+    /**Returns whether a ratio, vector, or string is stored inline. The result
+    is only meaningful for those types.*/
+    bool InternalIsInline() const
+    {
+      return *InternalInline() or not DataPointer;
+    }
+
+    /**Returns whether the data pointer refers to a string interned by Symbol.
+    Such strings are owned by the symbol table and are marked by setting the
+    lowest bit of the (aligned) data pointer.*/
+    bool InternalIsSymbol() const
+    {
+      return ValueType == ValueTypeString and not InternalIsInline() and
+        (reinterpret_cast<uintptr>(DataPointer) & 1) != 0;
+    }
+
+    /**Returns a view of the string data. If ToFirstNull is true, then the view
+    ends at the first null byte as it would for a C string.*/
+    StringView InternalStringView(bool ToFirstNull = false) const
+    {
+      if(InternalIsInline())
+      {
+        const byte* Bytes = InternalInline();
+        const byte* End = StringView::FindByte(Bytes, InlineStringCapacity(),
+          0);
+        return StringView(Bytes, End ? count(End - Bytes) :
+          InlineStringCapacity());
+      }
+      const String& s = AssumeAndGet<String>();
+      return ToFirstNull ? StringView(s.Merge()) : StringView(s);
+    }
+
+    ///Returns the ratio, which may be stored inline.
+    Ratio InternalRatio() const
+    {
+      if(not InternalIsInline())
+        return AssumeAndGet<Ratio>();
+      int32 Parts[2];
+      Memory::MemCopy(Parts, &DataField1, count(sizeof(Parts)));
+      return Ratio(int64(Parts[0]), int64(Parts[1]));
+    }
+
+    ///Returns the vector, which may be stored inline.
+    Vector InternalVector() const
+    {
+      if(not InternalIsInline())
+        return AssumeAndGet<Vector>();
+      float32 Parts[2];
+      Memory::MemCopy(Parts, &DataField1, count(sizeof(Parts)));
+      return Vector(number(Parts[0]), number(Parts[1]));
+    }
+
+    ///Sets the value to a string, storing it inline if possible.
+    void InternalSetString(const byte* Data, count Length)
+    {
+      if(Length <= InlineStringCapacity() and
+        not StringView::FindByte(Data, Length, 0))
+      {
+        //The data is copied out first in case it belongs to this value.
+        byte Bytes[sizeof(DataField1) + sizeof(DataField2)];
+        Memory::Clear(Bytes, count(sizeof(Bytes)));
+        if(Length)
+          Memory::MemCopy(Bytes, Data, Length);
+        InternalDeallocate();
+        ValueType = ValueTypeString;
+        Memory::MemCopy(InternalInline(), Bytes, InlineStringCapacity());
+      }
+      else
+      {
+        String& s = Get<String, ValueTypeString>();
+        s.Clear();
+        s.Append(Data, Length);
+      }
+    }
+
+    ///Sets the value to a string, storing it inline if possible.
+    void InternalSetString(const String& x)
+    {
+      if(x.n() <= InlineStringCapacity())
+        InternalSetString(reinterpret_cast<const byte*>(x.Merge()), x.n());
+      else
+        Get<String, ValueTypeString>() = x;
+    }
+
+    ///Sets the value to a ratio, storing it inline if the parts fit in 32 bits.
+    void InternalSetRatio(const Ratio& x)
+    {
+      int64 n = int64(x.Numerator()), d = int64(x.Denominator());
+      if(n >= int64(Limits<int32>::Min()) and n <= int64(Limits<int32>::Max())
+        and d > 0 and d <= int64(Limits<int32>::Max()))
+      {
+        int32 Parts[2] = {int32(n), int32(d)};
+        InternalDeallocate();
+        ValueType = ValueTypeRatio;
+        Memory::MemCopy(&DataField1, Parts, count(sizeof(Parts)));
+        *InternalInline() = 1;
+      }
+      else
+        Get<Ratio, ValueTypeRatio>() = x;
+    }
+
+    ///Returns whether a number converts to float32 and back without change.
+    static bool InternalIsExactFloat32(number x)
+    {
+      return x >= -number(Limits<float32>::Max()) and
+        x <= number(Limits<float32>::Max()) and number(float32(x)) == x;
+    }
+
+    /**Sets the value to a vector, storing it inline if both parts are exactly
+    representable as float32.*/
+    void InternalSetVector(const Vector& x)
+    {
+      if(InternalIsExactFloat32(x.x) and InternalIsExactFloat32(x.y))
+      {
+        float32 Parts[2] = {float32(x.x), float32(x.y)};
+        InternalDeallocate();
+        ValueType = ValueTypeVector;
+        Memory::MemCopy(&DataField1, Parts, count(sizeof(Parts)));
+        *InternalInline() = 1;
+      }
+      else
+        Get<Vector, ValueTypeVector>() = x;
+    }
+
+    /**Moves inline data to the heap, so that a mutable reference to it can be
+    handed out.*/
+    void InternalMoveInlineToHeap()
+    {
+      void* Data = 0;
+      if(ValueType == ValueTypeRatio)
+        Data = new Ratio(InternalRatio());
+      else if(ValueType == ValueTypeVector)
+        Data = new Vector(InternalVector());
+      else
+        Data = new String(InternalStringView());
+      ValueTypes Type = ValueType;
+      InternalClear();
+      ValueType = Type;
+      DataPointer = Data;
+    }
+
     ///Statically casts the data pointer to the requested type.
     template <class T> T* InternalCastTo()
     {
-      return reinterpret_cast<T*>(DataPointer);
+      return reinterpret_cast<T*>(
+        reinterpret_cast<uintptr>(DataPointer) & ~uintptr(1));
     }
 
     ///Statically const casts the data pointer to the requested type.
     template <class T> const T* InternalCastTo() const
     {
-      return reinterpret_cast<const T*>(DataPointer);
+      return reinterpret_cast<const T*>(
+        reinterpret_cast<uintptr>(DataPointer) & ~uintptr(1));
+    }
+
+    ///Refers to an interned string without copying it.
+    void InternalSetSymbol(const String* Interned)
+    {
+      InternalDeallocate();
+      ValueType = ValueTypeString;
+      DataPointer = reinterpret_cast<void*>(
+        reinterpret_cast<uintptr>(Interned) | 1);
+    }
+
+    ///Releases a reference to shared storage, deleting it if it is the last.
+    template <class T> void InternalRelease()
+    {
+      Shared<T>* Storage = InternalCastTo<Shared<T> >();
+      if(not --Storage->References)
+        delete Storage;
+    }
+
+    ///Clones the storage of the value if it is shared with any other value.
+    template <class T> void InternalUnshare()
+    {
+      Shared<T>* Storage = InternalCastTo<Shared<T> >();
+      if(Storage->References != 1)
+      {
+        DataPointer = reinterpret_cast<void*>(
+          new Shared<T>(Storage->Container));
+        if(not --Storage->References)
+          delete Storage;
+      }
     }
 
     ///Deallocates heap memory used for the value.
@@ -203,22 +467,25 @@ namespace PRIM_NAMESPACE
       switch(ValueType)
       {
       case ValueTypeRatio:
-        delete InternalCastTo<Ratio>();
+        if(not InternalIsInline())
+          delete InternalCastTo<Ratio>();
         break;
       case ValueTypeVector:
-        delete InternalCastTo<Vector>();
+        if(not InternalIsInline())
+          delete InternalCastTo<Vector>();
         break;
       case ValueTypeBox:
         delete InternalCastTo<Box>();
         break;
       case ValueTypeString:
-        delete InternalCastTo<String>();
+        if(not InternalIsInline() and not InternalIsSymbol())
+          delete InternalCastTo<String>();
         break;
       case ValueTypeArray:
-        delete InternalCastTo<ArrayType>();
+        InternalRelease<ArrayType>();
         break;
       case ValueTypeTree:
-        delete InternalCastTo<TreeType>();
+        InternalRelease<TreeType>();
         break;
       case ValueTypeObject:
         delete InternalCastTo<ObjectType>();
@@ -252,10 +519,10 @@ namespace PRIM_NAMESPACE
         DataPointer = reinterpret_cast<void*>(new String);
         break;
       case ValueTypeArray:
-        DataPointer = reinterpret_cast<void*>(new ArrayType);
+        DataPointer = reinterpret_cast<void*>(new Shared<ArrayType>);
         break;
       case ValueTypeTree:
-        DataPointer = reinterpret_cast<void*>(new TreeType);
+        DataPointer = reinterpret_cast<void*>(new Shared<TreeType>);
         break;
       case ValueTypeObject:
         DataPointer = reinterpret_cast<void*>(new ObjectType);
@@ -310,7 +577,9 @@ namespace PRIM_NAMESPACE
     //Value Referencing//
     //-----------------//
 
-    ///Gets a reference to a value of a specific type reallocating if necessary.
+    /**Gets a reference to a value of a specific type reallocating if necessary.
+    Inline data is moved to the heap, and arrays and trees are unshared first,
+    since the reference may be used to modify them.*/
     template <class T, ValueTypes ValueTypeT> T& Get()
     {
       if(ValueType != ValueTypeT)
@@ -319,9 +588,84 @@ namespace PRIM_NAMESPACE
         ValueType = ValueTypeT;
         InternalAllocate();
       }
+      else if((ValueTypeT == ValueTypeRatio or ValueTypeT == ValueTypeVector or
+        ValueTypeT == ValueTypeString) and InternalIsInline())
+          InternalMoveInlineToHeap();
+      else if(InternalIsSymbol())
+      {
+        //Make a private copy of an interned string before it can be modified.
+        DataPointer = reinterpret_cast<void*>(
+          new String(*InternalCastTo<String>()));
+      }
+      if(ValueTypeT == ValueTypeArray)
+        InternalUnshare<ArrayType>();
+      else if(ValueTypeT == ValueTypeTree)
+        InternalUnshare<TreeType>();
       return *InternalCastTo<T>();
     }
 
+    /**Gets a reference to an array or tree, reallocating if necessary, through
+    which a mutable reference to an element is about to be handed out. The
+    storage is marked as exposed until it is next cloned.*/
+    template <class T, ValueTypes ValueTypeT> T& GetAndExpose()
+    {
+      T& Container = Get<T, ValueTypeT>();
+      InternalCastTo<Shared<T> >()->Exposed = true;
+      return Container;
+    }
+
+    /**Returns whether an element lies in a container of this value, searching
+    only the storage that has handed out mutable references, since that is
+    the only way the element could have been reached for writing.*/
+    bool InternalExposes(const Value* Element) const
+    {
+      if(ValueType == ValueTypeArray)
+      {
+        const Shared<ArrayType>* Storage =
+          InternalCastTo<Shared<ArrayType> >();
+        if(Storage->Exposed)
+          for(count i = 0; i < Storage->Container.n(); i++)
+            if(&Storage->Container[i] == Element or
+              Storage->Container[i].InternalExposes(Element))
+                return true;
+      }
+      else if(ValueType == ValueTypeTree)
+      {
+        const Shared<TreeType>* Storage = InternalCastTo<Shared<TreeType> >();
+        if(Storage->Exposed)
+        {
+          TreeType::Iterator It;
+          for(It.Begin(Storage->Container); It.Iterating(); It.Next())
+            if(&It.Value() == Element or It.Value().InternalExposes(Element))
+              return true;
+        }
+      }
+      return false;
+    }
+
+    /**Clones the exposed storage that this value shares, and the exposed
+    storage below it, so that no element that could be written to through a
+    reference is shared with the value.*/
+    void InternalCloneExposed()
+    {
+      if(ValueType == ValueTypeArray and
+        InternalCastTo<Shared<ArrayType> >()->Exposed)
+      {
+        InternalUnshare<ArrayType>();
+        ArrayType& a = *InternalCastTo<ArrayType>();
+        for(count i = 0; i < a.n(); i++)
+          a[i].InternalCloneExposed();
+      }
+      else if(ValueType == ValueTypeTree and
+        InternalCastTo<Shared<TreeType> >()->Exposed)
+      {
+        InternalUnshare<TreeType>();
+        TreeType::Iterator It;
+        for(It.Begin(*InternalCastTo<TreeType>()); It.Iterating(); It.Next())
+          const_cast<Value&>(It.Value()).InternalCloneExposed();
+      }
+    }
+
     /**Gets a reference to a value of assumed type. If the value is not of the
     given type, then the behavior is undefined.*/
     template <class T> const T& AssumeAndGet() const
@@ -404,13 +748,13 @@ namespace PRIM_NAMESPACE
       case ValueTypeNumber:
         return bool(DataNumberValue);
       case ValueTypeRatio:
-        return !AssumeAndGet<Ratio>().IsEmpty();
+        return !InternalRatio().IsEmpty();
       case ValueTypeVector:
-        return !AssumeAndGet<Vector>().IsEmpty();
+        return !InternalVector().IsEmpty();
       case ValueTypeBox:
         return !AssumeAndGet<Box>().IsEmpty();
       case ValueTypeString:
-        return bool(AssumeAndGet<String>());
+        return bool(InternalStringView());
       case ValueTypeArray:
         return bool(AssumeAndGet<ArrayType>().n());
       case ValueTypeTree:
@@ -435,9 +779,9 @@ namespace PRIM_NAMESPACE
       case ValueTypeNumber:
         return integer(DataNumberValue);
       case ValueTypeRatio:
-        return AssumeAndGet<Ratio>().To<integer>();
+        return InternalRatio().To<integer>();
       case ValueTypeString:
-        return integer(AssumeAndGet<String>().ToNumber());
+        return integer(InternalStringView().ToNumber());
       case ValueTypeArray:
         return integer(AssumeAndGet<ArrayType>().n());
       case ValueTypeTree:
@@ -469,11 +813,11 @@ namespace PRIM_NAMESPACE
       case ValueTypeNumber:
         return DataNumberValue;
       case ValueTypeRatio:
-        return AssumeAndGet<Ratio>().To<number>();
+        return InternalRatio().To<number>();
       case ValueTypeVector:
-        return number(AssumeAndGet<Vector>().Mag());
+        return number(InternalVector().Mag());
       case ValueTypeString:
-        return number(AssumeAndGet<String>().ToNumber());
+        return number(InternalStringView().ToNumber());
       case ValueTypeNil:
       case ValueTypeBox:
       case ValueTypeArray:
@@ -496,9 +840,9 @@ namespace PRIM_NAMESPACE
       case ValueTypeNumber:
         return Ratio(DataNumberValue, 1000, false);
       case ValueTypeRatio:
-        return AssumeAndGet<Ratio>();
+        return InternalRatio();
       case ValueTypeString:
-        return Ratio(AssumeAndGet<String>());
+        return Ratio(AsString());
       case ValueTypeArray:
         return Ratio(AssumeAndGet<ArrayType>().n());
       case ValueTypeTree:
@@ -524,9 +868,9 @@ namespace PRIM_NAMESPACE
       case ValueTypeNumber:
         return Vector(number(DataNumberValue), 0.);
       case ValueTypeRatio:
-        return Vector(AssumeAndGet<Ratio>().To<number>(), 0.);
+        return Vector(InternalRatio().To<number>(), 0.);
       case ValueTypeVector:
-        return AssumeAndGet<Vector>();
+        return InternalVector();
       case ValueTypeBox:
         return AssumeAndGet<Box>().Size();
       case ValueTypeNil:
@@ -545,8 +889,7 @@ namespace PRIM_NAMESPACE
       if(ValueType == ValueTypeBox)
         return AssumeAndGet<Box>();
       else if(ValueType == ValueTypeVector)
-        return Box(Vector(),
-          AssumeAndGet<Vector>());
+        return Box(Vector(), InternalVector());
       return Box();
     }
 
@@ -564,12 +907,14 @@ namespace PRIM_NAMESPACE
       case ValueTypeNumber:
         return String(DataNumberValue);
       case ValueTypeRatio:
-        return String(AssumeAndGet<Ratio>());
+        return String(InternalRatio());
       case ValueTypeVector:
-        return String(AssumeAndGet<Vector>());
+        return String(InternalVector());
       case ValueTypeBox:
         return String(AssumeAndGet<Box>());
       case ValueTypeString:
+        if(InternalIsInline())
+          return String(InternalStringView());
         return AssumeAndGet<String>();
       case ValueTypeArray:
         return String(AssumeAndGet<ArrayType>());
@@ -638,6 +983,12 @@ namespace PRIM_NAMESPACE
     ///Returns whether the value is nil.
     bool IsNil() const {return ValueType == ValueTypeNil;}
 
+    ///Returns whether the value is a string interned by a symbol.
+    bool IsSymbol() const
+    {
+      return ValueType == ValueTypeString and InternalIsSymbol();
+    }
+
     ///Returns whether the value is a boolean.
     bool IsBoolean() const {return ValueType == ValueTypeBoolean;}
 
@@ -759,7 +1110,15 @@ namespace PRIM_NAMESPACE
       if(ValueType == ValueTypeBoolean)
         return AsInteger() < Other.AsInteger();
       else if(ValueType == ValueTypeString)
-        return AssumeAndGet<String>() < Other.AssumeAndGet<String>();
+      {
+        /*Strings compare as C strings, that is, up to the first null byte.
+        Interned strings carry their rank in that order, so two symbols are
+        ordered without looking at their text.*/
+        if(InternalIsSymbol() and Other.InternalIsSymbol())
+          return Symbol::RankOf(InternalCastTo<String>()) <
+            Symbol::RankOf(Other.InternalCastTo<String>());
+        return InternalStringView(true) < Other.InternalStringView(true);
+      }
       else if(ValueType == ValueTypeObject)
         return AssumeAndGet<ObjectType>() < Other.AssumeAndGet<ObjectType>();
 
@@ -797,17 +1156,22 @@ namespace PRIM_NAMESPACE
       case ValueTypeBoolean:
         return DataBooleanValue == Other.DataBooleanValue;
       case ValueTypeVector:
-        return AssumeAndGet<Vector>() ==
-          Other.AssumeAndGet<Vector>();
+        return InternalVector() == Other.InternalVector();
       case ValueTypeBox:
         return AssumeAndGet<Box>() ==
           Other.AssumeAndGet<Box>();
       case ValueTypeString:
-        return AssumeAndGet<String>() == Other.AssumeAndGet<String>();
+        //Interned strings are equal exactly when they are the same string.
+        if(InternalIsSymbol() and Other.InternalIsSymbol())
+          return DataPointer == Other.DataPointer;
+        return InternalStringView() == Other.InternalStringView(true);
       case ValueTypeArray:
-        return AssumeAndGet<ArrayType>() == Other.AssumeAndGet<ArrayType>();
+        //Copies that still share their storage are trivially equal.
+        return DataPointer == Other.DataPointer or
+          AssumeAndGet<ArrayType>() == Other.AssumeAndGet<ArrayType>();
       case ValueTypeTree:
-        return AssumeAndGet<TreeType>() == Other.AssumeAndGet<TreeType>();
+        return DataPointer == Other.DataPointer or
+          AssumeAndGet<TreeType>() == Other.AssumeAndGet<TreeType>();
       case ValueTypeObject:
         return AssumeAndGet<ObjectType>() == Other.AssumeAndGet<ObjectType>();
       case ValueTypeInteger:
@@ -904,6 +1268,16 @@ namespace PRIM_NAMESPACE
       AssumeDifferentDeepCopy(Other, *this);
     }
 
+#ifdef PRIM_11
+    ///Move constructor takes over the data of the other value.
+    Value(Value&& Other) noexcept
+    {
+      DataField1 = Other.DataField1;
+      DataField2 = Other.DataField2;
+      Other.InternalClear();
+    }
+#endif
+
     ///Constructs the value using a bool.
     explicit Value(bool x) {InternalClear(); GetBoolean() = x;}
 
@@ -946,19 +1320,31 @@ namespace PRIM_NAMESPACE
 
     ///Constructs the value using a ratio.
     explicit Value(Ratio x) {InternalClear();
-      Get<Ratio, ValueTypeRatio>() = x; InternalCoerceToNil();}
+      InternalSetRatio(x); InternalCoerceToNil();}
 
     ///Constructs the value using a string.
     explicit Value(const String& x) {InternalClear();
-      Get<String, ValueTypeString>() = x;}
+      InternalSetString(x);}
+
+#ifdef PRIM_11
+    ///Constructs the value by moving a string into it.
+    explicit Value(String&& x) {InternalClear();
+      if(x.n() <= InlineStringCapacity()) InternalSetString(x);
+      else Get<String, ValueTypeString>() = Move(x);}
+#endif
+
+    ///Constructs the value using an interned string without copying it.
+    explicit Value(const Symbol& x) {InternalClear();
+      InternalSetSymbol(x.InternedString());}
 
     ///Constructs the value using a constant string.
     explicit Value(const ascii* x) {InternalClear();
-      Get<String, ValueTypeString>() = x;}
+      InternalSetString(reinterpret_cast<const byte*>(x),
+        String::LengthOf(x));}
 
     ///Constructs the value using a vector.
     explicit Value(Vector x) {InternalClear();
-      Get<Vector, ValueTypeVector>() = x; InternalCoerceToNil();}
+      InternalSetVector(x); InternalCoerceToNil();}
 
     ///Constructs the value using a rectangle.
     explicit Value(Box x) {InternalClear();
@@ -977,9 +1363,15 @@ namespace PRIM_NAMESPACE
     private:
 
     /**Deep copies under the assumption that the copy value reference is not the
-    original or contained by original.*/
+    original or contained by original. Arrays and trees are copied by sharing
+    their storage (see Shared).*/
     static void AssumeDifferentDeepCopy(const Value& Original, Value& Copy)
     {
+#ifdef PRIM_VALUE_COPY_STATISTICS
+      if(Original.ValueType != ValueTypeArray and
+        Original.ValueType != ValueTypeTree)
+          DeepCopies()++;
+#endif
       switch(Original.ValueType)
       {
       case ValueTypeNil:
@@ -995,39 +1387,35 @@ namespace PRIM_NAMESPACE
         Copy.GetNumber() = Original.DataNumberValue;
         break;
       case ValueTypeRatio:
-        Copy.Get<Ratio, ValueTypeRatio>() =
-          Original.AssumeAndGet<Ratio>();
+        if(Original.InternalIsInline())
+          Copy.InternalCopyFields(Original);
+        else
+          Copy.Get<Ratio, ValueTypeRatio>() =
+            Original.AssumeAndGet<Ratio>();
         break;
       case ValueTypeVector:
-        Copy.Get<Vector, ValueTypeVector>() =
-          Original.AssumeAndGet<Vector>();
+        if(Original.InternalIsInline())
+          Copy.InternalCopyFields(Original);
+        else
+          Copy.Get<Vector, ValueTypeVector>() =
+            Original.AssumeAndGet<Vector>();
         break;
       case ValueTypeBox:
         Copy.Get<Box, ValueTypeBox>() =
           Original.AssumeAndGet<Box>();
         break;
       case ValueTypeString:
-        Copy.Get<String, ValueTypeString>() =
-          Original.AssumeAndGet<String>();
+        //Inline and interned strings are copied along with the fields.
+        if(Original.InternalIsInline() or Original.InternalIsSymbol())
+          Copy.InternalCopyFields(Original);
+        else
+          Copy.InternalSetString(Original.AssumeAndGet<String>());
         break;
       case ValueTypeArray:
-        {
-          const ArrayType& OriginalArray = Original.AssumeAndGet<ArrayType>();
-          ArrayType& CopyArray = Copy.Get<ArrayType, ValueTypeArray>();
-          CopyArray.n(OriginalArray.n());
-          for(count i = 0, n = OriginalArray.n(); i < n; i++)
-            AssumeDifferentDeepCopy(OriginalArray[i], CopyArray[i]);
-        }
+        AssumeDifferentShare<ArrayType>(Original, Copy);
         break;
       case ValueTypeTree:
-        {
-          /*Since key-values are about to be appended into an indefinite space,
-          make sure that any existing tree is cleared beforehand so that old
-          keys do not remain in the deep copy.*/
-          Copy.Clear();
-          Copy.Get<TreeType, ValueTypeTree>() =
-            Original.AssumeAndGet<TreeType>();
-        }
+        AssumeDifferentShare<TreeType>(Original, Copy);
         break;
       case ValueTypeObject:
         Copy.Get<ObjectType, ValueTypeObject>() =
@@ -1036,8 +1424,29 @@ namespace PRIM_NAMESPACE
       }
     }
 
+    ///Copies an array or tree by sharing its storage.
+    template <class T>
+    static void AssumeDifferentShare(const Value& Original, Value& Copy)
+    {
+      Shared<T>* Storage =
+        const_cast<Value&>(Original).InternalCastTo<Shared<T> >();
+      Copy.Clear();
+      Copy.ValueType = Original.ValueType;
+      ++Storage->References;
+      Copy.DataPointer = reinterpret_cast<void*>(Storage);
+    }
+
   public:
 
+#ifdef PRIM_VALUE_COPY_STATISTICS
+    ///Returns the running count of values that have been deep-copied.
+    static count& DeepCopies()
+    {
+      static count NumberOfDeepCopies = 0;
+      return NumberOfDeepCopies;
+    }
+#endif
+
     //--------------------//
     //Assignment Operators//
     //--------------------//
@@ -1054,33 +1463,22 @@ namespace PRIM_NAMESPACE
       {
         /* #screwcase : a = a, a[0] = a, a[a] = a, and so on...
         Self-assignment and especially partial self-assignment cause many
-        headaches. In order to rule out all the types of self-assignment that
-        may occur, a temporary deep-copy is made and the final deep-copy
-        proceeds from that. Although this doubles the time to make a copy, it is
-        guaranteed to be safe.
-
-                                      .-----.
-                                     /  ._.  \
-                                    |  /   \  |
-                                    |  |    | |
-                                    |  |    | |
-                                   /    \  / /
-                                  /      \/ /
-                                 /       /`/
-                                /       / /\
-                                |     .`-'  |
-                                |    .'.'   |
-                                |    : :    |
-                                |  ..: :..  |
-                                |.' .' `. '.|
-                                \ .'     `. /
-                                 \_________/
-
-        Need to do a full deep-copy to temporary if any containers are involved
-        to isolate the copy operation.*/
+        headaches. If this value contains the other, then overwriting this
+        value destroys the other mid-copy. If the other contains this value,
+        then the copy would read from the tree it is writing into.
+
+        Both cases are ruled out by making the one deep-copy into a temporary,
+        which is not reachable from either value, and then taking over the
+        data of the temporary without copying. Only after the copy is complete
+        is the old data of this value released. Since the copy shares the
+        storage of the other, if this value is inside the other, the storage
+        leading to it is cloned so that the value does not end up containing
+        itself.*/
         Value DeepCopyOther;
         AssumeDifferentDeepCopy(Other, DeepCopyOther);
-        AssumeDifferentDeepCopy(DeepCopyOther, *this);
+        if(Other.InternalExposes(this))
+          DeepCopyOther.InternalCloneExposed();
+        InternalTakeOver(DeepCopyOther);
       }
       else
       {
@@ -1092,6 +1490,19 @@ namespace PRIM_NAMESPACE
       return *this;
     }
 
+#ifdef PRIM_11
+    /**Move assignment takes over the data of the other value. The other value
+    is detached before the current data is released, so moving a descendant
+    into its container (a = Move(a["x"])) is safe. Moving a container into one
+    of its own descendants is not supported.*/
+    Value& operator = (Value&& Other) noexcept
+    {
+      if(this != &Other)
+        InternalTakeOver(Other);
+      return *this;
+    }
+#endif
+
     ///Assigns the value to a bool.
     Value& operator = (bool x)
       {GetBoolean() = x; return *this;}
@@ -1143,23 +1554,43 @@ namespace PRIM_NAMESPACE
     ///Assigns the value to a ratio.
     Value& operator = (Ratio x)
     {
-      Get<Ratio, ValueTypeRatio>() = x;
+      InternalSetRatio(x);
       InternalCoerceToNil();
       return *this;
     }
 
     ///Assigns the value to a string.
     Value& operator = (const String& x)
-      {Get<String, ValueTypeString>() = x; return *this;}
+      {InternalSetString(x); return *this;}
+
+#ifdef PRIM_11
+    ///Assigns the value to a string by moving it.
+    Value& operator = (String&& x)
+    {
+      if(x.n() <= InlineStringCapacity())
+        InternalSetString(x);
+      else
+        Get<String, ValueTypeString>() = Move(x);
+      return *this;
+    }
+#endif
+
+    ///Assigns the value to an interned string without copying it.
+    Value& operator = (const Symbol& x)
+      {InternalSetSymbol(x.InternedString()); return *this;}
 
     ///Assigns the value to a constant string.
     Value& operator = (const ascii* x)
-      {Get<String, ValueTypeString>() = x; return *this;}
+    {
+      InternalSetString(reinterpret_cast<const byte*>(x),
+        String::LengthOf(x));
+      return *this;
+    }
 
     ///Assigns the value to a vector.
     Value& operator = (Vector x)
     {
-      Get<Vector, ValueTypeVector>() = x;
+      InternalSetVector(x);
       InternalCoerceToNil();
       return *this;
     }
@@ -1249,7 +1680,7 @@ namespace PRIM_NAMESPACE
       x.Clear();
       if(ValueType == ValueTypeString)
       {
-        String s = AssumeAndGet<String>();
+        String s = AsString();
         return Encoding::Base64::Decode(s, x);
       }
       return false;
@@ -1299,7 +1730,7 @@ namespace PRIM_NAMESPACE
     {
       if(ValueType != ValueTypeArray)
         NewArray();
-      ArrayType& a = Get<ArrayType, ValueTypeArray>();
+      ArrayType& a = GetAndExpose<ArrayType, ValueTypeArray>();
       count NextIndexCount = n();
       a.n(NextIndexCount + 1);
       return a[NextIndexCount];
@@ -1343,17 +1774,12 @@ namespace PRIM_NAMESPACE
     const Value& operator [] (const Value& Key) const
     {
       /*In the const [] method, the underlying data structure can not change, so
-      only return a value if the key exists.*/
-
-      /* #screwcase : a[a]
-      Make a deep-copy in case of a self-assigned key. Usually a key is not a
-      container, so making a deep-copy is not expensive.*/
-      Value KeyCopy(Key);
-
-      if(ValueType == ValueTypeArray and KeyCopy.ValueType == ValueTypeInteger)
-        return AssumeAndGet<ArrayType>()[count(KeyCopy.DataIntegerValue)];
+      only return a value if the key exists. For the same reason, the key can
+      not be destroyed by the lookup even if it is an element of this value.*/
+      if(ValueType == ValueTypeArray and Key.ValueType == ValueTypeInteger)
+        return AssumeAndGet<ArrayType>()[count(Key.DataIntegerValue)];
       else if(ValueType == ValueTypeTree)
-        return AssumeAndGet<TreeType>()[KeyCopy];
+        return AssumeAndGet<TreeType>()[Key];
 
       //Key does not exist in the current container.
       return Empty();
@@ -1372,26 +1798,34 @@ namespace PRIM_NAMESPACE
       /*In the non-const [] method, the underlying data structure may change
       depending on the current type and the type of the key.*/
 
-      /* #screwcase : a[a]
-      Make a deep-copy in case of a self-assigned key. Usually a key is not a
-      container, so making a deep-copy is usually not expensive.*/
-      Value KeyCopy(Key);
-
       /*If the current type is a tree, then it stays as a tree (which is more
       general than an array).*/
-      bool KeyIsIndex = KeyCopy.ValueType == ValueTypeInteger and
-        KeyCopy.DataIntegerValue >= 0;
+      bool KeyIsIndex = Key.ValueType == ValueTypeInteger and
+        Key.DataIntegerValue >= 0;
 
-      //Treat as array if not already a tree and key is an index.
+      /*Treat as array if not already a tree and key is an index. The index is
+      read before the array is resized in case the key is one of its elements.*/
       if(ValueType != ValueTypeTree and KeyIsIndex)
       {
-        ArrayType& a = Get<ArrayType, ValueTypeArray>();
-        if(a.n() <= count(KeyCopy.DataIntegerValue))
-          a.n(count(KeyCopy.DataIntegerValue) + 1);
-        return a[count(KeyCopy.DataIntegerValue)];
+        count Index = count(Key.DataIntegerValue);
+        ArrayType& a = GetAndExpose<ArrayType, ValueTypeArray>();
+        if(a.n() <= Index)
+          a.n(Index + 1);
+        return a[Index];
       }
-      else //Treat as a tree if the key is generic or already a tree.
-        return Get<TreeType, ValueTypeTree>()[KeyCopy];
+
+      /* #screwcase : a[a] and a[a[0]]
+      Make a deep-copy of the key if it is this value, or if this value is
+      about to become a tree, since its previous contents (of which the key may
+      be a part) are released. Otherwise the key is used in place, since adding
+      to a tree does not move its existing keys and values.*/
+      if(&Key == this or (ValueType != ValueTypeTree and
+        ValueType != ValueTypeNil))
+      {
+        Value KeyCopy(Key);
+        return GetAndExpose<TreeType, ValueTypeTree>()[KeyCopy];
+      }
+      return GetAndExpose<TreeType, ValueTypeTree>()[Key];
     }
 
     /**Returns the first element of a value that is an array. If the value is
@@ -1456,6 +1890,22 @@ namespace PRIM_NAMESPACE
       return Contains(Value(s));
     }
 
+    /**Returns whether the value contains the given key. If the value is an
+    array, then it contains the key if it is a non-zero integer less than the
+    length of the array. If the value is a tree, then it contains the key if the
+    tree contains the same key.*/
+    bool Contains(const ascii* s) const
+    {
+      return Contains(Value(s));
+    }
+
+    /**Returns whether the value is a tree containing the symbol as a key. The
+    symbol is compared with string keys by its text.*/
+    bool Contains(const Symbol& s) const
+    {
+      return Contains(Value(s));
+    }
+
     ///Treats object as a key-value tree and looks up the value for the key.
     template <class T> const Value& operator [] (const T& Key) const
     {
@@ -1482,65 +1932,6 @@ namespace PRIM_NAMESPACE
 
     private:
 
-    ///Escapes the string for JSON.
-    static String EscapeForJSON(String s)
-    {
-      s.Replace("\\", "\\\\");
-      s.Replace("\"", "\\\"");
-      s.Replace(reinterpret_cast<const byte*>("\x00"), 1,
-        reinterpret_cast<const byte*>("\\u0000"), 6);
-      s.Replace("\x01", "\\u0001");
-      s.Replace("\x02", "\\u0002");
-      s.Replace("\x03", "\\u0003");
-      s.Replace("\x04", "\\u0004");
-      s.Replace("\x05", "\\u0005");
-      s.Replace("\x06", "\\u0006");
-      s.Replace("\x07", "\\u0007");
-      s.Replace("\x08", "\\u0008");
-      s.Replace("\x09", "\\t");
-      s.Replace("\x0a", "\\n");
-      s.Replace("\x0b", "\\u000b");
-      s.Replace("\x0c", "\\u000c");
-      s.Replace("\x0d", "\\r");
-      s.Replace("\x0e", "\\u000e");
-      s.Replace("\x0f", "\\u000f");
-      s.Replace("\x10", "\\u0010");
-      s.Replace("\x11", "\\u0011");
-      s.Replace("\x12", "\\u0012");
-      s.Replace("\x13", "\\u0013");
-      s.Replace("\x14", "\\u0014");
-      s.Replace("\x15", "\\u0015");
-      s.Replace("\x16", "\\u0016");
-      s.Replace("\x17", "\\u0017");
-      s.Replace("\x18", "\\u0018");
-      s.Replace("\x19", "\\u0019");
-      s.Replace("\x1a", "\\u001a");
-      s.Replace("\x1b", "\\u001b");
-      s.Replace("\x1c", "\\u001c");
-      s.Replace("\x1d", "\\u001d");
-      s.Replace("\x1e", "\\u001e");
-      s.Replace("\x1f", "\\u001f");
-      return s;
-    }
-
-    ///Converts any infinities and NaNs to null.
-    template <class T> static String SafeNumber(T x)
-    {
-      String s;
-      if(Limits<T>::IsNaN(x) or Limits<T>::IsEqual(x, Limits<T>::Infinity()) or
-        Limits<T>::IsEqual(x, Limits<T>::NegativeInfinity()))
-          s << "null";
-      else
-      {
-        s.Append(float64(x), 17, true);
-        if(not s.Contains("."))
-          s << ".0";
-      }
-      return s;
-    }
-
-    private:
-
     static bool IsInteger(const String& s)
     {
       bool IsStillInteger = true;
@@ -1556,73 +1947,28 @@ namespace PRIM_NAMESPACE
       return IsStillInteger;
     }
 
-    void CreateValueFromXML(const meta::tinyxml2::XMLElement* e, Value& x,
-      const List<String>& TagsToExclude,
-      const List<String>& AttributesToExclude)
+    /**Converts XML text to a number if it contains a decimal point and reads
+    as a number, to an integer if it only has digits and reads as an integer,
+    and otherwise to a string.*/
+    static Value FromXMLText(const String& s)
     {
-      x.Clear();
-      if(not e) return;
-      x.NewTree();
-      x["@name"] = e->Name();
-      const meta::tinyxml2::XMLAttribute* a = e->FirstAttribute();
-      while(a)
-      {
-        Value k, v;
-        k = String(a->Name());
-        {
-          int vi; double vd;
-          String vs = String(a->Value());
-          v = (vs.Contains(".") and a->QueryDoubleValue(&vd) ==
-            meta::tinyxml2::XML_NO_ERROR) ? v = Value(vd) :
-          (IsInteger(vs) and
-            a->QueryIntValue(&vi) == meta::tinyxml2::XML_NO_ERROR) ?
-            v = Value(vi) : v = Value(vs);
-        }
-        if(not AttributesToExclude.Contains(k.AsString()))
-          x[k] = v;
-        a = a->Next();
-      }
-      if(e->FirstChild() and e->FirstChild()->ToText())
-      {
-        Value v;
-        {
-          int vi; double vd;
-          String vs = String(e->GetText());
-          v = (vs.Contains(".") and e->QueryDoubleText(&vd) ==
-            meta::tinyxml2::XML_NO_ERROR) ? v = Value(vd) :
-          (IsInteger(vs) and
-            e->QueryIntText(&vi) == meta::tinyxml2::XML_NO_ERROR) ?
-            v = Value(vi) : v = Value(vs);
-        }
-        x["@value"] = v;
-      }
-      else
-      {
-        const meta::tinyxml2::XMLElement* c = e->FirstChildElement();
-        count i = 0;
-        while(c)
-        {
-          if(not TagsToExclude.Contains(c->Name()))
-            CreateValueFromXML(c, x[Value(i++)], TagsToExclude,
-              AttributesToExclude);
-          c = c->NextSiblingElement();
-        }
-      }
+      int vi; double vd;
+      if(s.Contains(".") and meta::tinyxml2::XMLUtil::ToDouble(s.Merge(), &vd))
+        return Value(vd);
+      else if(IsInteger(s) and meta::tinyxml2::XMLUtil::ToInt(s.Merge(), &vi))
+        return Value(vi);
+      return Value(s);
     }
 
     public:
 
-    ///Imports an XML string as a JSON-like structure.
+    /**Imports an XML string as a JSON-like structure. Each element becomes a
+    tree with its tag in @name, its attributes by name, and either its text in
+    @value (if the first thing in the element is text) or its child elements
+    by index. The XML is read with XML::PullParser, so no document tree is
+    built along the way. Malformed XML results in a nil value.*/
     void FromXML(const String& XMLString, const List<String>& TagsToExclude,
-      const List<String>& AttributesToExclude)
-    {
-      meta::tinyxml2::XMLDocument XMLDoc(true,
-        meta::tinyxml2::COLLAPSE_WHITESPACE);
-      XMLDoc.Parse(XMLString);
-      Clear();
-      CreateValueFromXML(XMLDoc.RootElement(), *this, TagsToExclude,
-        AttributesToExclude);
-    }
+      const List<String>& AttributesToExclude);
 
     ///Imports an XML string as a JSON-like structure.
     void FromXML(const String& XMLString)
@@ -1636,119 +1982,6 @@ namespace PRIM_NAMESPACE
     ///Returns the value of element that was imported from XML.
     Value Val() const {return (*this)["@value"];}
 
-    ///Gets the value as JSON with indentation level control.
-    String AsJSON(count Level, bool WithWhitespace) const
-    {
-      //Create the leading whitespace based on the level.
-      String t;
-      String ln = "\n";
-      String sep = " ";
-      String p = "  ";
-      if(not WithWhitespace)
-        ln = p = sep = "";
-      for(count l = 0; l < Level; l++)
-        t << p;
-
-      //Coerce the value to one of the JSON types.
-      switch(ValueType)
-      {
-      case ValueTypeBoolean:
-        return (DataBooleanValue ? "true" : "false");
-      case ValueTypeInteger:
-        return String(DataIntegerValue);
-      case ValueTypeNumber:
-      {
-        return SafeNumber(DataNumberValue);
-      }
-      case ValueTypeRatio:
-        {
-          Ratio r = AsRatio();
-          return String("\"") + r.Numerator() + "/" + r.Denominator() + "\"";
-        }
-      case ValueTypeVector:
-        {
-          Vector v = AsVector();
-          String s;
-          s << "[\"_JSONVector\"," << sep << SafeNumber(v.x) <<
-            "," << sep << SafeNumber(v.y) << "]";
-          return s;
-        }
-      case ValueTypeBox:
-        {
-          Box r = AsBox();
-          String s;
-          s << "[\"_JSONRectangle\"," << sep <<
-            SafeNumber(r.a.x) << "," << sep <<
-            SafeNumber(r.a.y) << "," << sep <<
-            SafeNumber(r.b.x) << "," << sep <<
-            SafeNumber(r.b.y) << "]";
-          return s;
-        }
-      case ValueTypeString:
-        {
-          String s = AsString();
-          s = EscapeForJSON(s);
-          s.Prepend("\"");
-          s.Append("\"");
-          return s;
-        }
-      case ValueTypeArray:
-        {
-          String s;
-          s << "[";
-          const ArrayType& a = AssumeAndGet<ArrayType>();
-          for(count i = 0, n = a.n(); i < n; i++)
-          {
-            s << ln << t << p <<
-              a[i].AsJSON(Level + 1, WithWhitespace);
-            if(i != n - 1)
-              s << ",";
-          }
-          s << ln << t << "]";
-          return s;
-        }
-      case ValueTypeTree:
-        {
-          String s;
-          s << "{";
-          const TreeType& kv = AssumeAndGet<TreeType>();
-          TreeType::Iterator It;
-          bool First = true;
-          for(It.Begin(kv); It.Iterating(); It.Next(), First = false)
-          {
-            if(not First)
-              s << ",";
-            if(It.Key().ValueType == ValueTypeString)
-            {
-              s << ln << t << p << "" <<
-                It.Key().AsJSON(0, WithWhitespace) << ":" << sep;
-            }
-            else
-            {
-              s << ln << t << p << "\"" <<
-                EscapeForJSON(It.Key().AsJSON(0, WithWhitespace)) <<
-                "\":" << sep;
-            }
-            s << It.Value().AsJSON(Level + 1, WithWhitespace);
-          }
-          s << ln << t << "}";
-          return s;
-        }
-      case ValueTypeNil:
-        break;
-      case ValueTypeObject:
-        {
-          String s;
-          const Value::Base* RawPointer = ConstObject().Raw();
-          s << "\"_JSONObject<";
-          s << (RawPointer ? ConstObject()->Name().Merge() : "null");
-          s << ", " << reinterpret_cast<const void*>(RawPointer) << ">\"";
-          return s;
-        }
-      }
-      return "null";
-    }
-
     public:
 
     /**Exports the value as JSON. The Value class is more general than JSON and
@@ -1757,28 +1990,9 @@ namespace PRIM_NAMESPACE
     rectangles are written as an array with an initial type string followed by
     two or four numbers respectively; tree keys are coerced to a string
     representation and for keys that are trees, the corresponding JSON text is
-    rendered as a compact escaped JSON string.*/
-    String ExportJSON(bool WithWhitespace = true, bool WithRoot = true) const
-    {
-      String s;
-
-      //Write outside container as an array.
-      if(ValueType == ValueTypeArray or ValueType == ValueTypeBox or
-        ValueType == ValueTypeVector or ValueType == ValueTypeTree)
-          s >> AsJSON(0, WithWhitespace);
-      else if(not WithRoot)
-        s >> AsJSON(0, WithWhitespace);
-      else
-      {
-        s >> "[";
-        if(WithWhitespace) s++;
-        s << AsJSON(1, WithWhitespace);
-        if(WithWhitespace) s++;
-        s << "]";
-      }
-
-      return s;
-    }
+    rendered as a compact escaped JSON string. To write large values without
+    building the text in memory, use JSON::Writer directly.*/
+    String ExportJSON(bool WithWhitespace = true, bool WithRoot = true) const;
   };
 
   //------------------------//
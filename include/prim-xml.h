@@ -107,7 +107,7 @@ class XML
         {
           //Decode the next UTF8 character.
           ptrPreviousCharacter = UTF8String;
-          Character = String::Decode(UTF8String,
+          Character = String::DecodeNext(UTF8String,
             reinterpret_cast<const byte*>(MarkupEnd));
 
           //At the end of stream there is no word.
@@ -156,7 +156,7 @@ class XML
         {
           //Decode the next UTF8 character.
           ptrPreviousCharacter = UTF8String;
-          Character = String::Decode(UTF8String,
+          Character = String::DecodeNext(UTF8String,
             reinterpret_cast<const byte*>(MarkupEnd));
 
           //At the end of the stream. The word runs to the end of the stream.
@@ -325,7 +325,7 @@ class XML
 
           const byte* OriginalCopyCast =
             reinterpret_cast<const byte*>(OriginalCopy);
-          unicode Value = String::Decode(OriginalCopyCast,
+          unicode Value = String::DecodeNext(OriginalCopyCast,
             reinterpret_cast<const byte*>(MarkupEnd));
           OriginalCopy = reinterpret_cast<const ascii*>(OriginalCopyCast);
           if(Value == unicode(*String::Newline))
@@ -352,7 +352,7 @@ class XML
         {
           const byte* OriginalCopyCast =
             reinterpret_cast<const byte*>(OriginalCopy);
-          unicode Value = String::Decode(OriginalCopyCast,
+          unicode Value = String::DecodeNext(OriginalCopyCast,
             reinterpret_cast<const byte*>(MarkupEnd));
           OriginalCopy = reinterpret_cast<const ascii*>(OriginalCopyCast);
           if(not Value)
@@ -384,7 +384,7 @@ class XML
           {
             const byte* OriginalCopyCast =
               reinterpret_cast<const byte*>(OriginalCopy);
-            String::Decode(OriginalCopyCast,
+            String::DecodeNext(OriginalCopyCast,
               reinterpret_cast<const byte*>(MarkupEnd));
             OriginalCopy = reinterpret_cast<const ascii*>(OriginalCopyCast);
             Index++;
@@ -400,6 +400,383 @@ class XML
     };
   };
 
+  /**Pull parser that reads XML directly from a span of bytes without building
+  a document tree. Each call to Next() advances to the next event and returns
+  its kind. Names and values are views of the markup itself, so the markup must
+  outlive the parser, and entities and line endings are only decoded when
+  Decoded() is called. Comments, processing instructions, and declarations are
+  reported as Markup so that callers can tell where they occur. The parser
+  checks that tags are balanced and that attribute values are quoted, but it
+  does not validate names or the document type.*/
+  class PullParser
+  {
+    public:
+
+    ///Kinds of event returned by Next()
+    enum Event
+    {
+      StartElement, //Name() is the tag name.
+      Attribute,    //Name() and Raw() are the attribute name and value.
+      Text,         //Raw() is character data or the inside of a CDATA section.
+      EndElement,   //Name() is the tag name. Also sent for empty-element tags.
+      Markup,       //Raw() is a comment, instruction, or declaration.
+      EndDocument,  //The markup ended with all elements closed.
+      Malformed     //ErrorInfo() describes the problem.
+    };
+
+    private:
+
+    ///Span of markup being parsed
+    const byte* Begin;
+    const byte* End;
+
+    ///Read position
+    const byte* At;
+
+    ///Start of the current event
+    const byte* EventAt;
+
+    ///Names of the open elements
+    Array<StringView> Open;
+
+    ///Name of the current element or attribute
+    StringView CurrentName;
+
+    ///Undecoded value of the current attribute, text, or markup
+    StringView CurrentRaw;
+
+    ///Description of the problem if the markup is malformed
+    String Error;
+
+    ///Current event
+    Event Current; PRIM_PAD(Event)
+
+    ///Depth of the current event
+    count CurrentDepth;
+
+    ///Whether the attributes of an opening tag are still being read
+    bool InTag; PRIM_PAD(bool)
+
+    ///Whether the current text came from a CDATA section
+    bool InCDATA; PRIM_PAD(bool)
+
+    public:
+
+    ///Creates a parser for the markup in a string.
+    PullParser(const String& Markup) : Current(Text), CurrentDepth(0),
+      InTag(false), InCDATA(false)
+    {
+      Begin = reinterpret_cast<const byte*>(Markup.Merge());
+      End = Begin + Markup.n();
+      SkipByteOrderMark();
+    }
+
+    ///Creates a parser for a span of bytes.
+    PullParser(const byte* Begin_, const byte* End_) : Begin(Begin_),
+      End(End_), Current(Text), CurrentDepth(0), InTag(false), InCDATA(false)
+    {
+      SkipByteOrderMark();
+    }
+
+    ///Advances to the next event and returns it.
+    Event Next()
+    {
+      if(Current == EndDocument or Current == Malformed)
+        return Current;
+      if(InTag)
+        return NextInTag();
+
+      EventAt = At;
+      InCDATA = false;
+      CurrentDepth = Open.n();
+      if(At == End)
+      {
+        if(Open.n())
+          return Fail("Unclosed element");
+        return Current = EndDocument;
+      }
+      else if(*At != '<')
+      {
+        const byte* Stop = StringView::FindByte(At, count(End - At), '<');
+        CurrentRaw = StringView(At, count((Stop ? Stop : End) - At));
+        At = CurrentRaw.End();
+        return Current = Text;
+      }
+      else if(Follows("<!--"))
+        return NextMarkup(4, "-->");
+      else if(Follows("<![CDATA["))
+      {
+        if(not SkipPast(9, "]]>"))
+          return Fail("Unterminated CDATA section");
+        CurrentRaw = StringView(EventAt + 9, count(At - EventAt) - 12);
+        InCDATA = true;
+        return Current = Text;
+      }
+      else if(Follows("<?"))
+        return NextMarkup(2, "?>");
+      else if(Follows("<!"))
+        return NextDeclaration();
+      else if(Follows("</"))
+        return NextEndTag();
+      return NextStartTag();
+    }
+
+    /**Skips the rest of the element whose StartElement was just returned,
+    including its attributes and content. The next event is the one following
+    its EndElement.*/
+    bool SkipElement()
+    {
+      count Depth = Open.n();
+      for(;;)
+      {
+        Event e = Next();
+        if(e == Malformed or e == EndDocument)
+          return false;
+        else if(e == EndElement and CurrentDepth == Depth)
+          return true;
+      }
+    }
+
+    ///Returns the name of the current element or attribute.
+    const StringView& Name() const {return CurrentName;}
+
+    /**Returns the undecoded value of the current attribute, text, or markup.
+    The view refers to the markup itself.*/
+    const StringView& Raw() const {return CurrentRaw;}
+
+    ///Returns whether the current text came from a CDATA section.
+    bool IsCDATA() const {return InCDATA;}
+
+    /**Returns whether the current text is only whitespace, that is, spaces,
+    tabs, and line breaks. Text from a CDATA section never is.*/
+    bool IsWhitespace() const
+    {
+      if(InCDATA)
+        return false;
+      for(const byte* p = CurrentRaw.Begin(); p < CurrentRaw.End(); p++)
+        if(not IsSpace(*p))
+          return false;
+      return true;
+    }
+
+    /**Returns the depth of the current event. Elements and their attributes
+    count the root element as one, and text and markup have the depth of the
+    element containing them.*/
+    count Depth() const {return CurrentDepth;}
+
+    ///Returns the byte offset of the current event from the start of markup.
+    count Offset() const {return count(EventAt - Begin);}
+
+    /**Returns the value of the current attribute or text with the predefined
+    entities and character references replaced and line endings normalized.
+    CDATA sections only have their line endings normalized. Unrecognized
+    entities are left as they are.*/
+    String Decoded() const
+    {
+      String Result;
+      Decode(CurrentRaw, not InCDATA, Result);
+      return Result;
+    }
+
+    ///Returns a description of the error if the markup is malformed.
+    String ErrorInfo() const
+    {
+      if(Current != Malformed)
+        return "";
+      count Line = 1;
+      for(const byte* p = Begin; p < EventAt; p++)
+        if(*p == '\n')
+          Line++;
+      String s = Error;
+      s << " at line " << Line;
+      return s;
+    }
+
+    /**Decodes the entities and line endings of markup and appends the result
+    to a string.*/
+    static void Decode(const StringView& Raw, bool WithEntities,
+      String& Result);
+
+    /**Removes leading and trailing whitespace and replaces each run of inner
+    whitespace with a single space.*/
+    static String CollapseWhitespace(const String& s);
+
+    private:
+
+    ///Skips the UTF-8 byte order mark.
+    void SkipByteOrderMark()
+    {
+      At = EventAt = Begin;
+      if(End - Begin >= 3 and Begin[0] == 0xef and Begin[1] == 0xbb and
+        Begin[2] == 0xbf)
+          At = EventAt = Begin + 3;
+    }
+
+    ///Records an error and returns Malformed.
+    Event Fail(const ascii* Info)
+    {
+      Error = Info;
+      InTag = false;
+      return Current = Malformed;
+    }
+
+    ///Returns whether the markup at the read position begins with the text.
+    bool Follows(const ascii* s) const
+    {
+      const byte* p = At;
+      for(; *s; s++, p++)
+        if(p == End or *p != byte(*s))
+          return false;
+      return true;
+    }
+
+    /**Moves the read position past the terminator, searching after the given
+    number of bytes. Returns false if there is no terminator.*/
+    bool SkipPast(count Skip, const ascii* Terminator)
+    {
+      count n = String::LengthOf(Terminator);
+      const byte* Found = 0;
+      if(End - At >= Skip)
+        Found = StringView::FindBytes(At + Skip, count(End - At) - Skip,
+          reinterpret_cast<const byte*>(Terminator), n);
+      if(not Found)
+        return false;
+      At = Found + n;
+      return true;
+    }
+
+    ///Returns whether the byte is a space, tab, or line break.
+    static bool IsSpace(byte c)
+    {
+      return c == ' ' or (c >= '\t' and c <= '\r');
+    }
+
+    ///Advances past whitespace.
+    void SkipSpace()
+    {
+      while(At < End and IsSpace(*At))
+        At++;
+    }
+
+    ///Reads a tag or attribute name at the read position.
+    StringView ReadName()
+    {
+      const byte* Start = At;
+      while(At < End and not IsSpace(*At) and *At != '>' and *At != '/' and
+        *At != '=' and *At != '<')
+          At++;
+      return StringView(Start, count(At - Start));
+    }
+
+    ///Reads a comment or processing instruction.
+    Event NextMarkup(count Skip, const ascii* Terminator)
+    {
+      if(not SkipPast(Skip, Terminator))
+        return Fail("Unterminated markup");
+      CurrentRaw = StringView(EventAt, count(At - EventAt));
+      return Current = Markup;
+    }
+
+    ///Reads a declaration, which may contain a bracketed internal subset.
+    Event NextDeclaration()
+    {
+      count Brackets = 0;
+      byte Quote = 0;
+      for(At += 2; At < End; At++)
+      {
+        if(Quote)
+        {
+          if(*At == Quote)
+            Quote = 0;
+        }
+        else if(*At == '"' or *At == '\'')
+          Quote = *At;
+        else if(*At == '[')
+          Brackets++;
+        else if(*At == ']')
+          Brackets--;
+        else if(*At == '>' and Brackets <= 0)
+        {
+          At++;
+          CurrentRaw = StringView(EventAt, count(At - EventAt));
+          return Current = Markup;
+        }
+      }
+      return Fail("Unterminated declaration");
+    }
+
+    ///Reads the name of an opening tag.
+    Event NextStartTag()
+    {
+      At++;
+      CurrentName = ReadName();
+      if(not CurrentName)
+        return Fail("Expected tag name");
+      Open.Push(CurrentName);
+      CurrentDepth = Open.n();
+      InTag = true;
+      return Current = StartElement;
+    }
+
+    ///Reads the next attribute or the end of an opening tag.
+    Event NextInTag()
+    {
+      SkipSpace();
+      EventAt = At;
+      CurrentDepth = Open.n();
+      if(At == End)
+        return Fail("Unterminated tag");
+      else if(*At == '/')
+      {
+        if(End - At < 2 or At[1] != '>')
+          return Fail("Expected '>' after '/'");
+        At += 2;
+        InTag = false;
+        CurrentName = Open.Pop();
+        return Current = EndElement;
+      }
+      else if(*At == '>')
+      {
+        At++;
+        InTag = false;
+        return Next();
+      }
+
+      CurrentName = ReadName();
+      if(not CurrentName)
+        return Fail("Expected attribute name");
+      SkipSpace();
+      if(At == End or *At != '=')
+        return Fail("Expected '=' after attribute name");
+      At++;
+      SkipSpace();
+      if(At == End or (*At != '"' and *At != '\''))
+        return Fail("Expected quoted attribute value");
+      const byte* Quote = StringView::FindByte(At + 1, count(End - At) - 1,
+        *At);
+      if(not Quote)
+        return Fail("Unterminated attribute value");
+      CurrentRaw = StringView(At + 1, count(Quote - At) - 1);
+      At = Quote + 1;
+      return Current = Attribute;
+    }
+
+    ///Reads a closing tag and checks it against the open element.
+    Event NextEndTag()
+    {
+      At += 2;
+      CurrentName = ReadName();
+      SkipSpace();
+      if(At == End or *At != '>')
+        return Fail("Expected '>' after closing tag name");
+      At++;
+      if(not Open.n() or Open.z() != CurrentName)
+        return Fail("Mismatched closing tag");
+      Open.Pop();
+      return Current = EndElement;
+    }
+  };
+
   class Element;
   class Text;
   class Document;
@@ -1185,6 +1562,163 @@ namespace PRIM_NAMESPACE
   const unicode XML::Parser::Delimiters::TagAttributeValueDouble[3] =
   {'"', '>', 0};
 
+  void XML::PullParser::Decode(const StringView& Raw, bool WithEntities,
+    String& Result)
+  {
+    const byte* p = Raw.Begin();
+    const byte* End = Raw.End();
+    while(p < End)
+    {
+      //Copy runs of bytes that need no decoding directly.
+      const byte* Run = p;
+      while(p < End and *p != '\r' and (*p != '&' or not WithEntities))
+        p++;
+      Result.Append(Run, count(p - Run));
+      if(p == End)
+        break;
+
+      if(*p == '\r')
+      {
+        Result << "\n";
+        p += (End - p >= 2 and p[1] == '\n') ? 2 : 1;
+        continue;
+      }
+
+      const byte* Semicolon = StringView::FindByte(p, Min(count(End - p),
+        count(12)), ';');
+      StringView Entity = Semicolon ?
+        StringView(p + 1, count(Semicolon - p) - 1) : StringView();
+      unicode u = 0;
+      if(Entity == "lt") u = '<';
+      else if(Entity == "gt") u = '>';
+      else if(Entity == "amp") u = '&';
+      else if(Entity == "quot") u = '"';
+      else if(Entity == "apos") u = '\'';
+      else if(Entity.n() >= 2 and Entity[0] == '#')
+      {
+        bool Hex = Entity[1] == 'x';
+        count i = Hex ? 2 : 1;
+        for(u = 0; i < Entity.n() and u < 0x110000; i++)
+        {
+          unicode d = Unicode::HexDigitValue(Entity[i]);
+          if(d >= (Hex ? 16u : 10u))
+            break;
+          u = u * (Hex ? 16 : 10) + d;
+        }
+        if(i != Entity.n() or i == (Hex ? 2 : 1) or u >= 0x110000)
+          u = 0;
+      }
+
+      if(u)
+      {
+        Result << u;
+        p = Semicolon + 1;
+      }
+      else
+        Result.Append(p++, 1);
+    }
+  }
+
+  String XML::PullParser::CollapseWhitespace(const String& s)
+  {
+    String Result;
+    const byte* p = reinterpret_cast<const byte*>(s.Merge());
+    const byte* End = p + s.n();
+    bool Space = false;
+    for(; p < End; p++)
+    {
+      if(IsSpace(*p))
+        Space = true;
+      else
+      {
+        const byte* Run = p;
+        while(p + 1 < End and not IsSpace(*(p + 1)))
+          p++;
+        if(Space and Result.n())
+          Result << " ";
+        Result.Append(Run, count(p - Run) + 1);
+        Space = false;
+      }
+    }
+    return Result;
+  }
+
+  void Value::FromXML(const String& XMLString,
+    const List<String>& TagsToExclude, const List<String>& AttributesToExclude)
+  {
+    /*For each open element, remember how many child elements have been added
+    and what its first child was, since the element takes its value from its
+    text only if text came first.*/
+    enum {NoChild, TextChild, OtherChild};
+    Array<Value*> Elements;
+    Array<count> ChildElements;
+    Array<byte> FirstChild;
+
+    Clear();
+    XML::PullParser p(XMLString);
+    for(;;)
+    {
+      XML::PullParser::Event e = p.Next();
+      if(e == XML::PullParser::StartElement)
+      {
+        Value* x = this;
+        if(Elements.n())
+        {
+          if(FirstChild.z() == NoChild)
+            FirstChild.z() = OtherChild;
+          if(FirstChild.z() == TextChild or
+            TagsToExclude.Contains(String(p.Name())))
+          {
+            if(p.SkipElement())
+              continue;
+            Clear();
+            return;
+          }
+          x = &(*Elements.z())[Value(ChildElements.z()++)];
+        }
+        x->NewTree();
+        (*x)["@name"] = String(p.Name());
+        Elements.Push(x);
+        ChildElements.Push(0);
+        FirstChild.Push(NoChild);
+      }
+      else if(e == XML::PullParser::Attribute)
+      {
+        String Name(p.Name());
+        if(not AttributesToExclude.Contains(Name))
+          (*Elements.z())[Name] = FromXMLText(p.Decoded());
+      }
+      else if(e == XML::PullParser::Text)
+      {
+        //Whitespace alone is not considered text.
+        if(not Elements.n() or FirstChild.z() != NoChild or p.IsWhitespace())
+          continue;
+        FirstChild.z() = TextChild;
+        (*Elements.z())["@value"] = FromXMLText(p.IsCDATA() ? p.Decoded() :
+          XML::PullParser::CollapseWhitespace(p.Decoded()));
+      }
+      else if(e == XML::PullParser::Markup)
+      {
+        if(Elements.n() and FirstChild.z() == NoChild)
+          FirstChild.z() = OtherChild;
+      }
+      else if(e == XML::PullParser::EndElement)
+      {
+        Elements.Pop();
+        ChildElements.Pop();
+        FirstChild.Pop();
+        if(not Elements.n())
+          return;
+      }
+      else
+      {
+        if(e == XML::PullParser::Malformed)
+          Clear();
+        return;
+      }
+    }
+  }
+
   //Avoid weak-vtable warning by making at least one virtual method out-of-line.
   XML::Object::~Object() {}
   XML::Text::~Text() {}
@@ -76,6 +76,7 @@
 #include "prim-mod-thread.h"
 #include "prim-mod-timer.h"
 #include "prim-pointer.h"
+#include "prim-pool.h"
 #include "prim-random.h"
 #include "prim-unicode.h"
 
@@ -83,8 +84,10 @@
 
 #include "prim-array.h"
 #include "prim-complex.h"
+#include "prim-inline-array.h"
 #include "prim-list.h"
 #include "prim-mod-tinyxml.h"
+#include "prim-sequence.h"
 
 //. . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . //
 
@@ -102,9 +105,12 @@
 #include "prim-console.h"
 #include "prim-encoding.h"
 #include "prim-file.h"
+#include "prim-hash-map.h"
 #include "prim-md5.h"
 #include "prim-planar.h"
 #include "prim-rational.h"
+#include "prim-string-builder.h"
+#include "prim-symbol.h"
 #include "prim-table.h"
 #include "prim-time.h"
 
@@ -47,7 +47,7 @@ int main(int ArgumentCount, const char** ArgumentData)
   (void)ArgumentData;
   AutoRelease<Console> ReleasePool;
 
-  List<number> MeasureWidths;
+  Sequence<number> MeasureWidths;
   Random R(123);
   const count Measures = 100;
   for(count i = 0; i < Measures; i++)
@@ -73,7 +73,7 @@ int main(int ArgumentCount, const char** ArgumentData)
     Margin.Dilate(-MarginSize);
     MyPage->BoxesToPaint.Add() = Margin;
 
-    List<VectorInt> Distributed = WrapDistributeMeasures(
+    Sequence<VectorInt> Distributed = WrapDistributeMeasures(
       MeasureWidths, Margin.Width(), Margin.Width(), 2.f);
     for(count i = 0; i < Distributed.n(); i++)
     {
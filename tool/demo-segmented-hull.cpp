@@ -54,7 +54,7 @@ int main()
   }
 
   {
-    List<Vector> A, B;
+    Sequence<Vector> A, B;
     A.Add() = Vector( 5.0,  0.0);
     A.Add() = Vector(10.0,  5.0);
     A.Add() = Vector( 5.0, 10.0);
@@ -80,7 +80,7 @@ int main()
   }
 
   {
-    List<Vector> A, B;
+    Sequence<Vector> A, B;
     A.Add() = Vector( 0.0,  0.0);
     A.Add() = Vector( 5.0,  5.0);
     A.Add() = Vector( 0.0, 10.0);
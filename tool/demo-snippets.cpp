@@ -268,7 +268,7 @@ struct SegmentedHullScore : public Portfolio
         Painter.Draw(p);
       }
       {
-        List<Vector> L = Box::SegmentedHull(A, Box::TopSide);
+        Sequence<Vector> L = Box::SegmentedHull(A, Box::TopSide);
 
         for(count i = 0; i < L.n() - 1; i++)
         {
@@ -287,7 +287,7 @@ struct SegmentedHullScore : public Portfolio
         }
       }
       {
-        List<Vector> L = Box::SegmentedHull(A, Box::BottomSide);
+        Sequence<Vector> L = Box::SegmentedHull(A, Box::BottomSide);
 
         for(count i = 0; i < L.n() - 1; i++)
         {
@@ -307,7 +307,7 @@ struct SegmentedHullScore : public Portfolio
       }
 
       {
-        List<Vector> L = Box::SegmentedHull(A, Box::LeftSide);
+        Sequence<Vector> L = Box::SegmentedHull(A, Box::LeftSide);
 
         for(count i = 0; i < L.n() - 1; i++)
         {
@@ -326,7 +326,7 @@ struct SegmentedHullScore : public Portfolio
         }
       }
       {
-        List<Vector> L = Box::SegmentedHull(A, Box::RightSide);
+        Sequence<Vector> L = Box::SegmentedHull(A, Box::RightSide);
 
         for(count i = 0; i < L.n() - 1; i++)
         {
@@ -30,9 +30,126 @@
 */
 
 #define PRIM_COMPILE_INLINE
+#define PRIM_WITH_TIMER
 #include "prim.h"
 using namespace prim;
-int main()
+
+//Reference find that compares byte by byte as String::Find used to.
+count ByteByByteFind(const String& s, const ascii* Source, count StartIndex)
+{
+  count SourceLength = String::LengthOf(Source);
+  count MaxCharacter = s.n() - SourceLength;
+  const ascii* Data = s.Merge();
+  for(count i = StartIndex; i <= MaxCharacter; i++)
+  {
+    bool MatchFound = true;
+    for(count j = 0; j < SourceLength and MatchFound; j++)
+      MatchFound = Data[i + j] == Source[j];
+    if(MatchFound)
+      return i;
+  }
+  return -1;
+}
+
+//Reference replace that edits the fragments in place as String::Replace did.
+count ByteByByteReplace(String& s, const ascii* Source,
+  const ascii* Destination)
+{
+  count SourceLength = String::LengthOf(Source);
+  count DestinationLength = String::LengthOf(Destination);
+  count Replacements = 0;
+  count Next = ByteByByteFind(s, Source, 0);
+  while(Next != -1)
+  {
+    s.Replace(Next, SourceLength, Destination);
+    if(++Replacements % 30 == 0)
+      s.Merge();
+    Next = ByteByByteFind(s, Source, Next + DestinationLength);
+  }
+  return Replacements;
+}
+
+//Reference tokenizer that copies each token out with Substring.
+List<String> ByteByByteTokenize(const String& s, const ascii* Delimiter)
+{
+  List<String> Result;
+  count DelimiterLength = String::LengthOf(Delimiter), Start = 0, Next;
+  while((Next = ByteByByteFind(s, Delimiter, Start)) != -1)
+  {
+    Result.Add() = Next > Start ? s.Substring(Start, Next - 1) : String();
+    Start = Next + DelimiterLength;
+  }
+  Result.Add() = Start < s.n() ? s.Substring(Start, s.n() - 1) : String();
+  return Result;
+}
+
+//Prints the time of the reference and the current implementation.
+void Report(const ascii* Name, number Reference, number Current, bool Agree)
+{
+  C::Out() >> Name << ": " << Reference * 1000.0 << " ms -> " <<
+    Current * 1000.0 << " ms (" << Reference / Max(Current, number(1.0e-9)) <<
+    "x)" << (Agree ? "" : " RESULTS DIFFER");
+}
+
+//Times the search operations on a multi-megabyte MusicXML input.
+void Benchmark(const ascii* Filename)
+{
+  String Original = File::Read(Filename), Input;
+  if(not Original)
+  {
+    C::Error() >> "Could not read " << Filename;
+    return;
+  }
+  while(Input.n() < 8 * 1024 * 1024)
+    Input << Original;
+  Input.Merge();
+  C::Out() >> "Searching " << Input.n() / 1024 / 1024 << " MB of " <<
+    Filename;
+
+  Timer t;
+  count a, b;
+
+  t.Start(), a = ByteByByteFind(Input, "</score-timewise>", 0);
+  number Reference = t.Stop();
+  t.Start(), b = Input.Find("</score-timewise>");
+  Report("Find (absent)", Reference, t.Stop(), a == b);
+
+  t.Start(), a = ByteByByteFind(Input, ";Kind:", 0) != -1;
+  Reference = t.Stop();
+  t.Start(), b = Input.Contains(";Kind:");
+  Report("Contains (absent)", Reference, t.Stop(), a == b);
+
+  a = b = 0;
+  t.Start();
+  for(count i = 0; (i = ByteByByteFind(Input, "<note", i)) != -1; i++) a++;
+  Reference = t.Stop();
+  t.Start();
+  for(count i = 0; (i = Input.Find("<note", i)) != -1; i++) b++;
+  Report("Find (every <note)", Reference, t.Stop(), a == b);
+
+  t.Start(), a = ByteByByteFind(Input, "<score-timewise", 0) == 0;
+  Reference = t.Stop();
+  t.Start(), b = Input.StartsWith("<score-timewise");
+  Report("StartsWith (absent)", Reference, t.Stop(), a == b);
+
+  t.Start();
+  a = ByteByByteTokenize(Input, "\n").n();
+  Reference = t.Stop();
+  t.Start();
+  b = Input.Tokenize("\n").n();
+  Report("Tokenize (lines)", Reference, t.Stop(), a == b);
+
+  //The reference replace edits fragments, so it is timed on the original.
+  String x = Original, y = Original;
+  t.Start(), a = ByteByByteReplace(x, "<duration>", "<d>");
+  Reference = t.Stop();
+  t.Start(), b = y.Replace("<duration>", "<d>");
+  Report("Replace (original)", Reference, t.Stop(), a == b and x == y);
+  t.Start(), Input.Replace("<duration>", "<d>");
+  C::Out() >> "Replace (all input): " << t.Stop() * 1000.0 << " ms";
+}
+
+int main(int ArgumentCount, const char** Arguments)
 {
   C::Out() >> String("ABCDEF GHIJK LMNOP QRSTU VWXYZ "
     "ÀÁÂÃÄÅ Æ Ç ÈÉÊË ÌÍÎÏ Ð Ñ ÒÓÔÕÖ × Ø ÙÚÛÜ Ý Þ ß Ÿ").ToLower();
@@ -46,5 +163,8 @@ int main()
   C::Out() >> Limits<float64>::Infinity();
   C::Out() >> 1.2345;
 
+  //Compare the search operations with their byte-by-byte counterparts.
+  Benchmark(ArgumentCount > 1 ? Arguments[1] : "resources/bach-invention.xml");
+
   return AutoRelease<Console>();
 }
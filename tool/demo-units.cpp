@@ -29,12 +29,20 @@
   ==============================================================================
 */
 
-#define PRIM_COMPILE_INLINE
+#define BELLE_COMPILE_INLINE
 #define PRIM_WITH_AES
 #define PRIM_WITH_FFT
+#define PRIM_WITH_MEMORY_MAP
 #define PRIM_WITH_MIDI
-#include "prim.h"
+#define PRIM_WITH_TIMER
+#define PRIM_VALUE_COPY_STATISTICS
+#include "belle.h"
+
+//Use the example helper
+#include "belle-helper.h"
+
 using namespace PRIM_NAMESPACE;
+using namespace BELLE_NAMESPACE;
 
 static count ChecksRun = 0;
 static count ChecksFailed = 0;
@@ -283,6 +291,261 @@ void TEST_PrimUnitTests_Base64Decode()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+static Value TEST_PrimUnitTests_BinaryValueRandom(Random& R, count Depth)
+{
+  Value v;
+  switch(R.NextIntegerInRange(0, Depth ? 10 : 8))
+  {
+  case 1:
+    v = R.NextIntegerInRange(0, 2) == 1;
+    break;
+  case 2:
+    v = integer(R.NextIntegerInRange(-100000, 100000)) *
+      (integer(1) << R.NextIntegerInRange(0, 40));
+    break;
+  case 3:
+    v = (R.NextNumber() - 0.5) * 1000.0;
+    break;
+  case 4:
+    v = Ratio(R.NextIntegerInRange(-50, 50), R.NextIntegerInRange(1, 50));
+    break;
+  case 5:
+    v = Vector(R.NextNumber(), -R.NextNumber());
+    break;
+  case 6:
+    v = Box(Vector(R.NextNumber(), 1.0), Vector(2.0, R.NextNumber()));
+    break;
+  case 7:
+    {
+      String s;
+      for(count i = R.NextIntegerInRange(0, 200); i > 0; i--)
+        if(R.NextIntegerInRange(0, 10))
+          s << ascii(R.NextIntegerInRange(32, 127));
+        else
+          s << "\xc3\xa9";
+      v = s;
+    }
+    break;
+  case 8:
+    {
+      v.NewArray();
+      for(count i = R.NextIntegerInRange(0, 12); i > 0; i--)
+        v.Add() = TEST_PrimUnitTests_BinaryValueRandom(R, Depth - 1);
+    }
+    break;
+  case 9:
+    {
+      v.NewTree();
+      for(count i = R.NextIntegerInRange(0, 12); i > 0; i--)
+      {
+        String Key = "k";
+        Key << R.NextIntegerInRange(0, 20);
+        v[Key] = TEST_PrimUnitTests_BinaryValueRandom(R, Depth - 1);
+      }
+    }
+    break;
+  default:
+    break;
+  }
+  return v;
+}
+
+void TEST_PrimUnitTests_BinaryValue();
+void TEST_PrimUnitTests_BinaryValue()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "BinaryValue";
+
+  //Random values survive a round trip and export the same JSON.
+  {
+    Random R(123);
+    bool Failed = false;
+    for(count i = 0; i < 1000; i++)
+    {
+      Value v = TEST_PrimUnitTests_BinaryValueRandom(R, 3);
+      Array<byte> Data = BinaryValue::Export(v);
+      Value w = BinaryValue::Import(Data);
+      BinaryValue::Reader r(Data);
+      if(w != v or JSON::Export(w) != JSON::Export(v))
+        C::Error() >> "Error: round trip changed " << JSON::Export(v),
+          Failed = true;
+      else if(r.Size() != Data.n() or r.n() != v.n())
+        C::Error() >> "Error: reader size mismatch", Failed = true;
+      else if(Data.n() and BinaryValue::Import(Array<byte>(&Data.a(),
+        Data.n() - 1)).IsNil() != true)
+          C::Error() >> "Error: truncated data was imported", Failed = true;
+
+      //Look up every key of a tree in place.
+      Value Keys = v.Keys();
+      for(count j = 0; j < Keys.n() and not Failed; j++)
+        if(r.Find(Keys[j]).ToValue() != v[Keys[j]])
+          C::Error() >> "Error: reader lookup failed", Failed = true;
+    }
+    EXPECT_EQ(false, Failed);
+  }
+
+  //Scalars keep their exact type and value.
+  {
+    Value v;
+    v["min"] = Limits<int64>::Min();
+    v["max"] = Limits<int64>::Max();
+    v["inf"] = Limits<number>::Infinity();
+    v[integer(7)] = "seven";
+    v[Ratio(1, 2)] = "half";
+    v["nil"].NewArray().Add() = Value();
+    Array<byte> Data = BinaryValue::Export(v);
+    Value w = BinaryValue::Import(Data);
+    EXPECT_EQ(w["min"].AsInteger(), Limits<int64>::Min());
+    EXPECT_EQ(w["max"].AsInteger(), Limits<int64>::Max());
+    EXPECT_EQ(w["inf"].AsNumber(), Limits<number>::Infinity());
+    EXPECT_EQ(w[integer(7)].AsString(), "seven");
+    EXPECT_EQ(w[Ratio(1, 2)].AsString(), "half");
+    EXPECT_EQ(w["nil"].n(), count(1));
+
+    BinaryValue::Reader r(Data);
+    EXPECT_EQ(r.IsTree(), true);
+    EXPECT_EQ(r["max"].AsInteger(), Limits<int64>::Max());
+    EXPECT_EQ(r[7].AsStringView() == StringView("seven"), true);
+    EXPECT_EQ(r[Ratio(1, 2)].AsString(), "half");
+    EXPECT_EQ(r["missing"].IsNil(), true);
+    EXPECT_EQ(r["nil"][0].IsNil(), true);
+    EXPECT_EQ(r["nil"][1].IsNil(), true);
+  }
+
+  //Large containers are indexed and searched by offset.
+  {
+    Value v;
+    for(count i = 0; i < 100; i++)
+    {
+      String Key = "key";
+      Key << i;
+      v[Key] = i;
+      v[integer(i)] = Key;
+    }
+    v[Vector(1.0, 2.0)] = "vector";
+    v["list"].n(50);
+    v["list"][count(49)] = "last";
+    Array<byte> Data = BinaryValue::Export(v);
+    BinaryValue::Reader r(Data);
+    EXPECT_EQ(r.Type(), BinaryValue::TagIndexedTree);
+    EXPECT_EQ(r["list"].Type(), BinaryValue::TagIndexedArray);
+    EXPECT_EQ(r["list"][49].AsString(), "last");
+    EXPECT_EQ(r["list"][50].IsNil(), true);
+    EXPECT_EQ(r["key0"].AsInteger(), integer(0));
+    EXPECT_EQ(r["key99"].AsInteger(), integer(99));
+    EXPECT_EQ(r["key100"].IsNil(), true);
+    EXPECT_EQ(r[42].AsString(), "key42");
+    EXPECT_EQ(r[Vector(1.0, 2.0)].AsString(), "vector");
+    EXPECT_EQ(BinaryValue::Import(Data), v);
+
+    //Offsets that do not match the elements are rejected on import.
+    Value Nils;
+    Nils.n(BinaryValue::IndexThreshold);
+    Data = BinaryValue::Export(Nils);
+    EXPECT_EQ(Data.n(), count(3 + 5 * BinaryValue::IndexThreshold));
+    EXPECT_EQ(BinaryValue::Import(Data), Nils);
+    Data[3] = 1;
+    EXPECT_EQ(BinaryValue::Import(Data).IsNil(), true);
+  }
+
+  //Object keys are left out so string keys are still found in order.
+  {
+    Value v;
+    Array<Pointer<Value::Base> > Objects;
+    for(count i = 0; i < BinaryValue::IndexThreshold; i++)
+    {
+      Objects.Add() = new Value::Base;
+      v[Value(Objects.z())] = i;
+      String Key = "key";
+      Key << i;
+      v[Key] = Key;
+    }
+    Array<byte> Data = BinaryValue::Export(v);
+    BinaryValue::Reader r(Data);
+    EXPECT_EQ(r.Type(), BinaryValue::TagIndexedTree);
+    EXPECT_EQ(r.n(), count(BinaryValue::IndexThreshold));
+    bool Found = true;
+    for(count i = 0; i < BinaryValue::IndexThreshold; i++)
+    {
+      String Key = "key";
+      Key << i;
+      Found = Found and r[Key].AsString() == Key;
+    }
+    EXPECT_EQ(Found, true);
+    Value w = BinaryValue::Import(Data);
+    EXPECT_EQ(w.n(), count(BinaryValue::IndexThreshold));
+    EXPECT_EQ(w.Contains(Value()), false);
+  }
+
+  //Small values are compact and malformed data reads as nil.
+  {
+    EXPECT_EQ(BinaryValue::Export(Value()).n(), count(1));
+    EXPECT_EQ(BinaryValue::Export(Value(integer(-64))).n(), count(2));
+    EXPECT_EQ(BinaryValue::Export(Value("abc")).n(), count(5));
+    byte Bad[3] = {BinaryValue::TagArray, 5, 1};
+    Value v;
+    v = integer(1);
+    EXPECT_EQ(BinaryValue::Import(Bad, Bad + 3, v), false);
+    EXPECT_EQ(v.IsNil(), true);
+    EXPECT_EQ(BinaryValue::Reader(Bad, Bad + 3).IsNil(), true);
+    byte Small[4];
+    EXPECT_EQ(BinaryValue::Export(Value("abc"), Small, 4), count(0));
+  }
+}
+
+void TEST_PrimUnitTests_MappedValue();
+void TEST_PrimUnitTests_MappedValue()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "MappedValue";
+
+  const ascii* Filename = "/tmp/prim-units-mapped-value.bin";
+  Value v;
+  for(count i = 0; i < 100; i++)
+  {
+    String Key = "key";
+    Key << i;
+    v[Key] = i;
+  }
+  v["list"].Add() = "first";
+  v["list"].Add() = Ratio(1, 3);
+
+  //A document written to a file is read in place.
+  {
+    EXPECT_EQ(BinaryValue::ExportFile(Filename, v), true);
+    MappedValue m(Filename);
+    EXPECT_EQ(m.IsOpen(), true);
+    EXPECT_EQ(m.n(), v.n());
+    EXPECT_EQ(m.Root().Type(), BinaryValue::TagIndexedTree);
+    EXPECT_EQ(m["key0"].AsInteger(), integer(0));
+    EXPECT_EQ(m["key99"].AsInteger(), integer(99));
+    EXPECT_EQ(m["key100"].IsNil(), true);
+    EXPECT_EQ(m["list"][0].AsString(), "first");
+    EXPECT_EQ(m["list"][1].AsRatio(), Ratio(1, 3));
+    EXPECT_EQ(m.ToValue(), v);
+    m.Close();
+    EXPECT_EQ(m.IsOpen(), false);
+    EXPECT_EQ(m["key0"].IsNil(), true);
+  }
+
+  //Truncated, corrupt and missing files are not opened.
+  {
+    Array<byte> Data = BinaryValue::Export(v);
+    MappedValue m;
+    EXPECT_EQ(File::Write(Filename, Array<byte>(&Data.a(), Data.n() - 1)),
+      true);
+    EXPECT_EQ(m.Open(Filename), false);
+    EXPECT_EQ(m.IsOpen(), false);
+    Data[0] = 0xff;
+    EXPECT_EQ(File::Write(Filename, Data), true);
+    EXPECT_EQ(m.Open(Filename), false);
+    EXPECT_EQ(m.IsOpen(), false);
+    std::remove(Filename);
+    EXPECT_EQ(m.Open(Filename), false);
+    EXPECT_EQ(m.IsOpen(), false);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void TEST_PrimUnitTests_EndianConversion();
 void TEST_PrimUnitTests_EndianConversion()
 {
@@ -466,6 +729,121 @@ void TEST_PrimUnitTests_JSONInvalid()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void TEST_PrimUnitTests_JSONEvents();
+void TEST_PrimUnitTests_JSONEvents()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "JSONEvents";
+
+  //Records the events as a compact string and stops at the key "stop".
+  class Recorder : public JSON::Handler
+  {
+    public:
+    String Events;
+    bool OnBeginObject() {Events << "{"; return true;}
+    bool OnEndObject() {Events << "}"; return true;}
+    bool OnBeginArray() {Events << "["; return true;}
+    bool OnEndArray() {Events << "]"; return true;}
+    bool OnKey(const StringView& x)
+    {
+      Events << "k:" << x << " ";
+      return x != "stop";
+    }
+    bool OnString(const StringView& x) {Events << "s:" << x << " "; return true;}
+    bool OnInteger(integer x) {Events << "i:" << x << " "; return true;}
+    bool OnNumber(number x) {Events << "n:" << x << " "; return true;}
+    bool OnBoolean(bool x) {Events << "b:" << x << " "; return true;}
+    bool OnNull() {Events << "null "; return true;}
+  };
+
+  //Events arrive in document order with escapes already interpreted.
+  {
+    Recorder r;
+    EXPECT_EQ(JSON::Parse("{\"a\": [1, 2.5, \"x\\ty\", true, null], "
+      "\"b\\u00e9\": {}}", r), true);
+    EXPECT_EQ(r.Events, "{k:a [i:1 n:2.5 s:x\ty b:True null ]k:b\xc3\xa9 {}}");
+  }
+
+  //A handler may stop the parse.
+  {
+    Recorder r;
+    String ErrorString, ErrorInfo;
+    EXPECT_EQ(JSON::Parse("{\"go\": 1, \"stop\": 2, \"x\": 3}", r,
+      ErrorString, ErrorInfo), false);
+    EXPECT_EQ(r.Events, "{k:go i:1 k:stop ");
+    EXPECT_EQ(ErrorInfo, "Stopped by handler");
+  }
+
+  //The structural index is independent of where the 64-byte blocks fall.
+  {
+    String Document = "{\"p\\\\\": \"a\\\\\\\"b\\\\\", \"q\": [\"\\\"]\", "
+      "\"{,:}\", \"\\\\\"], \"r\": \"\xe2\x99\xaa\", \"s\": [1e2, -0.5]}";
+    Value Expected = JSON::Import(Document);
+    EXPECT_EQ(Expected["q"].n(), count(3));
+    EXPECT_EQ(Expected["p\\"].AsString(), "a\\\"b\\");
+    String Padding;
+    for(count i = 0; i < 140; i++)
+    {
+      String Padded = Padding;
+      Padded << Document << Padding;
+      EXPECT_EQ(JSON::Import(Padded), Expected);
+      Padding << (i % 2 ? " " : "\n");
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//Collects the output of a JSON writer and counts the number of flushes.
+static bool TEST_PrimUnitTests_JSONWriterCollect(const byte* Data, count Bytes,
+  void* Context)
+{
+  List<String>& Chunks = *reinterpret_cast<List<String>*>(Context);
+  Chunks.Add().Append(Data, Bytes);
+  return Chunks.n() < 3;
+}
+
+void TEST_PrimUnitTests_JSONWriter();
+void TEST_PrimUnitTests_JSONWriter()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "JSONWriter";
+
+  //Scalars, escapes, and the special types are written as before.
+  {
+    Value v;
+    v["a"] = "q\"\\\x01\t";
+    v["b"] = 2.0;
+    v["c"] = Ratio(1, 3);
+    v["d"] = Vector(1.5, -2.0);
+    v["e"].Add() = true;
+    v["e"].Add() = Value();
+    EXPECT_EQ(v.ExportJSON(false), "{\"a\":\"q\\\"\\\\\\u0001\\t\","
+      "\"b\":2.0,\"c\":\"1/3\",\"d\":[\"_JSONVector\",1.5,-2.0],"
+      "\"e\":[true,null]}");
+    EXPECT_EQ(Value(integer(7)).ExportJSON(), "[\n7\n]");
+    EXPECT_EQ(JSON::ExportResult(Value("x")), "\"x\"");
+  }
+
+  //Large values reach the sink in several buffers.
+  {
+    Value v;
+    for(count i = 0; i < 1000; i++)
+      v.Add() = "A string long enough to fill the buffer quickly";
+    String Expected = v.ExportJSON();
+    List<String> Chunks;
+    JSON::CallbackSink Output(TEST_PrimUnitTests_JSONWriterCollect, &Chunks);
+    EXPECT_EQ(JSON::Writer(Output).Write(v), false);
+    EXPECT_EQ(Chunks.n(), count(3));
+    String Received;
+    for(count i = 0; i < Chunks.n(); i++)
+      Received << Chunks[i];
+    EXPECT_EQ(Expected.StartsWith(Received), true);
+    EXPECT_EQ(Received.n() < Expected.n(), true);
+    EXPECT_EQ(JSON::Import(Expected), v);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void TEST_PrimUnitTests_MD5Calculate();
 void TEST_PrimUnitTests_MD5Calculate()
 {
@@ -628,6 +1006,153 @@ void TEST_PrimUnitTests_NothingComparison()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#ifdef PRIM_11
+void TEST_PrimUnitTests_MoveSemantics();
+void TEST_PrimUnitTests_MoveSemantics()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "MoveSemantics";
+
+  //Array
+  Array<String> a;
+  a.Add("x"), a.Add("y");
+  const ascii* OriginalData = a.a().Merge();
+  Array<String> b(Move(a));
+  EXPECT_EQ(a.n(), count(0));
+  EXPECT_EQ(b.n(), count(2));
+  EXPECT_EQ(true, b.a().Merge() == OriginalData);
+  String s = "z";
+  b.Add(Move(s));
+  EXPECT_EQ(b.z(), "z");
+  EXPECT_EQ(s.n(), count(0));
+  a = Move(b);
+  EXPECT_EQ(a.n(), count(3));
+  EXPECT_EQ(b.n(), count(0));
+
+  //List
+  List<String> l;
+  l.Add("x"), l.Append(String("y"));
+  List<String> m(Move(l));
+  EXPECT_EQ(l.n(), count(0));
+  EXPECT_EQ(m.n(), count(2));
+  EXPECT_EQ(m.z(), "y");
+  l = Move(m);
+  EXPECT_EQ(l.n(), count(2));
+  EXPECT_EQ(m.n(), count(0));
+
+  //Tree
+  Tree<String, String> t;
+  t["x"] = "1", t["y"] = "2";
+  Tree<String, String> u(Move(t));
+  EXPECT_EQ(t.n(), count(0));
+  EXPECT_EQ(u.n(), count(2));
+  EXPECT_EQ(u["y"], "2");
+
+  //Value
+  Value v;
+  v["x"] = 1, v["y"].Add() = "z";
+  Value w(Move(v));
+  EXPECT_EQ(true, v.IsNil());
+  EXPECT_EQ(w["y"][0].AsString(), "z");
+  w = Move(w["y"]);
+  EXPECT_EQ(true, w.IsArray());
+  EXPECT_EQ(w[0].AsString(), "z");
+  w[0] = String("moved");
+  EXPECT_EQ(w[0].AsString(), "moved");
+
+  //Pointer
+  Pointer<String> p = new String("p");
+  Pointer<String>::Weak q = p;
+  Pointer<String> r(Move(p));
+  EXPECT_EQ(true, not p);
+  EXPECT_EQ(*r, "p");
+  Pointer<String> o(Move(q));
+  EXPECT_EQ(true, o == r);
+  r = Pointer<String>();
+  o = Pointer<String>();
+  EXPECT_EQ(true, not q);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+class MadeBase
+{
+  public:
+  static count Alive;
+  MadeBase() {Alive++;}
+  virtual ~MadeBase() {Alive--;}
+};
+
+count MadeBase::Alive = 0;
+
+class MadeDerived : public MadeBase
+{
+  public:
+  String Name;
+  MadeDerived(const String& Name_) : Name(Name_) {}
+};
+
+struct WeakSelf
+{
+  Pointer<WeakSelf>::Weak Self;
+  static count Revived;
+  ~WeakSelf()
+  {
+    Pointer<WeakSelf> Strong = Self;
+    Pointer<const WeakSelf> Consted = Self.Const();
+    if(Strong or Consted)
+      Revived++;
+  }
+};
+count WeakSelf::Revived = 0;
+
+void TEST_PrimUnitTests_PointerMake();
+void TEST_PrimUnitTests_PointerMake()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "PointerMake";
+
+  //Made objects share, cast and expire the same as owned objects.
+  {
+    Pointer<MadeDerived> d = Pointer<MadeDerived>::Make(String("d"));
+    EXPECT_EQ(d->Name, "d");
+    EXPECT_EQ(MadeBase::Alive, count(1));
+    Pointer<MadeBase> b = d;
+    Pointer<const MadeDerived> c = d.Const();
+    Pointer<MadeBase>::Weak w = b;
+    EXPECT_EQ(d.n(), count(3));
+    EXPECT_EQ(d.n(true), count(4));
+    d = Pointer<MadeDerived>(), c = Pointer<const MadeDerived>();
+    EXPECT_EQ(MadeBase::Alive, count(1));
+    b = Pointer<MadeBase>();
+    EXPECT_EQ(MadeBase::Alive, count(0));
+    EXPECT_EQ(true, not w);
+  }
+
+  //New() makes the object in place and handles const objects.
+  {
+    Pointer<String> s;
+    s.New()->Append("s");
+    EXPECT_EQ(*s, "s");
+    Pointer<const String> t = Pointer<const String>::Make(*s);
+    EXPECT_EQ(*t, "s");
+    EXPECT_EQ(t.n(), count(1));
+  }
+
+  //A weak handle can not revive an object that is being destroyed.
+  {
+    Pointer<WeakSelf> p = Pointer<WeakSelf>::Make();
+    p->Self = p;
+    p = Pointer<WeakSelf>();
+    EXPECT_EQ(WeakSelf::Revived, count(0));
+    Pointer<WeakSelf> q = new WeakSelf;
+    q->Self = q;
+    q = Pointer<WeakSelf>();
+    EXPECT_EQ(WeakSelf::Revived, count(0));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void TEST_PrimUnitTests_ListQuicksort();
 void TEST_PrimUnitTests_ListQuicksort()
 {
@@ -731,6 +1256,77 @@ void TEST_PrimUnitTests_SwappableArrayQuicksort()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void TEST_PrimUnitTests_SymbolKeys();
+void TEST_PrimUnitTests_SymbolKeys()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "SymbolKeys";
+
+  //Symbols with the same text are the same interned string.
+  Symbol a("PartState"), b(String("Part") + "State"), c("IslandState");
+  EXPECT_EQ(true, a == b);
+  EXPECT_EQ(true, a != c);
+  EXPECT_EQ(a.ID(), b.ID());
+  EXPECT_EQ(true, a.InternedString() == b.InternedString());
+  EXPECT_EQ(a.Name(), "PartState");
+  count InternedBefore = Symbol::InternedSymbols();
+  Symbol d("PartState");
+  EXPECT_EQ(Symbol::InternedSymbols(), InternedBefore);
+  EXPECT_EQ(d.ID(), a.ID());
+
+  //Symbol values are strings that compare with other strings by text.
+  Value v(a);
+  EXPECT_EQ(true, v.IsString());
+  EXPECT_EQ(true, v.IsSymbol());
+  EXPECT_EQ(true, v == Value("PartState"));
+  EXPECT_EQ(true, Value("PartState") == v);
+  EXPECT_EQ(true, v == Value(b));
+  EXPECT_EQ(false, v == Value(c));
+  EXPECT_EQ(true, Value(c) < v);
+  EXPECT_EQ(true, Value("Q") > v);
+
+  //Symbol and string keys address the same entry.
+  Value t;
+  t[a]["x"] = 1;
+  t["IslandState"] = 2;
+  EXPECT_EQ(t["PartState"]["x"].AsInteger(), integer(1));
+  EXPECT_EQ(t[c].AsInteger(), integer(2));
+  EXPECT_EQ(true, t.Contains(a));
+  EXPECT_EQ(true, t.Contains("IslandState"));
+  EXPECT_EQ(t.n(), count(2));
+  EXPECT_EQ(t.ExportJSON(false), "{\"IslandState\":2,\"PartState\":{\"x\":1}}");
+
+  //Copies share the interned string, and writes go to a private copy.
+  Value u = v;
+  EXPECT_EQ(true, u.IsSymbol());
+  u = String("Changed");
+  EXPECT_EQ(false, u.IsSymbol());
+  EXPECT_EQ(a.Name(), "PartState");
+  EXPECT_EQ(v.AsString(), "PartState");
+
+  /*Symbols are ordered by rank without comparing their text, and the ranks
+  follow text order regardless of the order in which they were interned. Each
+  key below is interned directly after the previous one in text order, which
+  eventually exhausts the gap between ranks and forces a renumbering.*/
+  Array<Symbol> Keys;
+  String Key = "SymbolKeys";
+  for(count i = 0; i < 100; i++)
+  {
+    Key << (i % 2 ? "a" : "z");
+    Keys.Add(Symbol(Key));
+    Keys.Add(Symbol(String("SymbolKeys") + integer((i * 37) % 100)));
+  }
+  count Misordered = 0;
+  for(count i = 0; i < Keys.n(); i++)
+    for(count j = 0; j < Keys.n(); j++)
+      if((Value(Keys[i]) < Value(Keys[j])) !=
+        (Value(Keys[i].Name()) < Value(Keys[j].Name())))
+          Misordered++;
+  EXPECT_EQ(Misordered, count(0));
+  EXPECT_EQ(false, Value(Keys[0]) < Value(Symbol(Keys[0].Name())));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void TEST_PrimUnitTests_TreeSmokeTest();
 void TEST_PrimUnitTests_TreeSmokeTest()
 {
@@ -987,6 +1583,822 @@ void TEST_PrimUnitTests_TreeLargeDeepCopy()
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+void TEST_PrimUnitTests_HashMap();
+void TEST_PrimUnitTests_HashMap()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "HashMap";
+
+  //Random insertions and removals agree with the ordered tree.
+  {
+    HashMap<int, int> H;
+    Tree<int, int> T;
+    Random r(123);
+    for(int i = 0; i < 20000; i++)
+    {
+      int k = int(r.Between(0, 2000));
+      if(r.Between(0, 2))
+        H.Remove(k), T.Remove(k);
+      else
+        H[k] = i, T[k] = i;
+    }
+    EXPECT_EQ(H.n(), T.n());
+    bool Agrees = true;
+    for(int k = 0; k < 2000; k++)
+      if(H.Contains(k) != T.Contains(k) or H.Get(k) != T.Get(k))
+        Agrees = false;
+    EXPECT_EQ(true, Agrees);
+
+    //Iteration visits each element exactly once.
+    count Visited = 0;
+    HashMap<int, int>::Iterator It;
+    for(It.Begin(H); It.Iterating(); It.Next(), Visited++)
+      if(T.Get(It.Key()) != It.Value())
+        Agrees = false;
+    EXPECT_EQ(Visited, H.n());
+    EXPECT_EQ(true, Agrees);
+
+    //Copies are deep and compare equal.
+    HashMap<int, int> H2 = H;
+    EXPECT_EQ(true, H2 == H);
+    H2.Remove(T.First());
+    EXPECT_EQ(true, H2 != H);
+    H.RemoveAll();
+    EXPECT_EQ(H.n(), count(0));
+    EXPECT_EQ(H.Get(5), Nothing<int>());
+  }
+
+  //String keys hash by content.
+  {
+    HashMap<String, count> H;
+    H["alpha"] = 1;
+    H[String("al") + "pha"] = 2;
+    H["beta"] = 3;
+    EXPECT_EQ(H.n(), count(2));
+    EXPECT_EQ(H["alpha"], count(2));
+    EXPECT_EQ(true, H.Contains("beta"));
+    EXPECT_EQ(false, H.Contains("gamma"));
+  }
+
+  //Pointer keys are released when removed from a set.
+  {
+    HashSet<Pointer<String> > S;
+    Pointer<String> p = new String("p");
+    S.Add(p), S.Add(p);
+    EXPECT_EQ(S.n(), count(1));
+    EXPECT_EQ(true, S.Contains(p));
+    EXPECT_EQ(false, S.Contains(Pointer<String>(new String("p"))));
+    S.Remove(p);
+    EXPECT_EQ(true, S.Empty());
+    EXPECT_EQ(p.n(), count(1));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TEST_PrimUnitTests_PooledContainers();
+void TEST_PrimUnitTests_PooledContainers()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "PooledContainers";
+
+  //A pooled tree agrees with a heap tree under random insertion and removal.
+  {
+    Tree<int, int, PooledAllocation> P;
+    Tree<int, int> T;
+    Random r(123);
+    for(int i = 0; i < 20000; i++)
+    {
+      int k = int(r.Between(0, 2000));
+      if(r.Between(0, 2))
+        P.Remove(k), T.Remove(k);
+      else
+        P[k] = i, T[k] = i;
+    }
+    EXPECT_EQ(P.n(), T.n());
+    EXPECT_LT(P.CalculateHeight(), P.MaximumHeight() + 1);
+
+    bool Agrees = true;
+    Tree<int, int, PooledAllocation>::Iterator It;
+    Tree<int, int>::Iterator Jt;
+    for(It.Begin(P), Jt.Begin(T); It.Iterating() and Jt.Iterating();
+      It.Next(), Jt.Next())
+        if(It.Key() != Jt.Key() or It.Value() != Jt.Value())
+          Agrees = false;
+    EXPECT_EQ(true, Agrees);
+
+    //Copies get their own pool.
+    Tree<int, int, PooledAllocation> P2 = P;
+    EXPECT_EQ(true, P2 == P);
+    P.RemoveAll();
+    EXPECT_EQ(P.n(), count(0));
+    EXPECT_EQ(P2.n(), T.n());
+  }
+
+  //Removed values are released immediately.
+  {
+    Pointer<String> p = new String("p");
+    Tree<int, Pointer<String>, PooledAllocation> P;
+    P[1] = p, P[2] = p;
+    EXPECT_EQ(p.n(), count(3));
+    P.Remove(1);
+    EXPECT_EQ(p.n(), count(2));
+    P.RemoveAll();
+    EXPECT_EQ(p.n(), count(1));
+  }
+
+  //A pooled list behaves like a heap list.
+  {
+    List<String, PooledAllocation> L;
+    for(count i = 0; i < 100; i++)
+      L.Append(String(i));
+    for(count i = 0; i < 50; i++)
+      L.Remove(i);
+    L.Prepend("first");
+    L.InsertAfter("second", 0);
+    EXPECT_EQ(L.n(), count(52));
+    EXPECT_EQ(L[0], "first");
+    EXPECT_EQ(L[1], "second");
+    EXPECT_EQ(L[2], "1");
+    EXPECT_EQ(L.z(), "99");
+    List<String, PooledAllocation> L2 = L;
+    L.RemoveAll();
+    EXPECT_EQ(L.n(), count(0));
+    EXPECT_EQ(L2.n(), count(52));
+    EXPECT_EQ(L2[3], "3");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TEST_PrimUnitTests_InlineArray();
+void TEST_PrimUnitTests_InlineArray()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "InlineArray";
+
+  //Elements stay inline until the array outgrows the buffer.
+  {
+    InlineArray<String, 4> a;
+    for(count i = 0; i < 4; i++)
+      a.Add(String(i));
+    EXPECT_EQ(true, a.IsInline());
+    EXPECT_EQ(a.Capacity(), count(4));
+    a.Add(a[0]);
+    EXPECT_EQ(false, a.IsInline());
+    EXPECT_EQ(a.n(), count(5));
+    EXPECT_EQ(a.z(), "0");
+    EXPECT_EQ(a[3], "3");
+    EXPECT_EQ(a[5], Nothing<String>());
+    EXPECT_EQ(a.Search("2"), count(2));
+    EXPECT_EQ(a.Pop(), "0");
+
+    //Clearing keeps the storage and copies are independent.
+    InlineArray<String, 4> b = a;
+    count Capacity = a.Capacity();
+    a.Clear();
+    EXPECT_EQ(a.n(), count(0));
+    EXPECT_EQ(a.Capacity(), Capacity);
+    EXPECT_EQ(b.n(), count(4));
+    EXPECT_EQ(b[1], "1");
+  }
+
+#ifdef PRIM_11
+  //Moving a spilled array takes over its heap storage.
+  {
+    InlineArray<String, 2> a;
+    for(count i = 0; i < 5; i++)
+      a.Add(String(i));
+    InlineArray<String, 2> b(Move(a));
+    EXPECT_EQ(false, b.IsInline());
+    EXPECT_EQ(b.n(), count(5));
+    EXPECT_EQ(b[4], "4");
+    EXPECT_EQ(a.n(), count(0));
+    EXPECT_EQ(true, a.IsInline());
+
+    InlineArray<String, 2> c;
+    c.Add("c");
+    c = Move(b);
+    EXPECT_EQ(c.n(), count(5));
+    EXPECT_EQ(c[0], "0");
+    EXPECT_EQ(b.n(), count(0));
+    b.Add("b");
+    EXPECT_EQ(b.z(), "b");
+  }
+#endif
+
+  //Elements removed from the buffer are released.
+  {
+    Pointer<String> p = new String("p");
+    InlineArray<Pointer<String>, 2> a;
+    a.Add(p), a.Add(p);
+    EXPECT_EQ(p.n(), count(3));
+    a.Clear();
+    EXPECT_EQ(p.n(), count(1));
+  }
+
+  //Graph traversal fills a caller-supplied buffer.
+  {
+    typedef GraphT<GraphTLabel<String> > G;
+    G g;
+    Pointer<G::Object> Root = g.Add();
+    GraphTLabel<String> x, s;
+    x.Set("k") = "x", s.Set("k") = "s";
+    Pointer<G::Object> Previous = Root;
+    for(count i = 0; i < 3; i++)
+    {
+      g.Connect(Root, g.Add())->Label = x;
+      Pointer<G::Object> Next = g.Add();
+      g.Connect(Previous, Next)->Label = s;
+      Previous = Next;
+    }
+
+    InlineArray<Pointer<const G::Object>, 4> Buffer;
+    Pointer<const G::Object> ConstRoot = Root;
+    ConstRoot->Children(x, Buffer);
+    EXPECT_EQ(Buffer.n(), count(3));
+    EXPECT_EQ(true, Buffer.IsInline());
+    EXPECT_EQ(true, Buffer.a() == ConstRoot->Children(x).a());
+    Buffer.a()->Parents(x, Buffer);
+    EXPECT_EQ(Buffer.n(), count(1));
+    EXPECT_EQ(true, Buffer.a() == ConstRoot);
+    Previous->Series(s, Buffer);
+    EXPECT_EQ(Buffer.n(), count(4));
+    EXPECT_EQ(true, Buffer.a() == ConstRoot);
+    EXPECT_EQ(true, Buffer.z() == Previous.Const());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+class KindLabel : public GraphTLabel<String>
+{
+  public:
+  uint64 EdgeKind() const
+  {
+    String Type = Get("type");
+    return Type ? uint64(Type.Merge()[0]) : 0;
+  }
+  bool EdgeEquivalent(const KindLabel& Filter) const
+  {
+    return Get("type") == Filter.Get("type");
+  }
+  KindLabel() {}
+  KindLabel(const ascii* Type) {Set("type") = Type;}
+};
+
+void TEST_PrimUnitTests_GraphAdjacency();
+void TEST_PrimUnitTests_GraphAdjacency()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "GraphAdjacency";
+  typedef GraphT<KindLabel> G;
+  typedef Pointer<G::Object> N;
+  G g;
+  N r = g.Add(), a = g.Add(), b = g.Add(), c = g.Add(), d = g.Add();
+  g.Connect(r, a)->Set("type") = "a";
+  N rb = g.Connect(r, b);
+  rb->Set("type") = "b";
+  g.Connect(r, c)->Set("type") = "a";
+  g.Connect(c, r)->Set("type") = "a";
+  g.Connect(r, r)->Set("type") = "b";
+  g.Connect(r, d);
+
+  //Typed lookups find the edges of their kind in each direction.
+  EXPECT_EQ(r->Children(KindLabel("a")).n(), count(2));
+  EXPECT_EQ(r->Children(KindLabel("b")).n(), count(2));
+  EXPECT_EQ(r->Parents(KindLabel("a")).n(), count(1));
+  EXPECT_EQ(true, r->Previous(KindLabel("a")) == c);
+  EXPECT_EQ(true, not r->Next(KindLabel("a")));
+  EXPECT_EQ(true, not r->Next(KindLabel("z")));
+  EXPECT_EQ(true, r->Parents(KindLabel("b")).a() == r);
+
+  //Filters with no kind still check every edge.
+  EXPECT_EQ(true, r->Next(KindLabel()) == d);
+
+  //Relabeling and disconnecting edges update the lookups.
+  rb->Set("type") = "a";
+  EXPECT_EQ(r->Children(KindLabel("a")).n(), count(3));
+  EXPECT_EQ(true, r->Next(KindLabel("b")) == r);
+  EXPECT_EQ(true, b->Previous(KindLabel("a")) == r);
+  EXPECT_EQ(true, not b->Previous(KindLabel("b")));
+  g.Disconnect(rb);
+  EXPECT_EQ(r->Children(KindLabel("a")).n(), count(2));
+  EXPECT_EQ(true, not b->Previous(KindLabel("a")));
+  g.Remove(c);
+  EXPECT_EQ(true, r->Next(KindLabel("a")) == a);
+  EXPECT_EQ(true, not r->Previous(KindLabel("a")));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+class KeepUnlessZ
+{
+  public:
+  bool operator () (const Pointer<const GraphT<KindLabel>::Object>& x) const
+  {
+    return x->Get("type") != "z";
+  }
+};
+
+void TEST_PrimUnitTests_GraphClone();
+void TEST_PrimUnitTests_GraphClone()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "GraphClone";
+  typedef GraphT<KindLabel> G;
+  typedef Pointer<G::Object> N;
+  G g;
+  N r = g.Add(), a = g.Add(), b = g.Add(), z = g.Add();
+  g.Root(a);
+  r->Set("name") = "r", a->Set("name") = "a", b->Set("name") = "b";
+  z->Set("type") = "z";
+  g.Connect(a, r)->Set("type") = "a";
+  g.Connect(r, b)->Set("type") = "a";
+  g.Connect(r, b)->Set("type") = "z";
+  g.Connect(b, z)->Set("type") = "a";
+
+  //The copy has the same nodes, edges, labels, and root.
+  {
+    G h;
+    g.CloneInto(h);
+    EXPECT_EQ(h.Nodes().n(), count(4));
+    EXPECT_EQ(h.Edges().n(), count(4));
+    EXPECT_EQ(h.Root()->Get("name"), "a");
+    N hr = h.Root()->Next(KindLabel("a"));
+    EXPECT_EQ(hr->Get("name"), "r");
+    EXPECT_EQ(hr->Next(KindLabel("z"))->Get("name"), "b");
+    EXPECT_EQ(true, h.Root() != a);
+  }
+
+  //A filter drops nodes and edges, along with the edges of dropped nodes.
+  {
+    G h;
+    g.CloneInto(h, KeepUnlessZ());
+    EXPECT_EQ(h.Nodes().n(), count(3));
+    EXPECT_EQ(h.Edges().n(), count(2));
+    N hb = h.Root()->Next(KindLabel("a"))->Next(KindLabel("a"));
+    EXPECT_EQ(hb->Get("name"), "b");
+    EXPECT_EQ(true, not hb->Next(KindLabel("a")));
+  }
+
+  //Cloning into a graph replaces its contents.
+  {
+    G h;
+    h.Connect(h.Add(), h.Add());
+    g.CloneInto(h);
+    EXPECT_EQ(h.Nodes().n(), count(4));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TEST_PrimUnitTests_GraphCycle();
+void TEST_PrimUnitTests_GraphCycle()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "GraphCycle";
+  typedef GraphT<KindLabel> G;
+  typedef Pointer<G::Object> N;
+
+  //Paths that rejoin without looping back are not cycles.
+  {
+    G g;
+    N a = g.Add(), b = g.Add(), c = g.Add(), e = g.Add();
+    g.Connect(a, b)->Set("type") = "a";
+    g.Connect(a, c)->Set("type") = "a";
+    g.Connect(c, e)->Set("type") = "a";
+    g.Connect(b, c)->Set("type") = "a";
+    g.Connect(e, a)->Set("type") = "b";
+    EXPECT_EQ(g.IsCyclic(KindLabel("a")), false);
+    EXPECT_EQ(g.Cycle(KindLabel("b")).n(), count(0));
+  }
+
+  //A cycle is found along with exactly the nodes on it.
+  {
+    G g;
+    N a = g.Add(), b = g.Add(), c = g.Add(), d = g.Add();
+    g.Connect(d, a)->Set("type") = "a";
+    g.Connect(a, b)->Set("type") = "a";
+    g.Connect(b, c)->Set("type") = "a";
+    g.Connect(c, a)->Set("type") = "a";
+    Array<Pointer<const G::Object> > Cycle = g.Cycle(KindLabel("a"));
+    EXPECT_EQ(Cycle.n(), count(3));
+    EXPECT_EQ(Cycle.Contains(d), false);
+
+    //Series stop before revisiting a node.
+    EXPECT_EQ(b->Series(KindLabel("a")).n(), count(3));
+    EXPECT_EQ(true, b->First(KindLabel("a")) == a);
+    EXPECT_EQ(true, b->Last(KindLabel("a")) == a);
+    EXPECT_EQ(true, d->Last(KindLabel("a")) == c);
+    EXPECT_EQ(d->Series(KindLabel("a"), false).n(), count(4));
+  }
+
+  //Series of a path are found from any node on it.
+  {
+    G g;
+    N x = g.Add(), y = g.Add(), z = g.Add();
+    g.Connect(x, y)->Set("type") = "a";
+    g.Connect(y, z)->Set("type") = "a";
+    EXPECT_EQ(y->Series(KindLabel("a")).n(), count(3));
+    EXPECT_EQ(y->Series(KindLabel("a"), false).n(), count(2));
+    EXPECT_EQ(true, y->First(KindLabel("a")) == x);
+    EXPECT_EQ(true, y->Last(KindLabel("a")) == z);
+    EXPECT_EQ(true, z->Series(KindLabel("b")).a() == z);
+
+    //Reindexing after a change gives the same traversals.
+    g.Connect(z, x)->Set("type") = "b";
+    g.Reindex();
+    EXPECT_EQ(true, z->Next(KindLabel("b")) == x);
+    EXPECT_EQ(true, y->Next(KindLabel("a")) == z);
+  }
+
+  //Series that run into a loop end just before the loop closes.
+  {
+    G g;
+    Array<N> Nodes;
+    for(count i = 0; i < 8; i++)
+      Nodes.Add() = g.Add();
+    for(count i = 0; i < 7; i++)
+      g.Connect(Nodes[i], Nodes[i + 1])->Set("type") = "a";
+    g.Connect(Nodes[7], Nodes[3])->Set("type") = "a";
+    g.Connect(Nodes[5], Nodes[5])->Set("type") = "b";
+    Array<N> Series = Nodes[0]->Series(KindLabel("a"), false);
+    EXPECT_EQ(Series.n(), count(8));
+    EXPECT_EQ(true, Series.z() == Nodes[7]);
+    EXPECT_EQ(true, Nodes[0]->Last(KindLabel("a")) == Nodes[7]);
+    EXPECT_EQ(true, Nodes[4]->Last(KindLabel("a")) == Nodes[3]);
+    EXPECT_EQ(true, Nodes[4]->First(KindLabel("a")) == Nodes[3]);
+    EXPECT_EQ(Nodes[5]->Series(KindLabel("b")).n(), count(1));
+    EXPECT_EQ(true, Nodes[5]->First(KindLabel("b")) == Nodes[5]);
+    EXPECT_EQ(true, Nodes[5]->Last(KindLabel("b")) == Nodes[5]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TEST_PrimUnitTests_Sequence();
+void TEST_PrimUnitTests_Sequence()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "Sequence";
+
+  //Appending and prepending across several blocks keeps the indices in order.
+  {
+    Sequence<count> s;
+    for(count i = 0; i < 100; i++)
+      s.Append(i), s.Prepend(-1 - i);
+    EXPECT_EQ(s.n(), count(200));
+    EXPECT_EQ(s.a(), count(-100));
+    EXPECT_EQ(s.z(), count(99));
+    bool InOrder = true;
+    for(count i = 0; i < s.n(); i++)
+      InOrder = InOrder and s[i] == i - 100;
+    EXPECT_EQ(true, InOrder);
+    EXPECT_EQ(s.Search(42), count(142));
+    EXPECT_EQ(s[200], Nothing<count>());
+    EXPECT_EQ(true, s < count(100));
+    EXPECT_EQ(false, s > count(0));
+  }
+
+  //Middle insertions and removals behave the same as they do on a List.
+  {
+    Random r(7);
+    Sequence<count> s;
+    List<count> l;
+    for(count i = 0; i < 500; i++)
+    {
+      count Index = r.Between(count(0), s.n() + 1);
+      if(s.n() > 10 and r.Between(0, 3) == 0)
+        s.Remove(Index), l.Remove(Index);
+      else if(r.Between(0, 2))
+        s.InsertBefore(i, Index), l.InsertBefore(i, Index);
+      else
+        s.InsertAfter(i, Index), l.InsertAfter(i, Index);
+    }
+    bool Same = s.n() == l.n();
+    for(count i = 0; Same and i < s.n(); i++)
+      Same = s[i] == l[i];
+    EXPECT_EQ(true, Same);
+
+    //Copies are independent and popping to empty releases the blocks.
+    Sequence<count> t = s;
+    while(s.n())
+      s.Pop();
+    EXPECT_EQ(s.n(), count(0));
+    EXPECT_EQ(t.n(), l.n());
+    t.Swap(0, 1);
+    EXPECT_EQ(t[0], l[1]);
+    s.Add(t.z());
+    EXPECT_EQ(s.a(), l.z());
+  }
+
+  //Removed elements are released.
+  {
+    Pointer<String> p = new String("p");
+    Sequence<Pointer<String> > s;
+    for(count i = 0; i < 40; i++)
+      s.Add(p);
+    s.Remove(3), s.Remove(30);
+    EXPECT_EQ(p.n(), count(39));
+    s.RemoveAll();
+    EXPECT_EQ(p.n(), count(1));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TEST_PrimUnitTests_NumberFormatting();
+void TEST_PrimUnitTests_NumberFormatting()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "NumberFormatting";
+
+  //Fixed notation matches printf across magnitudes and precisions.
+  Random r(11);
+  bool Same = true;
+  for(count i = 0; i < 20000 and Same; i++)
+  {
+    count Precision = r.Between(count(1), count(18));
+    float64 v = r.Between(-1.0, 1.0) * Power(10.0, r.Between(-12.0, 17.0));
+    if(i % 4 == 0)
+      v = float64(integer(v * 1024.0)) / 1024.0;
+    String s;
+    s.Append(v, Precision, false);
+
+    char Expected[64];
+    float64 w = Chop(v, 1.0e-16);
+    if(Abs(w) >= 1.0e+16) w = 1.0e+16 * Sign(w);
+    count Length = count(snprintf(Expected, sizeof(Expected), "%.*f",
+      int(Precision), w));
+    while(Length > 2 and Expected[Length - 1] == '0' and
+      Expected[Length - 2] != '.')
+        Expected[--Length] = 0;
+    Same = s == Expected;
+    if(not Same)
+      C::Error() >> "Mismatch: " << s << " " << Expected;
+  }
+  EXPECT_EQ(true, Same);
+
+  //Exact ties round to even and small negatives keep their sign.
+  {
+    String s;
+    s.Append(0.125, 2, false), s << " ";
+    s.Append(0.375, 2, false), s << " ";
+    s.Append(-0.000001, 5, false), s << " ";
+    s.Append(2.0, 5, false), s << " ";
+    s << 1.5 << " " << 1.0e20;
+    EXPECT_EQ(s, "0.12 0.38 -0.0 2.0 1.5 10000000000000000.0");
+  }
+
+  //Scientific notation keeps the significant digits.
+  {
+    String s;
+    s.Append(0.1, 17, true), s << " ";
+    s.Append(1.0e-7, 3, true);
+    EXPECT_EQ(s, "0.10000000000000001 1e-07");
+  }
+
+  //The decimal point is a period even if the locale uses another one.
+  {
+    const ascii* Locales[] = {"de_DE.UTF-8", "de_DE.utf8", "de_DE",
+      "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR", "German", "French"};
+    bool Comma = false;
+    for(count i = 0; i < 8 and not Comma; i++)
+      Comma = setlocale(LC_NUMERIC, Locales[i]) and
+        String(localeconv()->decimal_point) != ".";
+    if(not Comma)
+      C::Out() >> "  No decimal-comma locale found, checking the C locale.";
+    String s;
+    s.Append(0.1, 17, true), s << " ";
+    s.Append(2.5e-20, 3, true), s << " ";
+    s << 1.5 << " " << 1.0e20;
+    Value v;
+    v["x"] = 0.25;
+    String j = JSON::Export(v);
+    setlocale(LC_NUMERIC, "C");
+    EXPECT_EQ(s, "0.10000000000000001 2.5e-20 1.5 10000000000000000.0");
+    EXPECT_EQ(true, j.Contains("0.25"));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TEST_PrimUnitTests_NumberParsing();
+void TEST_PrimUnitTests_NumberParsing()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "NumberParsing";
+
+  //Parsing round-trips and matches strtod across magnitudes and lengths.
+  Random r(12);
+  bool Same = true;
+  for(count i = 0; i < 20000 and Same; i++)
+  {
+    char Text[64];
+    float64 v = r.Between(-1.0, 1.0) * Power(10.0, r.Between(-30.0, 30.0));
+    int Digits = int(r.Between(count(1), count(21)));
+    if(i % 3 == 0)
+      snprintf(Text, sizeof(Text), "%.*g", Digits, v);
+    else if(i % 3 == 1)
+      snprintf(Text, sizeof(Text), "%.17g", v);
+    else
+      snprintf(Text, sizeof(Text), "%.*f", Digits % 8,
+        float64(integer(v * 1.0e6)) / 1.0e3);
+    const byte* Begin = reinterpret_cast<const byte*>(&Text[0]);
+    const byte* End = Begin + String::LengthOf(Text);
+    number Result = 0;
+    Same = String::ParseNumber(Begin, End, Result) == End and
+      Result == number(strtod(Text, 0));
+    if(not Same)
+      C::Error() >> "Mismatch: " << Text;
+  }
+  EXPECT_EQ(true, Same);
+
+  //Spans end at the first character that does not continue the number.
+  {
+    String s = "-7 .5 5. 1e 2e+ 1e-3x -1234.5e-1 +0.1 abc";
+    const byte* i = reinterpret_cast<const byte*>(s.Merge());
+    const byte* e = i + s.n();
+    String Out;
+    while(i < e)
+    {
+      number Result = 99;
+      const byte* j = String::ParseNumber(i, e, Result);
+      if(j == i)
+        Out << "_", j++;
+      else
+        Out << Result;
+      while(j < e and *j != ' ')
+        Out << ascii(*j++);
+      i = j < e ? j + 1 : j;
+      Out << " ";
+    }
+    EXPECT_EQ(Out, "-7.0 0.5 5.0 1.0e 2.0e+ 0.001x -123.45 0.1 _bc ");
+  }
+
+  //Conversions through strings, ratios, and JSON use the same parser.
+  EXPECT_EQ(String(" 2.5").ToNumber(), 2.5);
+  EXPECT_EQ(String("0x10").ToNumber(), 16.0);
+
+  //The strtod slow path and fallback read a period under any locale.
+  {
+    const ascii* Texts[] = {"0.12345678901234567890123", "1.5e300",
+      "2.5e-320", "-123456789012345678901.5", "1.5abc", "0x1.8p1"};
+    number Expected[6], Parsed[6];
+    for(count i = 0; i < 6; i++)
+      Expected[i] = number(strtod(Texts[i], 0));
+    const ascii* Locales[] = {"de_DE", "de_DE.UTF-8", "de_DE.utf8",
+      "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR", "German", "French"};
+    bool Comma = false;
+    for(count i = 0; i < 8 and not Comma; i++)
+      Comma = setlocale(LC_NUMERIC, Locales[i]) and
+        String(localeconv()->decimal_point) != ".";
+    if(not Comma)
+      C::Out() >> "  No decimal-comma locale found, checking the C locale.";
+    for(count i = 0; i < 6; i++)
+      Parsed[i] = String(Texts[i]).ToNumber();
+    String Long = "0.";
+    for(count i = 0; i < 70; i++)
+      Long << "0";
+    Long << "15";
+    number LongParsed = Long.ToNumber();
+    setlocale(LC_NUMERIC, "C");
+    bool Same = true;
+    for(count i = 0; i < 6; i++)
+      if(Parsed[i] != Expected[i])
+        C::Error() >> "Mismatch: " << Texts[i], Same = false;
+    EXPECT_EQ(true, Same);
+    EXPECT_EQ(LongParsed, number(strtod(Long.Merge(), 0)));
+  }
+  EXPECT_EQ(Ratio(String("-3/4")), Ratio(-3, 4));
+  EXPECT_EQ(Ratio(String("3/")).IsEmpty(), true);
+  {
+    Value v = JSON::Import("[0.1, 7, 1e2, -2.5E-3]");
+    EXPECT_EQ(v[0].AsNumber(), 0.1);
+    EXPECT_EQ(v[1].IsInteger(), true);
+    EXPECT_EQ(v[2].AsNumber(), 100.0);
+    EXPECT_EQ(v[3].AsNumber(), -0.0025);
+    EXPECT_EQ(JSON::Import("[01]", v), false);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TEST_PrimUnitTests_StringBuilder();
+void TEST_PrimUnitTests_StringBuilder()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "StringBuilder";
+
+  //The builder formats exactly as String does.
+  {
+    Random r(13);
+    String s;
+    StringBuilder b;
+    for(count i = 0; i < 2000; i++)
+    {
+      float64 v = r.Between(-1.0, 1.0) * Power(10.0, r.Between(-8.0, 8.0));
+      integer k = integer(r.Between(-1.0e12, 1.0e12));
+      s >> v << " " << k << ' ' << (i % 2 == 0);
+      b >> v << " " << k << ' ' << (i % 2 == 0);
+    }
+    s++, b++;
+    s << Limits<int64>::Min() << Limits<uint64>::Max() << uint8(7) <<
+      unicode(0x263A) << Limits<float64>::Infinity();
+    b << Limits<int64>::Min() << Limits<uint64>::Max() << uint8(7) <<
+      unicode(0x263A) << Limits<float64>::Infinity();
+    EXPECT_EQ(b.n(), s.n());
+    EXPECT_EQ(true, b.View() == s);
+    EXPECT_EQ(b.ToString(), s);
+    b.Clear();
+    EXPECT_EQ(b.n(), count(0));
+    b >> "x";
+    EXPECT_EQ(b.ToString(), "x");
+  }
+
+  //Views slice, search, and compare without copying.
+  {
+    String s = "  The quick brown fox  ";
+    StringView v = StringView(s).Trimmed();
+    EXPECT_EQ(String(v), "The quick brown fox");
+    EXPECT_EQ(String(v.Slice(4, 8)), "quick");
+    EXPECT_EQ(v.Slice(8, 4).n(), count(0));
+    EXPECT_EQ(v.Find("o"), count(12));
+    EXPECT_EQ(v.Find("o", 13), count(17));
+    EXPECT_EQ(v.Find("cat"), count(-1));
+    EXPECT_EQ(v.StartsWith("The"), true);
+    EXPECT_EQ(v.EndsWith("fox"), true);
+    EXPECT_EQ(v.EndsWith("The quick brown fox!"), false);
+    EXPECT_EQ(v.Contains("brown"), true);
+    EXPECT_EQ(StringView("abc") < StringView("abd"), true);
+    EXPECT_EQ(StringView("ab") < StringView("abc"), true);
+    EXPECT_EQ(StringView("abc") == StringView("abc"), true);
+    EXPECT_EQ(StringView(" 2.5 ").ToNumber(), 2.5);
+  }
+
+  //Tokenizing keeps empty entries unless asked to remove them.
+  {
+    String s = "a,,b,";
+    EXPECT_EQ(s.Tokenize(",").n(), count(4));
+    EXPECT_EQ(s.Tokenize(",", true).n(), count(2));
+    EXPECT_EQ(s.Tokenize(",", true).z(), "b");
+    EXPECT_EQ(s.Tokenize("").n(), count(0));
+    EXPECT_EQ(String("").Tokenize(",").n(), count(1));
+    List<StringView> t = StringView("1 -- 2 -- 3").Tokenize(" -- ");
+    EXPECT_EQ(t.n(), count(3));
+    EXPECT_EQ(t[2] == "3", true);
+    EXPECT_EQ(t[1].Begin() - t[0].Begin(), count(5));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TEST_PrimUnitTests_StringSearch();
+void TEST_PrimUnitTests_StringSearch()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "StringSearch";
+
+  //The vectorized search agrees with a naive scan across block boundaries.
+  {
+    Random r(29);
+    Array<byte> h, n;
+    for(count i = 0; i < 3000; i++)
+    {
+      h.n(count(r.NextIntegerInRange(0, 100)));
+      n.n(count(r.NextIntegerInRange(1, 6)));
+      for(count j = 0; j < h.n(); j++)
+        h[j] = byte('a' + r.NextIntegerInRange(0, 3));
+      for(count j = 0; j < n.n(); j++)
+        n[j] = byte('a' + r.NextIntegerInRange(0, 3));
+
+      count Expected = -1;
+      for(count j = 0; Expected == -1 and j + n.n() <= h.n(); j++)
+      {
+        count k = 0;
+        while(k < n.n() and h[j + k] == n[k])
+          k++;
+        if(k == n.n())
+          Expected = j;
+      }
+
+      const byte* Found = StringView::FindBytes(h.n() ? &h.a() : 0, h.n(),
+        &n.a(), n.n());
+      EXPECT_EQ(Found ? count(Found - &h.a()) : count(-1), Expected);
+    }
+  }
+
+  //Replace substitutes every non-overlapping match from left to right.
+  {
+    String s = "aaaa-b-aaa";
+    EXPECT_EQ(s.Replace("aa", "x"), count(3));
+    EXPECT_EQ(s, "xx-b-xa");
+    EXPECT_EQ(s.Replace("-", ""), count(2));
+    EXPECT_EQ(s, "xxbxa");
+    EXPECT_EQ(s.Replace("q", "z"), count(0));
+    EXPECT_EQ(s, "xxbxa");
+    EXPECT_EQ(s.Replace("x", "<x>"), count(3));
+    EXPECT_EQ(s, "<x><x>b<x>a");
+    EXPECT_EQ(s.Find("b", 7), count(-1));
+    EXPECT_EQ(s.Find("<x>a", 3), count(7));
+    EXPECT_EQ(s.StartsWith("<x><x>"), true);
+    EXPECT_EQ(s.StartsWith("x"), false);
+    EXPECT_EQ(s.EndsWith(">a"), true);
+    EXPECT_EQ(s.EndsWith(""), false);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 static unsigned char UTF16_TestBE[] = {
   0xd8, 0x41, 0xdf, 0x0e, 0x00, 0x20, 0xd8, 0x41, 0xdf, 0x31, 0x00, 0x20,
@@ -1184,6 +2596,70 @@ void TEST_PrimUnitTests_UTF16Decode()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void TEST_PrimUnitTests_UTF8Decode();
+void TEST_PrimUnitTests_UTF8Decode()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "UTF8Decode";
+
+  //The bulk routines agree with decoding one character at a time.
+  {
+    const ascii* Pieces[] = {"\xc3\xa9", "\xe2\x99\xaa", "\xf0\x9d\x84\x9e",
+      "\xff", "\x80", "\xe2\x82", "\xc0\xaf"};
+    Random r(31);
+    for(count i = 0; i < 500; i++)
+    {
+      String s;
+      count Parts = count(r.NextIntegerInRange(0, 6));
+      for(count j = 0; j < Parts; j++)
+      {
+        count Run = count(r.NextIntegerInRange(0, 40));
+        for(count k = 0; k < Run; k++)
+          s << ascii('a' + r.NextIntegerInRange(0, 26));
+        s << Pieces[r.NextIntegerInRange(0, i % 2 ? 7 : 3)];
+      }
+
+      const byte* Begin = reinterpret_cast<const byte*>(s.Merge());
+      const byte* End = Begin + s.n();
+      const byte* FirstBad = End;
+      count Characters = 0;
+      String::UTF32 Decoded, Expected;
+      for(const byte* x = Begin; x < End; Characters++)
+      {
+        const byte* Character = x;
+        Expected.Add(String::Decode(x, End));
+        if(Expected.z() == meta::BadCharacter and FirstBad == End)
+          FirstBad = Character;
+      }
+      String::DecodeStream(Begin, s.n(), Decoded);
+
+      EXPECT_EQ(String::ValidateUTF8(Begin, End) == FirstBad, true);
+      EXPECT_EQ(s.IsUTF8(), FirstBad == End);
+      EXPECT_EQ(s.Characters(), Characters);
+      EXPECT_EQ(Decoded.n(), Expected.n());
+      for(count j = 0; j < Decoded.n() and j < Expected.n(); j++)
+        EXPECT_EQ(Decoded[j], Expected[j]);
+      count Sought = Characters / 2;
+      const byte* x = Begin;
+      for(count j = 0; j < Sought; j++)
+        String::Decode(x, End);
+      EXPECT_EQ(s.CharacterIndex(Sought), Sought ? count(x - Begin) : 0);
+    }
+  }
+
+  //JSON strings copy ASCII runs and decode escapes and multi-byte sequences.
+  {
+    Value v = JSON::Import("[\"plain\", \"caf\xc3\xa9 \\u00e9\\n\\\"x\\\" "
+      "\xf0\x9d\x84\x9e\", \"\\ud834\\udd1e\"]");
+    EXPECT_EQ(v.n(), count(3));
+    EXPECT_EQ(v[0].AsString(), "plain");
+    EXPECT_EQ(v[1].AsString(), "caf\xc3\xa9 \xc3\xa9\n\"x\" \xf0\x9d\x84\x9e");
+    EXPECT_EQ(v[2].AsString(), "\xf0\x9d\x84\x9e");
+    EXPECT_EQ(JSON::Import(JSON::Export(v)), v);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void TEST_PrimUnitTests_UUIDv4NoDuplicates();
 void TEST_PrimUnitTests_UUIDv4NoDuplicates()
 {
@@ -1288,6 +2764,227 @@ void TEST_PrimUnitTests_ValueNilTest()
   EXPECT_EQ(true, v == Value(Pointer<Value::Base>()));
 }
 
+void TEST_PrimUnitTests_ValueAssignment();
+void TEST_PrimUnitTests_ValueAssignment()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "ValueAssignment";
+
+  //Build a tree resembling a house style: keys with scalar and array values.
+  Value Style;
+  count Nodes = 1;
+  for(count i = 0; i < 64; i++)
+  {
+    Value& Entry = Style[String("Key") << i];
+    Nodes += 2;
+    if(i % 4)
+      Entry = number(i) / 4.f;
+    else
+      for(count j = 0; j < 4; j++)
+        Entry.Add() = integer(j), Nodes++;
+  }
+
+  //Assignment of a container shares its storage instead of copying values.
+  const count Assignments = 1000;
+  Value Copy;
+  count CopiesBefore = Value::DeepCopies();
+  for(count i = 0; i < Assignments; i++)
+    Copy = Style;
+  count CopiesPerAssignment = (Value::DeepCopies() - CopiesBefore) /
+    Assignments;
+  C::Out() >> "  Value copies per assignment of " << Nodes << " values: " <<
+    CopiesPerAssignment;
+  EXPECT_EQ(CopiesPerAssignment, count(0));
+  EXPECT_EQ(true, Copy == Style);
+
+  /*Writing to the copy then clones only the storage on the way to the write:
+  the keys and values of the tree (of which the 16 arrays are shared) and the
+  elements of the array written to.*/
+  CopiesBefore = Value::DeepCopies();
+  Copy["Key0"][0] = "changed";
+  EXPECT_EQ(Value::DeepCopies() - CopiesBefore, count(2 * 64 - 16 + 4));
+  EXPECT_EQ(Style["Key0"][0].AsInteger(), integer(0));
+
+  //Partial self-assignment must still be safe.
+  Value a;
+  a["x"].Add() = "y";
+  a["z"] = 1;
+  a["x"][0] = a;
+  EXPECT_EQ(a["x"][0]["x"][0].AsString(), "y");
+  EXPECT_EQ(a["x"][0]["z"].AsInteger(), integer(1));
+  a = a["x"];
+  EXPECT_EQ(true, a.IsArray());
+  EXPECT_EQ(a[0]["z"].AsInteger(), integer(1));
+  a = a;
+  EXPECT_EQ(a[0]["x"][0].AsString(), "y");
+  a[0]["x"] = a[0];
+  EXPECT_EQ(a[0]["x"]["x"][0].AsString(), "y");
+
+  //Lookups do not copy their keys, but keys taken from the value still work.
+  CopiesBefore = Value::DeepCopies();
+  const Value& ConstStyle = Style;
+  EXPECT_EQ(Style["Key1"].AsNumber(), number(0.25f));
+  EXPECT_EQ(ConstStyle[String("Key8")][2].AsInteger(), integer(2));
+  EXPECT_EQ(Value::DeepCopies() - CopiesBefore, count(0));
+  Value b;
+  b.Add() = "k";
+  b.Add() = 0;
+  b[b[1]] = "first";
+  EXPECT_EQ(b[0].AsString(), "first");
+  b[b[0]] = 5;
+  EXPECT_EQ(true, b.IsTree());
+  EXPECT_EQ(b["first"].AsInteger(), integer(5));
+  b["x"] = "y";
+  b[b["x"]] = "z";
+  EXPECT_EQ(b["y"].AsString(), "z");
+  b[b] = 1;
+  EXPECT_EQ(b.n(), count(4));
+}
+
+void TEST_PrimUnitTests_ValueCopyOnWrite();
+void TEST_PrimUnitTests_ValueCopyOnWrite()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "ValueCopyOnWrite";
+
+  Value Style;
+  for(count i = 0; i < 16; i++)
+    Style[String("Key") << i].Add() = integer(i);
+
+  //Copies share the storage even though references were handed out.
+  count CopiesBefore = Value::DeepCopies();
+  Value First = Style;
+  Value Second = First;
+  Value Third;
+  Third = Second;
+  EXPECT_EQ(Value::DeepCopies() - CopiesBefore, count(0));
+  EXPECT_EQ(true, First == Style and Second == Style and Third == Style);
+
+  //Modifying a copy leaves the others unchanged.
+  Second["Key3"][0] = "changed";
+  Third["Key4"].Add() = "added";
+  Third["Key5"].Clear();
+  EXPECT_EQ(First["Key3"][0].AsInteger(), integer(3));
+  EXPECT_EQ(First["Key4"].n(), count(1));
+  EXPECT_EQ(Second["Key3"][0].AsString(), "changed");
+  EXPECT_EQ(Second["Key4"].n(), count(1));
+  EXPECT_EQ(Second["Key5"].n(), count(1));
+  EXPECT_EQ(Third["Key3"][0].AsInteger(), integer(3));
+  EXPECT_EQ(Third["Key4"].n(), count(2));
+  EXPECT_EQ(true, Third["Key5"].IsNil());
+  EXPECT_EQ(true, First == Style);
+
+  //Writing to the original after a copy detaches it from the copy.
+  Value Original = First;
+  Original["Key6"][0] = "written";
+  Value Snapshot = Original;
+  Original["Key6"][0] = "rewritten";
+  EXPECT_EQ(Original["Key6"][0].AsString(), "rewritten");
+  EXPECT_EQ(Snapshot["Key6"][0].AsString(), "written");
+  EXPECT_EQ(First["Key6"][0].AsInteger(), integer(6));
+
+  //Trees built through operator [] or imported are copied without copying.
+  {
+    Value Built;
+    for(count i = 0; i < 1000; i++)
+      Built[String("Key") << i] = i;
+    Value Imported = JSON::Import(JSON::Export(Built));
+    count Before = Value::DeepCopies();
+    Value BuiltCopy = Built, ImportedCopy;
+    ImportedCopy = Imported;
+    EXPECT_EQ(Value::DeepCopies() - Before, count(0));
+    EXPECT_EQ(true, BuiltCopy == Built and ImportedCopy == Built);
+  }
+
+  //Partial self-assignment with shared storage
+  Value a = First;
+  a["Key0"][0] = a;
+  EXPECT_EQ(a["Key0"][0]["Key0"][0].AsInteger(), integer(0));
+  EXPECT_EQ(a["Key0"][0]["Key1"][0].AsInteger(), integer(1));
+  a = a["Key0"][0];
+  EXPECT_EQ(true, a == First);
+  EXPECT_EQ(First["Key0"][0].AsInteger(), integer(0));
+}
+
+void TEST_PrimUnitTests_ValueInlineStorage();
+void TEST_PrimUnitTests_ValueInlineStorage()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "ValueInlineStorage";
+
+  EXPECT_EQ(count(sizeof(Value)), count(16));
+
+  //Strings on either side of the inline capacity
+  const ascii* Texts[] = {"", "a", "TypesetX", "twelve chars", "thirteen char",
+    "a string that is much too long to be stored inline"};
+  count Texts_n = count(sizeof(Texts) / sizeof(Texts[0]));
+  Value Keys;
+  for(count i = 0; i < Texts_n; i++)
+  {
+    Value v(Texts[i]), w;
+    w = String(Texts[i]);
+    EXPECT_EQ(v.AsString(), Texts[i]);
+    EXPECT_EQ(true, v.IsString() and v == w and not v.IsSymbol());
+    EXPECT_EQ(bool(v), i > 0);
+    Value Copy = v;
+    v = "x";
+    EXPECT_EQ(Copy.AsString(), Texts[i]);
+    Keys[Texts[i]] = integer(i);
+  }
+
+  //Ordering is the same for inline and heap strings.
+  Value SortedKeys = Keys.Keys();
+  EXPECT_EQ(SortedKeys.n(), Texts_n);
+  for(count i = 0; i < SortedKeys.n(); i++)
+  {
+    const Value& Key = SortedKeys[i];
+    EXPECT_EQ(true, i == 0 or SortedKeys[i - 1] < Key);
+    EXPECT_EQ(Key.AsString(), Texts[Keys[Key].AsCount()]);
+    EXPECT_EQ(true, i == 0 or
+      strcmp(SortedKeys[i - 1].AsString(), Key.AsString()) < 0);
+  }
+
+  //A string with a null byte can not be inline but still compares as before.
+  String WithNull = "ab";
+  WithNull.Append(reinterpret_cast<const byte*>("\0c"), 2);
+  Value NullString(WithNull);
+  EXPECT_EQ(NullString.AsString().n(), count(4));
+  EXPECT_EQ(false, Value("ab") < NullString or NullString < Value("ab"));
+  EXPECT_EQ(true, Value("ab") == NullString);
+  EXPECT_EQ(false, NullString == Value("ab"));
+
+  //Interned strings compare with inline strings.
+  Symbol Name("TypesetX");
+  EXPECT_EQ(true, Value(Name) == Value("TypesetX"));
+  EXPECT_EQ(true, Value("TypesetX") == Value(Name));
+  EXPECT_EQ(true, Value(Name).IsSymbol());
+
+  //Ratios inline and on the heap
+  Ratio Small(3, 4), Large(int64(1) << 40, 3);
+  Value r1 = Value(Small), r2 = Value(Large), r3 = Value(Ratio(-5, 7));
+  EXPECT_EQ(r1.AsRatio(), Small);
+  EXPECT_EQ(r2.AsRatio(), Large);
+  EXPECT_EQ(r3.AsRatio(), Ratio(-5, 7));
+  EXPECT_EQ(true, Value(r1) == r1 and r1 != r2);
+  EXPECT_EQ(true, Value(Ratio()).IsNil());
+
+  //Vectors inline and on the heap
+  Vector v1(0.5, -2.0), v2(0.1, 3.0);
+  Value x1 = Value(v1), x2 = Value(v2);
+  EXPECT_EQ(x1.AsVector(), v1);
+  EXPECT_EQ(x2.AsVector(), v2);
+  EXPECT_EQ(true, Value(x1) == x1 and x1 != x2);
+  EXPECT_EQ(true, Value(Vector::Empty()).IsNil());
+
+  //Serialization of inline values
+  Value Document;
+  Document["Short"] = "abc";
+  Document["Long"] = "a string that is much too long to be stored inline";
+  Document["Ratio"] = Small;
+  Document["Vector"] = v1;
+  Document["Keys"] = Keys;
+  EXPECT_EQ(true, JSON::Import(JSON::Export(Document)) == Document);
+  EXPECT_EQ(true, BinaryValue::Import(BinaryValue::Export(Document)) ==
+    Document);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void TEST_PrimUnitTests_XMLParse();
@@ -1317,6 +3014,475 @@ void TEST_PrimUnitTests_XMLParse()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void TEST_PrimUnitTests_XMLPullParser();
+void TEST_PrimUnitTests_XMLPullParser()
+{
+  C::Out() >> "Testing: " "PrimUnitTests" " - " "XMLPullParser";
+
+  //Events arrive in document order with undecoded views of the markup.
+  {
+    String s = "<?xml version=\"1.0\"?><a x='1 &amp; 2'><b/><!--c-->"
+      "t &lt;&#65;&#x42;&bogus;<![CDATA[<d>]]></a>";
+    XML::PullParser p(s);
+    EXPECT_EQ(p.Next(), XML::PullParser::Markup);
+    EXPECT_EQ(p.Next(), XML::PullParser::StartElement);
+    EXPECT_EQ(String(p.Name()), "a");
+    EXPECT_EQ(p.Depth(), count(1));
+    EXPECT_EQ(p.Next(), XML::PullParser::Attribute);
+    EXPECT_EQ(String(p.Name()), "x");
+    EXPECT_EQ(String(p.Raw()), "1 &amp; 2");
+    EXPECT_EQ(p.Decoded(), "1 & 2");
+    EXPECT_EQ(p.Next(), XML::PullParser::StartElement);
+    EXPECT_EQ(p.Depth(), count(2));
+    EXPECT_EQ(p.Next(), XML::PullParser::EndElement);
+    EXPECT_EQ(String(p.Name()), "b");
+    EXPECT_EQ(p.Next(), XML::PullParser::Markup);
+    EXPECT_EQ(String(p.Raw()), "<!--c-->");
+    EXPECT_EQ(p.Next(), XML::PullParser::Text);
+    EXPECT_EQ(p.Decoded(), "t <AB&bogus;");
+    EXPECT_EQ(p.Next(), XML::PullParser::Text);
+    EXPECT_EQ(p.IsCDATA(), true);
+    EXPECT_EQ(p.Decoded(), "<d>");
+    EXPECT_EQ(p.Next(), XML::PullParser::EndElement);
+    EXPECT_EQ(p.Depth(), count(1));
+    EXPECT_EQ(p.Next(), XML::PullParser::EndDocument);
+  }
+
+  //Elements can be skipped without visiting their content.
+  {
+    String s = "<a><b><c/>x</b><d/></a>";
+    XML::PullParser p(s);
+    p.Next(), p.Next();
+    EXPECT_EQ(p.SkipElement(), true);
+    EXPECT_EQ(p.Next(), XML::PullParser::StartElement);
+    EXPECT_EQ(String(p.Name()), "d");
+  }
+
+  //Unbalanced tags and unquoted attributes are reported.
+  {
+    String s = "<a>\n<b></a>", t = "<a x=1/>";
+    XML::PullParser p(s);
+    while(p.Next() != XML::PullParser::Malformed) {}
+    EXPECT_EQ(p.ErrorInfo().EndsWith("line 2"), true);
+    XML::PullParser q(t);
+    q.Next();
+    EXPECT_EQ(q.Next(), XML::PullParser::Malformed);
+    Value v;
+    v.FromXML("<a><b></a>");
+    EXPECT_EQ(v.IsNil(), true);
+  }
+
+  //Values converted from XML keep their names, attributes, and children.
+  {
+    Value v;
+    v.FromXML("<a n='2.5'>\n  <b>  one\n two </b><b m=\"3\"/></a>");
+    EXPECT_EQ(v.Tag(), "a");
+    EXPECT_EQ(v["n"].AsNumber(), 2.5);
+    EXPECT_EQ(v.n(), count(4));
+    EXPECT_EQ(v.Contains(integer(2)), false);
+    EXPECT_EQ(v[0].Tag(), "b");
+    EXPECT_EQ(v[0].Val().AsString(), "one two");
+    EXPECT_EQ(v[1]["m"].AsInteger(), integer(3));
+  }
+
+  //Graph attributes survive a round trip through XML.
+  {
+    typedef GraphT<GraphTLabel<String> > G;
+    G g, h;
+    Pointer<G::Object> Root = g.Add();
+    Root->Label.Set("k") = "<\"a\" & b>\r\n";
+    GraphTLabel<String> e;
+    e.Set("type") = "x&y";
+    g.Connect(Root, g.Add())->Label = e;
+    EXPECT_EQ(h.ImportXML(g.ExportXML()), true);
+    EXPECT_EQ(h.Root()->Label.Get("k"), "<\"a\" & b>\r\n");
+    EXPECT_EQ(h.Root()->Children(e).n(), count(1));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void TEST_BelleUnitTests_EngraveCopies();
+void TEST_BelleUnitTests_EngraveCopies()
+{
+  C::Out() >> "Testing: " "BelleUnitTests" " - " "EngraveCopies";
+
+  //The benchmark needs the score from the resources directory.
+  String Input = File::Read("resources/bach-invention.xml");
+  if(not Input)
+  {
+    C::Out() >> "  Skipped: resources/bach-invention.xml was not found";
+    return;
+  }
+
+  Pointer<Music> M;
+  M.New()->ImportXML(ConvertToXML(Input));
+  UnlinkUnnecessaryInstantwiseEdges(*M);
+  EXPECT_EQ(true, M->Nodes().n() > 0);
+
+  //Engrave the system as Score::Engrave() would with its default dimensions.
+  Font NotationFont = Helper::ImportNotationFont();
+  System::SetHouseStyle(M, HouseStyle::Create(NotationFont));
+  System::SetDimensions(M, 7.25f, RastralSize::Inches(6), true);
+
+  //Report the values deep-copied over one full engraving of the system.
+  Timer TimeToEngrave;
+  count CopiesBefore = Value::DeepCopies();
+  TimeToEngrave.Start();
+  Value Widths = System::Engrave(M);
+  number Seconds = TimeToEngrave.Stop();
+  count Copies = Value::DeepCopies() - CopiesBefore;
+  C::Out() >> "  Value copies engraving " << M->Nodes().n() << " nodes: " <<
+    Copies << " (" << Seconds * 1000.f << " ms)";
+  EXPECT_EQ(true, +Widths["EngravedSpaceWidth"] > 0.f);
+}
+
+/*Compares every traversal of a frozen snapshot against the traversal of the
+graph itself, for each node and each edge type in the graph, and returns the
+number of disagreements. Ambiguous counts the node and type pairs with more than
+one matching edge in either direction.*/
+static count FrozenMusicMismatches(const Music& M, count& Ambiguous)
+{
+  Pointer<const FrozenMusic> F = M.Freeze();
+  count Mismatches = 0;
+  if(F->n() != M.Nodes().n() or F->Node(F->Root()) != M.Root())
+    Mismatches++;
+
+  //Collect the edge types that occur in the graph.
+  Array<mica::Concept> EdgeTypes;
+  Sortable::Array<Music::ConstNode> Nodes = M.Nodes();
+  for(count i = 0; i < Nodes.n(); i++)
+  {
+    Array<Music::ConstEdge> Edges = Nodes[i]->Children(MusicLabel(), true);
+    for(count j = 0; j < Edges.n(); j++)
+      if(not EdgeTypes.Contains(Edges[j]->Get(mica::Type)))
+        EdgeTypes.Add() = Edges[j]->Get(mica::Type);
+  }
+
+  Ambiguous = 0;
+  Array<count> IDs;
+  Array<Music::ConstNode> Handles;
+  for(count i = 0; i < F->n(); i++)
+  {
+    Music::ConstNode x = F->Node(i);
+    if(F->ID(x) != i or F->Type(i) != x->Get(mica::Type) or
+      F->Kind(i) != x->Get(mica::Kind))
+        Mismatches++;
+    for(count j = 0; j < EdgeTypes.n(); j++)
+    {
+      MusicLabel Filter(EdgeTypes[j]);
+      if(F->Next(i, EdgeTypes[j]) != F->ID(x->Next(Filter)) or
+        F->Previous(i, EdgeTypes[j]) != F->ID(x->Previous(Filter)))
+          Mismatches++;
+      F->Children(i, EdgeTypes[j], IDs);
+      F->Handles(IDs, Handles);
+      if(not (Handles == x->Children(Filter)))
+        Mismatches++;
+      if(IDs.n() > 1)
+        Ambiguous++;
+      F->Parents(i, EdgeTypes[j], IDs);
+      F->Handles(IDs, Handles);
+      if(not (Handles == x->Parents(Filter)))
+        Mismatches++;
+      if(IDs.n() > 1)
+        Ambiguous++;
+    }
+  }
+  return Mismatches;
+}
+
+void TEST_BelleUnitTests_FrozenMusicTraversal();
+void TEST_BelleUnitTests_FrozenMusicTraversal()
+{
+  C::Out() >> "Testing: " "BelleUnitTests" " - " "FrozenMusicTraversal";
+
+  /*Build a small graph in which several edges of one type leave or arrive at
+  the same node: a chord with three notes, two of which are tied into the
+  third, and a doubled partwise edge between two islands.*/
+  Music M;
+  Music::Node First = M.Add(), Second = M.Add(), Chord = M.Add();
+  First->Set(mica::Type) = mica::Island;
+  Second->Set(mica::Type) = mica::Island;
+  Chord->Set(mica::Type) = mica::Chord;
+  M.Connect(First, Second)->Set(mica::Type) = mica::Partwise;
+  M.Connect(First, Second)->Set(mica::Type) = mica::Partwise;
+  M.Connect(First, Chord)->Set(mica::Type) = mica::Token;
+  Music::Node Notes[3];
+  for(count i = 0; i < 3; i++)
+  {
+    Notes[i] = M.Add();
+    Notes[i]->Set(mica::Type) = mica::Note;
+    M.Connect(Chord, Notes[i])->Set(mica::Type) = mica::Note;
+  }
+  M.Connect(Notes[0], Notes[2])->Set(mica::Type) = mica::Tie;
+  M.Connect(Notes[1], Notes[2])->Set(mica::Type) = mica::Tie;
+
+  count Ambiguous = 0;
+  EXPECT_EQ(FrozenMusicMismatches(M, Ambiguous), count(0));
+  EXPECT_EQ(Ambiguous, count(4));
+
+  //Ambiguous steps return no node even though each edge leads somewhere.
+  Pointer<const FrozenMusic> F = M.Freeze();
+  Array<count> IDs;
+  EXPECT_EQ(F->Next(F->ID(Chord), mica::Note), count(-1));
+  EXPECT_EQ(F->Previous(F->ID(Notes[2]), mica::Tie), count(-1));
+  EXPECT_EQ(F->Next(F->ID(First), mica::Partwise), count(-1));
+  EXPECT_EQ(F->Next(F->ID(First), mica::Token), F->ID(Chord));
+  EXPECT_EQ(F->Next(F->ID(Notes[0]), mica::Tie), F->ID(Notes[2]));
+  F->Children(F->ID(Chord), mica::Note, IDs);
+  EXPECT_EQ(IDs.n(), count(3));
+  F->Parents(F->ID(Second), mica::Partwise, IDs);
+  EXPECT_EQ(IDs.n(), count(2));
+  EXPECT_EQ(F->Next(F->ID(Notes[2]), mica::Tie), count(-1));
+  EXPECT_EQ(F->Next(count(-1), mica::Tie), count(-1));
+  EXPECT_EQ(F->Next(F->n(), mica::Tie), count(-1));
+
+  //Compare against a full score graph when the resources are available.
+  String Input = File::Read("resources/bach-invention.xml");
+  if(not Input)
+  {
+    C::Out() >> "  Skipped: resources/bach-invention.xml was not found";
+    return;
+  }
+  Music Score;
+  Score.ImportXML(ConvertToXML(Input));
+  EXPECT_EQ(true, Score.Nodes().n() > 0);
+  EXPECT_EQ(FrozenMusicMismatches(Score, Ambiguous), count(0));
+  C::Out() >> "  Node and edge type pairs with several edges: " << Ambiguous;
+}
+
+//Counts the labels of a graph (nodes and edges) that carry typesetting state.
+static count LabelsWithState(const Music& M)
+{
+  count WithState = 0;
+  Sortable::Array<Music::ConstNode> Nodes = M.Nodes();
+  for(count i = 0; i < Nodes.n(); i++)
+  {
+    if(not Nodes[i]->Label.GetState().IsNil())
+      WithState++;
+    Array<Music::ConstEdge> Edges = Nodes[i]->Children(MusicLabel(), true);
+    for(count j = 0; j < Edges.n(); j++)
+      if(not Edges[j]->Label.GetState().IsNil())
+        WithState++;
+  }
+  return WithState;
+}
+
+/*Describes a graph independently of the addresses of its nodes: each node is
+described by its label and the labels of its edges and of the nodes on their
+other ends, and the descriptions are sorted.*/
+static String CanonicalForm(const Music& M)
+{
+  Sortable::Array<String> Descriptions;
+  Sortable::Array<Music::ConstNode> Nodes = M.Nodes();
+  for(count i = 0; i < Nodes.n(); i++)
+  {
+    Sortable::Array<String> Adjacent;
+    Array<Music::ConstEdge> Edges = Nodes[i]->Children(MusicLabel(), true);
+    for(count j = 0; j < Edges.n(); j++)
+      Adjacent.Add() = String("->") + String(Edges[j]->Label) + " " +
+        String(Edges[j]->Head()->Label);
+    Edges = Nodes[i]->Parents(MusicLabel(), true);
+    for(count j = 0; j < Edges.n(); j++)
+      Adjacent.Add() = String("<-") + String(Edges[j]->Label) + " " +
+        String(Edges[j]->Tail()->Label);
+    Adjacent.Sort();
+    String& Description = Descriptions.Add();
+    Description << (Nodes[i] == M.Root() ? "root " : "") <<
+      String(Nodes[i]->Label);
+    for(count j = 0; j < Adjacent.n(); j++)
+      Description << "\n  " << Adjacent[j];
+  }
+  Descriptions.Sort();
+  String Result;
+  for(count i = 0; i < Descriptions.n(); i++)
+    Result >> Descriptions[i];
+  return Result;
+}
+
+void TEST_BelleUnitTests_MusicClone();
+void TEST_BelleUnitTests_MusicClone()
+{
+  C::Out() >> "Testing: " "BelleUnitTests" " - " "MusicClone";
+
+  String Input = File::Read("resources/bach-invention.xml");
+  if(not Input)
+  {
+    C::Out() >> "  Skipped: resources/bach-invention.xml was not found";
+    return;
+  }
+  Pointer<Music> M;
+  M.New()->ImportXML(ConvertToXML(Input));
+  EXPECT_EQ(true, M->Nodes().n() > 0);
+
+  //Give every label some typesetting state as engraving would.
+  {
+    Sortable::Array<Music::Node> Nodes = M->Nodes();
+    for(count i = 0; i < Nodes.n(); i++)
+    {
+      Nodes[i]->Label.SetState(StateKey::IslandState())["Index"] = i;
+      Array<Music::Edge> Edges = Nodes[i]->Children(MusicLabel(), true);
+      for(count j = 0; j < Edges.n(); j++)
+        Edges[j]->Label.SetState(StateKey::Local())["Index"] = j;
+    }
+  }
+  String Original = M->ExportXML();
+
+  //A clone is the same graph that a round trip through XML gives.
+  Pointer<Music> RoundTrip;
+  RoundTrip.New()->ImportXML(Original);
+  Pointer<Music> Clone = M->Clone();
+  EXPECT_EQ(CanonicalForm(*Clone), CanonicalForm(*RoundTrip));
+  EXPECT_EQ(LabelsWithState(*Clone), count(0));
+
+  //The geometry subgraph is the round trip without the non-geometry parts.
+  Pointer<Music> Geometry;
+  Geometry.New()->ImportXML(Original);
+  {
+    Sortable::Array<Music::Node> Nodes = Geometry->Nodes();
+    for(count i = 0; i < Nodes.n(); i++)
+      if(Nodes[i]->Label.Get(mica::Type) != mica::Island)
+        Geometry->Remove(Nodes[i]);
+    Sortable::Array<Music::ConstEdge> Edges = Geometry->Edges();
+    for(count i = 0; i < Edges.n(); i++)
+      if(Edges[i]->Label.Get(mica::Type) != mica::Partwise and
+        Edges[i]->Label.Get(mica::Type) != mica::Instantwise)
+          Geometry->Remove(Geometry->Promote(Edges[i]));
+  }
+  Pointer<Music> Subgraph = M->GeometrySubgraph();
+  EXPECT_EQ(true, Subgraph->Nodes().n() > 0);
+  EXPECT_EQ(CanonicalForm(*Subgraph), CanonicalForm(*Geometry));
+  EXPECT_EQ(LabelsWithState(*Subgraph), count(0));
+
+  //Cloning leaves the original and its state unchanged.
+  EXPECT_EQ(M->ExportXML(), Original);
+  EXPECT_EQ(true, CanonicalForm(*M) != CanonicalForm(*Clone));
+  EXPECT_EQ(LabelsWithState(*M), M->Nodes().n() + M->Edges().n());
+}
+
+///Returns a binary graph with the given bytes following the magic.
+static Array<byte> BinaryGraphWithBody(const byte* Body, count Length)
+{
+  Array<byte> Data(Music::BinaryMagic(), 8);
+  Data.Append(Array<byte>(Body, Length));
+  return Data;
+}
+
+///Imports binary data into a graph that already has nodes.
+static bool ImportBinaryOver(Music& M, const Array<byte>& Data, count Length)
+{
+  M.Clear();
+  M.Connect(M.Add(), M.Add());
+  const byte* Begin = Data.n() ? &Data.a() : 0;
+  return M.ImportBinary(Begin, Begin + Length);
+}
+
+void TEST_BelleUnitTests_BinaryGraph();
+void TEST_BelleUnitTests_BinaryGraph()
+{
+  C::Out() >> "Testing: " "BelleUnitTests" " - " "BinaryGraph";
+
+  /*A hand-made graph of two nodes joined by an edge: no concepts, the strings
+  "k" and "v", a root of node 0, node 0 labeled k:v, and an edge from node 0 to
+  node 1.*/
+  const byte Body[] = {0, 2, 1, 'k', 1, 'v', 2, 1, 0, 1, 0, 1, 0, 0, 1, 0, 1,
+    0, 0};
+  const count BodyLength = count(sizeof(Body));
+  Music M;
+  Array<byte> Data = BinaryGraphWithBody(Body, BodyLength);
+  EXPECT_EQ(ImportBinaryOver(M, Data, Data.n()), true);
+  EXPECT_EQ(M.Nodes().n(), count(2));
+  EXPECT_EQ(M.Edges().n(), count(1));
+  EXPECT_EQ(M.Root()->Label.Get("k"), "v");
+
+  //Out-of-range indices and counts leave the graph empty.
+  {
+    //Positions and replacement values of the bytes to corrupt
+    const count Corruptions[][2] = {
+      {0, 100}, //More concepts than there is data for
+      {1, 100}, //More strings than there is data for
+      {7, 3},   //Root past the last node
+      {8, 1},   //Concept pair with an empty concept dictionary
+      {11, 2},  //String value past the end of the string dictionary
+      {15, 2},  //Edge from a node past the last node
+      {16, 2}}; //Edge to a node past the last node
+    count Accepted = 0, NotEmptied = 0;
+    for(count i = 0; i < count(sizeof(Corruptions) / sizeof(*Corruptions));
+      i++)
+    {
+      Array<byte> Corrupt = Data;
+      Corrupt[8 + Corruptions[i][0]] = byte(Corruptions[i][1]);
+      if(ImportBinaryOver(M, Corrupt, Corrupt.n()))
+        Accepted++;
+      if(M.Nodes().n())
+        NotEmptied++;
+    }
+    EXPECT_EQ(Accepted, count(0));
+    EXPECT_EQ(NotEmptied, count(0));
+  }
+
+  //Every truncation, and trailing data, leaves the graph empty.
+  {
+    count Accepted = 0, NotEmptied = 0;
+    for(count i = 0; i < Data.n(); i++)
+    {
+      if(ImportBinaryOver(M, Data, i))
+        Accepted++;
+      if(M.Nodes().n())
+        NotEmptied++;
+    }
+    Array<byte> Trailing = Data;
+    Trailing.Add(0);
+    if(ImportBinaryOver(M, Trailing, Trailing.n()))
+      Accepted++;
+    EXPECT_EQ(Accepted, count(0));
+    EXPECT_EQ(NotEmptied, count(0));
+  }
+
+  //A full score graph round-trips, also through a mapped file.
+  String Input = File::Read("resources/bach-invention.xml");
+  if(not Input)
+  {
+    C::Out() >> "  Skipped: resources/bach-invention.xml was not found";
+    return;
+  }
+  Pointer<Music> Score;
+  Score.New()->ImportXML(ConvertToXML(Input));
+  String XML = Score->ExportXML();
+  Array<byte> Binary = Score->ExportBinary();
+  EXPECT_EQ(true, Music::IsBinary(&Binary.a(), Binary.n()));
+  EXPECT_EQ(false, Music::IsBinary(XML));
+
+  /*The export of a graph numbers its nodes by address, so the graphs are
+  compared by their canonical forms, and also against an XML round trip.*/
+  Pointer<Music> FromXML, FromBinary, FromFile;
+  FromXML.New()->ImportXML(XML);
+  EXPECT_EQ(FromBinary.New()->ImportBinary(Binary), true);
+  EXPECT_EQ(CanonicalForm(*FromBinary), CanonicalForm(*Score));
+  EXPECT_EQ(CanonicalForm(*FromBinary), CanonicalForm(*FromXML));
+  EXPECT_EQ(Score->ExportXML(), XML);
+
+  const ascii* Filename = "/tmp/belle-units-binary-graph.belleg";
+  EXPECT_EQ(Score->ExportBinaryFile(Filename), true);
+  EXPECT_EQ(FromFile.New()->ImportBinaryFile(Filename), true);
+  EXPECT_EQ(CanonicalForm(*FromFile), CanonicalForm(*Score));
+  std::remove(Filename);
+  EXPECT_EQ(FromFile->ImportBinaryFile(Filename), false);
+  EXPECT_EQ(FromFile->Nodes().n(), count(0));
+
+  //Truncating the score anywhere leaves the graph empty.
+  count Accepted = 0, NotEmptied = 0;
+  for(count i = 0; i < 16; i++)
+  {
+    if(ImportBinaryOver(M, Binary, Binary.n() * i / 16))
+      Accepted++;
+    if(M.Nodes().n())
+      NotEmptied++;
+  }
+  EXPECT_EQ(Accepted, count(0));
+  EXPECT_EQ(NotEmptied, count(0));
+}
+
 void RunAllTests();
 void RunAllTests()
 {
@@ -1324,17 +3490,26 @@ void RunAllTests()
   TEST_PrimUnitTests_AESReference();
   TEST_PrimUnitTests_Base64Decode();
   TEST_PrimUnitTests_Base64Encode();
+  TEST_PrimUnitTests_BinaryValue();
+  TEST_PrimUnitTests_MappedValue();
   TEST_PrimUnitTests_EndianConversion();
   TEST_PrimUnitTests_FFTStressTest();
   TEST_PrimUnitTests_JSONValid();
   TEST_PrimUnitTests_JSONInvalid();
+  TEST_PrimUnitTests_JSONEvents();
+  TEST_PrimUnitTests_JSONWriter();
   TEST_PrimUnitTests_MD5Calculate();
   TEST_PrimUnitTests_MIDI();
+#ifdef PRIM_11
+  TEST_PrimUnitTests_MoveSemantics();
+#endif
+  TEST_PrimUnitTests_PointerMake();
   TEST_PrimUnitTests_NothingComparison();
   TEST_PrimUnitTests_ListQuicksort();
   TEST_PrimUnitTests_ListBubblesort();
   TEST_PrimUnitTests_ArrayQuicksort();
   TEST_PrimUnitTests_SwappableArrayQuicksort();
+  TEST_PrimUnitTests_SymbolKeys();
   TEST_PrimUnitTests_TreeSmokeTest();
   TEST_PrimUnitTests_TreeLargeInsertion();
   TEST_PrimUnitTests_TreeLargeRemoval();
@@ -1342,10 +3517,30 @@ void RunAllTests()
   TEST_PrimUnitTests_TreeTrimming();
   TEST_PrimUnitTests_TreeIterating();
   TEST_PrimUnitTests_TreeLargeDeepCopy();
+  TEST_PrimUnitTests_HashMap();
+  TEST_PrimUnitTests_PooledContainers();
+  TEST_PrimUnitTests_InlineArray();
+  TEST_PrimUnitTests_GraphAdjacency();
+  TEST_PrimUnitTests_GraphClone();
+  TEST_PrimUnitTests_GraphCycle();
+  TEST_PrimUnitTests_Sequence();
+  TEST_PrimUnitTests_NumberFormatting();
+  TEST_PrimUnitTests_NumberParsing();
+  TEST_PrimUnitTests_StringBuilder();
+  TEST_PrimUnitTests_StringSearch();
   TEST_PrimUnitTests_UTF16Decode();
+  TEST_PrimUnitTests_UTF8Decode();
   TEST_PrimUnitTests_UUIDv4NoDuplicates();
   TEST_PrimUnitTests_ValueNilTest();
+  TEST_PrimUnitTests_ValueAssignment();
+  TEST_PrimUnitTests_ValueCopyOnWrite();
+  TEST_PrimUnitTests_ValueInlineStorage();
   TEST_PrimUnitTests_XMLParse();
+  TEST_PrimUnitTests_XMLPullParser();
+  TEST_BelleUnitTests_EngraveCopies();
+  TEST_BelleUnitTests_FrozenMusicTraversal();
+  TEST_BelleUnitTests_MusicClone();
+  TEST_BelleUnitTests_BinaryGraph();
 }
 
 int main()
@@ -31,6 +31,7 @@
 
 #define BELLE_COMPILE_INLINE
 #define PRIM_WITH_DIRECTORY
+#define PRIM_WITH_MEMORY_MAP
 #define PRIM_WITH_TIMER
 #include "belle.h"
 
@@ -172,6 +173,7 @@ int main(int ArgumentCount, const char** Arguments)
     C::Out() >> "Pre-Engrave Options:";
     C::Out() >> " --autocorrect Invokes score autocorrection";
     C::Out() >> " --export    Export XML scores systems";
+    C::Out() >> " --exportbinary Export binary (.belleg) score systems";
     C::Out() >> " --filter   'filter1;filter2;...'";
     C::Out() >> " --generate '[[\"gen1\",args,...],[\"gen2\",args,...],...]'";
     C::Out() >> "             Invoke specific generators by name and arguments";
@@ -395,10 +397,13 @@ int main(int ArgumentCount, const char** Arguments)
         if(!FirstFilename)
           FirstFilename = Parameters[i];
 
-        //Read in the file.
+        /*Read in the file. Binary graphs are not read here since they are
+        decoded directly from a mapping of the file when imported.*/
         C::Out() >> "Reading file " << Parameters[i] << "...";
+        bool IsBinaryGraph = Parameters[i].EndsWith(".belleg");
         String InputData;
-        File::Read(Parameters[i], InputData);
+        if(not IsBinaryGraph)
+          File::Read(Parameters[i], InputData);
 
         if(Parameters.Contains("--publish") and i == 0)
         {
@@ -430,7 +435,10 @@ int main(int ArgumentCount, const char** Arguments)
           bool UseSVG = Parameters.Contains("--incipitsvg");
           String SVGFilename = Parameters[i] + (UseSVG ? ".svg" : ".pdf");
           Pointer<Music> MusicalIncipit;
-          MusicalIncipit.New()->ImportXML(ConvertToXML(InputData));
+          if(IsBinaryGraph)
+            MusicalIncipit.New()->ImportBinaryFile(Parameters[i]);
+          else
+            MusicalIncipit.New()->ImportXML(ConvertToXML(InputData));
           if(String SVGOutput = RenderIncipitAsSVG(
             MusicalIncipit, NotationFont, 6.f, 0.1f,
             0.065f, not UseSVG))
@@ -445,7 +453,12 @@ int main(int ArgumentCount, const char** Arguments)
         Pointer<Music> M;
         Array<byte> MusicXMLValidationZip;
         //Resources::Load("MusicXMLValidation.zip", MusicXMLValidationZip);
-        M.New()->ImportXML(ConvertToXML(InputData, MusicXMLValidationZip));
+        if(IsBinaryGraph)
+          M.New()->ImportBinaryFile(Parameters[i]);
+        else if(Music::IsBinary(InputData))
+          M.New()->ImportBinary(InputData);
+        else
+          M.New()->ImportXML(ConvertToXML(InputData, MusicXMLValidationZip));
         UnlinkUnnecessaryInstantwiseEdges(*M);
 
         System::SpaceStaves(M, StaffToStaffDistance);
@@ -464,6 +477,7 @@ int main(int ArgumentCount, const char** Arguments)
         OutFileStem = FirstFilename;
         OutFileStem.Replace(".txt", "");
         OutFileStem.Replace(".xml", "");
+        OutFileStem.Replace(".belleg", "");
       }
       if(Parameters.Contains("--publish"))
         OutFileStem << "Published";
@@ -658,6 +672,15 @@ int main(int ArgumentCount, const char** Arguments)
         f << i << ".xml";
         File::Write(f, MyScore.ith(i)->ExportXML());
       }
+      if(Parameters.Contains("--exportbinary"))
+      {
+        String f = "exported-";
+        if(i < 10 and MyScore.n() >= 10) f << "0";
+        if(i < 100 and MyScore.n() >= 100) f << "0";
+        if(i < 1000 and MyScore.n() >= 1000) f << "0";
+        f << i << ".belleg";
+        MyScore.ith(i)->ExportBinaryFile(f);
+      }
       if(Parameters.Contains("--publish"))
       {
         PublishedScore["systems"].Add() = MyScore.ith(i)->ExportXML();
@@ -810,7 +833,7 @@ int main(int ArgumentCount, const char** Arguments)
   {
     String PublishedJSONFilename = OutFileStem + ".json";
     C::Out() >> "Publishing to " << PublishedJSONFilename;
-    File::Write(PublishedJSONFilename, JSON::Export(PublishedScore));
+    JSON::ExportFile(PublishedJSONFilename, PublishedScore);
   }
 
   //Open the score if requested.